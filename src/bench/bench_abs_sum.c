@@ -0,0 +1,275 @@
+/* ==========================================================================
+ *  Copyright (C) 2026 Ljubomir Kurij <ljubomir_kurij@protonmail.com>
+ *
+ * This file is part of "C Common Memory Errors".
+ *
+ * "C Common Memory Errors" is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * "C Common Memory Errors" is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General
+ * Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with Focus Precision Analyze. If not, see <https://www.gnu.org/licenses/>.
+ * ========================================================================== */
+
+/* ==========================================================================
+ *
+ * 2026-10-18 Ljubomir Kurij <ljubomir_kurij@protonmail.com>
+ *
+ * * bench_abs_sum.c: created.
+ *
+ * ========================================================================== */
+
+/* ==========================================================================
+ * Headers Include Section
+ * ========================================================================== */
+
+/* Related header */
+
+/* System headers */
+
+/* Standard Library headers */
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+/* Project headers */
+#include "cme_abs_sum.h"
+
+/* ==========================================================================
+ * Macros Definitions Section
+ * ========================================================================== */
+
+#define APP_NAME "bench_abs_sum"
+#define MIN_COUNT ((size_t)1 << 10)
+#define MAX_COUNT ((size_t)1 << 24)
+#define ELEMENTS_PER_RUN ((size_t)1 << 28) /* Elements per measurement */
+
+/* ==========================================================================
+ * Type Definitions Section
+ * ========================================================================== */
+
+/* Input and output arrays shared by the kernels */
+typedef struct abs_data {
+  int32_t *a;
+  int32_t *b;
+  int64_t *wide;
+  int32_t *narrow;
+} abs_data;
+
+typedef int64_t (*abs_fn)(const abs_data *data, size_t n);
+
+typedef struct abs_method {
+  const char *name;
+  abs_fn fn;
+} abs_method;
+
+/* ==========================================================================
+ * User Defined Function Declarations Section
+ * ========================================================================== */
+
+static double now_ns(void);
+static int64_t run_branchy(const abs_data *data, size_t n);
+static int64_t run_sum(const abs_data *data, size_t n);
+static int64_t run_sum_sat(const abs_data *data, size_t n);
+static int64_t run_pairs(const abs_data *data, size_t n);
+static int64_t run_pairs_sat(const abs_data *data, size_t n);
+static double measure(abs_fn fn, const abs_data *data, size_t n);
+
+/* ==========================================================================
+ * Global Variables Section
+ * ========================================================================== */
+
+/* Keep the compiler from optimizing the results away */
+static volatile int64_t g_sink = 0;
+
+static const abs_method kMethods[] = {
+    {"branchy", run_branchy},     {"sum", run_sum},
+    {"sum_sat", run_sum_sat},     {"pairs", run_pairs},
+    {"pairs_sat", run_pairs_sat},
+};
+
+/* ==========================================================================
+ * Main Function Section
+ * ========================================================================== */
+
+int main(void) {
+  const size_t num_methods = sizeof(kMethods) / sizeof(kMethods[0]);
+  abs_data data = {NULL, NULL, NULL, NULL};
+  uint32_t state = 12345;
+  size_t count = 0;
+  size_t i = 0;
+
+  data.a = malloc(MAX_COUNT * sizeof(*data.a));
+  data.b = malloc(MAX_COUNT * sizeof(*data.b));
+  data.wide = malloc(MAX_COUNT * sizeof(*data.wide));
+  data.narrow = malloc(MAX_COUNT * sizeof(*data.narrow));
+  if (!data.a || !data.b || !data.wide || !data.narrow) {
+    fprintf(stderr, "%s: Out of memory\n", APP_NAME);
+    return EXIT_FAILURE;
+  }
+
+  /* Random signs, so a branch on the sign is mispredicted half the time */
+  for (i = 0; i < MAX_COUNT; i++) {
+    state = state * 1664525u + 1013904223u;
+    data.a[i] = (int32_t)state;
+    state = state * 1664525u + 1013904223u;
+    data.b[i] = (int32_t)(state >> 4) * ((state & 1) ? -1 : 1);
+  }
+
+  printf("%-10s", "elements");
+  for (i = 0; i < num_methods; i++) {
+    printf(" %10s", kMethods[i].name);
+  }
+  printf("   (M elements/s)\n");
+
+  for (count = MIN_COUNT; count <= MAX_COUNT; count *= 4) {
+    printf("%-10zu", count);
+    for (i = 0; i < num_methods; i++) {
+      printf(" %10.0f",
+             (double)count * 1e3 / measure(kMethods[i].fn, &data, count));
+    }
+    printf("\n");
+  }
+
+  free(data.a);
+  free(data.b);
+  free(data.wide);
+  free(data.narrow);
+
+  return EXIT_SUCCESS;
+}
+
+/* ==========================================================================
+ * User Defined Function Definitions Section
+ * ========================================================================== */
+
+/* --------------------------------------------------------------------------
+ * Function: now_ns
+ * --------------------------------------------------------------------------
+ *
+ * Description: Read the wall clock
+ *
+ * Returns: Current time in nanoseconds
+ *
+ * -------------------------------------------------------------------------- */
+static double now_ns(void) {
+  struct timespec ts;
+
+  timespec_get(&ts, TIME_UTC);
+
+  return (double)ts.tv_sec * 1e9 + (double)ts.tv_nsec;
+}
+
+/* --------------------------------------------------------------------------
+ * Function: run_branchy
+ * --------------------------------------------------------------------------
+ *
+ * Description: Baseline: the single pair `abs_sum` of the exercise, called
+ *              per element (widened, so it does not overflow)
+ *
+ * -------------------------------------------------------------------------- */
+static int64_t run_branchy(const abs_data *data, size_t n) {
+  int64_t sum = 0;
+  int64_t a = 0;
+  size_t i = 0;
+
+  for (i = 0; i < n; i++) {
+    a = data->a[i];
+    if (a < 0) {
+      a *= -1;
+    }
+    sum += a;
+  }
+
+  return sum;
+}
+
+/* --------------------------------------------------------------------------
+ * Function: run_sum
+ * --------------------------------------------------------------------------
+ *
+ * Description: Widened reduction
+ *
+ * -------------------------------------------------------------------------- */
+static int64_t run_sum(const abs_data *data, size_t n) {
+  return (int64_t)cme_abs_sum(data->a, n);
+}
+
+/* --------------------------------------------------------------------------
+ * Function: run_sum_sat
+ * --------------------------------------------------------------------------
+ *
+ * Description: Saturating reduction
+ *
+ * -------------------------------------------------------------------------- */
+static int64_t run_sum_sat(const abs_data *data, size_t n) {
+  return cme_abs_sum_sat(data->a, n);
+}
+
+/* --------------------------------------------------------------------------
+ * Function: run_pairs
+ * --------------------------------------------------------------------------
+ *
+ * Description: Widened element wise sums
+ *
+ * -------------------------------------------------------------------------- */
+static int64_t run_pairs(const abs_data *data, size_t n) {
+  cme_abs_sum_pairs(data->a, data->b, data->wide, n);
+
+  return data->wide[n - 1];
+}
+
+/* --------------------------------------------------------------------------
+ * Function: run_pairs_sat
+ * --------------------------------------------------------------------------
+ *
+ * Description: Saturating element wise sums
+ *
+ * -------------------------------------------------------------------------- */
+static int64_t run_pairs_sat(const abs_data *data, size_t n) {
+  cme_abs_sum_pairs_sat(data->a, data->b, data->narrow, n);
+
+  return data->narrow[n - 1];
+}
+
+/* --------------------------------------------------------------------------
+ * Function: measure
+ * --------------------------------------------------------------------------
+ *
+ * Description: Time a kernel for a given number of elements. The number of
+ *              repetitions is scaled so every measurement covers about the
+ *              same number of elements.
+ *
+ * Parameters:
+ *        fn: Kernel
+ *      data: Input and output arrays
+ *         n: Number of elements
+ *
+ * Returns: Average time per call in nanoseconds
+ *
+ * -------------------------------------------------------------------------- */
+static double measure(abs_fn fn, const abs_data *data, size_t n) {
+  size_t reps = ELEMENTS_PER_RUN / n;
+  size_t i = 0;
+  double start = 0.0;
+
+  if (4 > reps) {
+    reps = 4;
+  }
+
+  g_sink = fn(data, n); /* Warm up */
+
+  start = now_ns();
+  for (i = 0; i < reps; i++) {
+    g_sink = fn(data, n);
+  }
+
+  return (now_ns() - start) / (double)reps;
+}
@@ -0,0 +1,243 @@
+/* ==========================================================================
+ *  Copyright (C) 2026 Ljubomir Kurij <ljubomir_kurij@protonmail.com>
+ *
+ * This file is part of "C Common Memory Errors".
+ *
+ * "C Common Memory Errors" is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * "C Common Memory Errors" is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General
+ * Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with Focus Precision Analyze. If not, see <https://www.gnu.org/licenses/>.
+ * ========================================================================== */
+
+/* ==========================================================================
+ *
+ * 2026-10-18 Ljubomir Kurij <ljubomir_kurij@protonmail.com>
+ *
+ * * bench_array.c: created.
+ *
+ * ========================================================================== */
+
+/* ==========================================================================
+ * Headers Include Section
+ * ========================================================================== */
+
+/* Related header */
+
+/* System headers */
+
+/* Standard Library headers */
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+/* Project headers */
+
+/* Check every element access in the `checked each` variant, whatever the
+   build type, so it shows the cost of the debug mode */
+#define CME_ARRAY_CHECKED 1
+#include "cme_array.h"
+
+/* ==========================================================================
+ * Macros Definitions Section
+ * ========================================================================== */
+
+#define APP_NAME "bench_array"
+#define MIN_COUNT ((size_t)1 << 10)
+#define MAX_COUNT ((size_t)1 << 24)
+#define ELEMENTS_PER_RUN ((size_t)1 << 28) /* Elements summed per measurement */
+
+/* ==========================================================================
+ * Type Definitions Section
+ * ========================================================================== */
+
+typedef int64_t (*sum_fn)(cme_array_i32 arr, size_t n);
+
+typedef struct sum_method {
+  const char *name;
+  sum_fn fn;
+} sum_method;
+
+/* ==========================================================================
+ * User Defined Function Declarations Section
+ * ========================================================================== */
+
+static double now_ns(void);
+static int64_t sum_raw(cme_array_i32 arr, size_t n);
+static int64_t sum_checked_once(cme_array_i32 arr, size_t n);
+static int64_t sum_checked_each(cme_array_i32 arr, size_t n);
+static double measure(sum_fn fn, cme_array_i32 arr, size_t n);
+
+/* ==========================================================================
+ * Global Variables Section
+ * ========================================================================== */
+
+/* Keep the compiler from optimizing the sums away */
+static volatile int64_t g_sink = 0;
+
+static const sum_method kMethods[] = {
+    {"raw", sum_raw},
+    {"once", sum_checked_once},
+    {"each", sum_checked_each},
+};
+
+/* ==========================================================================
+ * Main Function Section
+ * ========================================================================== */
+
+int main(void) {
+  const size_t num_methods = sizeof(kMethods) / sizeof(kMethods[0]);
+  cme_array_i32 arr = {NULL, 0, 0};
+  size_t count = 0;
+  size_t i = 0;
+
+  arr.data = malloc(MAX_COUNT * sizeof(*arr.data));
+  if (NULL == arr.data) {
+    fprintf(stderr, "%s: Out of memory\n", APP_NAME);
+    return EXIT_FAILURE;
+  }
+  arr.len = arr.cap = MAX_COUNT;
+  for (i = 0; i < MAX_COUNT; i++) {
+    arr.data[i] = (int32_t)(i * 2654435761u);
+  }
+
+  printf("%-10s", "elements");
+  for (i = 0; i < num_methods; i++) {
+    printf(" %10s", kMethods[i].name);
+  }
+  printf("   (elements/ns)\n");
+
+  for (count = MIN_COUNT; count <= MAX_COUNT; count *= 4) {
+    printf("%-10zu", count);
+    for (i = 0; i < num_methods; i++) {
+      printf(" %10.2f", (double)count / measure(kMethods[i].fn, arr, count));
+    }
+    printf("\n");
+  }
+
+  free(arr.data);
+
+  return EXIT_SUCCESS;
+}
+
+/* ==========================================================================
+ * User Defined Function Definitions Section
+ * ========================================================================== */
+
+/* --------------------------------------------------------------------------
+ * Function: now_ns
+ * --------------------------------------------------------------------------
+ *
+ * Description: Read the wall clock
+ *
+ * Returns: Current time in nanoseconds
+ *
+ * -------------------------------------------------------------------------- */
+static double now_ns(void) {
+  struct timespec ts;
+
+  timespec_get(&ts, TIME_UTC);
+
+  return (double)ts.tv_sec * 1e9 + (double)ts.tv_nsec;
+}
+
+/* --------------------------------------------------------------------------
+ * Function: sum_raw
+ * --------------------------------------------------------------------------
+ *
+ * Description: Unchecked loop over the bare pointer, the baseline
+ *
+ * -------------------------------------------------------------------------- */
+static int64_t sum_raw(cme_array_i32 arr, size_t n) {
+  const int32_t *values = arr.data;
+  int64_t sum = 0;
+  size_t i = 0;
+
+  for (i = 0; i < n; i++) {
+    sum += values[i];
+  }
+
+  return sum;
+}
+
+/* --------------------------------------------------------------------------
+ * Function: sum_checked_once
+ * --------------------------------------------------------------------------
+ *
+ * Description: Release mode loop: the range is checked once, the loop body
+ *              is the same as the baseline and should vectorize the same way
+ *
+ * -------------------------------------------------------------------------- */
+static int64_t sum_checked_once(cme_array_i32 arr, size_t n) {
+  const int32_t *values = cme_array_range(i32, arr, 0, n);
+  int64_t sum = 0;
+  size_t i = 0;
+
+  for (i = 0; i < n; i++) {
+    sum += values[i];
+  }
+
+  return sum;
+}
+
+/* --------------------------------------------------------------------------
+ * Function: sum_checked_each
+ * --------------------------------------------------------------------------
+ *
+ * Description: Debug mode loop: every access is checked, the early exit
+ *              keeps the loop scalar
+ *
+ * -------------------------------------------------------------------------- */
+static int64_t sum_checked_each(cme_array_i32 arr, size_t n) {
+  int64_t sum = 0;
+  size_t i = 0;
+
+  for (i = 0; i < n; i++) {
+    sum += *cme_array_at(i32, arr, i);
+  }
+
+  return sum;
+}
+
+/* --------------------------------------------------------------------------
+ * Function: measure
+ * --------------------------------------------------------------------------
+ *
+ * Description: Time the summing loop for a given number of elements. The
+ *              number of repetitions is scaled so every measurement sums
+ *              about the same number of elements.
+ *
+ * Parameters:
+ *        fn: Summing loop
+ *       arr: Array to sum
+ *         n: Number of elements to sum
+ *
+ * Returns: Average time per call in nanoseconds
+ *
+ * -------------------------------------------------------------------------- */
+static double measure(sum_fn fn, cme_array_i32 arr, size_t n) {
+  size_t reps = ELEMENTS_PER_RUN / n;
+  size_t i = 0;
+  double start = 0.0;
+
+  if (4 > reps) {
+    reps = 4;
+  }
+
+  g_sink = fn(arr, n); /* Warm up */
+
+  start = now_ns();
+  for (i = 0; i < reps; i++) {
+    g_sink = fn(arr, n);
+  }
+
+  return (now_ns() - start) / (double)reps;
+}
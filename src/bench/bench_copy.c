@@ -0,0 +1,255 @@
+/* ==========================================================================
+ *  Copyright (C) 2026 Ljubomir Kurij <ljubomir_kurij@protonmail.com>
+ *
+ * This file is part of "C Common Memory Errors".
+ *
+ * "C Common Memory Errors" is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * "C Common Memory Errors" is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General
+ * Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with Focus Precision Analyze. If not, see <https://www.gnu.org/licenses/>.
+ * ========================================================================== */
+
+/* ==========================================================================
+ *
+ * 2026-10-18 Ljubomir Kurij <ljubomir_kurij@protonmail.com>
+ *
+ * * bench_copy.c: created.
+ *
+ * ========================================================================== */
+
+/* ==========================================================================
+ * Headers Include Section
+ * ========================================================================== */
+
+/* Related header */
+
+/* System headers */
+
+/* Standard Library headers */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+/* Project headers */
+#include "cme_string.h"
+
+/* ==========================================================================
+ * Macros Definitions Section
+ * ========================================================================== */
+
+#define APP_NAME "bench_copy"
+#define MIN_SIZE ((size_t)16)
+#define MAX_SIZE ((size_t)1 << 20)
+#define SHORT_LEN ((size_t)15)
+#define BYTES_PER_RUN ((size_t)1 << 28) /* Bytes moved per measurement */
+
+/* ==========================================================================
+ * Type Definitions Section
+ * ========================================================================== */
+
+typedef size_t (*copy_fn)(char *dest, const char *src, size_t src_len,
+                          size_t dest_size);
+
+typedef struct copy_method {
+  const char *name;
+  copy_fn fn;
+} copy_method;
+
+/* ==========================================================================
+ * User Defined Function Declarations Section
+ * ========================================================================== */
+
+static double now_ns(void);
+static size_t copy_strlcpy(char *dest, const char *src, size_t src_len,
+                           size_t dest_size);
+static size_t copy_strncpy(char *dest, const char *src, size_t src_len,
+                           size_t dest_size);
+static size_t copy_memcpy(char *dest, const char *src, size_t src_len,
+                          size_t dest_size);
+static size_t copy_snprintf(char *dest, const char *src, size_t src_len,
+                            size_t dest_size);
+static double measure(copy_fn fn, char *dest, const char *src, size_t size);
+
+/* ==========================================================================
+ * Global Variables Section
+ * ========================================================================== */
+
+/* Keep the compiler from optimizing the copies away */
+static volatile char g_sink = 0;
+
+static const copy_method kMethods[] = {
+    {"cme_strlcpy", copy_strlcpy},
+    {"strncpy", copy_strncpy},
+    {"memcpy", copy_memcpy},
+    {"snprintf", copy_snprintf},
+};
+
+/* ==========================================================================
+ * Main Function Section
+ * ========================================================================== */
+
+int main(void) {
+  const size_t num_methods = sizeof(kMethods) / sizeof(kMethods[0]);
+  char *dest = malloc(MAX_SIZE);
+  char *full = malloc(MAX_SIZE);
+  char *shortstr = malloc(MAX_SIZE);
+  size_t size = 0;
+  size_t i = 0;
+
+  if (NULL == dest || NULL == full || NULL == shortstr) {
+    fprintf(stderr, "%s: Out of memory\n", APP_NAME);
+    free(dest);
+    free(full);
+    free(shortstr);
+    return EXIT_FAILURE;
+  }
+
+  memset(dest, 'x', MAX_SIZE);
+  memset(shortstr, 'y', SHORT_LEN);
+  shortstr[SHORT_LEN] = '\0';
+
+  /* Source that exactly fills the destination, and a short source that makes
+     `strncpy` pad the rest of the destination with zeros */
+  printf("%-8s %-6s", "size", "source");
+  for (i = 0; i < num_methods; i++) {
+    printf(" %14s", kMethods[i].name);
+  }
+  printf("   (ns/op)\n");
+
+  for (size = MIN_SIZE; size <= MAX_SIZE; size *= 4) {
+    memset(full, 'z', size - 1);
+    full[size - 1] = '\0';
+
+    printf("%-8zu %-6s", size, "full");
+    for (i = 0; i < num_methods; i++) {
+      printf(" %14.1f", measure(kMethods[i].fn, dest, full, size));
+    }
+    printf("\n");
+
+    printf("%-8zu %-6s", size, "short");
+    for (i = 0; i < num_methods; i++) {
+      printf(" %14.1f", measure(kMethods[i].fn, dest, shortstr, size));
+    }
+    printf("\n");
+  }
+
+  free(dest);
+  free(full);
+  free(shortstr);
+
+  return EXIT_SUCCESS;
+}
+
+/* ==========================================================================
+ * User Defined Function Definitions Section
+ * ========================================================================== */
+
+/* --------------------------------------------------------------------------
+ * Function: now_ns
+ * --------------------------------------------------------------------------
+ *
+ * Description: Read the wall clock
+ *
+ * Returns: Current time in nanoseconds
+ *
+ * -------------------------------------------------------------------------- */
+static double now_ns(void) {
+  struct timespec ts;
+
+  timespec_get(&ts, TIME_UTC);
+
+  return (double)ts.tv_sec * 1e9 + (double)ts.tv_nsec;
+}
+
+/* --------------------------------------------------------------------------
+ * Functions: copy_strlcpy, copy_strncpy, copy_memcpy, copy_snprintf
+ * --------------------------------------------------------------------------
+ *
+ * Description: Copy a string into a buffer of a given size using one of the
+ *              compared methods. The `memcpy` variant is the lower bound: it
+ *              is told the source length up front and does no scanning, it
+ *              copies the string and its terminator, or what fits. The other
+ *              methods find the length themselves and ignore `src_len`.
+ *
+ * Returns: Number of bytes copied (or the source length)
+ *
+ * -------------------------------------------------------------------------- */
+static size_t copy_strlcpy(char *dest, const char *src, size_t src_len,
+                           size_t dest_size) {
+  (void)src_len;
+
+  return cme_strlcpy(dest, src, dest_size);
+}
+
+static size_t copy_strncpy(char *dest, const char *src, size_t src_len,
+                           size_t dest_size) {
+  (void)src_len;
+  strncpy(dest, src, dest_size - 1);
+  dest[dest_size - 1] = '\0';
+
+  return dest_size;
+}
+
+static size_t copy_memcpy(char *dest, const char *src, size_t src_len,
+                          size_t dest_size) {
+  size_t n = src_len < dest_size ? src_len + 1 : dest_size;
+
+  memcpy(dest, src, n);
+  dest[n - 1] = '\0';
+
+  return n;
+}
+
+static size_t copy_snprintf(char *dest, const char *src, size_t src_len,
+                            size_t dest_size) {
+  (void)src_len;
+
+  return (size_t)snprintf(dest, dest_size, "%s", src);
+}
+
+/* --------------------------------------------------------------------------
+ * Function: measure
+ * --------------------------------------------------------------------------
+ *
+ * Description: Time the copy method for a given destination size. The number
+ *              of repetitions is scaled so every measurement moves about the
+ *              same amount of memory. The source length is taken once, up
+ *              front, for the methods that are told it.
+ *
+ * Parameters:
+ *        fn: Copy method
+ *      dest: Destination buffer
+ *       src: Null terminated source string
+ *      size: Size of the destination buffer in bytes
+ *
+ * Returns: Average time per copy in nanoseconds
+ *
+ * -------------------------------------------------------------------------- */
+static double measure(copy_fn fn, char *dest, const char *src, size_t size) {
+  const size_t src_len = strlen(src);
+  size_t reps = BYTES_PER_RUN / size;
+  size_t i = 0;
+  double start = 0.0;
+
+  /* Warm up the caches and the branch predictors */
+  for (i = 0; i < reps / 16 + 1; i++) {
+    fn(dest, src, src_len, size);
+  }
+
+  start = now_ns();
+  for (i = 0; i < reps; i++) {
+    fn(dest, src, src_len, size);
+    g_sink = dest[i % size];
+  }
+
+  return (now_ns() - start) / (double)reps;
+}
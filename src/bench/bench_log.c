@@ -0,0 +1,204 @@
+/* ==========================================================================
+ *  Copyright (C) 2026 Ljubomir Kurij <ljubomir_kurij@protonmail.com>
+ *
+ * This file is part of "C Common Memory Errors".
+ *
+ * "C Common Memory Errors" is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * "C Common Memory Errors" is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General
+ * Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with Focus Precision Analyze. If not, see <https://www.gnu.org/licenses/>.
+ * ========================================================================== */
+
+/* ==========================================================================
+ *
+ * 2026-10-18 Ljubomir Kurij <ljubomir_kurij@protonmail.com>
+ *
+ * * bench_log.c: created.
+ *
+ * ========================================================================== */
+
+/* ==========================================================================
+ * Headers Include Section
+ * ========================================================================== */
+
+/* Related header */
+
+/* System headers */
+
+/* Standard Library headers */
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+/* Project headers */
+#include "cme_log.h"
+
+/* ==========================================================================
+ * Macros Definitions Section
+ * ========================================================================== */
+
+#define APP_NAME "bench_log"
+#define RECORDS_PER_RUN 1000000 /* Records logged per measurement */
+
+/* ==========================================================================
+ * Type Definitions Section
+ * ========================================================================== */
+
+typedef void (*log_fn)(int i);
+
+typedef struct log_method {
+  const char *name;
+  log_fn fn;
+  int async;                 /* Start the background writer first */
+  cme_log_overflow overflow; /* Overflow policy of the writer */
+} log_method;
+
+/* ==========================================================================
+ * User Defined Function Declarations Section
+ * ========================================================================== */
+
+static double thread_ns(void);
+static void log_printf(int i);
+static void log_printf_flush(int i);
+static void log_cme(int i);
+static double measure(const log_method *method);
+
+/* ==========================================================================
+ * Global Variables Section
+ * ========================================================================== */
+
+static const log_method kMethods[] = {
+    {"printf", log_printf, 0, CME_LOG_BLOCK},
+    {"printf+fflush", log_printf_flush, 0, CME_LOG_BLOCK},
+    {"cme_log sync", log_cme, 0, CME_LOG_BLOCK},
+    {"cme_log block", log_cme, 1, CME_LOG_BLOCK},
+    {"cme_log drop", log_cme, 1, CME_LOG_DROP},
+};
+
+/* ==========================================================================
+ * Main Function Section
+ * ========================================================================== */
+
+int main(void) {
+  const size_t num_methods = sizeof(kMethods) / sizeof(kMethods[0]);
+  uint64_t dropped = 0;
+  size_t i = 0;
+
+  fprintf(stderr, "%s: %d records per method, records go to stdout (e.g. "
+                  "redirect it to /dev/null or a file)\n",
+          APP_NAME, RECORDS_PER_RUN);
+  fprintf(stderr, "%-16s %12s %12s\n", "method", "ns/record", "dropped");
+
+  for (i = 0; i < num_methods; i++) {
+    dropped = cme_log_dropped();
+    fprintf(stderr, "%-16s %12.1f", kMethods[i].name, measure(&kMethods[i]));
+    fprintf(stderr, " %12llu\n",
+            (unsigned long long)(cme_log_dropped() - dropped));
+  }
+
+  return EXIT_SUCCESS;
+}
+
+/* ==========================================================================
+ * User Defined Function Definitions Section
+ * ========================================================================== */
+
+/* --------------------------------------------------------------------------
+ * Function: thread_ns
+ * --------------------------------------------------------------------------
+ *
+ * Description: Read the processor time of the calling thread, so the work of
+ *              the background writer is not counted even when both threads
+ *              share a processor (falls back to the wall clock)
+ *
+ * Returns: Current time in nanoseconds
+ *
+ * -------------------------------------------------------------------------- */
+static double thread_ns(void) {
+  struct timespec ts;
+
+#ifdef CLOCK_THREAD_CPUTIME_ID
+  clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts);
+#else
+  timespec_get(&ts, TIME_UTC);
+#endif
+
+  return (double)ts.tv_sec * 1e9 + (double)ts.tv_nsec;
+}
+
+/* --------------------------------------------------------------------------
+ * Function: log_printf
+ * --------------------------------------------------------------------------
+ *
+ * Description: Baseline: the `printf` calls of the demo programs
+ *
+ * -------------------------------------------------------------------------- */
+static void log_printf(int i) {
+  printf("%s: Record %d of %d\n", APP_NAME, i, RECORDS_PER_RUN);
+}
+
+/* --------------------------------------------------------------------------
+ * Function: log_printf_flush
+ * --------------------------------------------------------------------------
+ *
+ * Description: `printf` on a line buffered (terminal) or unbuffered stream:
+ *              one write per record
+ *
+ * -------------------------------------------------------------------------- */
+static void log_printf_flush(int i) {
+  printf("%s: Record %d of %d\n", APP_NAME, i, RECORDS_PER_RUN);
+  fflush(stdout);
+}
+
+/* --------------------------------------------------------------------------
+ * Function: log_cme
+ * --------------------------------------------------------------------------
+ *
+ * Description: The same record through the log
+ *
+ * -------------------------------------------------------------------------- */
+static void log_cme(int i) { cme_log("Record %d of %d\n", i, RECORDS_PER_RUN); }
+
+/* --------------------------------------------------------------------------
+ * Function: measure
+ * --------------------------------------------------------------------------
+ *
+ * Description: Time the logging calls of a method. Only the time the
+ *              calling thread spends in the calls is measured; the writes of
+ *              the background writer are not.
+ *
+ * Parameters:
+ *      method: Method to time
+ *
+ * Returns: Average time per record in nanoseconds
+ *
+ * -------------------------------------------------------------------------- */
+static double measure(const log_method *method) {
+  double elapsed = 0.0;
+  int i = 0;
+
+  cme_log_start(APP_NAME, 0, method->overflow);
+  if (!method->async) {
+    cme_log_stop();
+  }
+
+  elapsed = thread_ns();
+  for (i = 0; i < RECORDS_PER_RUN; i++) {
+    method->fn(i);
+  }
+  elapsed = thread_ns() - elapsed;
+
+  cme_log_stop();
+  fflush(stdout);
+
+  return elapsed / RECORDS_PER_RUN;
+}
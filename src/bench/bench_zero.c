@@ -0,0 +1,189 @@
+/* ==========================================================================
+ *  Copyright (C) 2026 Ljubomir Kurij <ljubomir_kurij@protonmail.com>
+ *
+ * This file is part of "C Common Memory Errors".
+ *
+ * "C Common Memory Errors" is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * "C Common Memory Errors" is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General
+ * Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with Focus Precision Analyze. If not, see <https://www.gnu.org/licenses/>.
+ * ========================================================================== */
+
+/* ==========================================================================
+ *
+ * 2026-10-18 Ljubomir Kurij <ljubomir_kurij@protonmail.com>
+ *
+ * * bench_zero.c: created.
+ *
+ * ========================================================================== */
+
+/* ==========================================================================
+ * Headers Include Section
+ * ========================================================================== */
+
+/* Related header */
+
+/* System headers */
+
+/* Standard Library headers */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+/* Project headers */
+#include "cme_zero.h"
+
+/* ==========================================================================
+ * Macros Definitions Section
+ * ========================================================================== */
+
+#define APP_NAME "bench_zero"
+#define MIN_SIZE ((size_t)16)
+#define MAX_SIZE ((size_t)64 << 20)
+#define BYTES_PER_RUN ((size_t)1 << 29) /* Bytes zeroed per measurement */
+
+/* ==========================================================================
+ * Type Definitions Section
+ * ========================================================================== */
+
+typedef void (*zero_fn)(void *dest, size_t size);
+
+typedef struct zero_method {
+  const char *name;
+  zero_fn fn;
+} zero_method;
+
+/* ==========================================================================
+ * User Defined Function Declarations Section
+ * ========================================================================== */
+
+static double now_ns(void);
+static void zero_memset(void *dest, size_t size);
+static double measure(zero_fn fn, unsigned char *buf, size_t size);
+
+/* ==========================================================================
+ * Global Variables Section
+ * ========================================================================== */
+
+/* Keep the compiler from optimizing the stores away */
+static volatile unsigned char g_sink = 0;
+
+static const zero_method kMethods[] = {
+    {"memset", zero_memset},        {"scalar", cme_zero_scalar},
+    {"vector", cme_zero_vector},    {"stream", cme_zero_stream},
+    {"cme_zero", cme_zero},         {"secure", cme_secure_zero},
+};
+
+/* ==========================================================================
+ * Main Function Section
+ * ========================================================================== */
+
+int main(void) {
+  const size_t num_methods = sizeof(kMethods) / sizeof(kMethods[0]);
+  unsigned char *buf = malloc(MAX_SIZE);
+  size_t size = 0;
+  size_t i = 0;
+
+  if (NULL == buf) {
+    fprintf(stderr, "%s: Out of memory\n", APP_NAME);
+    return EXIT_FAILURE;
+  }
+
+  /* Touch every page up front, so page faults do not end up in the timings */
+  memset(buf, 0xff, MAX_SIZE);
+
+  printf("%s: streaming threshold %zu bytes\n", APP_NAME,
+         cme_zero_stream_threshold());
+  printf("%-10s", "size");
+  for (i = 0; i < num_methods; i++) {
+    printf(" %10s", kMethods[i].name);
+  }
+  printf("   (GB/s)\n");
+
+  for (size = MIN_SIZE; size <= MAX_SIZE; size *= 2) {
+    printf("%-10zu", size);
+    for (i = 0; i < num_methods; i++) {
+      printf(" %10.2f", (double)size / measure(kMethods[i].fn, buf, size));
+    }
+    printf("\n");
+  }
+
+  free(buf);
+
+  return EXIT_SUCCESS;
+}
+
+/* ==========================================================================
+ * User Defined Function Definitions Section
+ * ========================================================================== */
+
+/* --------------------------------------------------------------------------
+ * Function: now_ns
+ * --------------------------------------------------------------------------
+ *
+ * Description: Read the wall clock
+ *
+ * Returns: Current time in nanoseconds
+ *
+ * -------------------------------------------------------------------------- */
+static double now_ns(void) {
+  struct timespec ts;
+
+  timespec_get(&ts, TIME_UTC);
+
+  return (double)ts.tv_sec * 1e9 + (double)ts.tv_nsec;
+}
+
+/* --------------------------------------------------------------------------
+ * Function: zero_memset
+ * --------------------------------------------------------------------------
+ *
+ * Description: The C library `memset` as the baseline
+ *
+ * -------------------------------------------------------------------------- */
+static void zero_memset(void *dest, size_t size) { memset(dest, 0, size); }
+
+/* --------------------------------------------------------------------------
+ * Function: measure
+ * --------------------------------------------------------------------------
+ *
+ * Description: Time the zeroing method for a given block size. The number of
+ *              repetitions is scaled so every measurement writes about the
+ *              same amount of memory.
+ *
+ * Parameters:
+ *        fn: Zeroing method
+ *       buf: Buffer to clear
+ *      size: Number of bytes to clear
+ *
+ * Returns: Average time per call in nanoseconds
+ *
+ * -------------------------------------------------------------------------- */
+static double measure(zero_fn fn, unsigned char *buf, size_t size) {
+  size_t reps = BYTES_PER_RUN / size;
+  size_t i = 0;
+  double start = 0.0;
+
+  if (4 > reps) {
+    reps = 4;
+  }
+
+  fn(buf, size); /* Warm up */
+
+  start = now_ns();
+  for (i = 0; i < reps; i++) {
+    fn(buf, size);
+    g_sink = buf[i % size];
+  }
+
+  return (now_ns() - start) / (double)reps;
+}
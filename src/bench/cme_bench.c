@@ -0,0 +1,538 @@
+/* ==========================================================================
+ *  Copyright (C) 2026 Ljubomir Kurij <ljubomir_kurij@protonmail.com>
+ *
+ * This file is part of "C Common Memory Errors".
+ *
+ * "C Common Memory Errors" is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * "C Common Memory Errors" is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General
+ * Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with Focus Precision Analyze. If not, see <https://www.gnu.org/licenses/>.
+ * ========================================================================== */
+
+/* ==========================================================================
+ *
+ * 2026-10-18 Ljubomir Kurij <ljubomir_kurij@protonmail.com>
+ *
+ * * cme_bench.c: created.
+ *
+ * ========================================================================== */
+
+/* ==========================================================================
+ * Headers Include Section
+ * ========================================================================== */
+
+/* Related header */
+
+/* System headers */
+
+/* Standard Library headers */
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/* External libraries headers */
+#include <argparse.h>
+
+/* Project headers */
+#include "cme_alloc.h"
+#include "cme_bench_harness.h"
+#include "cme_frees.h"
+#include "cme_reads.h"
+#include "cme_seq.h"
+#include "cme_string.h"
+#include "cme_values.h"
+#include "cme_writes.h"
+
+/* ==========================================================================
+ * Macros Definitions Section
+ * ========================================================================== */
+
+#define APP_NAME "cme_bench"
+#define APP_DESCRIPTION                                                        \
+  "Microbenchmarks of the routines of the demo programs. Every benchmark\n"    \
+  "runs at each of the input sizes (the length of the input text or\n"         \
+  "buffer, or the number of calls or values, see below) and reports the\n"     \
+  "time per operation (mean, minimum and percentiles over the samples) and\n"  \
+  "the allocations per operation. The results go to stderr."
+#define APP_USAGE_A APP_NAME " [OPTION]..."
+#define APP_EPILOGUE                                                           \
+  "\nOne operation of each benchmark, for an input size n:\n"                  \
+  "  even_or_blank      n calls (for 0 ... 99, cycling) and frees\n"           \
+  "  get_odds           odd numbers up to n, freed\n"                          \
+  "  splitter           split of an n character id, freed\n"                   \
+  "  fix_amp            encoding of an n character text, freed\n"              \
+  "  get_sentence       first sentence of an n character text, freed\n"        \
+  "  get_powers_of_7    first min(n, 22) powers, freed\n"                      \
+  "  get_alpha_letters  n letters, freed\n"                                    \
+  "  set_zero           zeroing of n bytes\n"                                  \
+  "  write_quote        an n character quote written to the null device\n"     \
+  "  abs_sum            n pairs summed"
+#define DEFAULT_SIZES "16,256,4096,65536"
+#define MAX_SIZES 32
+#define MAX_POWERS_OF_7 22 /* 7^22 is the largest power that fits 64 bits */
+#define AMP_EVERY 16       /* One ampersand every AMP_EVERY characters */
+#ifdef _WIN32
+#define NULL_DEVICE "NUL"
+#else
+#define NULL_DEVICE "/dev/null"
+#endif /* End of platform specific macro definition */
+
+/* ==========================================================================
+ * Type Definitions Section
+ * ========================================================================== */
+
+/* Inputs shared by the benchmarks, built for the largest size */
+typedef struct bench_inputs {
+  char *text;      /* Letters with '&'s, a '-' halfway and a '.' at the end */
+  char *buffer;    /* Scratch buffer */
+  int32_t *values; /* Random values of both signs (one more than the size) */
+  FILE *sink;      /* Null device */
+  size_t size;     /* Size the text is currently terminated at */
+} bench_inputs;
+
+typedef struct bench_case {
+  const char *name;
+  cme_bench_fn fn;
+} bench_case;
+
+/* ==========================================================================
+ * User Defined Function Declarations Section
+ * ========================================================================== */
+
+static size_t parse_sizes(const char *list, size_t *sizes, size_t max_sizes);
+static char text_char(size_t i);
+static int make_inputs(bench_inputs *inputs, size_t max_size);
+static void shape_text(bench_inputs *inputs, size_t size);
+static void free_inputs(bench_inputs *inputs);
+static void run_even_or_blank(void *ctx, size_t size);
+static void run_get_odds(void *ctx, size_t size);
+static void run_splitter(void *ctx, size_t size);
+static void run_fix_amp(void *ctx, size_t size);
+static void run_get_sentence(void *ctx, size_t size);
+static void run_get_powers_of_7(void *ctx, size_t size);
+static void run_get_alpha_letters(void *ctx, size_t size);
+static void run_set_zero(void *ctx, size_t size);
+static void run_write_quote(void *ctx, size_t size);
+static void run_abs_sum(void *ctx, size_t size);
+
+/* ==========================================================================
+ * Global Variables Section
+ * ========================================================================== */
+
+static const char *const kUsages[] = {
+    APP_USAGE_A,
+    NULL,
+};
+
+/* Keep the compiler from optimizing the results away */
+static volatile int64_t g_sink = 0;
+
+static const bench_case kCases[] = {
+    {"even_or_blank", run_even_or_blank},
+    {"get_odds", run_get_odds},
+    {"splitter", run_splitter},
+    {"fix_amp", run_fix_amp},
+    {"get_sentence", run_get_sentence},
+    {"get_powers_of_7", run_get_powers_of_7},
+    {"get_alpha_letters", run_get_alpha_letters},
+    {"set_zero", run_set_zero},
+    {"write_quote", run_write_quote},
+    {"abs_sum", run_abs_sum},
+};
+
+/* ==========================================================================
+ * Main Function Section
+ * ========================================================================== */
+
+int main(int argc, char **argv) {
+  const char *filter = NULL;
+  const char *size_list = DEFAULT_SIZES;
+  int warmup = CME_BENCH_DEFAULT_WARMUP;
+  int samples = CME_BENCH_DEFAULT_SAMPLES;
+  size_t sizes[MAX_SIZES];
+  size_t num_sizes = 0;
+  size_t max_size = 0;
+  bench_inputs inputs;
+  cme_bench_config config;
+  cme_bench_result result;
+  size_t i = 0;
+  size_t j = 0;
+
+  /* Define command line options */
+  struct argparse_option options[] = {
+      OPT_GROUP("general options"),
+      OPT_HELP(),
+      OPT_GROUP("benchmark options"),
+      OPT_STRING('f', "filter", &filter,
+                 "run only the benchmarks whose name contains the text", NULL,
+                 0, 0),
+      OPT_STRING('s', "sizes", &size_list,
+                 "comma separated input sizes (default " DEFAULT_SIZES ")",
+                 NULL, 0, 0),
+      OPT_INTEGER('w', "warmup", &warmup, "untimed samples per benchmark",
+                  NULL, 0, 0),
+      OPT_INTEGER('n', "samples", &samples, "timed samples per benchmark",
+                  NULL, 0, 0),
+      OPT_END(),
+  };
+
+  /* Parse command line arguments */
+  struct argparse argparse;
+  argparse_init(&argparse, options, kUsages, 0);
+  argparse_describe(&argparse, APP_DESCRIPTION, APP_EPILOGUE);
+  argc = argparse_parse(&argparse, argc, (const char **)argv);
+
+  num_sizes = parse_sizes(size_list, sizes, MAX_SIZES);
+  if (0 == num_sizes || 0 > warmup || 0 >= samples) {
+    fprintf(stderr, "%s: Invalid sizes, warmup or samples\n", APP_NAME);
+    return EXIT_FAILURE;
+  }
+  for (i = 0; i < num_sizes; i++) {
+    max_size = max_size < sizes[i] ? sizes[i] : max_size;
+  }
+  if (0 != make_inputs(&inputs, max_size)) {
+    fprintf(stderr, "%s: Can not prepare the inputs\n", APP_NAME);
+    return EXIT_FAILURE;
+  }
+
+  cme_bench_config_init(&config);
+  config.warmup = (size_t)warmup;
+  config.samples = (size_t)samples;
+
+  cme_bench_print_header(stderr);
+  for (i = 0; i < sizeof(kCases) / sizeof(kCases[0]); i++) {
+    if (filter && !strstr(kCases[i].name, filter)) {
+      continue;
+    }
+    for (j = 0; j < num_sizes; j++) {
+      shape_text(&inputs, sizes[j]);
+      if (0 == cme_bench_run(kCases[i].fn, &inputs, sizes[j], &config,
+                             &result)) {
+        cme_bench_print_result(stderr, kCases[i].name, sizes[j], &result);
+      }
+    }
+  }
+
+  free_inputs(&inputs);
+
+  return EXIT_SUCCESS;
+}
+
+/* ==========================================================================
+ * User Defined Function Definitions Section
+ * ========================================================================== */
+
+/* --------------------------------------------------------------------------
+ * Function: parse_sizes
+ * --------------------------------------------------------------------------
+ *
+ * Description: Parse a comma separated list of sizes
+ *
+ * Parameters:
+ *           list: List to parse
+ *          sizes: Receives the sizes
+ *      max_sizes: Capacity of `sizes`
+ *
+ * Returns: Number of sizes parsed (0 if the list is invalid)
+ *
+ * -------------------------------------------------------------------------- */
+static size_t parse_sizes(const char *list, size_t *sizes, size_t max_sizes) {
+  size_t count = 0;
+  char *end = NULL;
+  unsigned long long value = 0;
+
+  while (*list && count < max_sizes) {
+    value = strtoull(list, &end, 10);
+    if (end == list || 0 == value || (*end && ',' != *end)) {
+      return 0;
+    }
+    sizes[count++] = (size_t)value;
+    list = *end ? end + 1 : end;
+  }
+
+  return count;
+}
+
+/* --------------------------------------------------------------------------
+ * Function: text_char
+ * --------------------------------------------------------------------------
+ *
+ * Description: Character of the unmarked input text at an offset: letters
+ *              and spaces, with an ampersand every `AMP_EVERY` characters
+ *
+ * Parameters:
+ *      i: Offset
+ *
+ * Returns: The character
+ *
+ * -------------------------------------------------------------------------- */
+static char text_char(size_t i) {
+  static const char kLetters[] = "abcdefghijklmnopqrstuvwxyz ";
+
+  return AMP_EVERY - 1 == i % AMP_EVERY ? '&'
+                                        : kLetters[i % (sizeof(kLetters) - 1)];
+}
+
+/* --------------------------------------------------------------------------
+ * Function: make_inputs
+ * --------------------------------------------------------------------------
+ *
+ * Description: Allocate and fill the benchmark inputs
+ *
+ * Parameters:
+ *        inputs: Inputs to build
+ *      max_size: Largest input size
+ *
+ * Returns: 0 on success, -1 on failure
+ *
+ * -------------------------------------------------------------------------- */
+static int make_inputs(bench_inputs *inputs, size_t max_size) {
+  uint32_t state = 12345;
+  size_t i = 0;
+
+  inputs->text = malloc(max_size + 2);
+  inputs->buffer = malloc(max_size);
+  inputs->values = malloc((max_size + 1) * sizeof(*inputs->values));
+  inputs->sink = fopen(NULL_DEVICE, "w");
+  inputs->size = max_size;
+  if (!inputs->text || !inputs->buffer || !inputs->values || !inputs->sink) {
+    free_inputs(inputs);
+    return -1;
+  }
+
+  for (i = 0; i < max_size; i++) {
+    inputs->text[i] = text_char(i);
+  }
+  inputs->text[max_size] = '\0';
+  inputs->text[max_size + 1] = '\0';
+  for (i = 0; i <= max_size; i++) {
+    state = state * 1664525u + 1013904223u;
+    inputs->values[i] = (int32_t)state;
+  }
+
+  return 0;
+}
+
+/* --------------------------------------------------------------------------
+ * Function: shape_text
+ * --------------------------------------------------------------------------
+ *
+ * Description: Cut the input text to a size: a '-' halfway (for the
+ *              splitter) and a '.' at the end (for the first sentence). The
+ *              marks of the previous size are undone first.
+ *
+ * Parameters:
+ *      inputs: Benchmark inputs
+ *        size: Input size
+ *
+ * Returns: None
+ *
+ * -------------------------------------------------------------------------- */
+static void shape_text(bench_inputs *inputs, size_t size) {
+  const size_t old = inputs->size;
+
+  /* Restore the old marks (the text is one longer than the largest size,
+     so restoring the terminator of the largest size is harmless) */
+  inputs->text[old / 2] = text_char(old / 2);
+  inputs->text[old - 1] = text_char(old - 1);
+  inputs->text[old] = text_char(old);
+
+  inputs->text[size] = '\0';
+  inputs->text[size / 2] = '-';
+  inputs->text[size - 1] = '.';
+  inputs->size = size;
+}
+
+/* --------------------------------------------------------------------------
+ * Function: free_inputs
+ * --------------------------------------------------------------------------
+ *
+ * Description: Release the benchmark inputs
+ *
+ * Parameters:
+ *      inputs: Inputs to release
+ *
+ * Returns: None
+ *
+ * -------------------------------------------------------------------------- */
+static void free_inputs(bench_inputs *inputs) {
+  free(inputs->text);
+  free(inputs->buffer);
+  free(inputs->values);
+  if (inputs->sink) {
+    fclose(inputs->sink);
+  }
+  memset(inputs, 0, sizeof(*inputs));
+}
+
+
+/* --------------------------------------------------------------------------
+ * Function: run_even_or_blank
+ * --------------------------------------------------------------------------
+ *
+ * Description: Calls of `even_or_blank` for 0 ... 99, cycling
+ *
+ * -------------------------------------------------------------------------- */
+static void run_even_or_blank(void *ctx, size_t size) {
+  char *text = NULL;
+  char *err = NULL;
+  size_t i = 0;
+
+  (void)ctx;
+  for (i = 0; i < size; i++) {
+    text = cme_even_or_blank((int)(i % 100), &err);
+    g_sink += text ? text[0] : 0;
+    cme_free(text);
+  }
+}
+
+/* --------------------------------------------------------------------------
+ * Function: run_get_odds
+ * --------------------------------------------------------------------------
+ *
+ * Description: Odd numbers up to the size
+ *
+ * -------------------------------------------------------------------------- */
+static void run_get_odds(void *ctx, size_t size) {
+  cme_seq odds = cme_get_odds((int)size);
+
+  (void)ctx;
+  g_sink += (int64_t)odds.len;
+  cme_seq_free(&odds);
+}
+
+/* --------------------------------------------------------------------------
+ * Function: run_splitter
+ * --------------------------------------------------------------------------
+ *
+ * Description: Split of the input text at its dash
+ *
+ * -------------------------------------------------------------------------- */
+static void run_splitter(void *ctx, size_t size) {
+  bench_inputs *inputs = ctx;
+  char *prefix = NULL;
+  char *suffix = NULL;
+
+  (void)size;
+  cme_splitter(inputs->text, &prefix, &suffix);
+  g_sink += suffix ? suffix[0] : 0;
+  cme_free(prefix);
+}
+
+/* --------------------------------------------------------------------------
+ * Function: run_fix_amp
+ * --------------------------------------------------------------------------
+ *
+ * Description: Encoding of the ampersands of the input text
+ *
+ * -------------------------------------------------------------------------- */
+static void run_fix_amp(void *ctx, size_t size) {
+  bench_inputs *inputs = ctx;
+  char *fixed = cme_fix_amp(inputs->text);
+
+  (void)size;
+  g_sink += fixed ? fixed[0] : 0;
+  cme_free(fixed);
+}
+
+/* --------------------------------------------------------------------------
+ * Function: run_get_sentence
+ * --------------------------------------------------------------------------
+ *
+ * Description: First sentence of the input text
+ *
+ * -------------------------------------------------------------------------- */
+static void run_get_sentence(void *ctx, size_t size) {
+  bench_inputs *inputs = ctx;
+  cme_str text = {inputs->text, size, size + 1};
+  cme_str sentence = cme_get_sentence(text);
+
+  g_sink += (int64_t)sentence.len;
+  cme_str_free(&sentence);
+}
+
+/* --------------------------------------------------------------------------
+ * Function: run_get_powers_of_7
+ * --------------------------------------------------------------------------
+ *
+ * Description: First powers of 7 (at most `MAX_POWERS_OF_7`)
+ *
+ * -------------------------------------------------------------------------- */
+static void run_get_powers_of_7(void *ctx, size_t size) {
+  cme_seq powers = cme_get_powers_of_7(
+      (int)(MAX_POWERS_OF_7 < size ? MAX_POWERS_OF_7 : size));
+
+  (void)ctx;
+  g_sink += (int64_t)powers.len;
+  cme_seq_free(&powers);
+}
+
+/* --------------------------------------------------------------------------
+ * Function: run_get_alpha_letters
+ * --------------------------------------------------------------------------
+ *
+ * Description: Letters of the alphabet, cycling
+ *
+ * -------------------------------------------------------------------------- */
+static void run_get_alpha_letters(void *ctx, size_t size) {
+  char *letters = cme_get_alpha_letters((int)size);
+
+  (void)ctx;
+  g_sink += letters ? letters[0] : 0;
+  cme_free(letters);
+}
+
+/* --------------------------------------------------------------------------
+ * Function: run_set_zero
+ * --------------------------------------------------------------------------
+ *
+ * Description: Zeroing of the scratch buffer
+ *
+ * -------------------------------------------------------------------------- */
+static void run_set_zero(void *ctx, size_t size) {
+  bench_inputs *inputs = ctx;
+
+  cme_set_zero(inputs->buffer, size);
+  g_sink += inputs->buffer[0];
+}
+
+/* --------------------------------------------------------------------------
+ * Function: run_write_quote
+ * --------------------------------------------------------------------------
+ *
+ * Description: Quote written to the null device
+ *
+ * -------------------------------------------------------------------------- */
+static void run_write_quote(void *ctx, size_t size) {
+  bench_inputs *inputs = ctx;
+  cme_str quote = {inputs->text, size, size + 1};
+
+  cme_write_quote(inputs->sink, quote);
+}
+
+/* --------------------------------------------------------------------------
+ * Function: run_abs_sum
+ * --------------------------------------------------------------------------
+ *
+ * Description: Absolute sums of neighbouring values
+ *
+ * -------------------------------------------------------------------------- */
+static void run_abs_sum(void *ctx, size_t size) {
+  bench_inputs *inputs = ctx;
+  int64_t sum = 0;
+  size_t i = 0;
+
+  for (i = 0; i < size; i++) {
+    sum += cme_abs_sum_two(inputs->values[i], inputs->values[i + 1]);
+  }
+  g_sink += sum;
+}
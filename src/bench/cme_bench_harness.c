@@ -0,0 +1,299 @@
+/* ==========================================================================
+ *  Copyright (C) 2026 Ljubomir Kurij <ljubomir_kurij@protonmail.com>
+ *
+ * This file is part of "C Common Memory Errors".
+ *
+ * "C Common Memory Errors" is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * "C Common Memory Errors" is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General
+ * Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with Focus Precision Analyze. If not, see <https://www.gnu.org/licenses/>.
+ * ========================================================================== */
+
+/* ==========================================================================
+ *
+ * 2026-10-18 Ljubomir Kurij <ljubomir_kurij@protonmail.com>
+ *
+ * * cme_bench_harness.c: created.
+ *
+ * ========================================================================== */
+
+/* ==========================================================================
+ * Headers Include Section
+ * ========================================================================== */
+
+/* Related header */
+#include "cme_bench_harness.h"
+
+/* Standard Library headers */
+#include <stdlib.h>
+#include <time.h>
+
+/* Project headers */
+#include "cme_alloc.h"
+
+/* ==========================================================================
+ * Private Function Declarations Section
+ * ========================================================================== */
+
+static double now_ns(void);
+static double time_ops(cme_bench_fn fn, void *ctx, size_t size, size_t ops);
+static int compare_doubles(const void *a, const void *b);
+static double percentile(const double *sorted, size_t count, double p);
+
+/* ==========================================================================
+ * Function Definitions Section
+ * ========================================================================== */
+
+/* --------------------------------------------------------------------------
+ * Function: cme_bench_config_init
+ * --------------------------------------------------------------------------
+ *
+ * Description: Fill a configuration with the defaults
+ *
+ * Parameters:
+ *      config: Configuration to fill
+ *
+ * Returns: None
+ *
+ * -------------------------------------------------------------------------- */
+void cme_bench_config_init(cme_bench_config *config) {
+  config->warmup = CME_BENCH_DEFAULT_WARMUP;
+  config->samples = CME_BENCH_DEFAULT_SAMPLES;
+  config->sample_ns = CME_BENCH_DEFAULT_SAMPLE_NS;
+}
+
+/* --------------------------------------------------------------------------
+ * Function: cme_bench_run
+ * --------------------------------------------------------------------------
+ *
+ * Description: Benchmark an operation. The number of operations per sample
+ *              is calibrated so a sample lasts at least `sample_ns` (which
+ *              keeps the timer resolution out of the results), the warmup
+ *              samples are run and thrown away, then the timed samples are
+ *              taken. Each sample gives one time per operation; the
+ *              percentiles are taken over the samples. Allocations are
+ *              counted over the timed samples.
+ *
+ * Parameters:
+ *          fn: Operation
+ *         ctx: Passed to the operation
+ *        size: Input size passed to the operation
+ *      config: Warmup, samples and sample length
+ *      result: Receives the timings
+ *
+ * Returns: 0 on success, -1 if out of memory
+ *
+ * -------------------------------------------------------------------------- */
+int cme_bench_run(cme_bench_fn fn, void *ctx, size_t size,
+                  const cme_bench_config *config, cme_bench_result *result) {
+  size_t samples = config->samples;
+  size_t ops = 1;
+  double *times = NULL;
+  double elapsed = 0.0;
+  double total = 0.0;
+  cme_alloc_counts before;
+  cme_alloc_counts after;
+  size_t i = 0;
+
+  if (0 == samples) {
+    samples = 1;
+  }
+  if (CME_BENCH_MAX_SAMPLES < samples) {
+    samples = CME_BENCH_MAX_SAMPLES;
+  }
+  times = malloc(samples * sizeof(*times));
+  if (!times) {
+    return -1;
+  }
+
+  /* Calibrate: double the operations until a sample is long enough */
+  while ((elapsed = time_ops(fn, ctx, size, ops)) < config->sample_ns &&
+         ops < ((size_t)1 << 30)) {
+    ops *= 2;
+  }
+
+  for (i = 0; i < config->warmup; i++) {
+    time_ops(fn, ctx, size, ops);
+  }
+
+  before = cme_alloc_get_counts();
+  for (i = 0; i < samples; i++) {
+    times[i] = time_ops(fn, ctx, size, ops) / (double)ops;
+    total += times[i];
+  }
+  after = cme_alloc_get_counts();
+
+  qsort(times, samples, sizeof(*times), compare_doubles);
+
+  result->samples = samples;
+  result->ops_per_sample = ops;
+  result->mean_ns = total / (double)samples;
+  result->min_ns = times[0];
+  result->p50_ns = percentile(times, samples, 0.50);
+  result->p90_ns = percentile(times, samples, 0.90);
+  result->p99_ns = percentile(times, samples, 0.99);
+  result->max_ns = times[samples - 1];
+  result->allocs_per_op =
+      (double)(after.allocs - before.allocs) / (double)(samples * ops);
+  result->bytes_per_op =
+      (double)(after.bytes - before.bytes) / (double)(samples * ops);
+
+  free(times);
+
+  return 0;
+}
+
+/* --------------------------------------------------------------------------
+ * Function: cme_bench_print_header
+ * --------------------------------------------------------------------------
+ *
+ * Description: Print the column titles of the result table
+ *
+ * Parameters:
+ *      stream: Stream to print to
+ *
+ * Returns: None
+ *
+ * -------------------------------------------------------------------------- */
+void cme_bench_print_header(FILE *stream) {
+  fprintf(stream, "%-18s %9s %11s %11s %11s %11s %11s %9s %10s\n",
+          "benchmark", "size", "ns/op", "min", "p50", "p90", "p99",
+          "allocs/op", "bytes/op");
+}
+
+/* --------------------------------------------------------------------------
+ * Function: cme_bench_print_result
+ * --------------------------------------------------------------------------
+ *
+ * Description: Print one row of the result table. The allocation columns
+ *              read "n/a" in the builds whose allocations bypass `cme_alloc`
+ *              (`CME_ALLOC_TRACKED` is 0).
+ *
+ * Parameters:
+ *      stream: Stream to print to
+ *        name: Name of the benchmark
+ *        size: Input size
+ *      result: Timings
+ *
+ * Returns: None
+ *
+ * -------------------------------------------------------------------------- */
+void cme_bench_print_result(FILE *stream, const char *name, size_t size,
+                            const cme_bench_result *result) {
+  fprintf(stream, "%-18s %9zu %11.1f %11.1f %11.1f %11.1f %11.1f ", name,
+          size, result->mean_ns, result->min_ns, result->p50_ns,
+          result->p90_ns, result->p99_ns);
+  if (CME_ALLOC_TRACKED) {
+    fprintf(stream, "%9.2f %10.1f\n", result->allocs_per_op,
+            result->bytes_per_op);
+  } else {
+    /* The allocations of this build bypass `cme_alloc`: none is counted */
+    fprintf(stream, "%9s %10s\n", "n/a", "n/a");
+  }
+}
+
+/* ==========================================================================
+ * Private Function Definitions Section
+ * ========================================================================== */
+
+/* --------------------------------------------------------------------------
+ * Function: now_ns
+ * --------------------------------------------------------------------------
+ *
+ * Description: Read a monotonic clock where there is one, the calendar
+ *              clock otherwise (which steps when the time is set)
+ *
+ * Returns: Current time in nanoseconds, from an arbitrary start
+ *
+ * -------------------------------------------------------------------------- */
+static double now_ns(void) {
+  struct timespec ts;
+
+#ifdef CLOCK_MONOTONIC
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+#else
+  timespec_get(&ts, TIME_UTC);
+#endif
+
+  return (double)ts.tv_sec * 1e9 + (double)ts.tv_nsec;
+}
+
+/* --------------------------------------------------------------------------
+ * Function: time_ops
+ * --------------------------------------------------------------------------
+ *
+ * Description: Run an operation a number of times
+ *
+ * Parameters:
+ *        fn: Operation
+ *       ctx: Passed to the operation
+ *      size: Input size passed to the operation
+ *       ops: Number of runs
+ *
+ * Returns: Elapsed time in nanoseconds
+ *
+ * -------------------------------------------------------------------------- */
+static double time_ops(cme_bench_fn fn, void *ctx, size_t size, size_t ops) {
+  double start = now_ns();
+  size_t i = 0;
+
+  for (i = 0; i < ops; i++) {
+    fn(ctx, size);
+  }
+
+  return now_ns() - start;
+}
+
+/* --------------------------------------------------------------------------
+ * Function: compare_doubles
+ * --------------------------------------------------------------------------
+ *
+ * Description: `qsort` comparison of two doubles
+ *
+ * -------------------------------------------------------------------------- */
+static int compare_doubles(const void *a, const void *b) {
+  const double x = *(const double *)a;
+  const double y = *(const double *)b;
+
+  return (x > y) - (x < y);
+}
+
+/* --------------------------------------------------------------------------
+ * Function: percentile
+ * --------------------------------------------------------------------------
+ *
+ * Description: Percentile of sorted values (nearest rank)
+ *
+ * Parameters:
+ *      sorted: Values in ascending order
+ *       count: Number of values
+ *           p: Percentile as a fraction (e.g. 0.99)
+ *
+ * Returns: The value at the percentile
+ *
+ * -------------------------------------------------------------------------- */
+static double percentile(const double *sorted, size_t count, double p) {
+  const double exact = p * (double)count;
+  size_t rank = (size_t)exact;
+
+  /* Smallest value with at least a fraction p of the values at or below */
+  if ((double)rank < exact) {
+    rank++;
+  }
+  if (0 < rank) {
+    rank--;
+  }
+  if (count <= rank) {
+    rank = count - 1;
+  }
+
+  return sorted[rank];
+}
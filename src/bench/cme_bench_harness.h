@@ -0,0 +1,86 @@
+/* ==========================================================================
+ *  Copyright (C) 2026 Ljubomir Kurij <ljubomir_kurij@protonmail.com>
+ *
+ * This file is part of "C Common Memory Errors".
+ *
+ * "C Common Memory Errors" is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * "C Common Memory Errors" is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General
+ * Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with Focus Precision Analyze. If not, see <https://www.gnu.org/licenses/>.
+ * ========================================================================== */
+
+/* ==========================================================================
+ *
+ * 2026-10-18 Ljubomir Kurij <ljubomir_kurij@protonmail.com>
+ *
+ * * cme_bench_harness.h: created.
+ *
+ * ========================================================================== */
+
+#ifndef CME_BENCH_HARNESS_H_
+#define CME_BENCH_HARNESS_H_
+
+/* ==========================================================================
+ * Headers Include Section
+ * ========================================================================== */
+
+/* Standard Library headers */
+#include <stddef.h>
+#include <stdio.h>
+
+/* ==========================================================================
+ * Macros Definitions Section
+ * ========================================================================== */
+
+#define CME_BENCH_DEFAULT_WARMUP 3
+#define CME_BENCH_DEFAULT_SAMPLES 31
+#define CME_BENCH_DEFAULT_SAMPLE_NS 1e6 /* Shortest sample (1 ms) */
+#define CME_BENCH_MAX_SAMPLES 10000
+
+/* ==========================================================================
+ * Type Definitions Section
+ * ========================================================================== */
+
+/* One operation of a benchmark on an input of the given size. The context
+   holds the inputs, prepared outside of the timed loop. */
+typedef void (*cme_bench_fn)(void *ctx, size_t size);
+
+typedef struct cme_bench_config {
+  size_t warmup;     /* Untimed samples before the timed ones */
+  size_t samples;    /* Timed samples (percentiles are taken over these) */
+  double sample_ns;  /* Each sample repeats the operation at least this long */
+} cme_bench_config;
+
+typedef struct cme_bench_result {
+  size_t samples;       /* Timed samples */
+  size_t ops_per_sample;
+  double mean_ns;       /* Per operation */
+  double min_ns;
+  double p50_ns;
+  double p90_ns;
+  double p99_ns;
+  double max_ns;
+  double allocs_per_op; /* Blocks allocated through `cme_alloc` */
+  double bytes_per_op;  /* Bytes requested through `cme_alloc` */
+} cme_bench_result;
+
+/* ==========================================================================
+ * Function Declarations Section
+ * ========================================================================== */
+
+void cme_bench_config_init(cme_bench_config *config);
+int cme_bench_run(cme_bench_fn fn, void *ctx, size_t size,
+                  const cme_bench_config *config, cme_bench_result *result);
+void cme_bench_print_header(FILE *stream);
+void cme_bench_print_result(FILE *stream, const char *name, size_t size,
+                            const cme_bench_result *result);
+
+#endif /* CME_BENCH_HARNESS_H_ */
@@ -0,0 +1,238 @@
+/* ==========================================================================
+ *  Copyright (C) 2026 Ljubomir Kurij <ljubomir_kurij@protonmail.com>
+ *
+ * This file is part of "C Common Memory Errors".
+ *
+ * "C Common Memory Errors" is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * "C Common Memory Errors" is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General
+ * Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with Focus Precision Analyze. If not, see <https://www.gnu.org/licenses/>.
+ * ========================================================================== */
+
+/* ==========================================================================
+ *
+ * 2026-10-18 Ljubomir Kurij <ljubomir_kurij@protonmail.com>
+ *
+ * * cme_abs_sum.c: created.
+ *
+ * ========================================================================== */
+
+/* ==========================================================================
+ * Headers Include Section
+ * ========================================================================== */
+
+/* Related header */
+#include "cme_abs_sum.h"
+
+/* System headers */
+#if defined(__SSE2__) || defined(_M_X64) ||                                    \
+    (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define CME_HAVE_SSE2 1
+#include <emmintrin.h>
+#endif /* End of SSE2 headers */
+
+/* ==========================================================================
+ * Macros Definitions Section
+ * ========================================================================== */
+
+/* Branchless absolute value of a 32 bit integer, as unsigned */
+#define CME_UABS32(v)                                                          \
+  (((uint32_t)(v) ^ (0u - ((uint32_t)(v) >> 31))) + ((uint32_t)(v) >> 31))
+
+/* ==========================================================================
+ * Private Function Declarations Section
+ * ========================================================================== */
+
+#ifdef CME_HAVE_SSE2
+static __m128i uabs_epi32(__m128i v);
+#endif
+
+/* ==========================================================================
+ * Function Definitions Section
+ * ========================================================================== */
+
+/* --------------------------------------------------------------------------
+ * Function: cme_abs_sum
+ * --------------------------------------------------------------------------
+ *
+ * Description: Sum of the absolute values of an array, in 64 bits. Four
+ *              values per step: absolute values in 32 bit lanes, widened to
+ *              64 bits and added into two accumulators.
+ *
+ * Parameters:
+ *      values: Array of values
+ *           n: Number of values
+ *
+ * Returns: The sum
+ *
+ * -------------------------------------------------------------------------- */
+uint64_t cme_abs_sum(const int32_t *values, size_t n) {
+  uint64_t sum = 0;
+  size_t i = 0;
+
+#ifdef CME_HAVE_SSE2
+  const __m128i zero = _mm_setzero_si128();
+  __m128i acc_lo = _mm_setzero_si128();
+  __m128i acc_hi = _mm_setzero_si128();
+  uint64_t lanes[2];
+
+  for (; i + 4 <= n; i += 4) {
+    const __m128i u =
+        uabs_epi32(_mm_loadu_si128((const __m128i *)(values + i)));
+
+    acc_lo = _mm_add_epi64(acc_lo, _mm_unpacklo_epi32(u, zero));
+    acc_hi = _mm_add_epi64(acc_hi, _mm_unpackhi_epi32(u, zero));
+  }
+  _mm_storeu_si128((__m128i *)lanes, _mm_add_epi64(acc_lo, acc_hi));
+  sum = lanes[0] + lanes[1];
+#endif /* End of SSE2 code */
+
+  for (; i < n; i++) {
+    sum += CME_UABS32(values[i]);
+  }
+
+  return sum;
+}
+
+/* --------------------------------------------------------------------------
+ * Function: cme_abs_sum_sat
+ * --------------------------------------------------------------------------
+ *
+ * Description: Sum of the absolute values of an array, clamped to INT32_MAX
+ *
+ * Parameters:
+ *      values: Array of values
+ *           n: Number of values
+ *
+ * Returns: The sum, or INT32_MAX if it does not fit
+ *
+ * -------------------------------------------------------------------------- */
+int32_t cme_abs_sum_sat(const int32_t *values, size_t n) {
+  const uint64_t sum = cme_abs_sum(values, n);
+
+  return sum > INT32_MAX ? INT32_MAX : (int32_t)sum;
+}
+
+/* --------------------------------------------------------------------------
+ * Function: cme_abs_sum_pairs
+ * --------------------------------------------------------------------------
+ *
+ * Description: Element wise `|a[i]| + |b[i]|`, in 64 bits
+ *
+ * Parameters:
+ *        a: First array of values
+ *        b: Second array of values
+ *      out: Array receiving the sums (may not overlap the inputs)
+ *        n: Number of elements
+ *
+ * Returns: None
+ *
+ * -------------------------------------------------------------------------- */
+void cme_abs_sum_pairs(const int32_t *a, const int32_t *b, int64_t *out,
+                       size_t n) {
+  size_t i = 0;
+
+#ifdef CME_HAVE_SSE2
+  const __m128i zero = _mm_setzero_si128();
+
+  for (; i + 4 <= n; i += 4) {
+    const __m128i ua = uabs_epi32(_mm_loadu_si128((const __m128i *)(a + i)));
+    const __m128i ub = uabs_epi32(_mm_loadu_si128((const __m128i *)(b + i)));
+
+    _mm_storeu_si128((__m128i *)(out + i),
+                     _mm_add_epi64(_mm_unpacklo_epi32(ua, zero),
+                                   _mm_unpacklo_epi32(ub, zero)));
+    _mm_storeu_si128((__m128i *)(out + i + 2),
+                     _mm_add_epi64(_mm_unpackhi_epi32(ua, zero),
+                                   _mm_unpackhi_epi32(ub, zero)));
+  }
+#endif /* End of SSE2 code */
+
+  for (; i < n; i++) {
+    out[i] = (int64_t)CME_UABS32(a[i]) + (int64_t)CME_UABS32(b[i]);
+  }
+}
+
+/* --------------------------------------------------------------------------
+ * Function: cme_abs_sum_pairs_sat
+ * --------------------------------------------------------------------------
+ *
+ * Description: Element wise `|a[i]| + |b[i]|`, clamped to INT32_MAX. The sum
+ *              is formed in unsigned 32 bit lanes; it is clamped if it
+ *              wrapped (it is then smaller than one of the terms) or has its
+ *              top bit set.
+ *
+ * Parameters:
+ *        a: First array of values
+ *        b: Second array of values
+ *      out: Array receiving the sums (may be one of the inputs)
+ *        n: Number of elements
+ *
+ * Returns: None
+ *
+ * -------------------------------------------------------------------------- */
+void cme_abs_sum_pairs_sat(const int32_t *a, const int32_t *b, int32_t *out,
+                           size_t n) {
+  size_t i = 0;
+  uint32_t ua = 0;
+  uint32_t sum = 0;
+
+#ifdef CME_HAVE_SSE2
+  const __m128i bias = _mm_set1_epi32(INT32_MIN);
+  const __m128i max = _mm_set1_epi32(INT32_MAX);
+
+  for (; i + 4 <= n; i += 4) {
+    const __m128i va = uabs_epi32(_mm_loadu_si128((const __m128i *)(a + i)));
+    const __m128i vb = uabs_epi32(_mm_loadu_si128((const __m128i *)(b + i)));
+    const __m128i s = _mm_add_epi32(va, vb);
+    /* Unsigned `s < va` through signed compares of the biased values */
+    const __m128i wrapped = _mm_cmpgt_epi32(_mm_xor_si128(va, bias),
+                                            _mm_xor_si128(s, bias));
+    const __m128i clamp = _mm_or_si128(wrapped, _mm_srai_epi32(s, 31));
+
+    _mm_storeu_si128((__m128i *)(out + i),
+                     _mm_or_si128(_mm_andnot_si128(clamp, s),
+                                  _mm_and_si128(clamp, max)));
+  }
+#endif /* End of SSE2 code */
+
+  for (; i < n; i++) {
+    ua = CME_UABS32(a[i]);
+    sum = ua + CME_UABS32(b[i]);
+    out[i] = sum < ua || sum > INT32_MAX ? INT32_MAX : (int32_t)sum;
+  }
+}
+
+/* ==========================================================================
+ * Private Function Definitions Section
+ * ========================================================================== */
+
+#ifdef CME_HAVE_SSE2
+/* --------------------------------------------------------------------------
+ * Function: uabs_epi32
+ * --------------------------------------------------------------------------
+ *
+ * Description: Branchless absolute value of four 32 bit lanes (SSE2 has no
+ *              `pabsd`): `(v ^ s) - s` with `s` the sign mask. The result is
+ *              to be read as unsigned.
+ *
+ * Parameters:
+ *      v: Four signed values
+ *
+ * Returns: Four absolute values
+ *
+ * -------------------------------------------------------------------------- */
+static __m128i uabs_epi32(__m128i v) {
+  const __m128i sign = _mm_srai_epi32(v, 31);
+
+  return _mm_sub_epi32(_mm_xor_si128(v, sign), sign);
+}
+#endif
@@ -0,0 +1,57 @@
+/* ==========================================================================
+ *  Copyright (C) 2026 Ljubomir Kurij <ljubomir_kurij@protonmail.com>
+ *
+ * This file is part of "C Common Memory Errors".
+ *
+ * "C Common Memory Errors" is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * "C Common Memory Errors" is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General
+ * Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with Focus Precision Analyze. If not, see <https://www.gnu.org/licenses/>.
+ * ========================================================================== */
+
+/* ==========================================================================
+ *
+ * 2026-10-18 Ljubomir Kurij <ljubomir_kurij@protonmail.com>
+ *
+ * * cme_abs_sum.h: created.
+ *
+ * ========================================================================== */
+
+#ifndef CME_ABS_SUM_H_
+#define CME_ABS_SUM_H_
+
+/* ==========================================================================
+ * Headers Include Section
+ * ========================================================================== */
+
+/* Standard Library headers */
+#include <stddef.h>
+#include <stdint.h>
+
+/* ==========================================================================
+ * Function Declarations Section
+ * ========================================================================== */
+
+/* Sums of absolute values over arrays of 32 bit integers. Absolute values
+   are taken without branches (`|v| = (v ^ s) - s` with `s` the sign mask)
+   and read as unsigned, so |INT32_MIN| = 2^31 is exact. The wide variants
+   add in 64 bits and can not overflow (for the reductions: as long as
+   `n < 2^33`); the saturating variants stay in 32 bits and clamp at
+   INT32_MAX. */
+
+uint64_t cme_abs_sum(const int32_t *values, size_t n);
+int32_t cme_abs_sum_sat(const int32_t *values, size_t n);
+void cme_abs_sum_pairs(const int32_t *a, const int32_t *b, int64_t *out,
+                       size_t n);
+void cme_abs_sum_pairs_sat(const int32_t *a, const int32_t *b, int32_t *out,
+                           size_t n);
+
+#endif /* CME_ABS_SUM_H_ */
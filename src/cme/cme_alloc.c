@@ -0,0 +1,2594 @@
+/* ==========================================================================
+ *  Copyright (C) 2026 Ljubomir Kurij <ljubomir_kurij@protonmail.com>
+ *
+ * This file is part of "C Common Memory Errors".
+ *
+ * "C Common Memory Errors" is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * "C Common Memory Errors" is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General
+ * Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with Focus Precision Analyze. If not, see <https://www.gnu.org/licenses/>.
+ * ========================================================================== */
+
+/* ==========================================================================
+ *
+ * 2026-10-18 Ljubomir Kurij <ljubomir_kurij@protonmail.com>
+ *
+ * * cme_alloc.c: created.
+ *
+ * ========================================================================== */
+
+/* ==========================================================================
+ * Headers Include Section
+ * ========================================================================== */
+
+/* Related header (the plain functions are defined here, hence no call site
+   macros) */
+#define CME_ALLOC_NO_SITES
+#include "cme_alloc.h"
+
+/* System headers */
+#if defined(__unix__) || defined(__APPLE__)
+#define CME_HAVE_GUARD 1
+#include <sys/mman.h>
+#include <unistd.h>
+#endif /* End of platform specific headers */
+
+#ifdef CME_HAVE_PTHREADS
+#include <pthread.h>
+#endif
+
+#if defined(CME_HAVE_PTHREADS) && !defined(__STDC_NO_ATOMICS__)
+#define CME_HAVE_ATOMICS 1
+#include <stdatomic.h>
+#endif
+
+#if defined(__linux__) || defined(_WIN32)
+#include <malloc.h>
+#elif defined(__APPLE__)
+#include <malloc/malloc.h>
+#endif /* End of usable size headers */
+
+#if defined(__SSE2__) || defined(_M_X64) ||                                    \
+    (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define CME_HAVE_SSE2 1
+#include <emmintrin.h>
+#endif /* End of SSE2 headers */
+
+/* Standard Library headers */
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/* Project headers */
+#include "cme_heapprof.h"
+#include "cme_leakcheck.h"
+#include "cme_parallel.h"
+#include "cme_poison.h"
+#include "cme_trace.h"
+
+/* ==========================================================================
+ * Macros Definitions Section
+ * ========================================================================== */
+
+#ifdef CME_HAVE_GUARD
+#ifndef MAP_ANONYMOUS
+#define MAP_ANONYMOUS MAP_ANON
+#endif
+#ifndef MAP_NORESERVE
+#define MAP_NORESERVE 0
+#endif
+#endif
+
+#ifdef CME_HAVE_PTHREADS
+#define CME_ALLOC_LOCK() pthread_mutex_lock(&g_lock)
+#define CME_ALLOC_UNLOCK() pthread_mutex_unlock(&g_lock)
+#define CME_THREAD_LOCAL _Thread_local
+#else
+#define CME_ALLOC_LOCK() ((void)0)
+#define CME_ALLOC_UNLOCK() ((void)0)
+#define CME_THREAD_LOCAL
+#endif
+
+/* Bytes reserved in front of every guarded block for its header */
+#define CME_GUARD_HEADER 32
+#define CME_GUARD_MAGIC 0x47415244u /* "GARD" */
+
+/* Bytes in front of a block in redzone mode: header plus left redzone */
+#define CME_REDZONE_HEADER 16
+#define CME_REDZONE_OFFSET (CME_REDZONE_HEADER + CME_REDZONE_SIZE)
+#define CME_REDZONE_MAGIC 0x52445a4eu /* "RDZN" */
+
+/* Round `n` up to a multiple of the power of two `a` */
+#define CME_ROUND_UP(n, a) (((n) + (a) - 1) & ~((size_t)(a) - 1))
+
+/* Call site indices cached per thread (a power of two) */
+#define CME_SITE_CACHE_SIZE 256
+
+/* Keys of the free slots of the block table of the statistics */
+#define CME_BLOCK_EMPTY ((uintptr_t)0)
+#define CME_BLOCK_DELETED ((uintptr_t)1)
+
+/* Values of the block table: call site index above the requested size */
+#define CME_BLOCK_SIZE_BITS 40
+#define CME_BLOCK_SIZE_MASK ((UINT64_C(1) << CME_BLOCK_SIZE_BITS) - 1)
+
+/* Keys of the block tables. A thread enters and removes its own blocks
+   with plain loads and stores; a thread freeing a block of another thread
+   takes it out with compare and swap. */
+#ifdef CME_HAVE_ATOMICS
+#define CME_BLOCK_KEY atomic_uintptr_t
+#define CME_BLOCK_LOAD(key) atomic_load_explicit(&(key), memory_order_acquire)
+#define CME_BLOCK_STORE(key, value)                                            \
+  atomic_store_explicit(&(key), (value), memory_order_release)
+#define CME_BLOCK_CLAIM(key, seen, value)                                      \
+  atomic_compare_exchange_strong(&(key), &(seen), (value))
+#else
+#define CME_BLOCK_KEY uintptr_t
+#define CME_BLOCK_LOAD(key) (key)
+#define CME_BLOCK_STORE(key, value) ((key) = (value))
+#define CME_BLOCK_CLAIM(key, seen, value) ((void)(seen), (key) = (value), 1)
+#endif
+
+/* Globals set once under the lock and read without it: the store publishes
+   whatever was set before it to the threads that load the value */
+#ifdef CME_HAVE_ATOMICS
+#define CME_PUBLISHED(type) _Atomic(type)
+#define CME_LOAD_ACQUIRE(var) atomic_load_explicit(&(var), memory_order_acquire)
+#define CME_STORE_RELEASE(var, value)                                          \
+  atomic_store_explicit(&(var), (value), memory_order_release)
+#else
+#define CME_PUBLISHED(type) type
+#define CME_LOAD_ACQUIRE(var) (var)
+#define CME_STORE_RELEASE(var, value) ((var) = (value))
+#endif
+
+/* ==========================================================================
+ * Type Definitions Section
+ * ========================================================================== */
+
+/* Header stored right in front of a guarded block */
+typedef struct guard_header {
+  size_t size;      /* Requested size */
+  uint32_t first;   /* Index of the first page of the slot */
+  uint32_t pages;   /* Number of data pages of the slot */
+  uint32_t magic;   /* `CME_GUARD_MAGIC` while the block is live */
+} guard_header;
+
+_Static_assert(sizeof(guard_header) <= CME_GUARD_HEADER,
+               "guard header does not fit its reserved space");
+
+/* Header stored in front of the left redzone of a block */
+typedef struct redzone_header {
+  size_t size;    /* Requested size */
+  uint32_t magic; /* `CME_REDZONE_MAGIC` */
+} redzone_header;
+
+_Static_assert(sizeof(redzone_header) <= CME_REDZONE_HEADER,
+               "redzone header does not fit its reserved space");
+
+/* Counters of a call site in one thread. `live` goes negative in a thread
+   that frees what other threads allocated. */
+typedef struct site_counts {
+  uint64_t allocs;
+  uint64_t bytes;
+  uint64_t frees;
+  int64_t live;
+  int64_t peak;
+} site_counts;
+
+/* Live blocks a thread allocated with the statistics on: open addressing
+   hash table (linear probing, power of two capacity) of block pointers and
+   their site and size. Only the thread enters blocks and rebuilds the
+   table, the latter with the lock held; other threads look blocks up and
+   mark them deleted with the lock held. */
+typedef struct block_table {
+  CME_BLOCK_KEY *keys;
+  uint64_t *values;
+  size_t cap;  /* Number of slots (zero before the first block) */
+  size_t used; /* Slots taken since the last rebuild, deleted ones too */
+} block_table;
+
+/* Call site counters and live blocks of a thread. They are kept on a list,
+   past the end of the thread, to be merged at exit and to match the frees
+   of other threads. */
+typedef struct site_thread {
+  struct site_thread *next;
+  block_table blocks;
+  site_counts counts[CME_ALLOC_MAX_SITES];
+} site_thread;
+
+/* Call site index cached by a thread */
+typedef struct site_cache_entry {
+  const char *file;
+  int line;
+  unsigned site;
+} site_cache_entry;
+
+/* A call site */
+typedef struct site_info {
+  const char *file;
+  int line;
+  const char *func;
+} site_info;
+
+/* Set of block pointers: open addressing hash set (linear probing, power
+   of two capacity). Lookups never touch the memory in front of a pointer,
+   so blocks from the system allocator are told apart safely, and the flat
+   table is easy to sweep in parallel. The table is read and written with
+   the lock held; `used` may be read without it, to skip the lock while
+   nothing was ever entered. */
+typedef struct ptr_table {
+  void **slots;
+  size_t cap;
+  size_t count;
+  CME_PUBLISHED(int) used; /* Set once the first pointer is entered */
+} ptr_table;
+
+/* State of a `cme_heap_check` sweep */
+typedef struct heap_check_job {
+  void *const *table;
+  unsigned char *bad;
+} heap_check_job;
+
+/* ==========================================================================
+ * Private Function Declarations Section
+ * ========================================================================== */
+
+static void alloc_init(void);
+static int env_set(const char *name);
+static void *malloc_block(size_t size);
+static void *calloc_block(size_t count, size_t size);
+static void *realloc_block(void *ptr, size_t size);
+static void free_block(void *ptr);
+static void track_alloc(void *ptr, size_t size, const char *file, int line,
+                        const char *func);
+static void track_free(void *ptr);
+static size_t system_size(void *ptr);
+#ifdef CME_HAVE_GUARD
+static int use_guard(void);
+static int guard_setup(void);
+static int guard_owns(const void *ptr);
+static void *guard_alloc(size_t size, int *fresh);
+static void guard_free(void *ptr);
+static size_t guard_size(const void *ptr);
+#endif
+static void *redzone_alloc(size_t size);
+static int redzone_release(void *ptr);
+static int redzone_find(const void *ptr, size_t *size);
+static const void *redzone_holding(const ptr_table *table, const void *ptr);
+static int redzone_intact(const unsigned char *p, size_t n);
+static int redzone_check(const void *ptr, const char *context);
+static void redzone_check_range(void *ctx, size_t begin, size_t end);
+static int poison_track(void *ptr);
+static int poison_untrack(void *ptr);
+static size_t table_home(const ptr_table *table, const void *ptr);
+static int table_find(const ptr_table *table, const void *ptr);
+static int table_insert(ptr_table *table, void *ptr);
+static int table_remove(ptr_table *table, const void *ptr);
+static void stats_setup(int live);
+static void stats_at_exit(void);
+static int stats_compare(const void *a, const void *b);
+static unsigned site_find(const char *file, int line, const char *func);
+static site_counts *site_counts_of(unsigned site);
+static void site_alloc(void *ptr, size_t size, const char *file, int line,
+                       const char *func);
+static void site_free(void *ptr, const char *file, int line,
+                      const char *func);
+static size_t block_home(const void *ptr, size_t cap);
+static size_t block_find(block_table *table, const void *ptr);
+static int block_rebuild(block_table *table);
+static int block_insert(const void *ptr, uint64_t entry);
+static int block_remove(const void *ptr, uint64_t *entry);
+
+/* ==========================================================================
+ * Global Variables Section
+ * ========================================================================== */
+
+/* Instance the allocation macros use in the arena and pool builds (see
+   `cme_alloc.h`) */
+#if defined(CME_ALLOCATOR_ARENA)
+cme_arena cme_alloc_arena;
+#elif defined(CME_ALLOCATOR_POOL)
+cme_pool cme_alloc_pool;
+#endif
+
+#ifdef CME_HAVE_PTHREADS
+static pthread_mutex_t g_lock = PTHREAD_MUTEX_INITIALIZER;
+#endif
+
+static CME_PUBLISHED(int) g_initialized = 0; /* Settings read */
+static cme_alloc_mode g_mode = CME_ALLOC_SYSTEM;
+static unsigned g_guard_sample = 1;
+static int g_poison = 0;
+
+/* Nonzero while the allocations may go straight to the system allocator:
+   system mode, no poisoning or statistics, and nothing else watching the
+   blocks. Cleared for good once any of those is turned on, so a block of
+   another mode never reaches the direct `free`. */
+static CME_PUBLISHED(int) g_direct = 0;
+static int g_watched = 0; /* `cme_alloc_watch` called */
+
+/* Allocation counters (per thread, so counting does not need the lock) */
+static CME_THREAD_LOCAL cme_alloc_counts t_counts = {0, 0, 0};
+
+/* Bytes the thread may allocate before the heap profiler samples again */
+static CME_THREAD_LOCAL int64_t t_prof_left = 0;
+
+#ifdef CME_HAVE_GUARD
+/* Allocations left before the next guarded one (per thread, so sampling
+   does not need the lock) */
+static CME_THREAD_LOCAL unsigned t_guard_countdown = 0;
+
+static size_t g_page_size = 0;
+static CME_PUBLISHED(char *) g_region = NULL; /* Reserved address space */
+static size_t g_region_pages = 0; /* Size of the region in pages */
+static size_t g_region_top = 0;   /* First page never handed out */
+
+/* Pool of freed slots: singly linked FIFO per page count. Links live in a
+   side table indexed by page (the slots themselves are inaccessible), and
+   hold the page index plus one so zero ends a list. */
+static uint32_t *g_next = NULL;
+static uint32_t g_pool_head[CME_GUARD_POOL_CLASSES + 1];
+static uint32_t g_pool_tail[CME_GUARD_POOL_CLASSES + 1];
+#endif
+
+/* Live redzone blocks */
+static ptr_table g_rz_blocks = {NULL, 0, 0, 0};
+
+/* Freed redzone blocks not given back to the system allocator yet: the set,
+   to look them up, and the ring they leave, oldest first from `g_rz_next` */
+static ptr_table g_rz_freed = {NULL, 0, 0, 0};
+static void *g_rz_quarantine[CME_REDZONE_QUARANTINE];
+static size_t g_rz_next = 0;
+
+/* Live blocks of the system allocator handed out with poisoning on. Only
+   these are poisoned when freed: the size of any other pointer can not be
+   read safely. */
+static ptr_table g_poison_blocks = {NULL, 0, 0, 0};
+
+/* Allocation statistics per call site. Site 0 pools the allocations of the
+   plain functions and of the sites past `CME_ALLOC_MAX_SITES`. */
+static int g_stats = 0;
+static int g_stats_live = 0; /* Blocks followed to their free (peak live) */
+static int g_stats_at_exit = 0;
+static site_info g_sites[CME_ALLOC_MAX_SITES];
+static unsigned g_num_sites = 1;
+static site_thread *g_site_threads = NULL;
+static CME_THREAD_LOCAL site_thread *t_sites = NULL;
+static CME_THREAD_LOCAL site_cache_entry t_site_cache[CME_SITE_CACHE_SIZE];
+
+/* ==========================================================================
+ * Function Definitions Section
+ * ========================================================================== */
+
+/* --------------------------------------------------------------------------
+ * Function: cme_malloc
+ * --------------------------------------------------------------------------
+ *
+ * Description: Allocate a block of memory with the selected allocator. In
+ *              guard mode the block ends right before an inaccessible page,
+ *              so reading or writing past its end faults at once. In redzone
+ *              mode the block is surrounded by canary bytes, checked when it
+ *              is freed and by `cme_heap_check`. With poisoning on the block
+ *              is filled with `CME_POISON_ALLOC_BYTE`.
+ *
+ * Parameters:
+ *      size: Number of bytes to allocate
+ *
+ * Returns: Pointer to the block (release it with `cme_free`), or NULL on
+ *          failure
+ *
+ * -------------------------------------------------------------------------- */
+void *cme_malloc(size_t size) {
+  return cme_malloc_at(size, NULL, 0, NULL);
+}
+
+/* --------------------------------------------------------------------------
+ * Function: cme_malloc_at
+ * --------------------------------------------------------------------------
+ *
+ * Description: `cme_malloc` called from a known site (the `cme_malloc`
+ *              macro passes its own)
+ *
+ * Parameters:
+ *      size: Number of bytes to allocate
+ *      file: Source file of the call (NULL for an unknown site)
+ *      line: Line of the call
+ *      func: Function making the call
+ *
+ * Returns: Pointer to the block (release it with `cme_free`), or NULL on
+ *          failure
+ *
+ * -------------------------------------------------------------------------- */
+void *cme_malloc_at(size_t size, const char *file, int line,
+                    const char *func) {
+  void *ptr = NULL;
+
+  if (CME_LOAD_ACQUIRE(g_direct)) {
+    ptr = malloc(size);
+    if (ptr) {
+      t_counts.allocs++;
+      t_counts.bytes += size;
+    }
+    return ptr;
+  }
+
+  ptr = malloc_block(size);
+  if (ptr) {
+    track_alloc(ptr, size, file, line, func);
+    cme_trace_alloc(ptr, size, CME_TRACE_MALLOC);
+    if (g_stats) {
+      site_alloc(ptr, size, file, line, func);
+    }
+  }
+
+  return ptr;
+}
+
+/* --------------------------------------------------------------------------
+ * Function: cme_calloc
+ * --------------------------------------------------------------------------
+ *
+ * Description: Allocate a zeroed array with the selected allocator
+ *
+ * Parameters:
+ *      count: Number of elements
+ *       size: Size of an element
+ *
+ * Returns: Pointer to the block (release it with `cme_free`), or NULL on
+ *          failure or overflow
+ *
+ * -------------------------------------------------------------------------- */
+void *cme_calloc(size_t count, size_t size) {
+  return cme_calloc_at(count, size, NULL, 0, NULL);
+}
+
+/* --------------------------------------------------------------------------
+ * Function: cme_calloc_at
+ * --------------------------------------------------------------------------
+ *
+ * Description: `cme_calloc` called from a known site
+ *
+ * Parameters:
+ *      count: Number of elements
+ *       size: Size of an element
+ *       file: Source file of the call (NULL for an unknown site)
+ *       line: Line of the call
+ *       func: Function making the call
+ *
+ * Returns: Pointer to the block (release it with `cme_free`), or NULL on
+ *          failure or overflow
+ *
+ * -------------------------------------------------------------------------- */
+void *cme_calloc_at(size_t count, size_t size, const char *file, int line,
+                    const char *func) {
+  void *ptr = NULL;
+
+  if (CME_LOAD_ACQUIRE(g_direct)) {
+    ptr = calloc(count, size);
+  } else {
+    ptr = calloc_block(count, size);
+  }
+  if (ptr) {
+    t_counts.allocs++;
+    t_counts.bytes += count * size;
+    track_alloc(ptr, count * size, file, line, func);
+    cme_trace_alloc(ptr, count * size, CME_TRACE_CALLOC);
+    if (g_stats) {
+      site_alloc(ptr, count * size, file, line, func);
+    }
+  }
+
+  return ptr;
+}
+
+/* --------------------------------------------------------------------------
+ * Function: cme_realloc
+ * --------------------------------------------------------------------------
+ *
+ * Description: Resize a block allocated by `cme_malloc`, `cme_calloc` or
+ *              `cme_realloc`. Guarded and redzone blocks are always moved
+ *              (a stale pointer to an old guarded block faults on use, and
+ *              the redzones of the old block are checked).
+ *
+ * Parameters:
+ *       ptr: Block to resize (NULL allocates a new one)
+ *      size: New size in bytes
+ *
+ * Returns: Pointer to the resized block, or NULL on failure (the old block
+ *          is left untouched)
+ *
+ * -------------------------------------------------------------------------- */
+void *cme_realloc(void *ptr, size_t size) {
+  return cme_realloc_at(ptr, size, NULL, 0, NULL);
+}
+
+/* --------------------------------------------------------------------------
+ * Function: cme_realloc_at
+ * --------------------------------------------------------------------------
+ *
+ * Description: `cme_realloc` called from a known site. For the statistics
+ *              the old block is freed and the new one allocated at the site.
+ *
+ * Parameters:
+ *       ptr: Block to resize (NULL allocates a new one)
+ *      size: New size in bytes
+ *      file: Source file of the call (NULL for an unknown site)
+ *      line: Line of the call
+ *      func: Function making the call
+ *
+ * Returns: Pointer to the resized block, or NULL on failure (the old block
+ *          is left untouched)
+ *
+ * -------------------------------------------------------------------------- */
+void *cme_realloc_at(void *ptr, size_t size, const char *file, int line,
+                     const char *func) {
+  site_counts *counts = NULL;
+  uint64_t entry = 0;
+  uint64_t block = 0;
+  int tracked = 0;
+  void *moved = NULL;
+
+  if (CME_LOAD_ACQUIRE(g_direct)) {
+    moved = realloc(ptr, size);
+    if (moved) {
+      t_counts.allocs++;
+      t_counts.frees += NULL != ptr;
+      t_counts.bytes += size;
+    }
+    return moved;
+  }
+
+  /* Out of the table before the block is released, so another thread can
+     not get (and enter) the same address first */
+  if (ptr && g_stats_live) {
+    tracked = block_remove(ptr, &entry);
+  }
+  if (ptr) {
+    track_free(ptr); /* A failed resize loses the sample and the tracking */
+    block = cme_trace_detach(ptr);
+  }
+  moved = realloc_block(ptr, size);
+  cme_trace_realloc(block, ptr, moved, size);
+  if (NULL == moved) {
+    if (tracked) {
+      block_insert(ptr, entry);
+    }
+    return NULL;
+  }
+  if (tracked) {
+    counts = site_counts_of((unsigned)(entry >> CME_BLOCK_SIZE_BITS));
+    if (counts) {
+      counts->frees++;
+      counts->live -= (int64_t)(entry & CME_BLOCK_SIZE_MASK);
+    }
+  } else if (ptr && g_stats) {
+    /* Not followed: the free is counted here, like `site_free` does */
+    counts = site_counts_of(site_find(file, line, func));
+    if (counts) {
+      counts->frees++;
+    }
+  }
+  track_alloc(moved, size, file, line, func);
+  if (g_stats) {
+    site_alloc(moved, size, file, line, func);
+  }
+
+  return moved;
+}
+
+/* --------------------------------------------------------------------------
+ * Function: cme_strdup
+ * --------------------------------------------------------------------------
+ *
+ * Description: Duplicate a string with the selected allocator
+ *
+ * Parameters:
+ *      str: String to duplicate
+ *
+ * Returns: Pointer to the copy (release it with `cme_free`), or NULL on
+ *          failure
+ *
+ * -------------------------------------------------------------------------- */
+char *cme_strdup(const char *str) {
+  return cme_strdup_at(str, NULL, 0, NULL);
+}
+
+/* --------------------------------------------------------------------------
+ * Function: cme_strdup_at
+ * --------------------------------------------------------------------------
+ *
+ * Description: `cme_strdup` called from a known site
+ *
+ * Parameters:
+ *       str: String to duplicate
+ *      file: Source file of the call (NULL for an unknown site)
+ *      line: Line of the call
+ *      func: Function making the call
+ *
+ * Returns: Pointer to the copy (release it with `cme_free`), or NULL on
+ *          failure
+ *
+ * -------------------------------------------------------------------------- */
+char *cme_strdup_at(const char *str, const char *file, int line,
+                    const char *func) {
+  size_t size = strlen(str) + 1;
+  char *copy = NULL;
+
+  if (CME_LOAD_ACQUIRE(g_direct)) {
+    copy = malloc(size);
+    if (copy) {
+      memcpy(copy, str, size);
+      t_counts.allocs++;
+      t_counts.bytes += size;
+    }
+    return copy;
+  }
+
+  copy = malloc_block(size);
+  if (copy) {
+    memcpy(copy, str, size);
+    track_alloc(copy, size, file, line, func);
+    cme_trace_alloc(copy, size, CME_TRACE_MALLOC);
+    if (g_stats) {
+      site_alloc(copy, size, file, line, func);
+    }
+  }
+
+  return copy;
+}
+
+/* --------------------------------------------------------------------------
+ * Function: cme_free
+ * --------------------------------------------------------------------------
+ *
+ * Description: Release a block allocated by any of the `cme_*` allocation
+ *              functions, whichever mode it was allocated in. A guarded block
+ *              is made inaccessible, so later use of it (or freeing it again)
+ *              faults. The redzones of a redzone block are checked, and an
+ *              overrun is reported and the program aborted. With poisoning on
+ *              the block is filled with the freed pattern first (apart from
+ *              guarded blocks, which are made inaccessible instead; the
+ *              system allocator may reuse the first few bytes of a freed
+ *              system block for its own bookkeeping).
+ *
+ * Parameters:
+ *      ptr: Block to release (may be NULL)
+ *
+ * Returns: None
+ *
+ * -------------------------------------------------------------------------- */
+void cme_free(void *ptr) { cme_free_at(ptr, NULL, 0, NULL); }
+
+/* --------------------------------------------------------------------------
+ * Function: cme_free_at
+ * --------------------------------------------------------------------------
+ *
+ * Description: `cme_free` called from a known site. The free is counted at
+ *              the site the block was allocated at; a pointer the
+ *              statistics do not know (allocated before they were turned on,
+ *              or not allocated at all) is counted as a free at this site.
+ *
+ * Parameters:
+ *       ptr: Block to release (may be NULL)
+ *      file: Source file of the call (NULL for an unknown site)
+ *      line: Line of the call
+ *      func: Function making the call
+ *
+ * Returns: None
+ *
+ * -------------------------------------------------------------------------- */
+void cme_free_at(void *ptr, const char *file, int line, const char *func) {
+  if (CME_LOAD_ACQUIRE(g_direct)) {
+    if (ptr) {
+      t_counts.frees++;
+    }
+    free(ptr);
+    return;
+  }
+
+  if (ptr) {
+    track_free(ptr);
+    cme_trace_free(ptr);
+    if (g_stats) {
+      site_free(ptr, file, line, func);
+    }
+  }
+  free_block(ptr);
+}
+
+/* --------------------------------------------------------------------------
+ * Function: cme_alloc_get_mode
+ * --------------------------------------------------------------------------
+ *
+ * Description: Get the allocator mode
+ *
+ * Parameters: None
+ *
+ * Returns: Mode used for new allocations
+ *
+ * -------------------------------------------------------------------------- */
+cme_alloc_mode cme_alloc_get_mode(void) {
+  alloc_init();
+
+  return g_mode;
+}
+
+/* --------------------------------------------------------------------------
+ * Function: cme_alloc_set_mode
+ * --------------------------------------------------------------------------
+ *
+ * Description: Select the allocator mode, overriding the environment. Blocks
+ *              allocated before the switch are still released correctly. If
+ *              guard mode is not supported on the platform, or the address
+ *              space for it can not be reserved, the system mode is kept.
+ *
+ * Parameters:
+ *      mode: Mode to use for new allocations
+ *
+ * Returns: None
+ *
+ * -------------------------------------------------------------------------- */
+void cme_alloc_set_mode(cme_alloc_mode mode) {
+  alloc_init();
+
+  CME_ALLOC_LOCK();
+#ifdef CME_HAVE_GUARD
+  if (CME_ALLOC_GUARD == mode && !guard_setup()) {
+    mode = CME_ALLOC_SYSTEM;
+  }
+#else
+  if (CME_ALLOC_GUARD == mode) {
+    mode = CME_ALLOC_SYSTEM;
+  }
+#endif
+  g_mode = mode;
+  if (CME_ALLOC_SYSTEM != mode) {
+    CME_STORE_RELEASE(g_direct, 0);
+  }
+  CME_ALLOC_UNLOCK();
+}
+
+/* --------------------------------------------------------------------------
+ * Function: cme_alloc_set_guard_sample
+ * --------------------------------------------------------------------------
+ *
+ * Description: In guard mode, guard only one in every `every` allocations
+ *              and serve the rest from the system allocator. Sampling keeps
+ *              the page and system call overhead low on allocation heavy
+ *              code while still catching repeated overruns quickly.
+ *
+ * Parameters:
+ *      every: Sampling period (0 and 1 guard every allocation)
+ *
+ * Returns: None
+ *
+ * -------------------------------------------------------------------------- */
+void cme_alloc_set_guard_sample(unsigned every) {
+  alloc_init();
+
+  g_guard_sample = 0 < every ? every : 1;
+}
+
+/* --------------------------------------------------------------------------
+ * Function: cme_alloc_set_poison
+ * --------------------------------------------------------------------------
+ *
+ * Description: Turn poisoning on or off, overriding the environment. With
+ *              poisoning on, new blocks (except those from `cme_calloc`) are
+ *              filled with `CME_POISON_ALLOC_BYTE` and freed blocks with
+ *              `CME_POISON_FREE_BYTE`, so reads of uninitialized or freed
+ *              memory give recognizable values (see `cme_poison_scan`).
+ *
+ * Parameters:
+ *      enable: Nonzero to turn poisoning on
+ *
+ * Returns: None
+ *
+ * -------------------------------------------------------------------------- */
+void cme_alloc_set_poison(int enable) {
+  alloc_init();
+
+  CME_ALLOC_LOCK();
+  g_poison = 0 != enable;
+  if (g_poison) {
+    CME_STORE_RELEASE(g_direct, 0);
+  }
+  CME_ALLOC_UNLOCK();
+}
+
+/* --------------------------------------------------------------------------
+ * Function: cme_alloc_watch
+ * --------------------------------------------------------------------------
+ *
+ * Description: Send every later allocation through the hooks of the heap
+ *              profiler, the leak checker and the traces, which call this
+ *              when they start. Until then (and with no other mode on) the
+ *              allocations go straight to the system allocator.
+ *
+ * Parameters: None
+ *
+ * Returns: None
+ *
+ * -------------------------------------------------------------------------- */
+void cme_alloc_watch(void) {
+  CME_ALLOC_LOCK();
+  g_watched = 1;
+  CME_STORE_RELEASE(g_direct, 0);
+  CME_ALLOC_UNLOCK();
+}
+
+/* --------------------------------------------------------------------------
+ * Function: cme_heap_check
+ * --------------------------------------------------------------------------
+ *
+ * Description: Check the redzones of every live redzone block, and report
+ *              the corrupted ones on `stderr`. The sweep is split across
+ *              threads for large heaps; allocations and frees wait until it
+ *              is done. Does nothing unless blocks were allocated in redzone
+ *              mode.
+ *
+ * Parameters: None
+ *
+ * Returns: Number of corrupted blocks
+ *
+ * -------------------------------------------------------------------------- */
+size_t cme_heap_check(void) {
+  heap_check_job job = {NULL, NULL};
+  size_t corrupted = 0;
+  size_t i = 0;
+
+  CME_ALLOC_LOCK();
+  if (0 < g_rz_blocks.count) {
+    job.table = g_rz_blocks.slots;
+    job.bad = calloc(g_rz_blocks.cap, 1);
+  }
+  if (job.bad) {
+    cme_parallel_for(g_rz_blocks.cap, CME_HEAP_CHECK_PARALLEL_MIN,
+                     redzone_check_range, &job);
+    for (i = 0; i < g_rz_blocks.cap; i++) {
+      if (job.bad[i]) {
+        redzone_check(g_rz_blocks.slots[i], "heap check");
+        corrupted++;
+      }
+    }
+    free(job.bad);
+  }
+  CME_ALLOC_UNLOCK();
+
+  return corrupted;
+}
+
+/* --------------------------------------------------------------------------
+ * Function: cme_alloc_get_counts
+ * --------------------------------------------------------------------------
+ *
+ * Description: Read the allocation counters of the calling thread. The
+ *              counters only grow; take the difference of two readings to
+ *              count the allocations of a piece of code.
+ *
+ * Parameters: None
+ *
+ * Returns: Counters of the calling thread
+ *
+ * -------------------------------------------------------------------------- */
+cme_alloc_counts cme_alloc_get_counts(void) { return t_counts; }
+
+/* --------------------------------------------------------------------------
+ * Function: cme_alloc_stats_enable
+ * --------------------------------------------------------------------------
+ *
+ * Description: Start collecting allocation statistics per call site, and
+ *              print them on `stderr` at exit (`cme_alloc_stats_print`).
+ *              Every thread counts in counters of its own, without the
+ *              lock; the counters are merged when the statistics are read.
+ *              Without the live tracking a free is counted at the site of
+ *              the free. With it, every block is entered in a hash table of
+ *              its thread, so that its free is counted at the site of its
+ *              allocation and the peak of the live bytes is known, at the
+ *              cost of a table insertion and removal for every block. Blocks
+ *              allocated before the live tracking is on are not followed.
+ *
+ * Parameters:
+ *      live: Nonzero to turn the live tracking on as well
+ *
+ * Returns: 0 on success, -1 if the allocation macros of this build do not
+ *          go through the `cme` allocator (`CME_ALLOC_TRACKED` is 0), so
+ *          there would be nothing to count
+ *
+ * -------------------------------------------------------------------------- */
+int cme_alloc_stats_enable(int live) {
+  if (!CME_ALLOC_TRACKED) {
+    return -1;
+  }
+
+  alloc_init();
+
+  CME_ALLOC_LOCK();
+  stats_setup(live);
+  CME_ALLOC_UNLOCK();
+
+  return 0;
+}
+
+/* --------------------------------------------------------------------------
+ * Function: cme_alloc_stats_get
+ * --------------------------------------------------------------------------
+ *
+ * Description: Merge the call site counters of every thread, finished
+ *              threads included. The peak live bytes of a site (live
+ *              tracking only) are exact when one thread allocates and frees
+ *              its blocks, and an upper bound (the sum of the peaks of the
+ *              threads) otherwise.
+ *              Counters of threads still running may be a few allocations
+ *              behind.
+ *
+ * Parameters:
+ *          sites: Receives the statistics of the sites that allocated or
+ *                 freed anything, in the order the sites were first used
+ *      max_sites: Capacity of `sites`
+ *
+ * Returns: Number of entries filled in
+ *
+ * -------------------------------------------------------------------------- */
+size_t cme_alloc_stats_get(cme_alloc_site_stats *sites, size_t max_sites) {
+  const site_thread *thread = NULL;
+  cme_alloc_site_stats merged;
+  size_t count = 0;
+  unsigned site = 0;
+
+  CME_ALLOC_LOCK();
+  for (site = 0; site < g_num_sites && count < max_sites; site++) {
+    memset(&merged, 0, sizeof(merged));
+    merged.file = g_sites[site].file;
+    merged.line = g_sites[site].line;
+    merged.func = g_sites[site].func;
+    for (thread = g_site_threads; thread; thread = thread->next) {
+      merged.allocs += thread->counts[site].allocs;
+      merged.bytes += thread->counts[site].bytes;
+      merged.frees += thread->counts[site].frees;
+      merged.peak_live += (uint64_t)thread->counts[site].peak;
+    }
+    if (merged.allocs || merged.frees) {
+      sites[count++] = merged;
+    }
+  }
+  CME_ALLOC_UNLOCK();
+
+  return count;
+}
+
+/* --------------------------------------------------------------------------
+ * Function: cme_alloc_stats_print
+ * --------------------------------------------------------------------------
+ *
+ * Description: Print the allocation statistics on `stderr`, one call site
+ *              per line, the sites that allocated the most bytes first
+ *
+ * Parameters: None
+ *
+ * Returns: None
+ *
+ * -------------------------------------------------------------------------- */
+void cme_alloc_stats_print(void) {
+  cme_alloc_site_stats *sites =
+      malloc(CME_ALLOC_MAX_SITES * sizeof(cme_alloc_site_stats));
+  const char *file = NULL;
+  size_t count = 0;
+  size_t i = 0;
+
+  if (NULL == sites) {
+    return;
+  }
+  count = cme_alloc_stats_get(sites, CME_ALLOC_MAX_SITES);
+  qsort(sites, count, sizeof(cme_alloc_site_stats), stats_compare);
+
+  fprintf(stderr, "cme_alloc: allocations per call site\n");
+  fprintf(stderr, "%10s %12s %10s %12s  %s\n", "allocs", "bytes", "frees",
+          "peak live", "site");
+  for (i = 0; i < count; i++) {
+    fprintf(stderr, "%10llu %12llu %10llu ",
+            (unsigned long long)sites[i].allocs,
+            (unsigned long long)sites[i].bytes,
+            (unsigned long long)sites[i].frees);
+    if (g_stats_live) {
+      fprintf(stderr, "%12llu  ", (unsigned long long)sites[i].peak_live);
+    } else {
+      fprintf(stderr, "%12s  ", "-"); /* Not followed */
+    }
+    if (NULL == sites[i].file) {
+      fprintf(stderr, "(other sites)\n");
+      continue;
+    }
+    file = strrchr(sites[i].file, '/');
+    file = file ? file + 1 : sites[i].file;
+    fprintf(stderr, "%s:%d (%s)\n", file, sites[i].line, sites[i].func);
+  }
+
+  free(sites);
+}
+
+/* ==========================================================================
+ * Private Function Definitions Section
+ * ========================================================================== */
+
+/* --------------------------------------------------------------------------
+ * Function: alloc_init
+ * --------------------------------------------------------------------------
+ *
+ * Description: Read the allocator settings from the environment, once
+ *
+ * Parameters: None
+ *
+ * Returns: None
+ *
+ * -------------------------------------------------------------------------- */
+static void alloc_init(void) {
+  const char *value = NULL;
+
+  if (CME_LOAD_ACQUIRE(g_initialized)) {
+    return;
+  }
+
+  CME_ALLOC_LOCK();
+  if (!CME_LOAD_ACQUIRE(g_initialized)) {
+    value = getenv(CME_GUARD_SAMPLE_ENV);
+    if (value && 0 < atoi(value)) {
+      g_guard_sample = (unsigned)atoi(value);
+    }
+
+    value = getenv(CME_POISON_ENV);
+    g_poison = value && 0 != strcmp(value, "0");
+
+    value = getenv(CME_ALLOC_STATS_ENV);
+    if (value && 0 != strcmp(value, "0")) {
+      stats_setup(0 == strcmp(value, "live"));
+    }
+
+    value = getenv(CME_ALLOC_ENV);
+#ifdef CME_ALLOCATOR_GUARDED
+    if (NULL == value || '\0' == *value) {
+      value = "guard"; /* The guarded build starts in guard mode */
+    }
+#endif
+    if (value && 0 == strcmp(value, "redzone")) {
+      g_mode = CME_ALLOC_REDZONE;
+    } else if (value && 0 == strcmp(value, "guard")) {
+#ifdef CME_HAVE_GUARD
+      if (guard_setup()) {
+        g_mode = CME_ALLOC_GUARD;
+      }
+#else
+      fprintf(stderr, "cme_alloc: guard mode is not supported here, using "
+                      "the system allocator\n");
+#endif
+    } else if (value && 0 != strcmp(value, "system")) {
+      fprintf(stderr, "cme_alloc: unknown allocator '%s', using the system "
+                      "allocator\n", value);
+    }
+
+    /* The heap profiler, the leak checker and the traces read their own
+       settings later: any of them set keeps every allocation on the hooks */
+    CME_STORE_RELEASE(g_direct, CME_ALLOC_SYSTEM == g_mode && !g_poison &&
+                                    !g_stats && !g_watched &&
+                                    !env_set(CME_HEAPPROF_ENV) &&
+                                    !env_set(CME_LEAKCHECK_ENV) &&
+                                    !env_set(CME_TRACE_ENV));
+
+    CME_STORE_RELEASE(g_initialized, 1); /* After every setting above */
+  }
+  CME_ALLOC_UNLOCK();
+}
+
+/* --------------------------------------------------------------------------
+ * Function: env_set
+ * --------------------------------------------------------------------------
+ *
+ * Description: Check whether an environment variable is set to a value
+ *
+ * Parameters:
+ *      name: Name of the variable
+ *
+ * Returns: 1 if the variable is set and not empty, 0 otherwise
+ *
+ * -------------------------------------------------------------------------- */
+static int env_set(const char *name) {
+  const char *value = getenv(name);
+
+  return value && '\0' != *value;
+}
+
+/* --------------------------------------------------------------------------
+ * Function: malloc_block
+ * --------------------------------------------------------------------------
+ *
+ * Description: Allocate a block with the selected allocator (see `cme_malloc`)
+ *
+ * Parameters:
+ *      size: Number of bytes to allocate
+ *
+ * Returns: Pointer to the block, or NULL on failure
+ *
+ * -------------------------------------------------------------------------- */
+static void *malloc_block(size_t size) {
+  void *ptr = NULL;
+
+  alloc_init();
+
+#ifdef CME_HAVE_GUARD
+  if (use_guard()) {
+    ptr = guard_alloc(size, NULL);
+  }
+#endif
+  if (NULL == ptr) {
+    if (CME_ALLOC_REDZONE == g_mode) {
+      ptr = redzone_alloc(size);
+    } else {
+      ptr = malloc(size);
+      if (ptr && g_poison) {
+        poison_track(ptr);
+      }
+    }
+  }
+  if (ptr) {
+    t_counts.allocs++;
+    t_counts.bytes += size;
+    if (g_poison) {
+      cme_poison_fill(ptr, size, CME_POISON_UNINIT);
+    }
+  }
+
+  return ptr;
+}
+
+/* --------------------------------------------------------------------------
+ * Function: calloc_block
+ * --------------------------------------------------------------------------
+ *
+ * Description: Allocate a zeroed array with the selected allocator
+ *
+ * Parameters:
+ *      count: Number of elements
+ *       size: Size of an element
+ *
+ * Returns: Pointer to the block, or NULL on failure or overflow
+ *
+ * -------------------------------------------------------------------------- */
+static void *calloc_block(size_t count, size_t size) {
+  void *ptr = NULL;
+
+  alloc_init();
+
+#ifdef CME_HAVE_GUARD
+  if (use_guard()) {
+    int fresh = 0;
+
+    if (0 != size && count > SIZE_MAX / size) {
+      return NULL;
+    }
+    ptr = guard_alloc(count * size, &fresh);
+    if (ptr) {
+      if (!fresh) {
+        memset(ptr, 0, count * size); /* Recycled pages hold old data */
+      }
+      return ptr;
+    }
+  }
+#endif
+  if (CME_ALLOC_REDZONE == g_mode) {
+    if (0 != size && count > SIZE_MAX / size) {
+      return NULL;
+    }
+    ptr = redzone_alloc(count * size);
+    if (ptr) {
+      memset(ptr, 0, count * size);
+    }
+    return ptr;
+  }
+
+  ptr = calloc(count, size);
+  if (ptr && g_poison) {
+    poison_track(ptr);
+  }
+
+  return ptr;
+}
+
+/* --------------------------------------------------------------------------
+ * Function: realloc_block
+ * --------------------------------------------------------------------------
+ *
+ * Description: Resize a block with the selected allocator (see `cme_realloc`)
+ *
+ * Parameters:
+ *       ptr: Block to resize (NULL allocates a new one)
+ *      size: New size in bytes
+ *
+ * Returns: Pointer to the resized block, or NULL on failure
+ *
+ * -------------------------------------------------------------------------- */
+static void *realloc_block(void *ptr, size_t size) {
+  size_t old_size = 0;
+  void *moved = NULL;
+  int poisoned = 0;
+
+  if (redzone_find(ptr, &old_size)) {
+    moved = malloc_block(size);
+    if (moved) {
+      memcpy(moved, ptr, old_size < size ? old_size : size);
+      free_block(ptr);
+    }
+    return moved;
+  }
+#ifdef CME_HAVE_GUARD
+  if (guard_owns(ptr)) {
+    moved = malloc_block(size);
+    old_size = guard_size(ptr);
+    if (moved) {
+      memcpy(moved, ptr, old_size < size ? old_size : size);
+      guard_free(ptr);
+      t_counts.frees++;
+    }
+    return moved;
+  }
+#endif
+  if (NULL == ptr) {
+    return malloc_block(size);
+  }
+
+  /* Only the usable size of a block handed out with poisoning on can be
+     read: any other pointer goes to the system allocator untouched */
+  poisoned = poison_untrack(ptr);
+  if (poisoned) {
+    old_size = system_size(ptr);
+  }
+  moved = realloc(ptr, size);
+  if (NULL == moved) {
+    if (poisoned) {
+      poison_track(ptr);
+    }
+    return NULL;
+  }
+  if (g_poison) {
+    poison_track(moved);
+    if (poisoned && size > old_size) {
+      /* Poison whatever the block grows by */
+      cme_poison_fill((char *)moved + old_size, size - old_size,
+                      CME_POISON_UNINIT);
+    }
+  }
+  t_counts.allocs++;
+  t_counts.frees++;
+  t_counts.bytes += size;
+
+  return moved;
+}
+
+/* --------------------------------------------------------------------------
+ * Function: free_block
+ * --------------------------------------------------------------------------
+ *
+ * Description: Release a block, whichever mode it was allocated in (see
+ *              `cme_free`)
+ *
+ * Parameters:
+ *      ptr: Block to release (may be NULL)
+ *
+ * Returns: None
+ *
+ * -------------------------------------------------------------------------- */
+static void free_block(void *ptr) {
+  if (ptr) {
+    t_counts.frees++;
+  }
+
+#ifdef CME_HAVE_GUARD
+  if (guard_owns(ptr)) {
+    guard_free(ptr);
+    return;
+  }
+#endif
+  if (redzone_release(ptr)) {
+    return;
+  }
+
+  /* Poison only a block handed out with poisoning on: the size of any
+     other pointer can not be read safely, so it goes to `free` untouched */
+  if (poison_untrack(ptr) && g_poison) {
+    cme_poison_fill(ptr, system_size(ptr), CME_POISON_FREED);
+  }
+  free(ptr);
+}
+
+/* --------------------------------------------------------------------------
+ * Function: track_alloc
+ * --------------------------------------------------------------------------
+ *
+ * Description: Hand a new block to the heap profiler and the leak checker.
+ *              The profiler sees it only if the thread went past its sampling
+ *              point (a subtraction and a test otherwise).
+ *
+ * Parameters:
+ *       ptr: The new block
+ *      size: Its size
+ *      file: Source file of the allocation (NULL for an unknown site)
+ *      line: Line of the allocation
+ *      func: Function making the allocation
+ *
+ * Returns: None
+ *
+ * -------------------------------------------------------------------------- */
+static void track_alloc(void *ptr, size_t size, const char *file, int line,
+                        const char *func) {
+  t_prof_left -= (int64_t)size;
+  if (0 > t_prof_left) {
+    t_prof_left = cme_heapprof_sample(ptr, size);
+  }
+  cme_leakcheck_track(ptr, size, file, line, func);
+}
+
+/* --------------------------------------------------------------------------
+ * Function: track_free
+ * --------------------------------------------------------------------------
+ *
+ * Description: Tell the heap profiler and the leak checker a block is about
+ *              to be freed (before it is, so its address can not be handed
+ *              out again first)
+ *
+ * Parameters:
+ *      ptr: The block
+ *
+ * Returns: None
+ *
+ * -------------------------------------------------------------------------- */
+static void track_free(void *ptr) {
+  cme_heapprof_forget(ptr);
+  cme_leakcheck_forget(ptr);
+}
+
+/* --------------------------------------------------------------------------
+ * Function: system_size
+ * --------------------------------------------------------------------------
+ *
+ * Description: Usable size of a block from the system allocator
+ *
+ * Parameters:
+ *      ptr: Block
+ *
+ * Returns: Size in bytes (at least the requested size), or zero if the
+ *          platform can not tell
+ *
+ * -------------------------------------------------------------------------- */
+static size_t system_size(void *ptr) {
+#if defined(__linux__)
+  return malloc_usable_size(ptr);
+#elif defined(__APPLE__)
+  return malloc_size(ptr);
+#elif defined(_WIN32)
+  return _msize(ptr);
+#else
+  (void)ptr;
+  return 0;
+#endif /* End of platform specific code */
+}
+
+#ifdef CME_HAVE_GUARD
+/* --------------------------------------------------------------------------
+ * Function: use_guard
+ * --------------------------------------------------------------------------
+ *
+ * Description: Decide whether the next allocation is guarded
+ *
+ * Parameters: None
+ *
+ * Returns: Nonzero if the allocation should get a guard page
+ *
+ * -------------------------------------------------------------------------- */
+static int use_guard(void) {
+  if (CME_ALLOC_GUARD != g_mode) {
+    return 0;
+  }
+  if (0 < t_guard_countdown) {
+    t_guard_countdown--;
+    return 0;
+  }
+  t_guard_countdown = g_guard_sample - 1;
+
+  return 1;
+}
+
+/* --------------------------------------------------------------------------
+ * Function: guard_setup
+ * --------------------------------------------------------------------------
+ *
+ * Description: Reserve the address space of the guarded blocks and the side
+ *              table of the slot pool. Nothing is committed until used.
+ *              Called with the lock held. The region is published last, so
+ *              a thread that sees it (`guard_owns`) sees its size too.
+ *
+ * Parameters: None
+ *
+ * Returns: Nonzero on success
+ *
+ * -------------------------------------------------------------------------- */
+static int guard_setup(void) {
+  void *region = NULL;
+  void *next = NULL;
+
+  if (CME_LOAD_ACQUIRE(g_region)) {
+    return 1;
+  }
+
+  g_page_size = (size_t)sysconf(_SC_PAGESIZE);
+  g_region_pages = CME_GUARD_REGION_SIZE / g_page_size;
+
+  region = mmap(NULL, CME_GUARD_REGION_SIZE, PROT_NONE,
+                MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+  if (MAP_FAILED == region) {
+    return 0;
+  }
+  next = mmap(NULL, g_region_pages * sizeof(uint32_t), PROT_READ | PROT_WRITE,
+              MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+  if (MAP_FAILED == next) {
+    munmap(region, CME_GUARD_REGION_SIZE);
+    return 0;
+  }
+
+  g_next = next;
+  CME_STORE_RELEASE(g_region, (char *)region);
+
+  return 1;
+}
+
+/* --------------------------------------------------------------------------
+ * Function: guard_owns
+ * --------------------------------------------------------------------------
+ *
+ * Description: Check whether a pointer lies in the guarded region
+ *
+ * Parameters:
+ *      ptr: Pointer to check
+ *
+ * Returns: Nonzero if the pointer belongs to the guard allocator
+ *
+ * -------------------------------------------------------------------------- */
+static int guard_owns(const void *ptr) {
+  const char *region = CME_LOAD_ACQUIRE(g_region);
+  const char *p = ptr;
+
+  return region && p >= region && p < region + g_region_pages * g_page_size;
+}
+
+/* --------------------------------------------------------------------------
+ * Function: guard_alloc
+ * --------------------------------------------------------------------------
+ *
+ * Description: Allocate a guarded block. The slot holds the data pages
+ *              followed by one inaccessible guard page; the block is placed
+ *              at the end of the data pages with its header in front of it.
+ *              Slots are taken from the pool if one of the right size was
+ *              freed before, otherwise carved from the top of the region.
+ *
+ * Parameters:
+ *       size: Number of bytes to allocate
+ *      fresh: Set to nonzero if the pages were never used (so they are still
+ *             zero); may be NULL
+ *
+ * Returns: Pointer to the block, or NULL if the region is exhausted
+ *
+ * -------------------------------------------------------------------------- */
+static void *guard_alloc(size_t size, int *fresh) {
+  size_t span = 0;
+  size_t pages = 0;
+  size_t first = 0;
+  char *slot = NULL;
+  char *ptr = NULL;
+  guard_header *header = NULL;
+  int is_fresh = 0;
+
+  if (size > CME_GUARD_REGION_SIZE) {
+    return NULL;
+  }
+  span = CME_ROUND_UP(size, CME_GUARD_ALIGN);
+  pages = (span + CME_GUARD_HEADER + g_page_size - 1) / g_page_size;
+
+  CME_ALLOC_LOCK();
+  if (pages <= CME_GUARD_POOL_CLASSES && 0 != g_pool_head[pages]) {
+    first = g_pool_head[pages] - 1;
+    g_pool_head[pages] = g_next[first];
+    if (0 == g_pool_head[pages]) {
+      g_pool_tail[pages] = 0;
+    }
+  } else if (g_region_top + pages + 1 <= g_region_pages) {
+    first = g_region_top;
+    g_region_top += pages + 1;
+    is_fresh = 1;
+  } else {
+    CME_ALLOC_UNLOCK();
+    return NULL;
+  }
+  CME_ALLOC_UNLOCK();
+
+  slot = CME_LOAD_ACQUIRE(g_region) + first * g_page_size;
+  if (0 != mprotect(slot, pages * g_page_size, PROT_READ | PROT_WRITE)) {
+    return NULL;
+  }
+
+  ptr = slot + pages * g_page_size - span;
+  header = (guard_header *)(ptr - CME_GUARD_HEADER);
+  header->size = size;
+  header->first = (uint32_t)first;
+  header->pages = (uint32_t)pages;
+  header->magic = CME_GUARD_MAGIC;
+
+  if (fresh) {
+    *fresh = is_fresh;
+  }
+
+  return ptr;
+}
+
+/* --------------------------------------------------------------------------
+ * Function: guard_free
+ * --------------------------------------------------------------------------
+ *
+ * Description: Release a guarded block. Its pages are made inaccessible and
+ *              the slot joins the back of its pool, so it is reused as late
+ *              as possible and use after free faults in the meantime. A
+ *              pointer that is not the start of a live block is reported and
+ *              the program aborted; freeing a block twice faults on reading
+ *              its header.
+ *
+ * Parameters:
+ *      ptr: Block to release
+ *
+ * Returns: None
+ *
+ * -------------------------------------------------------------------------- */
+static void guard_free(void *ptr) {
+  guard_header *header = (guard_header *)((char *)ptr - CME_GUARD_HEADER);
+  size_t first = 0;
+  size_t pages = 0;
+  char *slot = NULL;
+
+  if (0 != ((uintptr_t)ptr & (CME_GUARD_ALIGN - 1)) ||
+      CME_GUARD_MAGIC != header->magic) {
+    fflush(stdout);
+    fprintf(stderr, "cme_alloc: invalid free of %p (not a live guarded "
+                    "block)\n", ptr);
+    abort();
+  }
+
+  first = header->first;
+  pages = header->pages;
+  header->magic = 0;
+  slot = CME_LOAD_ACQUIRE(g_region) + first * g_page_size;
+
+  if (pages > CME_GUARD_POOL_CLASSES) {
+    /* Too big to pool: give the memory back, keep the addresses reserved */
+    madvise(slot, pages * g_page_size, MADV_DONTNEED);
+    mprotect(slot, pages * g_page_size, PROT_NONE);
+    return;
+  }
+  mprotect(slot, pages * g_page_size, PROT_NONE);
+
+  CME_ALLOC_LOCK();
+  g_next[first] = 0;
+  if (0 == g_pool_tail[pages]) {
+    g_pool_head[pages] = (uint32_t)first + 1;
+  } else {
+    g_next[g_pool_tail[pages] - 1] = (uint32_t)first + 1;
+  }
+  g_pool_tail[pages] = (uint32_t)first + 1;
+  CME_ALLOC_UNLOCK();
+}
+
+/* --------------------------------------------------------------------------
+ * Function: guard_size
+ * --------------------------------------------------------------------------
+ *
+ * Description: Get the requested size of a guarded block
+ *
+ * Parameters:
+ *      ptr: Block
+ *
+ * Returns: Size in bytes
+ *
+ * -------------------------------------------------------------------------- */
+static size_t guard_size(const void *ptr) {
+  return ((const guard_header *)((const char *)ptr - CME_GUARD_HEADER))->size;
+}
+#endif
+
+/* --------------------------------------------------------------------------
+ * Function: redzone_alloc
+ * --------------------------------------------------------------------------
+ *
+ * Description: Allocate a block surrounded by redzones and register it. The
+ *              layout is: header, left redzone, block, right redzone (which
+ *              takes up the padding as well).
+ *
+ * Parameters:
+ *      size: Number of bytes to allocate
+ *
+ * Returns: Pointer to the block, or NULL on failure
+ *
+ * -------------------------------------------------------------------------- */
+static void *redzone_alloc(size_t size) {
+  size_t span = 0;
+  unsigned char *base = NULL;
+  unsigned char *ptr = NULL;
+  redzone_header *header = NULL;
+  int registered = 0;
+
+  if (size > SIZE_MAX - CME_REDZONE_OFFSET - 2 * CME_REDZONE_SIZE) {
+    return NULL;
+  }
+  span = CME_ROUND_UP(size, CME_REDZONE_SIZE);
+
+  base = malloc(CME_REDZONE_OFFSET + span + CME_REDZONE_SIZE);
+  if (NULL == base) {
+    return NULL;
+  }
+  ptr = base + CME_REDZONE_OFFSET;
+  header = (redzone_header *)base;
+  header->size = size;
+  header->magic = CME_REDZONE_MAGIC;
+  memset(ptr - CME_REDZONE_SIZE, CME_REDZONE_BYTE, CME_REDZONE_SIZE);
+  memset(ptr + size, CME_REDZONE_BYTE, span - size + CME_REDZONE_SIZE);
+
+  CME_ALLOC_LOCK();
+  registered = table_insert(&g_rz_blocks, ptr);
+  CME_ALLOC_UNLOCK();
+  if (!registered) {
+    free(base);
+    return NULL;
+  }
+
+  return ptr;
+}
+
+/* --------------------------------------------------------------------------
+ * Function: redzone_release
+ * --------------------------------------------------------------------------
+ *
+ * Description: Release a redzone block after checking its redzones. An
+ *              overrun is reported and the program aborted. The block is
+ *              put in quarantine, and the one that has been there longest
+ *              goes back to the system allocator instead, so freeing a block
+ *              of the last `CME_REDZONE_QUARANTINE` freed again is reported
+ *              as a double free (and the program aborted) rather than passed
+ *              to `free`. So is a pointer inside a live or quarantined block,
+ *              and one still behind a left redzone (a block given back since,
+ *              the system allocator does not write there; no header of its
+ *              own looks like one).
+ *
+ * Parameters:
+ *      ptr: Block to release
+ *
+ * Returns: Nonzero if the pointer was a redzone block (and is released),
+ *          zero if it belongs to another allocator
+ *
+ * -------------------------------------------------------------------------- */
+static int redzone_release(void *ptr) {
+  const void *holder = NULL;
+  void *evicted = NULL;
+  int found = 0;
+  int quarantined = 0;
+  int freed = 0;
+
+  if (NULL == ptr || !CME_LOAD_ACQUIRE(g_rz_blocks.used)) {
+    return 0;
+  }
+
+  CME_ALLOC_LOCK();
+  found = table_remove(&g_rz_blocks, ptr);
+  if (found) {
+    quarantined = table_insert(&g_rz_freed, ptr);
+  } else if (!(freed = table_find(&g_rz_freed, ptr))) {
+    /* Not a block: only the error path and blocks of other modes get here */
+    holder = redzone_holding(&g_rz_freed, ptr);
+    freed = NULL != holder;
+    if (NULL == holder) {
+      holder = redzone_holding(&g_rz_blocks, ptr);
+    }
+  }
+  CME_ALLOC_UNLOCK();
+  if (!found && !freed && NULL == holder &&
+      0 == ((uintptr_t)ptr & (CME_REDZONE_SIZE - 1)) &&
+      redzone_intact((unsigned char *)ptr - CME_REDZONE_SIZE,
+                     CME_REDZONE_SIZE)) {
+    fflush(stdout);
+    fprintf(stderr, "cme_alloc: invalid free of %p (redzone block no longer "
+                    "live)\n", ptr);
+    abort();
+  }
+  if (freed || holder) {
+    fflush(stdout);
+    if (NULL == holder) {
+      fprintf(stderr, "cme_alloc: double free of %p (redzone block freed "
+                      "before)\n", ptr);
+    } else {
+      fprintf(stderr, "cme_alloc: invalid free of %p (inside the %sredzone "
+                      "block %p)\n", ptr, freed ? "freed " : "", holder);
+    }
+    abort();
+  }
+  if (!found) {
+    return 0;
+  }
+
+  if (!redzone_check(ptr, "free")) {
+    abort();
+  }
+  if (g_poison) {
+    cme_poison_fill(ptr, ((redzone_header *)((unsigned char *)ptr -
+                                             CME_REDZONE_OFFSET))->size,
+                    CME_POISON_FREED);
+  }
+
+  /* Only now in the ring, so it can not be given back while checked */
+  evicted = ptr;
+  if (quarantined) {
+    CME_ALLOC_LOCK();
+    evicted = g_rz_quarantine[g_rz_next];
+    g_rz_quarantine[g_rz_next] = ptr;
+    g_rz_next = (g_rz_next + 1) % CME_REDZONE_QUARANTINE;
+    if (evicted) {
+      table_remove(&g_rz_freed, evicted);
+    }
+    CME_ALLOC_UNLOCK();
+  }
+  if (evicted) {
+    free((unsigned char *)evicted - CME_REDZONE_OFFSET);
+  }
+
+  return 1;
+}
+
+/* --------------------------------------------------------------------------
+ * Function: redzone_find
+ * --------------------------------------------------------------------------
+ *
+ * Description: Look a pointer up among the live redzone blocks. A block
+ *              in quarantine (see `redzone_release`) is reported as resized
+ *              after it was freed, and the program aborted.
+ *
+ * Parameters:
+ *       ptr: Pointer to look up
+ *      size: Set to the size of the block if found
+ *
+ * Returns: Nonzero if the pointer is a live redzone block
+ *
+ * -------------------------------------------------------------------------- */
+static int redzone_find(const void *ptr, size_t *size) {
+  int found = 0;
+  int freed = 0;
+
+  if (NULL == ptr || !CME_LOAD_ACQUIRE(g_rz_blocks.used)) {
+    return 0;
+  }
+
+  CME_ALLOC_LOCK();
+  found = table_find(&g_rz_blocks, ptr);
+  freed = !found && table_find(&g_rz_freed, ptr);
+  CME_ALLOC_UNLOCK();
+  if (freed) {
+    fflush(stdout);
+    fprintf(stderr, "cme_alloc: realloc of %p (redzone block freed "
+                    "before)\n", ptr);
+    abort();
+  }
+
+  if (found) {
+    *size = ((const redzone_header *)((const unsigned char *)ptr -
+                                      CME_REDZONE_OFFSET))->size;
+  }
+
+  return found;
+}
+
+/* --------------------------------------------------------------------------
+ * Function: redzone_holding
+ * --------------------------------------------------------------------------
+ *
+ * Description: Find the redzone block of a table whose memory (header and
+ *              redzones included) holds a pointer. Walks the whole table.
+ *              Called with the lock held.
+ *
+ * Parameters:
+ *      table: Table of redzone blocks
+ *        ptr: Pointer to look for
+ *
+ * Returns: The block holding the pointer, or NULL if there is none
+ *
+ * -------------------------------------------------------------------------- */
+static const void *redzone_holding(const ptr_table *table, const void *ptr) {
+  const unsigned char *p = ptr;
+  const unsigned char *block = NULL;
+  size_t size = 0;
+  size_t i = 0;
+
+  for (i = 0; i < table->cap; i++) {
+    block = table->slots[i];
+    if (NULL == block) {
+      continue;
+    }
+    size = ((const redzone_header *)(block - CME_REDZONE_OFFSET))->size;
+    if (p >= block - CME_REDZONE_OFFSET &&
+        p < block + CME_ROUND_UP(size, CME_REDZONE_SIZE) + CME_REDZONE_SIZE) {
+      return block;
+    }
+  }
+
+  return NULL;
+}
+
+/* --------------------------------------------------------------------------
+ * Function: redzone_intact
+ * --------------------------------------------------------------------------
+ *
+ * Description: Check that a redzone holds nothing but canary bytes. Every
+ *              redzone is `CME_REDZONE_SIZE` to `2 * CME_REDZONE_SIZE - 1`
+ *              bytes long, so two overlapping 16 byte compares cover it.
+ *
+ * Parameters:
+ *      p: Start of the redzone
+ *      n: Length of the redzone (16 to 31 bytes)
+ *
+ * Returns: Nonzero if the redzone is intact
+ *
+ * -------------------------------------------------------------------------- */
+static int redzone_intact(const unsigned char *p, size_t n) {
+#ifdef CME_HAVE_SSE2
+  const __m128i canary = _mm_set1_epi8((char)CME_REDZONE_BYTE);
+  const __m128i head = _mm_loadu_si128((const __m128i *)p);
+  const __m128i tail = _mm_loadu_si128((const __m128i *)(p + n - 16));
+
+  return 0xFFFF == _mm_movemask_epi8(_mm_and_si128(
+                       _mm_cmpeq_epi8(head, canary),
+                       _mm_cmpeq_epi8(tail, canary)));
+#else
+  const uint64_t canary = UINT64_C(0x0101010101010101) * CME_REDZONE_BYTE;
+  uint64_t words[4];
+
+  memcpy(&words[0], p, 8);
+  memcpy(&words[1], p + 8, 8);
+  memcpy(&words[2], p + n - 16, 8);
+  memcpy(&words[3], p + n - 8, 8);
+
+  return canary == words[0] && canary == words[1] && canary == words[2] &&
+         canary == words[3];
+#endif /* End of SSE2 code */
+}
+
+/* --------------------------------------------------------------------------
+ * Function: redzone_check
+ * --------------------------------------------------------------------------
+ *
+ * Description: Check both redzones of a block, and report the first
+ *              corrupted byte of each damaged one
+ *
+ * Parameters:
+ *          ptr: Block to check
+ *      context: Where the check is made (used in the report)
+ *
+ * Returns: Nonzero if both redzones are intact
+ *
+ * -------------------------------------------------------------------------- */
+static int redzone_check(const void *ptr, const char *context) {
+  const unsigned char *p = ptr;
+  const redzone_header *header =
+      (const redzone_header *)(p - CME_REDZONE_OFFSET);
+  size_t size = header->size;
+  size_t right = CME_ROUND_UP(size, CME_REDZONE_SIZE) - size +
+                 CME_REDZONE_SIZE;
+  int intact = 1;
+  size_t i = 0;
+
+  if (CME_REDZONE_MAGIC != header->magic) {
+    fflush(stdout);
+    fprintf(stderr, "cme_alloc: %s: header of block %p overwritten "
+                    "(underrun past the left redzone)\n", context, ptr);
+    return 0;
+  }
+
+  if (!redzone_intact(p - CME_REDZONE_SIZE, CME_REDZONE_SIZE)) {
+    for (i = 0; CME_REDZONE_BYTE == p[(ptrdiff_t)i - CME_REDZONE_SIZE]; i++) {
+    }
+    fflush(stdout);
+    fprintf(stderr, "cme_alloc: %s: block %p of %zu bytes underrun, left "
+                    "redzone corrupted at offset %td\n",
+            context, ptr, size, (ptrdiff_t)i - CME_REDZONE_SIZE);
+    intact = 0;
+  }
+  if (!redzone_intact(p + size, right)) {
+    for (i = 0; CME_REDZONE_BYTE == p[size + i]; i++) {
+    }
+    fflush(stdout);
+    fprintf(stderr, "cme_alloc: %s: block %p of %zu bytes overrun, right "
+                    "redzone corrupted at offset %zu\n",
+            context, ptr, size, size + i);
+    intact = 0;
+  }
+
+  return intact;
+}
+
+/* --------------------------------------------------------------------------
+ * Function: redzone_check_range
+ * --------------------------------------------------------------------------
+ *
+ * Description: Flag the corrupted blocks in a range of the block table
+ *              (loop body of `cme_heap_check`)
+ *
+ * Parameters:
+ *        ctx: Pointer to the heap check job
+ *      begin: First table slot
+ *        end: One past the last table slot
+ *
+ * Returns: None
+ *
+ * -------------------------------------------------------------------------- */
+static void redzone_check_range(void *ctx, size_t begin, size_t end) {
+  heap_check_job *job = ctx;
+  const unsigned char *p = NULL;
+  size_t size = 0;
+  size_t i = 0;
+
+  for (i = begin; i < end; i++) {
+    p = job->table[i];
+    if (NULL == p) {
+      continue;
+    }
+    size = ((const redzone_header *)(p - CME_REDZONE_OFFSET))->size;
+    job->bad[i] =
+        CME_REDZONE_MAGIC !=
+            ((const redzone_header *)(p - CME_REDZONE_OFFSET))->magic ||
+        !redzone_intact(p - CME_REDZONE_SIZE, CME_REDZONE_SIZE) ||
+        !redzone_intact(p + size, CME_ROUND_UP(size, CME_REDZONE_SIZE) - size +
+                                      CME_REDZONE_SIZE);
+  }
+}
+
+/* --------------------------------------------------------------------------
+ * Function: poison_track
+ * --------------------------------------------------------------------------
+ *
+ * Description: Remember a block of the system allocator handed out with
+ *              poisoning on, so its free may poison it
+ *
+ * Parameters:
+ *      ptr: The block
+ *
+ * Returns: Nonzero if the block is remembered (it is freed unpoisoned
+ *          otherwise)
+ *
+ * -------------------------------------------------------------------------- */
+static int poison_track(void *ptr) {
+  int tracked = 0;
+
+  CME_ALLOC_LOCK();
+  tracked = table_insert(&g_poison_blocks, ptr);
+  CME_ALLOC_UNLOCK();
+
+  return tracked;
+}
+
+/* --------------------------------------------------------------------------
+ * Function: poison_untrack
+ * --------------------------------------------------------------------------
+ *
+ * Description: Forget a block of the system allocator about to be freed or
+ *              resized
+ *
+ * Parameters:
+ *      ptr: The block
+ *
+ * Returns: Nonzero if the block was handed out with poisoning on, so its
+ *          usable size can be read
+ *
+ * -------------------------------------------------------------------------- */
+static int poison_untrack(void *ptr) {
+  int tracked = 0;
+
+  if (NULL == ptr || !CME_LOAD_ACQUIRE(g_poison_blocks.used)) {
+    return 0;
+  }
+
+  CME_ALLOC_LOCK();
+  tracked = table_remove(&g_poison_blocks, ptr);
+  CME_ALLOC_UNLOCK();
+
+  return tracked;
+}
+
+/* --------------------------------------------------------------------------
+ * Function: table_home
+ * --------------------------------------------------------------------------
+ *
+ * Description: Home slot of a pointer in a pointer table (Fibonacci hashing
+ *              of the address without its always zero low bits)
+ *
+ * Parameters:
+ *      table: Pointer table
+ *        ptr: Block pointer
+ *
+ * Returns: Slot index
+ *
+ * -------------------------------------------------------------------------- */
+static size_t table_home(const ptr_table *table, const void *ptr) {
+  uint64_t hash =
+      (uint64_t)((uintptr_t)ptr >> 4) * UINT64_C(0x9E3779B97F4A7C15);
+
+  return (size_t)(hash >> 32) & (table->cap - 1);
+}
+
+/* --------------------------------------------------------------------------
+ * Function: table_find
+ * --------------------------------------------------------------------------
+ *
+ * Description: Look a block up in a pointer table. Called with the lock
+ *              held.
+ *
+ * Parameters:
+ *      table: Pointer table
+ *        ptr: Block pointer
+ *
+ * Returns: Nonzero if the block is in the table
+ *
+ * -------------------------------------------------------------------------- */
+static int table_find(const ptr_table *table, const void *ptr) {
+  size_t i = 0;
+
+  if (0 == table->cap) {
+    return 0;
+  }
+
+  for (i = table_home(table, ptr); NULL != table->slots[i];
+       i = (i + 1) & (table->cap - 1)) {
+    if (ptr == table->slots[i]) {
+      return 1;
+    }
+  }
+
+  return 0;
+}
+
+/* --------------------------------------------------------------------------
+ * Function: table_insert
+ * --------------------------------------------------------------------------
+ *
+ * Description: Add a block to a pointer table, doubling the table when it
+ *              gets three quarters full. Called with the lock held.
+ *
+ * Parameters:
+ *      table: Pointer table
+ *        ptr: Block pointer
+ *
+ * Returns: Nonzero on success, zero if the table can not grow
+ *
+ * -------------------------------------------------------------------------- */
+static int table_insert(ptr_table *table, void *ptr) {
+  size_t i = 0;
+
+  if (4 * (table->count + 1) > 3 * table->cap) {
+    void **old_slots = table->slots;
+    size_t old_cap = table->cap;
+    size_t new_cap = 0 < old_cap ? 2 * old_cap : 1024;
+    void **new_slots = calloc(new_cap, sizeof(*new_slots));
+
+    if (NULL == new_slots) {
+      return 0;
+    }
+    table->slots = new_slots;
+    table->cap = new_cap;
+    for (i = 0; i < old_cap; i++) {
+      if (old_slots[i]) {
+        size_t j = table_home(table, old_slots[i]);
+
+        while (table->slots[j]) {
+          j = (j + 1) & (table->cap - 1);
+        }
+        table->slots[j] = old_slots[i];
+      }
+    }
+    free(old_slots);
+  }
+
+  for (i = table_home(table, ptr); table->slots[i];
+       i = (i + 1) & (table->cap - 1)) {
+  }
+  table->slots[i] = ptr;
+  table->count++;
+  CME_STORE_RELEASE(table->used, 1);
+
+  return 1;
+}
+
+/* --------------------------------------------------------------------------
+ * Function: table_remove
+ * --------------------------------------------------------------------------
+ *
+ * Description: Remove a block from a pointer table. Entries after it in the
+ *              probe sequence are shifted back, so no tombstones are needed.
+ *              Called with the lock held.
+ *
+ * Parameters:
+ *      table: Pointer table
+ *        ptr: Block pointer
+ *
+ * Returns: Nonzero if the block was in the table
+ *
+ * -------------------------------------------------------------------------- */
+static int table_remove(ptr_table *table, const void *ptr) {
+  const size_t mask = table->cap - 1;
+  size_t hole = 0;
+  size_t i = 0;
+  size_t home = 0;
+
+  if (0 == table->cap) {
+    return 0;
+  }
+
+  for (hole = table_home(table, ptr); ptr != table->slots[hole];
+       hole = (hole + 1) & mask) {
+    if (NULL == table->slots[hole]) {
+      return 0;
+    }
+  }
+
+  for (i = (hole + 1) & mask; table->slots[i]; i = (i + 1) & mask) {
+    home = table_home(table, table->slots[i]);
+    /* Move the entry into the hole unless its home lies cyclically in
+       (hole, i], in which case it is already as close to home as it can be */
+    if (((i - home) & mask) >= ((i - hole) & mask)) {
+      table->slots[hole] = table->slots[i];
+      hole = i;
+    }
+  }
+  table->slots[hole] = NULL;
+  table->count--;
+
+  return 1;
+}
+
+/* --------------------------------------------------------------------------
+ * Function: stats_setup
+ * --------------------------------------------------------------------------
+ *
+ * Description: Turn the statistics on and have them printed at exit. The
+ *              block tables are allocated by the threads as they use them.
+ *              Called with the lock held.
+ *
+ * Parameters:
+ *      live: Nonzero to also follow every block to its free (the live
+ *            tracking stays on once turned on)
+ *
+ * Returns: None
+ *
+ * -------------------------------------------------------------------------- */
+static void stats_setup(int live) {
+  if (!g_stats_at_exit) {
+    g_stats_at_exit = 0 == atexit(stats_at_exit);
+  }
+  g_stats_live |= live;
+  g_stats = 1;
+  CME_STORE_RELEASE(g_direct, 0);
+}
+
+/* --------------------------------------------------------------------------
+ * Function: stats_at_exit
+ * --------------------------------------------------------------------------
+ *
+ * Description: Print the allocation statistics at exit
+ *
+ * Parameters: None
+ *
+ * Returns: None
+ *
+ * -------------------------------------------------------------------------- */
+static void stats_at_exit(void) { cme_alloc_stats_print(); }
+
+/* --------------------------------------------------------------------------
+ * Function: stats_compare
+ * --------------------------------------------------------------------------
+ *
+ * Description: Order call sites by the bytes they allocated, most first
+ *
+ * Parameters:
+ *      a: First site
+ *      b: Second site
+ *
+ * Returns: Negative, zero or positive, as for `qsort`
+ *
+ * -------------------------------------------------------------------------- */
+static int stats_compare(const void *a, const void *b) {
+  uint64_t bytes_a = ((const cme_alloc_site_stats *)a)->bytes;
+  uint64_t bytes_b = ((const cme_alloc_site_stats *)b)->bytes;
+
+  return (bytes_a < bytes_b) - (bytes_a > bytes_b);
+}
+
+/* --------------------------------------------------------------------------
+ * Function: site_find
+ * --------------------------------------------------------------------------
+ *
+ * Description: Index of a call site. The thread looks the site up in its
+ *              cache first, so only the first call from a site (per thread)
+ *              takes the lock.
+ *
+ * Parameters:
+ *      file: Source file of the call (NULL for an unknown site)
+ *      line: Line of the call
+ *      func: Function making the call
+ *
+ * Returns: Index of the site (0 for an unknown site, or when the sites are
+ *          used up)
+ *
+ * -------------------------------------------------------------------------- */
+static unsigned site_find(const char *file, int line, const char *func) {
+  site_cache_entry *cached = NULL;
+  unsigned site = 0;
+
+  if (NULL == file) {
+    return 0;
+  }
+
+  cached = &t_site_cache[((uintptr_t)file ^ (uintptr_t)line * 0x9E3779B1u) &
+                         (CME_SITE_CACHE_SIZE - 1)];
+  if (cached->file == file && cached->line == line) {
+    return cached->site;
+  }
+
+  CME_ALLOC_LOCK();
+  for (site = 1; site < g_num_sites; site++) {
+    if (g_sites[site].line == line &&
+        (g_sites[site].file == file || 0 == strcmp(g_sites[site].file, file))) {
+      break;
+    }
+  }
+  if (site == g_num_sites) {
+    if (g_num_sites < CME_ALLOC_MAX_SITES) {
+      g_sites[site].file = file;
+      g_sites[site].line = line;
+      g_sites[site].func = func;
+      g_num_sites++;
+    } else {
+      site = 0;
+    }
+  }
+  CME_ALLOC_UNLOCK();
+
+  cached->file = file;
+  cached->line = line;
+  cached->site = site;
+
+  return site;
+}
+
+/* --------------------------------------------------------------------------
+ * Function: site_counts_of
+ * --------------------------------------------------------------------------
+ *
+ * Description: Counters of a call site in the calling thread. The counters
+ *              of a thread are allocated on its first use of them.
+ *
+ * Parameters:
+ *      site: Index of the site
+ *
+ * Returns: Counters, or NULL if out of memory
+ *
+ * -------------------------------------------------------------------------- */
+static site_counts *site_counts_of(unsigned site) {
+  if (NULL == t_sites) {
+    t_sites = calloc(1, sizeof(site_thread));
+    if (NULL == t_sites) {
+      return NULL;
+    }
+    CME_ALLOC_LOCK();
+    t_sites->next = g_site_threads;
+    g_site_threads = t_sites;
+    CME_ALLOC_UNLOCK();
+  }
+
+  return &t_sites->counts[site];
+}
+
+/* --------------------------------------------------------------------------
+ * Function: site_alloc
+ * --------------------------------------------------------------------------
+ *
+ * Description: Count an allocation at its call site, and with the live
+ *              tracking on enter the block in the block table so its free
+ *              is counted there as well
+ *
+ * Parameters:
+ *       ptr: The block
+ *      size: Requested size
+ *      file: Source file of the call (NULL for an unknown site)
+ *      line: Line of the call
+ *      func: Function making the call
+ *
+ * Returns: None
+ *
+ * -------------------------------------------------------------------------- */
+static void site_alloc(void *ptr, size_t size, const char *file, int line,
+                       const char *func) {
+  unsigned site = site_find(file, line, func);
+  site_counts *counts = site_counts_of(site);
+
+  if (NULL == counts) {
+    return;
+  }
+  counts->allocs++;
+  counts->bytes += size;
+  if (g_stats_live &&
+      block_insert(ptr, ((uint64_t)site << CME_BLOCK_SIZE_BITS) |
+                            ((uint64_t)size & CME_BLOCK_SIZE_MASK))) {
+    counts->live += (int64_t)size;
+    if (counts->live > counts->peak) {
+      counts->peak = counts->live;
+    }
+  }
+}
+
+/* --------------------------------------------------------------------------
+ * Function: site_free
+ * --------------------------------------------------------------------------
+ *
+ * Description: Count a free at the call site of the block's allocation, or
+ *              at the call site of the free if the block is not in the
+ *              block table (always, with the live tracking off)
+ *
+ * Parameters:
+ *       ptr: The block (not released yet)
+ *      file: Source file of the free (NULL for an unknown site)
+ *      line: Line of the free
+ *      func: Function calling free
+ *
+ * Returns: None
+ *
+ * -------------------------------------------------------------------------- */
+static void site_free(void *ptr, const char *file, int line,
+                      const char *func) {
+  site_counts *counts = NULL;
+  uint64_t entry = 0;
+
+  if (g_stats_live && block_remove(ptr, &entry)) {
+    counts = site_counts_of((unsigned)(entry >> CME_BLOCK_SIZE_BITS));
+    if (counts) {
+      counts->frees++;
+      counts->live -= (int64_t)(entry & CME_BLOCK_SIZE_MASK);
+    }
+  } else {
+    counts = site_counts_of(site_find(file, line, func));
+    if (counts) {
+      counts->frees++;
+    }
+  }
+}
+
+/* --------------------------------------------------------------------------
+ * Function: block_home
+ * --------------------------------------------------------------------------
+ *
+ * Description: Home slot of a block in a block table
+ *
+ * Parameters:
+ *      ptr: Block pointer
+ *      cap: Capacity of the table (a power of two)
+ *
+ * Returns: Slot index
+ *
+ * -------------------------------------------------------------------------- */
+static size_t block_home(const void *ptr, size_t cap) {
+  uint64_t hash =
+      (uint64_t)((uintptr_t)ptr >> 4) * UINT64_C(0x9E3779B97F4A7C15);
+
+  return (size_t)(hash >> 32) & (cap - 1);
+}
+
+/* --------------------------------------------------------------------------
+ * Function: block_find
+ * --------------------------------------------------------------------------
+ *
+ * Description: Slot of a block in a block table. The table is at most half
+ *              full, so the probe sequence ends at an empty slot soon.
+ *
+ * Parameters:
+ *      table: Block table
+ *        ptr: Block pointer
+ *
+ * Returns: Slot index, or the capacity of the table if the block is not in
+ *          it
+ *
+ * -------------------------------------------------------------------------- */
+static size_t block_find(block_table *table, const void *ptr) {
+  size_t slot = 0;
+  uintptr_t seen = 0;
+
+  if (0 == table->cap) {
+    return 0;
+  }
+
+  for (slot = block_home(ptr, table->cap);;
+       slot = (slot + 1) & (table->cap - 1)) {
+    seen = CME_BLOCK_LOAD(table->keys[slot]);
+    if ((uintptr_t)ptr == seen) {
+      return slot;
+    }
+    if (CME_BLOCK_EMPTY == seen) {
+      return table->cap;
+    }
+  }
+}
+
+/* --------------------------------------------------------------------------
+ * Function: block_rebuild
+ * --------------------------------------------------------------------------
+ *
+ * Description: Rebuild the block table of the calling thread without its
+ *              deleted slots, at the least capacity (`CME_ALLOC_STATS_BLOCKS`
+ *              or more) the live blocks fill at most a quarter of. Takes the
+ *              lock, so no other thread is looking into the table meanwhile.
+ *
+ * Parameters:
+ *      table: Block table of the calling thread
+ *
+ * Returns: Nonzero on success, zero if out of memory (the table is left
+ *          as it was)
+ *
+ * -------------------------------------------------------------------------- */
+static int block_rebuild(block_table *table) {
+  block_table rebuilt = {NULL, NULL, CME_ALLOC_STATS_BLOCKS, 0};
+  uintptr_t key = 0;
+  size_t slot = 0;
+  size_t i = 0;
+
+  CME_ALLOC_LOCK();
+  for (i = 0; i < table->cap; i++) {
+    if (CME_BLOCK_DELETED < CME_BLOCK_LOAD(table->keys[i])) {
+      rebuilt.used++;
+    }
+  }
+  while (rebuilt.cap < 4 * (rebuilt.used + 1)) {
+    rebuilt.cap *= 2;
+  }
+
+  rebuilt.keys = calloc(rebuilt.cap, sizeof(CME_BLOCK_KEY));
+  rebuilt.values = malloc(rebuilt.cap * sizeof(uint64_t));
+  if (NULL == rebuilt.keys || NULL == rebuilt.values) {
+    free(rebuilt.keys);
+    free(rebuilt.values);
+    CME_ALLOC_UNLOCK();
+    return 0;
+  }
+
+  for (i = 0; i < table->cap; i++) {
+    key = CME_BLOCK_LOAD(table->keys[i]);
+    if (CME_BLOCK_DELETED >= key) {
+      continue;
+    }
+    for (slot = block_home((const void *)key, rebuilt.cap);
+         CME_BLOCK_EMPTY != CME_BLOCK_LOAD(rebuilt.keys[slot]);
+         slot = (slot + 1) & (rebuilt.cap - 1)) {
+    }
+    rebuilt.values[slot] = table->values[i];
+    CME_BLOCK_STORE(rebuilt.keys[slot], key);
+  }
+
+  free(table->keys);
+  free(table->values);
+  *table = rebuilt;
+  CME_ALLOC_UNLOCK();
+
+  return 1;
+}
+
+/* --------------------------------------------------------------------------
+ * Function: block_insert
+ * --------------------------------------------------------------------------
+ *
+ * Description: Enter a block in the block table of the calling thread. The
+ *              first empty or deleted slot from the home slot on is taken
+ *              without the lock: other threads only ever turn a slot that
+ *              holds a live block into a deleted one. The value is stored
+ *              before the key, so a thread that finds the key finds the
+ *              value too.
+ *
+ * Parameters:
+ *        ptr: Block pointer
+ *      entry: Site index and size of the block
+ *
+ * Returns: Nonzero on success, zero if out of memory
+ *
+ * -------------------------------------------------------------------------- */
+static int block_insert(const void *ptr, uint64_t entry) {
+  block_table *table = NULL;
+  size_t slot = 0;
+  uintptr_t seen = 0;
+
+  /* The counters of the thread come with its table */
+  if (NULL == t_sites && NULL == site_counts_of(0)) {
+    return 0;
+  }
+  table = &t_sites->blocks;
+  if (table->cap < 2 * (table->used + 1) && !block_rebuild(table)) {
+    return 0;
+  }
+
+  for (slot = block_home(ptr, table->cap);;
+       slot = (slot + 1) & (table->cap - 1)) {
+    seen = CME_BLOCK_LOAD(table->keys[slot]);
+    if (CME_BLOCK_EMPTY == seen || CME_BLOCK_DELETED == seen) {
+      break;
+    }
+  }
+  table->values[slot] = entry;
+  CME_BLOCK_STORE(table->keys[slot], (uintptr_t)ptr);
+  if (CME_BLOCK_EMPTY == seen) {
+    table->used++;
+  }
+
+  return 1;
+}
+
+/* --------------------------------------------------------------------------
+ * Function: block_remove
+ * --------------------------------------------------------------------------
+ *
+ * Description: Take a block out of the block tables. The table of the
+ *              calling thread is looked at first, without the lock; a block
+ *              of another thread (or a block in no table) costs a look at
+ *              every table, with the lock held. The slot is marked deleted,
+ *              not emptied, so the probe sequences other threads may be
+ *              following stay intact; rebuilds reclaim the deleted slots.
+ *
+ * Parameters:
+ *        ptr: Block pointer
+ *      entry: Receives the site index and size of the block
+ *
+ * Returns: Nonzero if the block was in a table
+ *
+ * -------------------------------------------------------------------------- */
+static int block_remove(const void *ptr, uint64_t *entry) {
+  site_thread *thread = t_sites;
+  size_t slot = 0;
+  uintptr_t seen = (uintptr_t)ptr;
+  int found = 0;
+
+  if (thread) {
+    slot = block_find(&thread->blocks, ptr);
+    if (slot < thread->blocks.cap) {
+      *entry = thread->blocks.values[slot];
+      CME_BLOCK_STORE(thread->blocks.keys[slot], CME_BLOCK_DELETED);
+      return 1;
+    }
+  }
+
+  CME_ALLOC_LOCK();
+  for (thread = g_site_threads; thread && !found; thread = thread->next) {
+    if (thread == t_sites) {
+      continue;
+    }
+    slot = block_find(&thread->blocks, ptr);
+    if (slot < thread->blocks.cap) {
+      *entry = thread->blocks.values[slot];
+      found = CME_BLOCK_CLAIM(thread->blocks.keys[slot], seen,
+                              CME_BLOCK_DELETED);
+    }
+  }
+  CME_ALLOC_UNLOCK();
+
+  return found;
+}
@@ -0,0 +1,257 @@
+/* ==========================================================================
+ *  Copyright (C) 2026 Ljubomir Kurij <ljubomir_kurij@protonmail.com>
+ *
+ * This file is part of "C Common Memory Errors".
+ *
+ * "C Common Memory Errors" is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * "C Common Memory Errors" is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General
+ * Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with Focus Precision Analyze. If not, see <https://www.gnu.org/licenses/>.
+ * ========================================================================== */
+
+/* ==========================================================================
+ *
+ * 2026-10-18 Ljubomir Kurij <ljubomir_kurij@protonmail.com>
+ *
+ * * cme_alloc.h: created.
+ *
+ * ========================================================================== */
+
+#ifndef CME_ALLOC_H_
+#define CME_ALLOC_H_
+
+/* ==========================================================================
+ * Headers Include Section
+ * ========================================================================== */
+
+/* Standard Library headers */
+#include <stddef.h>
+#include <stdint.h>
+#if defined(CME_ALLOCATOR_SYSTEM)
+#include <stdlib.h>
+#include <string.h>
+#endif
+
+/* Project headers (the allocator of the allocation macros) */
+#if defined(CME_ALLOCATOR_ARENA)
+#include "cme_arena.h"
+#elif defined(CME_ALLOCATOR_POOL)
+#include "cme_pool.h"
+#endif
+
+/* ==========================================================================
+ * Macros Definitions Section
+ * ========================================================================== */
+
+/* Environment variables read on the first allocation:
+
+   CME_ALLOC=system|guard|redzone  Allocator mode (default `system`)
+   CME_GUARD_SAMPLE=N              In guard mode, guard only every N-th
+                                   allocation (default 1, i.e. all of them)
+   CME_POISON=1                    Fill new blocks and freed blocks with the
+                                   patterns of `cme_poison.h` (any mode)
+   CME_ALLOC_STATS=1|live          Collect allocation statistics per call
+                                   site and print them at exit; `live` also
+                                   follows every block to its free (see
+                                   `cme_alloc_stats_enable`) */
+#define CME_ALLOC_ENV "CME_ALLOC"
+#define CME_GUARD_SAMPLE_ENV "CME_GUARD_SAMPLE"
+#define CME_POISON_ENV "CME_POISON"
+#define CME_ALLOC_STATS_ENV "CME_ALLOC_STATS"
+
+/* Call sites the statistics tell apart. Sites past this many are pooled in
+   one entry. */
+#define CME_ALLOC_MAX_SITES 512
+
+/* Live blocks the block table of a thread starts with room for (a power of
+   two). The statistics follow the blocks a thread allocates in a table of
+   its own, which grows as needed. */
+#define CME_ALLOC_STATS_BLOCKS ((size_t)1 << 10)
+
+/* Address space reserved up front for the guarded blocks. Blocks that do not
+   fit are served by the system allocator. */
+#define CME_GUARD_REGION_SIZE ((size_t)1 << 30)
+
+/* Freed slots of up to this many data pages are kept in a pool (one FIFO per
+   page count) and reused; larger slots are released to the system */
+#define CME_GUARD_POOL_CLASSES 64
+
+/* Alignment of the guarded blocks. The end of a block is placed as close to
+   its guard page as this alignment allows, so overruns of less than
+   `CME_GUARD_ALIGN - 1` bytes may go unnoticed. */
+#define CME_GUARD_ALIGN 16
+
+/* Canary bytes put on each side of a block in redzone mode. The right redzone
+   also covers the padding up to the next multiple of `CME_REDZONE_SIZE`, so
+   it is `CME_REDZONE_SIZE` to `2 * CME_REDZONE_SIZE - 1` bytes long and an
+   overrun is caught from its first byte. */
+#define CME_REDZONE_SIZE 16
+#define CME_REDZONE_BYTE 0xFD
+
+/* Freed redzone blocks held back from the system allocator. Freeing one of
+   them again is reported as a double free; past this many frees the oldest
+   goes back to the system allocator. */
+#define CME_REDZONE_QUARANTINE 1024
+
+/* Smallest number of live blocks `cme_heap_check` splits across threads */
+#define CME_HEAP_CHECK_PARALLEL_MIN 4096
+
+/* ==========================================================================
+ * Type Definitions Section
+ * ========================================================================== */
+
+typedef enum cme_alloc_mode {
+  CME_ALLOC_SYSTEM,  /* Plain `malloc` and `free` */
+  CME_ALLOC_GUARD,   /* Every block is followed by an inaccessible page */
+  CME_ALLOC_REDZONE, /* Every block is surrounded by canary bytes */
+} cme_alloc_mode;
+
+/* Allocation counters of a thread (e.g. for allocations per operation in a
+   benchmark). A `cme_realloc` that moves or resizes a block counts as one
+   allocation and one free. */
+typedef struct cme_alloc_counts {
+  uint64_t allocs; /* Blocks allocated */
+  uint64_t frees;  /* Blocks freed */
+  uint64_t bytes;  /* Bytes requested by the allocations */
+} cme_alloc_counts;
+
+/* Allocation statistics of a call site, merged over the threads */
+typedef struct cme_alloc_site_stats {
+  const char *file;
+  int line;
+  const char *func;
+  uint64_t allocs;    /* Blocks allocated at the site */
+  uint64_t bytes;     /* Bytes requested there */
+  uint64_t frees;     /* Blocks allocated there that were freed (freed
+                         there, without the live tracking) */
+  uint64_t peak_live; /* Most bytes allocated there live at once (0
+                         without the live tracking) */
+} cme_alloc_site_stats;
+
+/* ==========================================================================
+ * Function Declarations Section
+ * ========================================================================== */
+
+void *cme_malloc(size_t size);
+void *cme_calloc(size_t count, size_t size);
+void *cme_realloc(void *ptr, size_t size);
+char *cme_strdup(const char *str);
+void cme_free(void *ptr);
+
+void *cme_malloc_at(size_t size, const char *file, int line,
+                    const char *func);
+void *cme_calloc_at(size_t count, size_t size, const char *file, int line,
+                    const char *func);
+void *cme_realloc_at(void *ptr, size_t size, const char *file, int line,
+                     const char *func);
+char *cme_strdup_at(const char *str, const char *file, int line,
+                    const char *func);
+void cme_free_at(void *ptr, const char *file, int line, const char *func);
+
+cme_alloc_mode cme_alloc_get_mode(void);
+void cme_alloc_set_mode(cme_alloc_mode mode);
+void cme_alloc_set_guard_sample(unsigned every);
+void cme_alloc_set_poison(int enable);
+void cme_alloc_watch(void);
+size_t cme_heap_check(void);
+cme_alloc_counts cme_alloc_get_counts(void);
+int cme_alloc_stats_enable(int live);
+size_t cme_alloc_stats_get(cme_alloc_site_stats *sites, size_t max_sites);
+void cme_alloc_stats_print(void);
+
+/* Instance the arena and pool builds allocate from by default */
+#if defined(CME_ALLOCATOR_ARENA)
+extern cme_arena cme_alloc_arena;
+#elif defined(CME_ALLOCATOR_POOL)
+extern cme_pool cme_alloc_pool;
+#endif
+
+/* Name of the allocator of the allocation macros (below) */
+#if defined(CME_ALLOCATOR_SYSTEM)
+#define CME_ALLOCATOR_NAME "system"
+#elif defined(CME_ALLOCATOR_ARENA)
+#define CME_ALLOCATOR_NAME "arena"
+#elif defined(CME_ALLOCATOR_POOL)
+#define CME_ALLOCATOR_NAME "pool"
+#elif defined(CME_ALLOCATOR_GUARDED)
+#define CME_ALLOCATOR_NAME "guarded"
+#else
+#define CME_ALLOCATOR_NAME "tracking"
+#endif
+
+/* Whether the allocation macros go through the `cme` allocator. The
+   statistics and the leak checker only see its blocks, so they are not
+   available when this is 0. */
+#if defined(CME_ALLOCATOR_SYSTEM) || defined(CME_ALLOCATOR_ARENA) ||           \
+    defined(CME_ALLOCATOR_POOL)
+#define CME_ALLOC_TRACKED 0
+#else
+#define CME_ALLOC_TRACKED 1
+#endif
+
+/* The allocation macros call the allocator chosen at build time (CMake
+   option `CME_ALLOCATOR`, which defines one of these):
+
+   CME_ALLOCATOR_TRACKING  The functions above, passing their call site along
+                           (file, line and function) for the statistics
+                           (default). The modes of `CME_ALLOC`, the heap
+                           profiler, the leak checker and the traces need it.
+   CME_ALLOCATOR_GUARDED   The same, starting in guard mode (unless
+                           `CME_ALLOC` says otherwise)
+   CME_ALLOCATOR_SYSTEM    `malloc`, `calloc`, `realloc`, `strdup` and
+                           `free`, called directly
+   CME_ALLOCATOR_ARENA     `cme_arena.h`: a free gives back only the last
+                           block, the rest is held until exit
+   CME_ALLOCATOR_POOL      `cme_pool.h`: size classes with free lists
+
+   The arena and the pool allocate from `CME_ALLOC_CTX`, the instance of the
+   library unless a file defines its own before including this header (e.g.
+   `#define CME_ALLOC_CTX (&parser_arena)`); neither is thread safe. Define
+   `CME_ALLOC_NO_SITES` before including this header to call the plain
+   functions whatever the build, whose allocations are counted as of an
+   unknown site. */
+#ifndef CME_ALLOC_NO_SITES
+#if defined(CME_ALLOCATOR_SYSTEM)
+#define cme_malloc(size) malloc(size)
+#define cme_calloc(count, size) calloc((count), (size))
+#define cme_realloc(ptr, size) realloc((ptr), (size))
+#define cme_strdup(str) strdup(str)
+#define cme_free(ptr) free(ptr)
+#elif defined(CME_ALLOCATOR_ARENA)
+#ifndef CME_ALLOC_CTX
+#define CME_ALLOC_CTX (&cme_alloc_arena)
+#endif
+#define cme_malloc(size) cme_arena_malloc(CME_ALLOC_CTX, (size))
+#define cme_calloc(count, size)                                                \
+  cme_arena_calloc(CME_ALLOC_CTX, (count), (size))
+#define cme_realloc(ptr, size) cme_arena_realloc(CME_ALLOC_CTX, (ptr), (size))
+#define cme_strdup(str) cme_arena_strdup(CME_ALLOC_CTX, (str))
+#define cme_free(ptr) cme_arena_free(CME_ALLOC_CTX, (ptr))
+#elif defined(CME_ALLOCATOR_POOL)
+#ifndef CME_ALLOC_CTX
+#define CME_ALLOC_CTX (&cme_alloc_pool)
+#endif
+#define cme_malloc(size) cme_pool_malloc(CME_ALLOC_CTX, (size))
+#define cme_calloc(count, size) cme_pool_calloc(CME_ALLOC_CTX, (count), (size))
+#define cme_realloc(ptr, size) cme_pool_realloc(CME_ALLOC_CTX, (ptr), (size))
+#define cme_strdup(str) cme_pool_strdup(CME_ALLOC_CTX, (str))
+#define cme_free(ptr) cme_pool_free(CME_ALLOC_CTX, (ptr))
+#else
+#define CME_ALLOC_SITE __FILE__, __LINE__, __func__
+#define cme_malloc(size) cme_malloc_at((size), CME_ALLOC_SITE)
+#define cme_calloc(count, size) cme_calloc_at((count), (size), CME_ALLOC_SITE)
+#define cme_realloc(ptr, size) cme_realloc_at((ptr), (size), CME_ALLOC_SITE)
+#define cme_strdup(str) cme_strdup_at((str), CME_ALLOC_SITE)
+#define cme_free(ptr) cme_free_at((ptr), CME_ALLOC_SITE)
+#endif /* End of allocator specific macros */
+#endif
+
+#endif /* CME_ALLOC_H_ */
@@ -0,0 +1,339 @@
+/* ==========================================================================
+ *  Copyright (C) 2026 Ljubomir Kurij <ljubomir_kurij@protonmail.com>
+ *
+ * This file is part of "C Common Memory Errors".
+ *
+ * "C Common Memory Errors" is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * "C Common Memory Errors" is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General
+ * Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with Focus Precision Analyze. If not, see <https://www.gnu.org/licenses/>.
+ * ========================================================================== */
+
+/* ==========================================================================
+ *
+ * 2026-10-18 Ljubomir Kurij <ljubomir_kurij@protonmail.com>
+ *
+ * * cme_arena.c: created.
+ *
+ * ========================================================================== */
+
+/* ==========================================================================
+ * Headers Include Section
+ * ========================================================================== */
+
+/* Related header */
+#include "cme_arena.h"
+
+/* Standard Library headers */
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+/* ==========================================================================
+ * Macros Definitions Section
+ * ========================================================================== */
+
+/* Round a size up to the alignment */
+#define ARENA_ROUND(size)                                                      \
+  (((size) + CME_ARENA_ALIGN - 1) & ~(size_t)(CME_ARENA_ALIGN - 1))
+
+/* Bytes at the start of a chunk, before its first block */
+#define ARENA_CHUNK_HEADER ARENA_ROUND(sizeof(cme_arena_chunk))
+
+/* Size of a block, from the header in front of it */
+#define ARENA_SIZE(ptr) (*(size_t *)((char *)(ptr) - CME_ARENA_ALIGN))
+
+/* ==========================================================================
+ * Type Definitions Section
+ * ========================================================================== */
+
+/* Head of a chunk */
+typedef struct cme_arena_chunk {
+  struct cme_arena_chunk *next;
+  size_t size; /* Bytes of the chunk, head included */
+} cme_arena_chunk;
+
+/* ==========================================================================
+ * Private Function Declarations Section
+ * ========================================================================== */
+
+static char *arena_chunk(cme_arena *arena, size_t size, int behind);
+
+/* ==========================================================================
+ * Function Definitions Section
+ * ========================================================================== */
+
+/* --------------------------------------------------------------------------
+ * Function: cme_arena_init
+ * --------------------------------------------------------------------------
+ *
+ * Description: Initialize an empty arena (no memory is allocated until the
+ *              first block)
+ *
+ * Parameters:
+ *           arena: The arena
+ *      chunk_size: Size of the chunks (0 for CME_ARENA_CHUNK_SIZE)
+ *
+ * Returns: None
+ *
+ * -------------------------------------------------------------------------- */
+void cme_arena_init(cme_arena *arena, size_t chunk_size) {
+  memset(arena, 0, sizeof(*arena));
+  arena->chunk_size = chunk_size ? chunk_size : CME_ARENA_CHUNK_SIZE;
+}
+
+/* --------------------------------------------------------------------------
+ * Function: cme_arena_malloc
+ * --------------------------------------------------------------------------
+ *
+ * Description: Cut a block from the arena. A block bigger than a quarter of
+ *              a chunk gets a chunk of its own, linked behind the newest one
+ *              so the free end of that one is not given up.
+ *
+ * Parameters:
+ *      arena: The arena
+ *       size: Number of bytes
+ *
+ * Returns: Pointer to the block, or NULL if out of memory
+ *
+ * -------------------------------------------------------------------------- */
+void *cme_arena_malloc(cme_arena *arena, size_t size) {
+  size_t need = 0;
+  char *block = NULL;
+
+  if (size > SIZE_MAX - 2 * CME_ARENA_ALIGN - ARENA_CHUNK_HEADER) {
+    return NULL;
+  }
+  need = CME_ARENA_ALIGN + ARENA_ROUND(size);
+
+  if (need > (size_t)(arena->end - arena->top)) {
+    if (0 == arena->chunk_size) {
+      arena->chunk_size = CME_ARENA_CHUNK_SIZE;
+    }
+    if (need > arena->chunk_size / 4) {
+      block = arena_chunk(arena, need, 1);
+      if (NULL == block) {
+        return NULL;
+      }
+      *(size_t *)block = size;
+      return block + CME_ARENA_ALIGN;
+    }
+    block = arena_chunk(arena, arena->chunk_size, 0);
+    if (NULL == block) {
+      return NULL;
+    }
+    arena->top = block;
+    arena->end = block + arena->chunk_size;
+  }
+
+  block = arena->top;
+  arena->top += need;
+  *(size_t *)block = size;
+  arena->last = block + CME_ARENA_ALIGN;
+
+  return arena->last;
+}
+
+/* --------------------------------------------------------------------------
+ * Function: cme_arena_calloc
+ * --------------------------------------------------------------------------
+ *
+ * Description: Cut a zeroed array from the arena
+ *
+ * Parameters:
+ *      arena: The arena
+ *      count: Number of elements
+ *       size: Size of an element
+ *
+ * Returns: Pointer to the block, or NULL if out of memory or on overflow
+ *
+ * -------------------------------------------------------------------------- */
+void *cme_arena_calloc(cme_arena *arena, size_t count, size_t size) {
+  void *ptr = NULL;
+
+  if (0 != size && count > SIZE_MAX / size) {
+    return NULL;
+  }
+  ptr = cme_arena_malloc(arena, count * size);
+  if (ptr) {
+    memset(ptr, 0, count * size);
+  }
+
+  return ptr;
+}
+
+/* --------------------------------------------------------------------------
+ * Function: cme_arena_realloc
+ * --------------------------------------------------------------------------
+ *
+ * Description: Resize a block of the arena. The last block cut grows in
+ *              place while its chunk has room, and any block shrinks in
+ *              place; otherwise the block is copied to a new one.
+ *
+ * Parameters:
+ *      arena: The arena
+ *        ptr: Block to resize (NULL cuts a new one)
+ *       size: New size in bytes
+ *
+ * Returns: Pointer to the resized block, or NULL if out of memory (the old
+ *          block is left untouched)
+ *
+ * -------------------------------------------------------------------------- */
+void *cme_arena_realloc(cme_arena *arena, void *ptr, size_t size) {
+  size_t old = 0;
+  char *copy = NULL;
+
+  if (NULL == ptr) {
+    return cme_arena_malloc(arena, size);
+  }
+
+  old = ARENA_SIZE(ptr);
+  if ((char *)ptr == arena->last &&
+      ARENA_ROUND(size) <= (size_t)(arena->end - arena->last)) {
+    arena->top = arena->last + ARENA_ROUND(size);
+    ARENA_SIZE(ptr) = size;
+    return ptr;
+  }
+  if (size <= old) {
+    ARENA_SIZE(ptr) = size;
+    return ptr;
+  }
+
+  copy = cme_arena_malloc(arena, size);
+  if (copy) {
+    memcpy(copy, ptr, old);
+  }
+
+  return copy;
+}
+
+/* --------------------------------------------------------------------------
+ * Function: cme_arena_strdup
+ * --------------------------------------------------------------------------
+ *
+ * Description: Copy a string into the arena
+ *
+ * Parameters:
+ *      arena: The arena
+ *        str: String to copy
+ *
+ * Returns: Pointer to the copy, or NULL if out of memory
+ *
+ * -------------------------------------------------------------------------- */
+char *cme_arena_strdup(cme_arena *arena, const char *str) {
+  size_t size = strlen(str) + 1;
+  char *copy = cme_arena_malloc(arena, size);
+
+  if (copy) {
+    memcpy(copy, str, size);
+  }
+
+  return copy;
+}
+
+/* --------------------------------------------------------------------------
+ * Function: cme_arena_free
+ * --------------------------------------------------------------------------
+ *
+ * Description: Free a block of the arena. Only the last block cut is given
+ *              back (to be cut again); the others are kept until the arena
+ *              is released.
+ *
+ * Parameters:
+ *      arena: The arena
+ *        ptr: Block to free (may be NULL)
+ *
+ * Returns: None
+ *
+ * -------------------------------------------------------------------------- */
+void cme_arena_free(cme_arena *arena, void *ptr) {
+  if (ptr && (char *)ptr == arena->last) {
+    arena->top = arena->last - CME_ARENA_ALIGN;
+    arena->last = NULL;
+  }
+}
+
+/* --------------------------------------------------------------------------
+ * Function: cme_arena_release
+ * --------------------------------------------------------------------------
+ *
+ * Description: Release every chunk of the arena, and with them all of its
+ *              blocks. The arena can be used again.
+ *
+ * Parameters:
+ *      arena: The arena
+ *
+ * Returns: None
+ *
+ * -------------------------------------------------------------------------- */
+void cme_arena_release(cme_arena *arena) {
+  cme_arena_chunk *chunk = arena->chunks;
+  cme_arena_chunk *next = NULL;
+
+  while (chunk) {
+    next = chunk->next;
+    free(chunk);
+    chunk = next;
+  }
+  cme_arena_init(arena, arena->chunk_size);
+}
+
+/* --------------------------------------------------------------------------
+ * Function: cme_arena_footprint
+ * --------------------------------------------------------------------------
+ *
+ * Description: Memory the arena holds
+ *
+ * Parameters:
+ *      arena: The arena
+ *
+ * Returns: Bytes of all its chunks
+ *
+ * -------------------------------------------------------------------------- */
+size_t cme_arena_footprint(const cme_arena *arena) { return arena->footprint; }
+
+/* ==========================================================================
+ * Private Function Definitions Section
+ * ========================================================================== */
+
+/* --------------------------------------------------------------------------
+ * Function: arena_chunk
+ * --------------------------------------------------------------------------
+ *
+ * Description: Allocate a chunk and link it into the arena
+ *
+ * Parameters:
+ *       arena: The arena
+ *        size: Usable bytes of the chunk
+ *      behind: Link it behind the newest chunk (which stays the one blocks
+ *              are cut from) instead of in front
+ *
+ * Returns: First usable byte of the chunk, or NULL if out of memory
+ *
+ * -------------------------------------------------------------------------- */
+static char *arena_chunk(cme_arena *arena, size_t size, int behind) {
+  cme_arena_chunk *chunk = malloc(ARENA_CHUNK_HEADER + size);
+
+  if (NULL == chunk) {
+    return NULL;
+  }
+  chunk->size = ARENA_CHUNK_HEADER + size;
+  if (behind && arena->chunks) {
+    chunk->next = arena->chunks->next;
+    arena->chunks->next = chunk;
+  } else {
+    chunk->next = arena->chunks;
+    arena->chunks = chunk;
+  }
+  arena->footprint += chunk->size;
+
+  return (char *)chunk + ARENA_CHUNK_HEADER;
+}
@@ -0,0 +1,79 @@
+/* ==========================================================================
+ *  Copyright (C) 2026 Ljubomir Kurij <ljubomir_kurij@protonmail.com>
+ *
+ * This file is part of "C Common Memory Errors".
+ *
+ * "C Common Memory Errors" is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * "C Common Memory Errors" is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General
+ * Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with Focus Precision Analyze. If not, see <https://www.gnu.org/licenses/>.
+ * ========================================================================== */
+
+/* ==========================================================================
+ *
+ * 2026-10-18 Ljubomir Kurij <ljubomir_kurij@protonmail.com>
+ *
+ * * cme_arena.h: created.
+ *
+ * ========================================================================== */
+
+#ifndef CME_ARENA_H_
+#define CME_ARENA_H_
+
+/* ==========================================================================
+ * Headers Include Section
+ * ========================================================================== */
+
+/* Standard Library headers */
+#include <stddef.h>
+
+/* ==========================================================================
+ * Macros Definitions Section
+ * ========================================================================== */
+
+/* Alignment of the blocks (and size of the header in front of each) */
+#define CME_ARENA_ALIGN 16
+
+/* Default size of the chunks the blocks are cut from */
+#define CME_ARENA_CHUNK_SIZE ((size_t)64 * 1024)
+
+/* ==========================================================================
+ * Type Definitions Section
+ * ========================================================================== */
+
+/* Bump allocator: blocks are cut from large chunks one after the other, and
+   released all at once with the arena. Freeing (or resizing) a block frees
+   (or resizes) it in place only if it is the last one cut; otherwise its
+   bytes stay used until the arena is released. An arena of all zeros is
+   empty, with chunks of the default size. */
+typedef struct cme_arena {
+  struct cme_arena_chunk *chunks; /* Newest first */
+  char *top;         /* Next free byte of the newest chunk */
+  char *end;         /* End of the newest chunk */
+  char *last;        /* Last block cut, while nothing follows it */
+  size_t chunk_size; /* Size of a new chunk */
+  size_t footprint;  /* Bytes of all the chunks */
+} cme_arena;
+
+/* ==========================================================================
+ * Function Declarations Section
+ * ========================================================================== */
+
+void cme_arena_init(cme_arena *arena, size_t chunk_size);
+void *cme_arena_malloc(cme_arena *arena, size_t size);
+void *cme_arena_calloc(cme_arena *arena, size_t count, size_t size);
+void *cme_arena_realloc(cme_arena *arena, void *ptr, size_t size);
+char *cme_arena_strdup(cme_arena *arena, const char *str);
+void cme_arena_free(cme_arena *arena, void *ptr);
+void cme_arena_release(cme_arena *arena);
+size_t cme_arena_footprint(const cme_arena *arena);
+
+#endif /* CME_ARENA_H_ */
@@ -0,0 +1,73 @@
+/* ==========================================================================
+ *  Copyright (C) 2026 Ljubomir Kurij <ljubomir_kurij@protonmail.com>
+ *
+ * This file is part of "C Common Memory Errors".
+ *
+ * "C Common Memory Errors" is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * "C Common Memory Errors" is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General
+ * Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with Focus Precision Analyze. If not, see <https://www.gnu.org/licenses/>.
+ * ========================================================================== */
+
+/* ==========================================================================
+ *
+ * 2026-10-18 Ljubomir Kurij <ljubomir_kurij@protonmail.com>
+ *
+ * * cme_array.c: created.
+ *
+ * ========================================================================== */
+
+/* ==========================================================================
+ * Headers Include Section
+ * ========================================================================== */
+
+/* Related header */
+#include "cme_array.h"
+
+/* Standard Library headers */
+#include <stdio.h>
+#include <stdlib.h>
+
+/* ==========================================================================
+ * Function Definitions Section
+ * ========================================================================== */
+
+/* --------------------------------------------------------------------------
+ * Function: cme_array_out_of_bounds
+ * --------------------------------------------------------------------------
+ *
+ * Description: Report an access outside of a fat array and abort. Kept out
+ *              of line so the checks in the accessors stay small.
+ *
+ * Parameters:
+ *       file: Source file of the access
+ *       line: Source line of the access
+ *      first: Index of the first element accessed
+ *          n: Number of elements accessed
+ *        len: Length of the array
+ *
+ * Returns: Does not return
+ *
+ * -------------------------------------------------------------------------- */
+_Noreturn void cme_array_out_of_bounds(const char *file, int line,
+                                       size_t first, size_t n, size_t len) {
+  fflush(stdout);
+  if (1 == n) {
+    fprintf(stderr, "%s:%d: index %zu out of bounds of array of length %zu\n",
+            file, line, first, len);
+  } else {
+    fprintf(stderr,
+            "%s:%d: range [%zu, %zu + %zu) out of bounds of array of length "
+            "%zu\n",
+            file, line, first, first, n, len);
+  }
+  abort();
+}
@@ -0,0 +1,127 @@
+/* ==========================================================================
+ *  Copyright (C) 2026 Ljubomir Kurij <ljubomir_kurij@protonmail.com>
+ *
+ * This file is part of "C Common Memory Errors".
+ *
+ * "C Common Memory Errors" is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * "C Common Memory Errors" is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General
+ * Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with Focus Precision Analyze. If not, see <https://www.gnu.org/licenses/>.
+ * ========================================================================== */
+
+/* ==========================================================================
+ *
+ * 2026-10-18 Ljubomir Kurij <ljubomir_kurij@protonmail.com>
+ *
+ * * cme_array.h: created.
+ *
+ * ========================================================================== */
+
+#ifndef CME_ARRAY_H_
+#define CME_ARRAY_H_
+
+/* ==========================================================================
+ * Headers Include Section
+ * ========================================================================== */
+
+/* Standard Library headers */
+#include <stddef.h>
+#include <stdint.h>
+
+/* ==========================================================================
+ * Macros Definitions Section
+ * ========================================================================== */
+
+/* Bounds checking mode. With `CME_ARRAY_CHECKED` set to 1 (the default for
+   builds without `NDEBUG`) every element access is checked, so a bad index
+   is reported at the exact access. With 0 (release builds) an access is not
+   checked on its own; loops instead check their whole range once, up front,
+   with `cme_array_<sfx>_range`, which leaves the loop body free of branches
+   and lets the compiler vectorize it. */
+#ifndef CME_ARRAY_CHECKED
+#ifdef NDEBUG
+#define CME_ARRAY_CHECKED 0
+#else
+#define CME_ARRAY_CHECKED 1
+#endif
+#endif
+
+/* --------------------------------------------------------------------------
+ * Macro: CME_ARRAY_DECLARE
+ * --------------------------------------------------------------------------
+ *
+ * Description: Declare a fat array type for one element type, carrying its
+ *              length (elements in use) and capacity (elements allocated)
+ *              along with the pointer, and its inline accessors:
+ *
+ *              cme_array_<sfx>_at     Pointer to element `i` (checked only
+ *                                     if `CME_ARRAY_CHECKED`)
+ *              cme_array_<sfx>_range  Pointer to elements [first, first + n)
+ *                                     (always checked, once)
+ *
+ *              A failed check reports the call site and aborts.
+ *
+ * Parameters:
+ *      sfx: Suffix of the type and function names
+ *     type: Element type
+ *
+ * -------------------------------------------------------------------------- */
+#define CME_ARRAY_DECLARE(sfx, type)                                           \
+  typedef struct cme_array_##sfx {                                             \
+    type *data;                                                                \
+    size_t len;                                                                \
+    size_t cap;                                                                \
+  } cme_array_##sfx;                                                           \
+                                                                               \
+  static inline type *cme_array_##sfx##_at_(cme_array_##sfx arr, size_t i,     \
+                                            const char *file, int line) {      \
+    if (CME_ARRAY_CHECKED && i >= arr.len) {                                   \
+      cme_array_out_of_bounds(file, line, i, 1, arr.len);                      \
+    }                                                                          \
+    return arr.data + i;                                                       \
+  }                                                                            \
+                                                                               \
+  static inline type *cme_array_##sfx##_range_(cme_array_##sfx arr,            \
+                                               size_t first, size_t n,         \
+                                               const char *file, int line) {   \
+    if (first > arr.len || n > arr.len - first) {                              \
+      cme_array_out_of_bounds(file, line, first, n, arr.len);                  \
+    }                                                                          \
+    return arr.data + first;                                                   \
+  }
+
+/* Call site reporting front ends of the accessors */
+#define cme_array_at(sfx, arr, i)                                              \
+  cme_array_##sfx##_at_((arr), (i), __FILE__, __LINE__)
+#define cme_array_range(sfx, arr, first, n)                                    \
+  cme_array_##sfx##_range_((arr), (first), (n), __FILE__, __LINE__)
+
+/* ==========================================================================
+ * Function Declarations Section
+ * ========================================================================== */
+
+_Noreturn void cme_array_out_of_bounds(const char *file, int line,
+                                       size_t first, size_t n, size_t len);
+
+/* ==========================================================================
+ * Template Instantiations Section
+ * ========================================================================== */
+
+CME_ARRAY_DECLARE(u8, uint8_t)
+CME_ARRAY_DECLARE(u16, uint16_t)
+CME_ARRAY_DECLARE(u32, uint32_t)
+CME_ARRAY_DECLARE(u64, uint64_t)
+CME_ARRAY_DECLARE(i8, int8_t)
+CME_ARRAY_DECLARE(i16, int16_t)
+CME_ARRAY_DECLARE(i32, int32_t)
+CME_ARRAY_DECLARE(i64, int64_t)
+
+#endif /* CME_ARRAY_H_ */
@@ -0,0 +1,127 @@
+/* ==========================================================================
+ *  Copyright (C) 2026 Ljubomir Kurij <ljubomir_kurij@protonmail.com>
+ *
+ * This file is part of "C Common Memory Errors".
+ *
+ * "C Common Memory Errors" is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * "C Common Memory Errors" is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General
+ * Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with Focus Precision Analyze. If not, see <https://www.gnu.org/licenses/>.
+ * ========================================================================== */
+
+/* ==========================================================================
+ *
+ * 2026-10-18 Ljubomir Kurij <ljubomir_kurij@protonmail.com>
+ *
+ * * cme_fill.c: created.
+ *
+ * ========================================================================== */
+
+/* ==========================================================================
+ * Headers Include Section
+ * ========================================================================== */
+
+/* Related header */
+#include "cme_fill.h"
+
+/* System headers */
+
+/* Standard Library headers */
+#include <string.h>
+
+/* ==========================================================================
+ * Function Definitions Section
+ * ========================================================================== */
+
+/* --------------------------------------------------------------------------
+ * Function: cme_fill_pattern
+ * --------------------------------------------------------------------------
+ *
+ * Description: Fill a block of memory by repeating a pattern, i.e. the
+ *              letters of an alphabet. Same as `cme_fill_cycle` starting at
+ *              the first byte of the pattern.
+ *
+ * Parameters:
+ *         dest: Pointer to the memory block
+ *         size: Size of the memory block in bytes
+ *      pattern: Pointer to the pattern
+ *       period: Length of the pattern in bytes
+ *
+ * Returns: None
+ *
+ * -------------------------------------------------------------------------- */
+void cme_fill_pattern(void *dest, size_t size, const void *pattern,
+                      size_t period) {
+  cme_fill_cycle(dest, size, pattern, period, 0);
+}
+
+/* --------------------------------------------------------------------------
+ * Function: cme_fill_cycle
+ * --------------------------------------------------------------------------
+ *
+ * Description: Fill a block of memory by repeating a pattern, starting at
+ *              the given position in the pattern. The pattern is written
+ *              once and then doubled with `memcpy` until the filled part
+ *              reaches CME_FILL_BLOCK bytes. The rest of the block is filled
+ *              by copying that part over and over. There is no per byte work
+ *              (such as the `i % period` of a naive loop), so the fill runs
+ *              at the speed of `memcpy`.
+ *
+ * Parameters:
+ *         dest: Pointer to the memory block
+ *         size: Size of the memory block in bytes
+ *      pattern: Pointer to the pattern
+ *       period: Length of the pattern in bytes
+ *        phase: Index of the pattern byte to start with
+ *
+ * Returns: None
+ *
+ * -------------------------------------------------------------------------- */
+void cme_fill_cycle(void *dest, size_t size, const void *pattern,
+                    size_t period, size_t phase) {
+  unsigned char *p = dest;
+  const unsigned char *pat = pattern;
+  size_t block = 0;
+  size_t count = 0;
+  size_t done = 0;
+
+  if (0 == size || 0 == period) {
+    return;
+  }
+
+  /* Write one period, rotated to start at the requested phase */
+  phase %= period;
+  count = period - phase < size ? period - phase : size;
+  memcpy(p, pat + phase, count);
+  done = count;
+  if (done < size && 0 < phase) {
+    count = phase < size - done ? phase : size - done;
+    memcpy(p + done, pat, count);
+    done += count;
+  }
+
+  /* Double the filled part. The block stays a multiple of the period, so
+     copies of it continue the cycle seamlessly. */
+  block = done;
+  while (done < size && block < CME_FILL_BLOCK) {
+    count = block < size - done ? block : size - done;
+    memcpy(p + done, p, count);
+    done += count;
+    block = done;
+  }
+
+  /* Stamp the (cache resident) block over the rest of the destination */
+  while (done < size) {
+    count = block < size - done ? block : size - done;
+    memcpy(p + done, p, count);
+    done += count;
+  }
+}
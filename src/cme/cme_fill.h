@@ -0,0 +1,56 @@
+/* ==========================================================================
+ *  Copyright (C) 2026 Ljubomir Kurij <ljubomir_kurij@protonmail.com>
+ *
+ * This file is part of "C Common Memory Errors".
+ *
+ * "C Common Memory Errors" is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * "C Common Memory Errors" is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General
+ * Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with Focus Precision Analyze. If not, see <https://www.gnu.org/licenses/>.
+ * ========================================================================== */
+
+/* ==========================================================================
+ *
+ * 2026-10-18 Ljubomir Kurij <ljubomir_kurij@protonmail.com>
+ *
+ * * cme_fill.h: created.
+ *
+ * ========================================================================== */
+
+#ifndef CME_FILL_H_
+#define CME_FILL_H_
+
+/* ==========================================================================
+ * Headers Include Section
+ * ========================================================================== */
+
+/* Standard Library headers */
+#include <stddef.h>
+
+/* ==========================================================================
+ * Macros Definitions Section
+ * ========================================================================== */
+
+/* Once the pattern has been doubled up to this size, the block is copied
+   over and over instead of doubling further, so the source of the copies
+   stays in L1 cache however big the destination is */
+#define CME_FILL_BLOCK ((size_t)16 << 10)
+
+/* ==========================================================================
+ * Function Declarations Section
+ * ========================================================================== */
+
+void cme_fill_pattern(void *dest, size_t size, const void *pattern,
+                      size_t period);
+void cme_fill_cycle(void *dest, size_t size, const void *pattern,
+                    size_t period, size_t phase);
+
+#endif /* CME_FILL_H_ */
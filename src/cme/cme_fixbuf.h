@@ -0,0 +1,136 @@
+/* ==========================================================================
+ *  Copyright (C) 2026 Ljubomir Kurij <ljubomir_kurij@protonmail.com>
+ *
+ * This file is part of "C Common Memory Errors".
+ *
+ * "C Common Memory Errors" is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * "C Common Memory Errors" is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General
+ * Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with Focus Precision Analyze. If not, see <https://www.gnu.org/licenses/>.
+ * ========================================================================== */
+
+/* ==========================================================================
+ *
+ * 2026-10-18 Ljubomir Kurij <ljubomir_kurij@protonmail.com>
+ *
+ * * cme_fixbuf.h: created.
+ *
+ * ========================================================================== */
+
+#ifndef CME_FIXBUF_H_
+#define CME_FIXBUF_H_
+
+/* ==========================================================================
+ * Headers Include Section
+ * ========================================================================== */
+
+/* Standard Library headers */
+#include <stddef.h>
+#include <string.h>
+
+/* Project headers */
+#include "cme_string.h"
+
+/* ==========================================================================
+ * Macros Definitions Section
+ * ========================================================================== */
+
+/* --------------------------------------------------------------------------
+ * Fixed buffer writes
+ * --------------------------------------------------------------------------
+ *
+ * The macros below take the destination as an array, so its size travels
+ * with it through `sizeof` instead of getting lost when it decays into a
+ * pointer. Writes whose size is known at compile time (string literals) are
+ * checked with `_Static_assert` and do not compile if they do not fit:
+ *
+ *     char message[10] = "";
+ *     CME_FIXBUF_STRCPY(message, "ABCDEFGHIJKLMNOPQRSTUVWXYZ");
+ *     // error: static assertion failed: "destination array is too small"
+ *
+ * Writes whose size is only known at run time go through one inlined bounds
+ * check. When the size is a constant after all, the compiler folds the check
+ * away, so checked writes cost nothing in optimized builds.
+ *
+ * With GCC and Clang, passing a pointer instead of an array is a compile
+ * time error as well. Other compilers can not detect it.
+ * -------------------------------------------------------------------------- */
+
+#if defined(__GNUC__) || defined(__clang__)
+#define CME_FIXBUF_IS_ARRAY(buf)                                               \
+  (!__builtin_types_compatible_p(__typeof__(buf), __typeof__(&(buf)[0])))
+#else
+#define CME_FIXBUF_IS_ARRAY(buf) 1
+#endif /* End of compiler specific macro definition */
+
+/* Size of the destination array, rejecting pointers at compile time */
+#define CME_FIXBUF_SIZE(buf)                                                   \
+  (sizeof(buf) + 0 * sizeof(struct {                                           \
+     _Static_assert(CME_FIXBUF_IS_ARRAY(buf),                                  \
+                    "destination must be an array, not a pointer");            \
+     int dummy;                                                                \
+   }))
+
+/* Copy a string literal (terminator included) into an array */
+#define CME_FIXBUF_STRCPY(buf, lit)                                            \
+  do {                                                                         \
+    _Static_assert(CME_FIXBUF_SIZE(buf) >= sizeof("" lit ""),                  \
+                   "destination array is too small");                          \
+    memcpy((buf), "" lit "", sizeof(lit));                                     \
+  } while (0)
+
+/* Copy a run time string into an array, truncating it if it does not fit.
+   Evaluates to the length of the source string. */
+#define CME_FIXBUF_STRLCPY(buf, src)                                           \
+  cme_strlcpy((buf), (src), CME_FIXBUF_SIZE(buf))
+
+/* Copy `n` bytes into an array at the given offset. Nothing is written if
+   the bytes do not fit. Evaluates to zero on success, or -1 otherwise. */
+#define CME_FIXBUF_WRITE(buf, offset, src, n)                                  \
+  cme_fixbuf_write((buf), CME_FIXBUF_SIZE(buf), (offset), (src), (n))
+
+/* Wrap an array into an empty counted string of the same capacity */
+#define CME_FIXBUF_STR(buf) cme_str_wrap((buf), CME_FIXBUF_SIZE(buf))
+
+/* ==========================================================================
+ * Inline Function Definitions Section
+ * ========================================================================== */
+
+/* --------------------------------------------------------------------------
+ * Function: cme_fixbuf_write
+ * --------------------------------------------------------------------------
+ *
+ * Description: Bounds checked copy into a buffer of known capacity. Use it
+ *              through the `CME_FIXBUF_WRITE` macro.
+ *
+ * Parameters:
+ *       buf: Pointer to the destination buffer
+ *       cap: Capacity of the destination buffer in bytes
+ *    offset: Offset of the first byte to write
+ *       src: Pointer to the source bytes
+ *         n: Number of bytes to write
+ *
+ * Returns: Zero on success, or -1 if the write would go out of bounds
+ *
+ * -------------------------------------------------------------------------- */
+static inline int cme_fixbuf_write(void *buf, size_t cap, size_t offset,
+                                   const void *src, size_t n) {
+  /* Single check, written so it can not overflow */
+  if (n > cap || offset > cap - n) {
+    return -1;
+  }
+
+  memcpy((char *)buf + offset, src, n);
+
+  return 0;
+}
+
+#endif /* CME_FIXBUF_H_ */
@@ -0,0 +1,220 @@
+/* ==========================================================================
+ *  Copyright (C) 2026 Ljubomir Kurij <ljubomir_kurij@protonmail.com>
+ *
+ * This file is part of "C Common Memory Errors".
+ *
+ * "C Common Memory Errors" is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * "C Common Memory Errors" is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General
+ * Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with Focus Precision Analyze. If not, see <https://www.gnu.org/licenses/>.
+ * ========================================================================== */
+
+/* ==========================================================================
+ *
+ * 2026-10-18 Ljubomir Kurij <ljubomir_kurij@protonmail.com>
+ *
+ * * cme_frees.c: created.
+ *
+ * ========================================================================== */
+
+/* ==========================================================================
+ * Headers Include Section
+ * ========================================================================== */
+
+/* Related header */
+#include "cme_frees.h"
+
+/* System headers */
+
+/* Standard Library headers */
+#include <stdio.h>
+#include <string.h>
+
+/* Project headers */
+#include "cme_alloc.h"
+
+/* ==========================================================================
+ * Function Definitions Section
+ * ========================================================================== */
+
+/* --------------------------------------------------------------------------
+ * Function: cme_even_or_blank
+ * --------------------------------------------------------------------------
+ *
+ * Description: Return a string representation of an even number or an empty
+ *              string for an odd number. If the number is too large (>= 100),
+ *              return an NULL reference, and set the error message. Every
+ *              string returned is allocated, so the caller can release all of
+ *              them the same way.
+ *
+ * Parameters:
+ *        i: Integer number to check
+ *      err: Receives the error message, or NULL if there is none
+ *
+ * Returns: String representation of the number or an empty string (release
+ *          it with `cme_free`), or NULL if the number is too large
+ *
+ * -------------------------------------------------------------------------- */
+char *cme_even_or_blank(int i, char **err) {
+  char buf[12] = ""; // big enough for any int + null terminator
+
+  *err = NULL;
+  if (i >= 100) {
+    *err = "Sorry, this number is too large.";
+    return NULL;
+  }
+
+  if (i % 2 == 0) {
+    snprintf(buf, sizeof(buf), "%d", i);
+    return cme_strdup(buf);
+  } else {
+    return cme_strdup("");
+  }
+}
+
+/* --------------------------------------------------------------------------
+ * Function: cme_even_or_blank_buggy
+ * --------------------------------------------------------------------------
+ *
+ * Description: Same as `cme_even_or_blank`, as first written: the function
+ *              returns a reference to allocated memory when the input number
+ *              is even, and a reference to a read-only string literal when
+ *              the number is odd or too large. A caller freeing every string
+ *              it gets frees a string literal.
+ *
+ * Parameters:
+ *        i: Integer number to check
+ *      err: Receives the error message, or NULL if there is none
+ *
+ * Returns: Allocated string representation of an even number, a string
+ *          literal otherwise
+ *
+ * -------------------------------------------------------------------------- */
+char *cme_even_or_blank_buggy(int i, char **err) {
+  char buf[12] = ""; // big enough for any int + null terminator
+
+  *err = NULL;
+  if (i >= 100) {
+    return "Sorry, this number is too large.";
+  }
+
+  if (i % 2 == 0) {
+    snprintf(buf, sizeof(buf), "%d", i);
+    return cme_strdup(buf);
+  } else {
+    return "";
+  }
+}
+
+/* --------------------------------------------------------------------------
+ * Function: cme_get_odds
+ * --------------------------------------------------------------------------
+ *
+ * Description: Return an array of odd numbers up to a given number. The
+ *              numbers are stored in the narrowest integer type that holds
+ *              them (i.e. one byte each for numbers up to 255). The function
+ *              returns a sequence that owns allocated memory. It is up to the
+ *              caller to free the memory when done with it.
+ *
+ * Parameters:
+ *      highest: Highest number to return
+ *
+ * Returns: Sequence of odd numbers (empty if there are none)
+ *
+ * -------------------------------------------------------------------------- */
+cme_seq cme_get_odds(int highest) {
+  cme_seq odds = {CME_INT_U8, NULL, 0, 0};
+
+  if (0 < highest) {
+    odds = cme_seq_odds((uint64_t)highest);
+  }
+
+  return odds;
+}
+
+/* --------------------------------------------------------------------------
+ * Function: cme_splitter
+ * --------------------------------------------------------------------------
+ *
+ * Description: Split a string into two parts: prefix and suffix. The input
+ *              is copied, and the first dash character of the copy replaced
+ *              with a null terminator. Both parts point into the same
+ *              allocated block, so only the prefix is to be freed. The suffix
+ *              is left untouched if there is no dash.
+ *
+ * Parameters:
+ *      input: Input string to split
+ *     prefix: Pointer to store the prefix part of the string
+ *     suffix: Pointer to store the suffix part of the string
+ *
+ * Returns: None
+ *
+ * -------------------------------------------------------------------------- */
+void cme_splitter(const char *input, char **prefix, char **suffix) {
+  char *copied = NULL;
+
+  copied = cme_strdup(input);
+  if (copied) {
+    *prefix = copied;
+    while (*copied) {
+      if (*copied == '-') {
+        *copied = '\0';
+        *suffix = copied + 1;
+        break;
+      }
+      copied++;
+    }
+  }
+}
+
+/* --------------------------------------------------------------------------
+ * Function: cme_fix_amp
+ * --------------------------------------------------------------------------
+ *
+ * Description: Fix ampersands in a string by double-encoding them.
+ *
+ * Parameters:
+ *     src: Pointer to the source string
+ *
+ * Returns: Pointer to the fixed string (release it with `cme_free`), or NULL
+ *          if the allocation failed
+ *
+ * -------------------------------------------------------------------------- */
+char *cme_fix_amp(const char *src) {
+  char *fixed = NULL;
+  int i = 0;
+  int new_len = 0;
+
+  for (i = 0; src[i] != '\0'; i++) {
+    if (src[i] == '&') {
+      new_len += 5;
+    } else {
+      new_len++;
+    }
+  }
+
+  fixed = cme_calloc(new_len + 1, sizeof(char));
+  if (fixed) {
+    int j = 0;
+    for (i = 0; src[i] != '\0'; i++) {
+      if (src[i] == '&') {
+        memcpy(fixed + j, "&amp;", 5);
+        j += 5;
+      } else {
+        fixed[j] = src[i];
+        j++;
+      }
+    }
+    fixed[j] = '\0';
+  }
+
+  return fixed;
+}
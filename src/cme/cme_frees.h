@@ -0,0 +1,52 @@
+/* ==========================================================================
+ *  Copyright (C) 2026 Ljubomir Kurij <ljubomir_kurij@protonmail.com>
+ *
+ * This file is part of "C Common Memory Errors".
+ *
+ * "C Common Memory Errors" is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * "C Common Memory Errors" is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General
+ * Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with Focus Precision Analyze. If not, see <https://www.gnu.org/licenses/>.
+ * ========================================================================== */
+
+/* ==========================================================================
+ *
+ * 2026-10-18 Ljubomir Kurij <ljubomir_kurij@protonmail.com>
+ *
+ * * cme_frees.h: created.
+ *
+ * ========================================================================== */
+
+#ifndef CME_FREES_H_
+#define CME_FREES_H_
+
+/* ==========================================================================
+ * Headers Include Section
+ * ========================================================================== */
+
+/* Project headers */
+#include "cme_seq.h"
+
+/* ==========================================================================
+ * Function Declarations Section
+ * ========================================================================== */
+
+/* Routines of the invalid frees demo and exercise. The `_buggy` variants
+   keep the error the demo is about, so they are only safe to call under a
+   memory checker. */
+
+char *cme_even_or_blank(int i, char **err);
+char *cme_even_or_blank_buggy(int i, char **err);
+cme_seq cme_get_odds(int highest);
+void cme_splitter(const char *input, char **prefix, char **suffix);
+char *cme_fix_amp(const char *src);
+
+#endif /* CME_FREES_H_ */
@@ -0,0 +1,167 @@
+/* ==========================================================================
+ *  Copyright (C) 2026 Ljubomir Kurij <ljubomir_kurij@protonmail.com>
+ *
+ * This file is part of "C Common Memory Errors".
+ *
+ * "C Common Memory Errors" is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * "C Common Memory Errors" is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General
+ * Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with Focus Precision Analyze. If not, see <https://www.gnu.org/licenses/>.
+ * ========================================================================== */
+
+/* ==========================================================================
+ *
+ * 2026-10-18 Ljubomir Kurij <ljubomir_kurij@protonmail.com>
+ *
+ * * cme_gen_powers.c: created.
+ *
+ * ========================================================================== */
+
+/* ==========================================================================
+ * Headers Include Section
+ * ========================================================================== */
+
+/* Related header */
+
+/* System headers */
+
+/* Standard Library headers */
+#include <inttypes.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+/* ==========================================================================
+ * Macros Definitions Section
+ * ========================================================================== */
+
+#define APP_NAME "cme_gen_powers"
+
+/* ==========================================================================
+ * Global Variables Section
+ * ========================================================================== */
+
+/* Bases that get a precomputed table of powers */
+static const unsigned kBases[] = {2, 3, 5, 7, 10};
+
+/* ==========================================================================
+ * User Defined Function Declarations Section
+ * ========================================================================== */
+
+static void write_table(FILE *f, const char *suffix, const char *type,
+                        const char *literal, unsigned base, uint64_t max);
+static void write_index(FILE *f, const char *suffix);
+
+/* ==========================================================================
+ * Main Function Section
+ * ========================================================================== */
+
+int main(int argc, char **argv) {
+  const size_t num_bases = sizeof(kBases) / sizeof(kBases[0]);
+  FILE *f = NULL;
+  size_t i = 0;
+
+  if (2 != argc) {
+    fprintf(stderr, "Usage: %s OUTPUT_FILE\n", APP_NAME);
+    return EXIT_FAILURE;
+  }
+
+  f = fopen(argv[1], "w");
+  if (NULL == f) {
+    fprintf(stderr, "%s: Can not open %s for writing\n", APP_NAME, argv[1]);
+    return EXIT_FAILURE;
+  }
+
+  fprintf(f, "/* Generated by %s at build time. Do not edit. */\n\n", APP_NAME);
+  fprintf(f, "#include \"cme_powers.h\"\n\n");
+
+  for (i = 0; i < num_bases; i++) {
+    write_table(f, "i32", "int32_t", "", kBases[i], INT32_MAX);
+    write_table(f, "i64", "int64_t", "INT64_C", kBases[i], INT64_MAX);
+    write_table(f, "u64", "uint64_t", "UINT64_C", kBases[i], UINT64_MAX);
+  }
+
+  write_index(f, "i32");
+  write_index(f, "i64");
+  write_index(f, "u64");
+  fprintf(f, "const size_t cme_powers_num_tables = %zu;\n", num_bases);
+
+  if (0 != fclose(f)) {
+    fprintf(stderr, "%s: Error writing %s\n", APP_NAME, argv[1]);
+    return EXIT_FAILURE;
+  }
+
+  return EXIT_SUCCESS;
+}
+
+/* ==========================================================================
+ * User Defined Function Definitions Section
+ * ========================================================================== */
+
+/* --------------------------------------------------------------------------
+ * Function: write_table
+ * --------------------------------------------------------------------------
+ *
+ * Description: Write the array of all powers of a base (starting from the
+ *              zeroth) that do not exceed the maximum of the element type.
+ *
+ * Parameters:
+ *            f: Output file
+ *       suffix: Suffix of the element type used in the names
+ *         type: Element type
+ *      literal: Macro used to spell out the values (can be empty)
+ *         base: Base of the powers
+ *          max: Maximum value of the element type
+ *
+ * Returns: None
+ *
+ * -------------------------------------------------------------------------- */
+static void write_table(FILE *f, const char *suffix, const char *type,
+                        const char *literal, unsigned base, uint64_t max) {
+  uint64_t value = 1;
+
+  fprintf(f, "static const %s kPowers_%s_%u[] = {\n", type, suffix, base);
+  for (;;) {
+    fprintf(f, "    %s(%" PRIu64 "),\n", literal, value);
+    if (value > max / base) {
+      break;
+    }
+    value *= base;
+  }
+  fprintf(f, "};\n\n");
+}
+
+/* --------------------------------------------------------------------------
+ * Function: write_index
+ * --------------------------------------------------------------------------
+ *
+ * Description: Write the array of table descriptors for one element type
+ *
+ * Parameters:
+ *            f: Output file
+ *       suffix: Suffix of the element type used in the names
+ *
+ * Returns: None
+ *
+ * -------------------------------------------------------------------------- */
+static void write_index(FILE *f, const char *suffix) {
+  const size_t num_bases = sizeof(kBases) / sizeof(kBases[0]);
+  size_t i = 0;
+
+  fprintf(f, "const cme_powers_table cme_powers_tables_%s[] = {\n", suffix);
+  for (i = 0; i < num_bases; i++) {
+    fprintf(f, "    {%u, sizeof(kPowers_%s_%u) / sizeof(kPowers_%s_%u[0]), "
+               "kPowers_%s_%u},\n",
+            kBases[i], suffix, kBases[i], suffix, kBases[i], suffix,
+            kBases[i]);
+  }
+  fprintf(f, "};\n\n");
+}
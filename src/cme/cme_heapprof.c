@@ -0,0 +1,962 @@
+/* ==========================================================================
+ *  Copyright (C) 2026 Ljubomir Kurij <ljubomir_kurij@protonmail.com>
+ *
+ * This file is part of "C Common Memory Errors".
+ *
+ * "C Common Memory Errors" is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * "C Common Memory Errors" is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General
+ * Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with Focus Precision Analyze. If not, see <https://www.gnu.org/licenses/>.
+ * ========================================================================== */
+
+/* ==========================================================================
+ *
+ * 2026-10-18 Ljubomir Kurij <ljubomir_kurij@protonmail.com>
+ *
+ * * cme_heapprof.c: created.
+ *
+ * ========================================================================== */
+
+/* ==========================================================================
+ * Headers Include Section
+ * ========================================================================== */
+
+/* For `pthread_getattr_np` (bounds of the stack walk) */
+#define _GNU_SOURCE
+
+/* Related header */
+#include "cme_heapprof.h"
+
+/* System headers */
+#if (defined(__unix__) || defined(__APPLE__)) &&                              \
+    defined(CME_HAVE_PTHREADS) && !defined(__STDC_NO_ATOMICS__)
+#define CME_HAVE_HEAPPROF 1
+#include <fcntl.h>
+#include <pthread.h>
+#include <sched.h>
+#include <signal.h>
+#include <stdatomic.h>
+#include <unistd.h>
+#endif /* End of platform specific headers */
+
+#if defined(CME_HAVE_HEAPPROF) && defined(__GLIBC__) &&                       \
+    (defined(__x86_64__) || defined(__aarch64__))
+#define CME_HEAPPROF_FRAME_WALK 1 /* Needs `-fno-omit-frame-pointer` */
+#elif defined(CME_HAVE_HEAPPROF) && (defined(__GLIBC__) || defined(__APPLE__))
+#define CME_HEAPPROF_BACKTRACE 1
+#include <execinfo.h>
+#endif /* End of stack walk headers */
+
+/* Standard Library headers */
+#include <errno.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+/* Project headers */
+#include "cme_alloc.h"
+
+#ifdef CME_HAVE_HEAPPROF
+
+/* ==========================================================================
+ * Macros Definitions Section
+ * ========================================================================== */
+
+/* Slots of the hash tables: twice the entries, so the probes stay short */
+#define PROF_STACK_SLOTS (2 * CME_HEAPPROF_MAX_STACKS)
+#define PROF_SAMPLE_SLOTS (2 * CME_HEAPPROF_MAX_SAMPLES)
+
+/* Counters of the sample filter (a power of two). A free looks its block up
+   in the samples only if the counter of its hash is nonzero, so most frees
+   never take the lock. */
+#define PROF_FILTER_SIZE ((size_t)1 << 16)
+
+/* Bytes of a profile written at a time */
+#define PROF_WRITE_BUFFER 4096
+
+/* Longest file name prefix */
+#define PROF_PREFIX_SIZE 256
+
+/* Signal that makes the profiler write a profile */
+#define PROF_SIGNAL SIGUSR2
+
+/* Profiler states */
+#define PROF_UNSET 0 /* Environment not read yet */
+#define PROF_OFF 1
+#define PROF_ON 2
+
+/* ==========================================================================
+ * Type Definitions Section
+ * ========================================================================== */
+
+/* Sampled allocations that share a stack */
+typedef struct prof_bucket {
+  uint64_t hash;
+  size_t depth;
+  uintptr_t pcs[CME_HEAPPROF_MAX_DEPTH];
+  uint64_t live_count;  /* Sampled blocks still live */
+  uint64_t live_bytes;
+  uint64_t alloc_count; /* Sampled blocks ever allocated */
+  uint64_t alloc_bytes;
+} prof_bucket;
+
+/* A live sampled block */
+typedef struct prof_sample {
+  const void *ptr; /* NULL for an empty slot */
+  size_t size;
+  uint32_t bucket;
+} prof_sample;
+
+/* A profile being written (with `write` only, so it works in a signal
+   handler) */
+typedef struct prof_writer {
+  int fd;
+  int failed;
+  size_t len;
+  char buf[PROF_WRITE_BUFFER];
+} prof_writer;
+
+/* ==========================================================================
+ * Private Function Declarations Section
+ * ========================================================================== */
+
+static void prof_lock(void);
+static void prof_unlock(void);
+static int prof_setup(const char *prefix, size_t rate);
+static void prof_at_exit(void);
+static void prof_on_signal(int signal_number);
+static int64_t prof_next_interval(void);
+static double prof_log2(double x);
+static size_t prof_stack(uintptr_t *pcs, void *frame);
+static uint32_t prof_bucket_of(const uintptr_t *pcs, size_t depth);
+static size_t prof_filter_index(const void *ptr);
+static size_t prof_sample_home(const void *ptr);
+static int prof_write_profile(char *path, size_t path_size);
+static void out_flush(prof_writer *out);
+static void out_str(prof_writer *out, const char *str);
+static void out_u64(prof_writer *out, uint64_t value);
+static void out_hex(prof_writer *out, uint64_t value);
+
+/* ==========================================================================
+ * Global Variables Section
+ * ========================================================================== */
+
+/* Taken for samples, frees of sampled blocks and profiles. A spin lock, so
+   the signal handler can try it. */
+static atomic_flag g_lock = ATOMIC_FLAG_INIT;
+
+static atomic_int g_state = PROF_UNSET;
+static size_t g_rate = CME_HEAPPROF_DEFAULT_RATE;
+static char g_prefix[PROF_PREFIX_SIZE];
+static atomic_uint g_profiles = 0; /* Profiles written so far */
+static uint64_t g_dropped = 0;     /* Samples over the limits */
+
+static prof_bucket *g_buckets = NULL;
+static uint32_t g_num_buckets = 0;
+static uint32_t *g_stack_slots = NULL; /* Bucket index plus one */
+static prof_sample *g_samples = NULL;
+static size_t g_num_samples = 0;
+static atomic_uint *g_filter = NULL;
+
+/* Random state of the sampling intervals, and bounds of the stack (per
+   thread) */
+static _Thread_local uint64_t t_random = 0;
+#ifdef CME_HEAPPROF_FRAME_WALK
+static _Thread_local uintptr_t t_stack_low = 0;
+static _Thread_local uintptr_t t_stack_high = 0;
+#endif
+
+#endif /* CME_HAVE_HEAPPROF */
+
+/* ==========================================================================
+ * Function Definitions Section
+ * ========================================================================== */
+
+/* --------------------------------------------------------------------------
+ * Function: cme_heapprof_start
+ * --------------------------------------------------------------------------
+ *
+ * Description: Start the sampling heap profiler, as setting `CME_HEAPPROF`
+ *              would. Every `rate` bytes allocated on average (exponentially
+ *              distributed, so every byte is equally likely to be sampled),
+ *              the allocation is sampled: its stack is recorded, and it is
+ *              counted live until freed. A profile of the live samples, in
+ *              the heap profile format of gperftools that `pprof` reads, is
+ *              written at exit and on SIGUSR2.
+ *
+ * Parameters:
+ *      prefix: Path prefix of the profiles (PREFIX.PID.N.heap)
+ *        rate: Mean bytes between samples (0 for the default)
+ *
+ * Returns: 0 on success, -1 if the profiler is not supported here or out of
+ *          memory
+ *
+ * -------------------------------------------------------------------------- */
+int cme_heapprof_start(const char *prefix, size_t rate) {
+#ifdef CME_HAVE_HEAPPROF
+  int status = 0;
+
+  cme_alloc_watch();
+  prof_lock();
+  status = prof_setup(prefix, rate);
+  prof_unlock();
+
+  return status;
+#else
+  (void)prefix;
+  (void)rate;
+
+  return -1;
+#endif /* End of platform specific code */
+}
+
+/* --------------------------------------------------------------------------
+ * Function: cme_heapprof_dump
+ * --------------------------------------------------------------------------
+ *
+ * Description: Write a profile of the sampled blocks live now, and report
+ *              its name on `stderr`
+ *
+ * Parameters: None
+ *
+ * Returns: 0 on success, -1 if the profiler is off or the file can not be
+ *          written
+ *
+ * -------------------------------------------------------------------------- */
+int cme_heapprof_dump(void) {
+#ifdef CME_HAVE_HEAPPROF
+  char path[PROF_PREFIX_SIZE + 48];
+  int status = -1;
+
+  if (PROF_ON != atomic_load(&g_state)) {
+    return -1;
+  }
+
+  prof_lock();
+  status = prof_write_profile(path, sizeof(path));
+  prof_unlock();
+
+  if (0 == status) {
+    fprintf(stderr, "cme_heapprof: wrote %s\n", path);
+  } else {
+    fprintf(stderr, "cme_heapprof: can not write %s\n", path);
+  }
+
+  return status;
+#else
+  return -1;
+#endif /* End of platform specific code */
+}
+
+/* --------------------------------------------------------------------------
+ * Function: cme_heapprof_sample
+ * --------------------------------------------------------------------------
+ *
+ * Description: Called by the allocator when a thread has allocated past
+ *              its sampling point: sample the block that crossed it. The
+ *              first call reads the environment. The recorded stack starts
+ *              in the allocator (`cme_malloc_at` and the like).
+ *
+ * Parameters:
+ *       ptr: The block that crossed the sampling point
+ *      size: Its size
+ *
+ * Returns: Bytes the thread may allocate before its next sample
+ *
+ * -------------------------------------------------------------------------- */
+int64_t cme_heapprof_sample(void *ptr, size_t size) {
+#ifdef CME_HAVE_HEAPPROF
+  uintptr_t pcs[CME_HEAPPROF_MAX_DEPTH];
+  const char *value = NULL;
+  size_t depth = 0;
+  size_t slot = 0;
+  uint32_t bucket = 0;
+
+  if (PROF_UNSET == atomic_load_explicit(&g_state, memory_order_acquire)) {
+    prof_lock();
+    if (PROF_UNSET == atomic_load(&g_state)) {
+      value = getenv(CME_HEAPPROF_ENV);
+      if (value && '\0' != *value) {
+        const char *rate = getenv(CME_HEAPPROF_RATE_ENV);
+
+        prof_setup(value, rate ? (size_t)strtoull(rate, NULL, 10) : 0);
+      } else {
+        atomic_store(&g_state, PROF_OFF);
+      }
+    }
+    prof_unlock();
+  }
+  if (PROF_ON != atomic_load_explicit(&g_state, memory_order_acquire)) {
+    return (int64_t)CME_HEAPPROF_DEFAULT_RATE; /* Look again later */
+  }
+
+  /* The stack is taken before the lock */
+  depth = prof_stack(pcs, __builtin_frame_address(0));
+
+  prof_lock();
+  bucket = prof_bucket_of(pcs, depth);
+  if (UINT32_MAX == bucket || CME_HEAPPROF_MAX_SAMPLES <= g_num_samples) {
+    g_dropped++;
+  } else {
+    for (slot = prof_sample_home(ptr); NULL != g_samples[slot].ptr;
+         slot = (slot + 1) & (PROF_SAMPLE_SLOTS - 1)) {
+    }
+    g_samples[slot].ptr = ptr;
+    g_samples[slot].size = size;
+    g_samples[slot].bucket = bucket;
+    g_num_samples++;
+    atomic_fetch_add_explicit(&g_filter[prof_filter_index(ptr)], 1,
+                              memory_order_relaxed);
+    g_buckets[bucket].live_count++;
+    g_buckets[bucket].live_bytes += size;
+    g_buckets[bucket].alloc_count++;
+    g_buckets[bucket].alloc_bytes += size;
+  }
+  prof_unlock();
+
+  return prof_next_interval();
+#else
+  (void)ptr;
+  (void)size;
+
+  return INT64_MAX / 2;
+#endif /* End of platform specific code */
+}
+
+/* --------------------------------------------------------------------------
+ * Function: cme_heapprof_forget
+ * --------------------------------------------------------------------------
+ *
+ * Description: Called by the allocator before a block is freed: if the
+ *              block was sampled, it is no longer live. Blocks that were not
+ *              sampled (nearly all) are told apart by the sample filter,
+ *              without the lock.
+ *
+ * Parameters:
+ *      ptr: Block about to be freed
+ *
+ * Returns: None
+ *
+ * -------------------------------------------------------------------------- */
+void cme_heapprof_forget(const void *ptr) {
+#ifdef CME_HAVE_HEAPPROF
+  size_t slot = 0;
+  size_t next = 0;
+  size_t home = 0;
+  prof_bucket *bucket = NULL;
+
+  if (NULL == g_filter ||
+      0 == atomic_load_explicit(&g_filter[prof_filter_index(ptr)],
+                                memory_order_relaxed)) {
+    return;
+  }
+
+  prof_lock();
+  for (slot = prof_sample_home(ptr); NULL != g_samples[slot].ptr;
+       slot = (slot + 1) & (PROF_SAMPLE_SLOTS - 1)) {
+    if (ptr != g_samples[slot].ptr) {
+      continue;
+    }
+    bucket = &g_buckets[g_samples[slot].bucket];
+    bucket->live_count--;
+    bucket->live_bytes -= g_samples[slot].size;
+    atomic_fetch_sub_explicit(&g_filter[prof_filter_index(ptr)], 1,
+                              memory_order_relaxed);
+    g_num_samples--;
+
+    /* Shift the following entries back into the hole (no tombstones) */
+    g_samples[slot].ptr = NULL;
+    for (next = (slot + 1) & (PROF_SAMPLE_SLOTS - 1);
+         NULL != g_samples[next].ptr;
+         next = (next + 1) & (PROF_SAMPLE_SLOTS - 1)) {
+      home = prof_sample_home(g_samples[next].ptr);
+      if (((next - home) & (PROF_SAMPLE_SLOTS - 1)) >=
+          ((next - slot) & (PROF_SAMPLE_SLOTS - 1))) {
+        g_samples[slot] = g_samples[next];
+        g_samples[next].ptr = NULL;
+        slot = next;
+      }
+    }
+    break;
+  }
+  prof_unlock();
+#else
+  (void)ptr;
+#endif /* End of platform specific code */
+}
+
+#ifdef CME_HAVE_HEAPPROF
+
+/* ==========================================================================
+ * Private Function Definitions Section
+ * ========================================================================== */
+
+/* --------------------------------------------------------------------------
+ * Function: prof_lock
+ * --------------------------------------------------------------------------
+ *
+ * Description: Take the profiler lock (spinning; it is held briefly)
+ *
+ * Parameters: None
+ *
+ * Returns: None
+ *
+ * -------------------------------------------------------------------------- */
+static void prof_lock(void) {
+  while (atomic_flag_test_and_set_explicit(&g_lock, memory_order_acquire)) {
+    sched_yield();
+  }
+}
+
+/* --------------------------------------------------------------------------
+ * Function: prof_unlock
+ * --------------------------------------------------------------------------
+ *
+ * Description: Release the profiler lock
+ *
+ * Parameters: None
+ *
+ * Returns: None
+ *
+ * -------------------------------------------------------------------------- */
+static void prof_unlock(void) {
+  atomic_flag_clear_explicit(&g_lock, memory_order_release);
+}
+
+/* --------------------------------------------------------------------------
+ * Function: prof_setup
+ * --------------------------------------------------------------------------
+ *
+ * Description: Allocate the tables of the profiler, have it write profiles
+ *              at exit and on SIGUSR2 (unless the program handles that
+ *              signal itself), and turn it on. Called with the lock held.
+ *
+ * Parameters:
+ *      prefix: Path prefix of the profiles
+ *        rate: Mean bytes between samples (0 for the default)
+ *
+ * Returns: 0 on success, -1 if out of memory
+ *
+ * -------------------------------------------------------------------------- */
+static int prof_setup(const char *prefix, size_t rate) {
+  struct sigaction action;
+  struct sigaction previous;
+
+  snprintf(g_prefix, sizeof(g_prefix), "%s", prefix);
+  g_rate = 0 < rate ? rate : CME_HEAPPROF_DEFAULT_RATE;
+  if (PROF_ON == atomic_load(&g_state)) {
+    return 0;
+  }
+
+  /* The tables come from the system allocator, which is not sampled */
+  g_buckets = calloc(CME_HEAPPROF_MAX_STACKS, sizeof(prof_bucket));
+  g_stack_slots = calloc(PROF_STACK_SLOTS, sizeof(uint32_t));
+  g_samples = calloc(PROF_SAMPLE_SLOTS, sizeof(prof_sample));
+  g_filter = calloc(PROF_FILTER_SIZE, sizeof(atomic_uint));
+  if (NULL == g_buckets || NULL == g_stack_slots || NULL == g_samples ||
+      NULL == g_filter) {
+    free(g_buckets);
+    free(g_stack_slots);
+    free(g_samples);
+    free((void *)g_filter);
+    g_filter = NULL;
+    atomic_store(&g_state, PROF_OFF);
+    fprintf(stderr, "cme_heapprof: no memory for the profiler\n");
+    return -1;
+  }
+
+  atexit(prof_at_exit);
+  memset(&action, 0, sizeof(action));
+  action.sa_handler = prof_on_signal;
+  action.sa_flags = SA_RESTART;
+  sigemptyset(&action.sa_mask);
+  if (0 == sigaction(PROF_SIGNAL, NULL, &previous) &&
+      SIG_DFL == previous.sa_handler) {
+    sigaction(PROF_SIGNAL, &action, NULL);
+  }
+  atomic_store(&g_state, PROF_ON);
+
+  return 0;
+}
+
+/* --------------------------------------------------------------------------
+ * Function: prof_at_exit
+ * --------------------------------------------------------------------------
+ *
+ * Description: Write the last profile at exit
+ *
+ * Parameters: None
+ *
+ * Returns: None
+ *
+ * -------------------------------------------------------------------------- */
+static void prof_at_exit(void) {
+  if (0 < g_dropped) {
+    fprintf(stderr,
+            "cme_heapprof: %llu samples dropped (more than %d stacks or %d "
+            "live samples)\n",
+            (unsigned long long)g_dropped, CME_HEAPPROF_MAX_STACKS,
+            CME_HEAPPROF_MAX_SAMPLES);
+  }
+  cme_heapprof_dump();
+}
+
+/* --------------------------------------------------------------------------
+ * Function: prof_on_signal
+ * --------------------------------------------------------------------------
+ *
+ * Description: Write a profile on SIGUSR2. Only async signal safe calls are
+ *              made; if the signal interrupted a thread holding the lock
+ *              the profile is skipped.
+ *
+ * Parameters:
+ *      signal_number: The signal
+ *
+ * Returns: None
+ *
+ * -------------------------------------------------------------------------- */
+static void prof_on_signal(int signal_number) {
+  char path[PROF_PREFIX_SIZE + 48];
+  int saved_errno = errno;
+
+  (void)signal_number;
+  if (!atomic_flag_test_and_set_explicit(&g_lock, memory_order_acquire)) {
+    prof_write_profile(path, sizeof(path));
+    prof_unlock();
+  }
+  errno = saved_errno;
+}
+
+/* --------------------------------------------------------------------------
+ * Function: prof_next_interval
+ * --------------------------------------------------------------------------
+ *
+ * Description: Bytes until the next sample of the calling thread: drawn
+ *              from an exponential distribution of mean `g_rate`, which
+ *              makes sampling a Poisson process over the allocated bytes
+ *              (what `pprof` assumes when it scales the samples back up)
+ *
+ * Parameters: None
+ *
+ * Returns: Bytes until the next sample (at least 1)
+ *
+ * -------------------------------------------------------------------------- */
+static int64_t prof_next_interval(void) {
+  double uniform = 0.0;
+  double interval = 0.0;
+
+  if (0 == t_random) {
+    t_random = (uint64_t)(uintptr_t)&t_random ^ (uint64_t)time(NULL) ^
+               UINT64_C(0x9E3779B97F4A7C15);
+  }
+
+  /* xorshift64* */
+  t_random ^= t_random >> 12;
+  t_random ^= t_random << 25;
+  t_random ^= t_random >> 27;
+  uniform = (double)((t_random * UINT64_C(0x2545F4914F6CDD1D)) >> 11) *
+                (1.0 / 9007199254740992.0) +
+            (1.0 / 9007199254740992.0); /* (0, 1] */
+
+  /* -ln(u) = -log2(u) * ln(2) */
+  interval = -prof_log2(uniform) * 0.6931471805599453 * (double)g_rate;
+
+  return 1.0 > interval ? 1 : (int64_t)interval;
+}
+
+/* --------------------------------------------------------------------------
+ * Function: prof_log2
+ * --------------------------------------------------------------------------
+ *
+ * Description: Base 2 logarithm of a positive number, to about 1e-4 (the
+ *              exponent from the bits, the mantissa by a polynomial), so the
+ *              library needs no math library
+ *
+ * Parameters:
+ *      x: Positive number
+ *
+ * Returns: Approximate log2(x)
+ *
+ * -------------------------------------------------------------------------- */
+static double prof_log2(double x) {
+  uint64_t bits = 0;
+  double m = 0.0;
+  int exponent = 0;
+
+  memcpy(&bits, &x, sizeof(bits));
+  exponent = (int)((bits >> 52) & 0x7FF) - 1023;
+  bits = (bits & ((UINT64_C(1) << 52) - 1)) | (UINT64_C(1023) << 52);
+  memcpy(&m, &bits, sizeof(m)); /* Mantissa in [1, 2) */
+
+  return exponent +
+         (-1.7417939 +
+          (2.8212026 + (-1.4699568 + (0.44717955 - 0.056570851 * m) * m) * m) *
+              m);
+}
+
+/* --------------------------------------------------------------------------
+ * Function: prof_stack
+ * --------------------------------------------------------------------------
+ *
+ * Description: Record the return addresses of the stack. With frame
+ *              pointers the chain of frames is followed, within the bounds
+ *              of the thread's stack (tens of nanoseconds); elsewhere
+ *              `backtrace` is used.
+ *
+ * Parameters:
+ *        pcs: Receives the return addresses, innermost first
+ *      frame: Frame to start from (that of the caller)
+ *
+ * Returns: Number of addresses recorded
+ *
+ * -------------------------------------------------------------------------- */
+static size_t prof_stack(uintptr_t *pcs, void *frame) {
+  size_t depth = 0;
+#if defined(CME_HEAPPROF_FRAME_WALK)
+  const uintptr_t *fp = frame;
+  const uintptr_t *next = NULL;
+
+  if (0 == t_stack_high) {
+    pthread_attr_t attr;
+    void *low = NULL;
+    size_t size = 0;
+
+    if (0 == pthread_getattr_np(pthread_self(), &attr)) {
+      if (0 == pthread_attr_getstack(&attr, &low, &size)) {
+        t_stack_low = (uintptr_t)low;
+        t_stack_high = (uintptr_t)low + size;
+      }
+      pthread_attr_destroy(&attr);
+    }
+  }
+
+  /* A frame holds the caller's frame pointer and the return address */
+  while (depth < CME_HEAPPROF_MAX_DEPTH && (uintptr_t)fp >= t_stack_low &&
+         (uintptr_t)fp + 2 * sizeof(uintptr_t) <= t_stack_high &&
+         0 == ((uintptr_t)fp & (sizeof(uintptr_t) - 1))) {
+    if (0 == fp[1]) {
+      break;
+    }
+    pcs[depth++] = fp[1];
+    next = (const uintptr_t *)fp[0];
+    if (next <= fp) {
+      break; /* The chain must lead up the stack */
+    }
+    fp = next;
+  }
+#elif defined(CME_HEAPPROF_BACKTRACE)
+  void *addresses[CME_HEAPPROF_MAX_DEPTH + 1];
+  int count = backtrace(addresses, CME_HEAPPROF_MAX_DEPTH + 1);
+  int i = 0;
+
+  (void)frame;
+  for (i = 1; i < count; i++) { /* Skip this function */
+    pcs[depth++] = (uintptr_t)addresses[i];
+  }
+#else
+  (void)pcs;
+  (void)frame;
+#endif /* End of platform specific code */
+
+  return depth;
+}
+
+/* --------------------------------------------------------------------------
+ * Function: prof_bucket_of
+ * --------------------------------------------------------------------------
+ *
+ * Description: Bucket of a stack, added if new. Called with the lock held.
+ *
+ * Parameters:
+ *        pcs: Return addresses of the stack
+ *      depth: Number of addresses
+ *
+ * Returns: Index of the bucket, or UINT32_MAX if the buckets are used up
+ *
+ * -------------------------------------------------------------------------- */
+static uint32_t prof_bucket_of(const uintptr_t *pcs, size_t depth) {
+  uint64_t hash = UINT64_C(14695981039346656037);
+  prof_bucket *bucket = NULL;
+  size_t slot = 0;
+  size_t i = 0;
+
+  for (i = 0; i < depth; i++) {
+    hash = (hash ^ (uint64_t)pcs[i]) * UINT64_C(1099511628211);
+  }
+
+  for (slot = (size_t)(hash >> 32) & (PROF_STACK_SLOTS - 1);
+       0 != g_stack_slots[slot]; slot = (slot + 1) & (PROF_STACK_SLOTS - 1)) {
+    bucket = &g_buckets[g_stack_slots[slot] - 1];
+    if (hash == bucket->hash && depth == bucket->depth &&
+        0 == memcmp(pcs, bucket->pcs, depth * sizeof(uintptr_t))) {
+      return g_stack_slots[slot] - 1;
+    }
+  }
+  if (CME_HEAPPROF_MAX_STACKS <= g_num_buckets) {
+    return UINT32_MAX;
+  }
+
+  bucket = &g_buckets[g_num_buckets];
+  bucket->hash = hash;
+  bucket->depth = depth;
+  memcpy(bucket->pcs, pcs, depth * sizeof(uintptr_t));
+  g_stack_slots[slot] = ++g_num_buckets;
+
+  return g_num_buckets - 1;
+}
+
+/* --------------------------------------------------------------------------
+ * Function: prof_filter_index
+ * --------------------------------------------------------------------------
+ *
+ * Description: Counter of a block in the sample filter
+ *
+ * Parameters:
+ *      ptr: Block pointer
+ *
+ * Returns: Index of the counter
+ *
+ * -------------------------------------------------------------------------- */
+static size_t prof_filter_index(const void *ptr) {
+  uint64_t hash =
+      (uint64_t)((uintptr_t)ptr >> 4) * UINT64_C(0x9E3779B97F4A7C15);
+
+  return (size_t)(hash >> 40) & (PROF_FILTER_SIZE - 1);
+}
+
+/* --------------------------------------------------------------------------
+ * Function: prof_sample_home
+ * --------------------------------------------------------------------------
+ *
+ * Description: Home slot of a block in the table of samples
+ *
+ * Parameters:
+ *      ptr: Block pointer
+ *
+ * Returns: Slot index
+ *
+ * -------------------------------------------------------------------------- */
+static size_t prof_sample_home(const void *ptr) {
+  uint64_t hash =
+      (uint64_t)((uintptr_t)ptr >> 4) * UINT64_C(0x9E3779B97F4A7C15);
+
+  return (size_t)(hash >> 32) & (PROF_SAMPLE_SLOTS - 1);
+}
+
+/* --------------------------------------------------------------------------
+ * Function: prof_write_profile
+ * --------------------------------------------------------------------------
+ *
+ * Description: Write a profile to the next file PREFIX.PID.N.heap: a header
+ *              with the totals and the sampling rate, one line per stack
+ *              (live blocks and bytes, then all blocks and bytes sampled,
+ *              then the return addresses), and the memory map the addresses
+ *              are resolved with. Async signal safe. Called with the lock
+ *              held.
+ *
+ * Parameters:
+ *           path: Receives the name of the file
+ *      path_size: Size of `path`
+ *
+ * Returns: 0 on success, -1 on failure
+ *
+ * -------------------------------------------------------------------------- */
+static int prof_write_profile(char *path, size_t path_size) {
+  prof_writer out;
+  uint64_t totals[4] = {0, 0, 0, 0};
+  unsigned number = atomic_fetch_add(&g_profiles, 1);
+  const prof_bucket *bucket = NULL;
+  ssize_t got = 0;
+  uint32_t i = 0;
+  size_t j = 0;
+  int maps = -1;
+
+  /* The name, built without `snprintf` (not async signal safe) */
+  out.fd = -1;
+  out.failed = 0;
+  out.len = 0;
+  out_str(&out, g_prefix);
+  out_str(&out, ".");
+  out_u64(&out, (uint64_t)getpid());
+  out_str(&out, ".");
+  out_u64(&out, number);
+  out_str(&out, ".heap");
+  j = out.len < path_size - 1 ? out.len : path_size - 1;
+  memcpy(path, out.buf, j);
+  path[j] = '\0';
+
+  out.len = 0;
+  out.fd = open(path, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+  if (0 > out.fd) {
+    return -1;
+  }
+
+  for (i = 0; i < g_num_buckets; i++) {
+    totals[0] += g_buckets[i].live_count;
+    totals[1] += g_buckets[i].live_bytes;
+    totals[2] += g_buckets[i].alloc_count;
+    totals[3] += g_buckets[i].alloc_bytes;
+  }
+  out_str(&out, "heap profile: ");
+  out_u64(&out, totals[0]);
+  out_str(&out, ": ");
+  out_u64(&out, totals[1]);
+  out_str(&out, " [");
+  out_u64(&out, totals[2]);
+  out_str(&out, ": ");
+  out_u64(&out, totals[3]);
+  out_str(&out, "] @ heap_v2/");
+  out_u64(&out, g_rate);
+  out_str(&out, "\n");
+
+  for (i = 0; i < g_num_buckets; i++) {
+    bucket = &g_buckets[i];
+    out_u64(&out, bucket->live_count);
+    out_str(&out, ": ");
+    out_u64(&out, bucket->live_bytes);
+    out_str(&out, " [");
+    out_u64(&out, bucket->alloc_count);
+    out_str(&out, ": ");
+    out_u64(&out, bucket->alloc_bytes);
+    out_str(&out, "] @");
+    for (j = 0; j < bucket->depth; j++) {
+      out_str(&out, " ");
+      out_hex(&out, bucket->pcs[j]);
+    }
+    out_str(&out, "\n");
+  }
+
+  /* The memory map, for symbolization */
+  out_str(&out, "\nMAPPED_LIBRARIES:\n");
+  out_flush(&out);
+  maps = open("/proc/self/maps", O_RDONLY);
+  while (0 <= maps && 0 < (got = read(maps, out.buf, sizeof(out.buf)))) {
+    out.len = (size_t)got;
+    out_flush(&out);
+  }
+  if (0 <= maps) {
+    close(maps);
+  }
+
+  close(out.fd);
+
+  return out.failed ? -1 : 0;
+}
+
+/* --------------------------------------------------------------------------
+ * Function: out_flush
+ * --------------------------------------------------------------------------
+ *
+ * Description: Write out the buffer of a profile
+ *
+ * Parameters:
+ *      out: The profile
+ *
+ * Returns: None
+ *
+ * -------------------------------------------------------------------------- */
+static void out_flush(prof_writer *out) {
+  size_t done = 0;
+  ssize_t wrote = 0;
+
+  while (done < out->len && 0 <= out->fd) {
+    wrote = write(out->fd, out->buf + done, out->len - done);
+    if (0 > wrote && EINTR == errno) {
+      continue;
+    }
+    if (0 >= wrote) {
+      out->failed = 1;
+      break;
+    }
+    done += (size_t)wrote;
+  }
+  out->len = 0;
+}
+
+/* --------------------------------------------------------------------------
+ * Function: out_str
+ * --------------------------------------------------------------------------
+ *
+ * Description: Add a string to a profile
+ *
+ * Parameters:
+ *      out: The profile
+ *      str: String to add
+ *
+ * Returns: None
+ *
+ * -------------------------------------------------------------------------- */
+static void out_str(prof_writer *out, const char *str) {
+  while (*str) {
+    if (out->len == sizeof(out->buf)) {
+      out_flush(out);
+      if (0 > out->fd) {
+        return; /* Building a name: truncate */
+      }
+    }
+    out->buf[out->len++] = *str++;
+  }
+}
+
+/* --------------------------------------------------------------------------
+ * Function: out_u64
+ * --------------------------------------------------------------------------
+ *
+ * Description: Add a number in decimal to a profile
+ *
+ * Parameters:
+ *        out: The profile
+ *      value: Number to add
+ *
+ * Returns: None
+ *
+ * -------------------------------------------------------------------------- */
+static void out_u64(prof_writer *out, uint64_t value) {
+  char digits[24];
+  size_t i = sizeof(digits) - 1;
+
+  digits[i] = '\0';
+  do {
+    digits[--i] = (char)('0' + value % 10);
+    value /= 10;
+  } while (value);
+  out_str(out, digits + i);
+}
+
+/* --------------------------------------------------------------------------
+ * Function: out_hex
+ * --------------------------------------------------------------------------
+ *
+ * Description: Add an address in hexadecimal (0x...) to a profile
+ *
+ * Parameters:
+ *        out: The profile
+ *      value: Address to add
+ *
+ * Returns: None
+ *
+ * -------------------------------------------------------------------------- */
+static void out_hex(prof_writer *out, uint64_t value) {
+  char digits[24];
+  size_t i = sizeof(digits) - 1;
+
+  digits[i] = '\0';
+  do {
+    digits[--i] = "0123456789abcdef"[value & 0xF];
+    value >>= 4;
+  } while (value);
+  digits[--i] = 'x';
+  digits[--i] = '0';
+  out_str(out, digits + i);
+}
+
+#endif /* CME_HAVE_HEAPPROF */
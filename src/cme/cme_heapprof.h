@@ -0,0 +1,72 @@
+/* ==========================================================================
+ *  Copyright (C) 2026 Ljubomir Kurij <ljubomir_kurij@protonmail.com>
+ *
+ * This file is part of "C Common Memory Errors".
+ *
+ * "C Common Memory Errors" is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * "C Common Memory Errors" is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General
+ * Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with Focus Precision Analyze. If not, see <https://www.gnu.org/licenses/>.
+ * ========================================================================== */
+
+/* ==========================================================================
+ *
+ * 2026-10-18 Ljubomir Kurij <ljubomir_kurij@protonmail.com>
+ *
+ * * cme_heapprof.h: created.
+ *
+ * ========================================================================== */
+
+#ifndef CME_HEAPPROF_H_
+#define CME_HEAPPROF_H_
+
+/* ==========================================================================
+ * Headers Include Section
+ * ========================================================================== */
+
+/* Standard Library headers */
+#include <stddef.h>
+#include <stdint.h>
+
+/* ==========================================================================
+ * Macros Definitions Section
+ * ========================================================================== */
+
+/* Environment variables read on the first allocation:
+
+   CME_HEAPPROF=PREFIX      Profile the heap and write the profiles to
+                            PREFIX.PID.N.heap (at exit, and on SIGUSR2)
+   CME_HEAPPROF_RATE=BYTES  Mean number of bytes allocated between two
+                            samples (default `CME_HEAPPROF_DEFAULT_RATE`) */
+#define CME_HEAPPROF_ENV "CME_HEAPPROF"
+#define CME_HEAPPROF_RATE_ENV "CME_HEAPPROF_RATE"
+
+/* Mean bytes between samples, as in tcmalloc */
+#define CME_HEAPPROF_DEFAULT_RATE ((size_t)512 * 1024)
+
+/* Deepest stack recorded for a sample */
+#define CME_HEAPPROF_MAX_DEPTH 32
+
+/* Distinct allocation stacks, and sampled blocks live at once, the profiler
+   can hold. Samples past either limit are dropped (and counted). */
+#define CME_HEAPPROF_MAX_STACKS 4096
+#define CME_HEAPPROF_MAX_SAMPLES 16384
+
+/* ==========================================================================
+ * Function Declarations Section
+ * ========================================================================== */
+
+int cme_heapprof_start(const char *prefix, size_t rate);
+int cme_heapprof_dump(void);
+int64_t cme_heapprof_sample(void *ptr, size_t size);
+void cme_heapprof_forget(const void *ptr);
+
+#endif /* CME_HEAPPROF_H_ */
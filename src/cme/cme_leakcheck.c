@@ -0,0 +1,1157 @@
+/* ==========================================================================
+ *  Copyright (C) 2026 Ljubomir Kurij <ljubomir_kurij@protonmail.com>
+ *
+ * This file is part of "C Common Memory Errors".
+ *
+ * "C Common Memory Errors" is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * "C Common Memory Errors" is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General
+ * Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with Focus Precision Analyze. If not, see <https://www.gnu.org/licenses/>.
+ * ========================================================================== */
+
+/* ==========================================================================
+ *
+ * 2026-10-18 Ljubomir Kurij <ljubomir_kurij@protonmail.com>
+ *
+ * * cme_leakcheck.c: created.
+ *
+ * ========================================================================== */
+
+/* ==========================================================================
+ * Headers Include Section
+ * ========================================================================== */
+
+/* For `pthread_getattr_np` (the stack) and `dl_iterate_phdr` (the globals) */
+#define _GNU_SOURCE
+
+/* Related header */
+#include "cme_leakcheck.h"
+
+/* System headers */
+#if defined(__linux__) && defined(CME_HAVE_PTHREADS) &&                       \
+    !defined(__STDC_NO_ATOMICS__)
+#define CME_HAVE_LEAKCHECK 1
+#include <link.h>
+#include <pthread.h>
+#include <stdatomic.h>
+#endif /* End of platform specific headers */
+
+/* Standard Library headers */
+#include <setjmp.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/* Project headers */
+#include "cme_alloc.h"
+#include "cme_parallel.h"
+
+#ifdef CME_HAVE_LEAKCHECK
+
+/* ==========================================================================
+ * Macros Definitions Section
+ * ========================================================================== */
+
+/* Slots a shard starts with (a power of two); it doubles when half full */
+#define LEAK_SHARD_SLOTS 1024
+
+/* Bytes of the roots (stack and globals) scanned as one piece of work */
+#define LEAK_ROOT_CHUNK ((size_t)64 * 1024)
+
+/* Blocks of a level of the mark phase worth handing to a thread */
+#define LEAK_PARALLEL_MIN 1024
+
+/* Bits of the block starts sorted per pass of the radix sort */
+#define LEAK_RADIX_BITS 11
+
+/* Marked blocks a thread collects before it adds them to the next level */
+#define LEAK_BATCH 256
+
+/* States of the checker */
+#define LEAK_UNSET 0 /* Environment not read yet */
+#define LEAK_OFF 1
+#define LEAK_ON 2
+
+/* The scan reads whole stacks, segments and blocks, redzones and
+   uninitialized bytes included, so the sanitizers must not check it */
+#if defined(__clang__)
+#define LEAK_NO_SANITIZE __attribute__((no_sanitize("address", "memory")))
+#elif defined(__GNUC__)
+#define LEAK_NO_SANITIZE __attribute__((no_sanitize_address))
+#else
+#define LEAK_NO_SANITIZE
+#endif
+
+/* ==========================================================================
+ * Type Definitions Section
+ * ========================================================================== */
+
+/* A live block and the site it was allocated at */
+typedef struct leak_entry {
+  uintptr_t ptr; /* 0 for an empty slot */
+  size_t size;
+  const char *file;
+  const char *func;
+  int line;
+} leak_entry;
+
+/* Open addressing hash table (linear probing) of some of the live blocks */
+typedef struct leak_shard {
+  pthread_mutex_t lock;
+  leak_entry *slots;
+  size_t cap;
+  size_t count;
+  size_t dropped; /* Blocks not tracked for lack of memory */
+} leak_shard;
+
+/* Address range [begin, end) */
+typedef struct leak_range {
+  uintptr_t begin;
+  uintptr_t end;
+} leak_range;
+
+/* Roots found so far */
+typedef struct leak_roots {
+  leak_range ranges[CME_LEAKCHECK_MAX_SEGMENTS + 1];
+  size_t count;
+} leak_roots;
+
+/* Block start, size and entry, while the index is sorted */
+typedef struct leak_key {
+  uintptr_t start;
+  size_t size;
+  const leak_entry *entry;
+} leak_key;
+
+/* Unreachable blocks allocated at one site */
+typedef struct leak_site {
+  const char *file;
+  const char *func;
+  int line;
+  uint64_t blocks;
+  uint64_t bytes;
+} leak_site;
+
+/* A scan of the heap: the index of the live blocks (sorted by address, the
+   starts and ends in arrays of their own, so a lookup is a binary search
+   over 8 bytes per block), their marks, and the levels of the mark phase.
+   The address range of the heap is cut into buckets of equal size (about
+   as many as blocks), each with the first block starting in it, so the
+   search of an address covers only the blocks of its bucket. */
+typedef struct leak_scan {
+  size_t count;
+  uintptr_t *starts;
+  uintptr_t *ends;
+  const leak_entry **entries;
+  atomic_uchar *marks;
+  uintptr_t low;  /* Lowest block start */
+  uintptr_t span; /* Past the highest block end, from `low` */
+  size_t *buckets; /* First block of each bucket, and the count at the end */
+  unsigned bucket_shift; /* Log2 of the bucket size */
+  const leak_range *chunks; /* Pieces of the roots */
+  const size_t *level;      /* Blocks marked by the last level */
+  size_t *next;             /* Blocks marked by this level */
+  atomic_size_t next_count;
+  leak_key *keys; /* Sorted, then reused for the levels */
+  leak_key *tmp;  /* Scratch space of the sort, then reused for the index */
+} leak_scan;
+
+/* ==========================================================================
+ * Private Function Declarations Section
+ * ========================================================================== */
+
+static int leak_setup(void);
+static void leak_at_exit(void);
+static size_t leak_shard_of(uintptr_t ptr);
+static size_t leak_home(uintptr_t ptr, size_t cap);
+static int leak_grow(leak_shard *shard);
+static int leak_index(leak_scan *scan);
+static void leak_sort(leak_key *keys, leak_key *tmp, size_t count);
+static void leak_find_roots(leak_roots *roots, uintptr_t stack_low);
+static int leak_segment(struct dl_phdr_info *info, size_t size, void *ctx);
+static int leak_mark(leak_scan *scan, const leak_roots *roots);
+static void leak_mark_roots(void *ctx, size_t begin, size_t end);
+static void leak_mark_blocks(void *ctx, size_t begin, size_t end);
+static size_t leak_scan_words(leak_scan *scan, uintptr_t begin, uintptr_t end,
+                              size_t *batch, size_t used);
+static size_t leak_find(const leak_scan *scan, uintptr_t addr);
+static void leak_publish(leak_scan *scan, const size_t *batch, size_t used);
+static long leak_report(const leak_scan *scan, size_t dropped);
+static int leak_site_order(const void *a, const void *b);
+static int leak_site_bytes(const void *a, const void *b);
+
+/* ==========================================================================
+ * Global Variables Section
+ * ========================================================================== */
+
+static pthread_mutex_t g_setup_lock = PTHREAD_MUTEX_INITIALIZER;
+static atomic_int g_state = LEAK_UNSET;
+static leak_shard g_shards[CME_LEAKCHECK_SHARDS];
+
+#endif /* CME_HAVE_LEAKCHECK */
+
+/* ==========================================================================
+ * Function Definitions Section
+ * ========================================================================== */
+
+/* --------------------------------------------------------------------------
+ * Function: cme_leakcheck_start
+ * --------------------------------------------------------------------------
+ *
+ * Description: Start tracking the blocks the `cme` allocator hands out, and
+ *              scan for leaks at exit, as setting `CME_LEAKS=1` would. Blocks
+ *              allocated before are not tracked (nor scanned for pointers),
+ *              so start it before the first allocation.
+ *
+ * Parameters: None
+ *
+ * Returns: 0 on success, -1 if the checker is not supported here (nor in
+ *          a build whose allocation macros bypass the `cme` allocator, see
+ *          `CME_ALLOC_TRACKED`) or out of memory
+ *
+ * -------------------------------------------------------------------------- */
+int cme_leakcheck_start(void) {
+#ifdef CME_HAVE_LEAKCHECK
+  int status = 0;
+
+  if (!CME_ALLOC_TRACKED) {
+    return -1; /* No block would be tracked: every scan would come out clean */
+  }
+
+  cme_alloc_watch();
+  pthread_mutex_lock(&g_setup_lock);
+  status = leak_setup();
+  pthread_mutex_unlock(&g_setup_lock);
+
+  return status;
+#else
+  return -1;
+#endif /* End of platform specific code */
+}
+
+/* --------------------------------------------------------------------------
+ * Function: cme_leakcheck_run
+ * --------------------------------------------------------------------------
+ *
+ * Description: Scan the heap for leaks now (a conservative mark and sweep),
+ *              and report the unreachable blocks on `stderr`, grouped by the
+ *              site that allocated them. Every word of the roots (the stack
+ *              of the calling thread, the callee saved registers spilled onto
+ *              it, and the writable segments of the program and its
+ *              libraries) that points into a tracked block marks the block,
+ *              and the marked blocks are scanned in turn, level by level, in
+ *              parallel. Pointers held only by other threads, by thread local
+ *              variables or by memory from other allocators are not seen.
+ *              Allocations and frees wait for the scan to end.
+ *
+ * Parameters: None
+ *
+ * Returns: Number of unreachable blocks, or -1 if the checker is off or out
+ *          of memory
+ *
+ * -------------------------------------------------------------------------- */
+long cme_leakcheck_run(void) {
+#ifdef CME_HAVE_LEAKCHECK
+  jmp_buf registers; /* The callee saved registers, on the stack */
+  leak_roots roots;
+  leak_scan scan;
+  /* Volatile, as they live across the `setjmp` (nothing jumps back to it) */
+  volatile size_t dropped = 0;
+  size_t i = 0;
+  volatile long leaked = -1;
+
+  if (LEAK_ON != atomic_load(&g_state)) {
+    return -1;
+  }
+
+  setjmp(registers);
+  memset(&scan, 0, sizeof(scan));
+  for (i = 0; i < CME_LEAKCHECK_SHARDS; i++) {
+    pthread_mutex_lock(&g_shards[i].lock);
+    dropped += g_shards[i].dropped;
+  }
+
+  leak_find_roots(&roots, (uintptr_t)&registers);
+  if (0 == leak_index(&scan) && 0 == leak_mark(&scan, &roots)) {
+    leaked = leak_report(&scan, dropped);
+  } else {
+    fprintf(stderr, "cme_leakcheck: no memory for the scan\n");
+  }
+
+  for (i = CME_LEAKCHECK_SHARDS; i > 0; i--) {
+    pthread_mutex_unlock(&g_shards[i - 1].lock);
+  }
+  free(scan.keys);
+  free(scan.tmp);
+  free((void *)scan.marks);
+  free(scan.buckets);
+
+  return leaked;
+#else
+  return -1;
+#endif /* End of platform specific code */
+}
+
+/* --------------------------------------------------------------------------
+ * Function: cme_leakcheck_track
+ * --------------------------------------------------------------------------
+ *
+ * Description: Called by the allocator for every new block: track it until
+ *              it is freed. The first call reads the environment.
+ *
+ * Parameters:
+ *       ptr: The new block
+ *      size: Its size
+ *      file: Source file of the allocation (NULL for an unknown site)
+ *      line: Line of the allocation
+ *      func: Function making the allocation
+ *
+ * Returns: None
+ *
+ * -------------------------------------------------------------------------- */
+void cme_leakcheck_track(void *ptr, size_t size, const char *file, int line,
+                         const char *func) {
+#ifdef CME_HAVE_LEAKCHECK
+  const char *value = NULL;
+  leak_shard *shard = NULL;
+  size_t slot = 0;
+
+  if (LEAK_UNSET == atomic_load_explicit(&g_state, memory_order_acquire)) {
+    pthread_mutex_lock(&g_setup_lock);
+    if (LEAK_UNSET == atomic_load(&g_state)) {
+      value = getenv(CME_LEAKCHECK_ENV);
+      if (value && '\0' != *value && 0 != strcmp(value, "0")) {
+        leak_setup();
+      } else {
+        atomic_store(&g_state, LEAK_OFF);
+      }
+    }
+    pthread_mutex_unlock(&g_setup_lock);
+  }
+  if (LEAK_ON != atomic_load_explicit(&g_state, memory_order_acquire)) {
+    return;
+  }
+
+  shard = &g_shards[leak_shard_of((uintptr_t)ptr)];
+  pthread_mutex_lock(&shard->lock);
+  if (2 * (shard->count + 1) > shard->cap && 0 != leak_grow(shard)) {
+    shard->dropped++;
+  } else {
+    for (slot = leak_home((uintptr_t)ptr, shard->cap);
+         0 != shard->slots[slot].ptr; slot = (slot + 1) & (shard->cap - 1)) {
+    }
+    shard->slots[slot].ptr = (uintptr_t)ptr;
+    shard->slots[slot].size = size;
+    shard->slots[slot].file = file;
+    shard->slots[slot].func = func;
+    shard->slots[slot].line = line;
+    shard->count++;
+  }
+  pthread_mutex_unlock(&shard->lock);
+#else
+  (void)ptr;
+  (void)size;
+  (void)file;
+  (void)line;
+  (void)func;
+#endif /* End of platform specific code */
+}
+
+/* --------------------------------------------------------------------------
+ * Function: cme_leakcheck_forget
+ * --------------------------------------------------------------------------
+ *
+ * Description: Called by the allocator before a block is freed: stop
+ *              tracking it
+ *
+ * Parameters:
+ *      ptr: Block about to be freed
+ *
+ * Returns: None
+ *
+ * -------------------------------------------------------------------------- */
+void cme_leakcheck_forget(const void *ptr) {
+#ifdef CME_HAVE_LEAKCHECK
+  leak_shard *shard = NULL;
+  size_t mask = 0;
+  size_t slot = 0;
+  size_t next = 0;
+  size_t home = 0;
+
+  if (LEAK_ON != atomic_load_explicit(&g_state, memory_order_acquire)) {
+    return;
+  }
+
+  shard = &g_shards[leak_shard_of((uintptr_t)ptr)];
+  pthread_mutex_lock(&shard->lock);
+  mask = shard->cap - 1;
+  for (slot = leak_home((uintptr_t)ptr, shard->cap);
+       0 != shard->slots[slot].ptr; slot = (slot + 1) & mask) {
+    if ((uintptr_t)ptr != shard->slots[slot].ptr) {
+      continue;
+    }
+    shard->count--;
+
+    /* Shift the following entries back into the hole (no tombstones) */
+    shard->slots[slot].ptr = 0;
+    for (next = (slot + 1) & mask; 0 != shard->slots[next].ptr;
+         next = (next + 1) & mask) {
+      home = leak_home(shard->slots[next].ptr, shard->cap);
+      if (((next - home) & mask) >= ((next - slot) & mask)) {
+        shard->slots[slot] = shard->slots[next];
+        shard->slots[next].ptr = 0;
+        slot = next;
+      }
+    }
+    break;
+  }
+  pthread_mutex_unlock(&shard->lock);
+#else
+  (void)ptr;
+#endif /* End of platform specific code */
+}
+
+#ifdef CME_HAVE_LEAKCHECK
+
+/* ==========================================================================
+ * Private Function Definitions Section
+ * ========================================================================== */
+
+/* --------------------------------------------------------------------------
+ * Function: leak_setup
+ * --------------------------------------------------------------------------
+ *
+ * Description: Allocate the shards, have the heap scanned at exit, and
+ *              turn the checker on. Called with the setup lock held.
+ *
+ * Parameters: None
+ *
+ * Returns: 0 on success, -1 if out of memory
+ *
+ * -------------------------------------------------------------------------- */
+static int leak_setup(void) {
+  size_t i = 0;
+
+  if (LEAK_ON == atomic_load(&g_state)) {
+    return 0;
+  }
+
+  /* The shards come from the system allocator, so they are neither tracked
+     nor scanned */
+  for (i = 0; i < CME_LEAKCHECK_SHARDS; i++) {
+    pthread_mutex_init(&g_shards[i].lock, NULL);
+    g_shards[i].slots = calloc(LEAK_SHARD_SLOTS, sizeof(leak_entry));
+    g_shards[i].cap = LEAK_SHARD_SLOTS;
+    if (NULL == g_shards[i].slots) {
+      while (i > 0) {
+        free(g_shards[--i].slots);
+        g_shards[i].slots = NULL;
+      }
+      atomic_store(&g_state, LEAK_OFF);
+      fprintf(stderr, "cme_leakcheck: no memory for the leak checker\n");
+      return -1;
+    }
+  }
+
+  atexit(leak_at_exit);
+  atomic_store(&g_state, LEAK_ON);
+
+  return 0;
+}
+
+/* --------------------------------------------------------------------------
+ * Function: leak_at_exit
+ * --------------------------------------------------------------------------
+ *
+ * Description: Scan the heap for leaks at exit
+ *
+ * Parameters: None
+ *
+ * Returns: None
+ *
+ * -------------------------------------------------------------------------- */
+static void leak_at_exit(void) { cme_leakcheck_run(); }
+
+/* --------------------------------------------------------------------------
+ * Function: leak_shard_of
+ * --------------------------------------------------------------------------
+ *
+ * Description: Shard a block is tracked in
+ *
+ * Parameters:
+ *      ptr: Block address
+ *
+ * Returns: Shard index
+ *
+ * -------------------------------------------------------------------------- */
+static size_t leak_shard_of(uintptr_t ptr) {
+  uint64_t hash = (uint64_t)(ptr >> 4) * UINT64_C(0x9E3779B97F4A7C15);
+
+  return (size_t)(hash >> 48) % CME_LEAKCHECK_SHARDS;
+}
+
+/* --------------------------------------------------------------------------
+ * Function: leak_home
+ * --------------------------------------------------------------------------
+ *
+ * Description: Home slot of a block in its shard
+ *
+ * Parameters:
+ *      ptr: Block address
+ *      cap: Slots of the shard (a power of two)
+ *
+ * Returns: Slot index
+ *
+ * -------------------------------------------------------------------------- */
+static size_t leak_home(uintptr_t ptr, size_t cap) {
+  uint64_t hash = (uint64_t)(ptr >> 4) * UINT64_C(0x9E3779B97F4A7C15);
+
+  return (size_t)(hash >> 16) & (cap - 1);
+}
+
+/* --------------------------------------------------------------------------
+ * Function: leak_grow
+ * --------------------------------------------------------------------------
+ *
+ * Description: Double the slots of a shard. Called with its lock held.
+ *
+ * Parameters:
+ *      shard: The shard
+ *
+ * Returns: 0 on success, -1 if out of memory (the shard is left as it was)
+ *
+ * -------------------------------------------------------------------------- */
+static int leak_grow(leak_shard *shard) {
+  size_t cap = 2 * shard->cap;
+  leak_entry *slots = calloc(cap, sizeof(leak_entry));
+  size_t slot = 0;
+  size_t i = 0;
+
+  if (NULL == slots) {
+    return -1;
+  }
+  for (i = 0; i < shard->cap; i++) {
+    if (0 == shard->slots[i].ptr) {
+      continue;
+    }
+    for (slot = leak_home(shard->slots[i].ptr, cap); 0 != slots[slot].ptr;
+         slot = (slot + 1) & (cap - 1)) {
+    }
+    slots[slot] = shard->slots[i];
+  }
+  free(shard->slots);
+  shard->slots = slots;
+  shard->cap = cap;
+
+  return 0;
+}
+
+/* --------------------------------------------------------------------------
+ * Function: leak_index
+ * --------------------------------------------------------------------------
+ *
+ * Description: Build the sorted index of the live blocks, and the arrays of
+ *              the mark phase. The index takes the place of the scratch space
+ *              of the sort, and the levels that of the keys, so the scan
+ *              touches as little fresh memory as it can (at about 60 bytes a
+ *              block, the page faults are most of the time it takes). Called
+ *              with all the shards locked.
+ *
+ * Parameters:
+ *      scan: Receives the index (the arrays are released by the caller)
+ *
+ * Returns: 0 on success, -1 if out of memory
+ *
+ * -------------------------------------------------------------------------- */
+static int leak_index(leak_scan *scan) {
+  leak_key *keys = NULL;
+  size_t num_buckets = 0;
+  size_t count = 0;
+  size_t i = 0;
+  size_t j = 0;
+
+  for (i = 0; i < CME_LEAKCHECK_SHARDS; i++) {
+    count += g_shards[i].count;
+  }
+  scan->count = count;
+  if (0 == count) {
+    return 0;
+  }
+
+  /* Keys of 24 bytes hold the start, end and entry (8 bytes each) of the
+     index, and the two levels (8 bytes each) */
+  scan->keys = keys = malloc(count * sizeof(leak_key));
+  scan->tmp = malloc(count * sizeof(leak_key));
+  scan->marks = calloc(count, sizeof(atomic_uchar));
+  for (num_buckets = 1; num_buckets < count; num_buckets *= 2) {
+  }
+  scan->buckets = malloc((num_buckets + 1) * sizeof(size_t));
+  if (NULL == scan->keys || NULL == scan->tmp || NULL == scan->marks ||
+      NULL == scan->buckets) {
+    return -1;
+  }
+
+  for (i = 0; i < CME_LEAKCHECK_SHARDS; i++) {
+    for (j = 0; j < g_shards[i].cap; j++) {
+      if (0 != g_shards[i].slots[j].ptr) {
+        keys[count - 1].start = g_shards[i].slots[j].ptr;
+        keys[count - 1].size = g_shards[i].slots[j].size;
+        keys[count - 1].entry = &g_shards[i].slots[j];
+        count--;
+      }
+    }
+  }
+  leak_sort(keys, scan->tmp, scan->count);
+
+  scan->starts = (uintptr_t *)scan->tmp;
+  scan->ends = scan->starts + scan->count;
+  scan->entries = (const leak_entry **)(scan->ends + scan->count);
+  for (i = 0; i < scan->count; i++) {
+    scan->starts[i] = keys[i].start;
+    scan->ends[i] = keys[i].start + keys[i].size;
+    scan->entries[i] = keys[i].entry;
+  }
+  scan->low = scan->starts[0];
+  scan->span = scan->ends[scan->count - 1] - scan->low + 1;
+
+  /* Buckets: the smallest size that covers the range */
+  while ((scan->span - 1) >> scan->bucket_shift >= num_buckets) {
+    scan->bucket_shift++;
+  }
+  for (j = 0, i = 0; i <= num_buckets; i++) {
+    while (j < scan->count && scan->starts[j] - scan->low <
+                                  ((uintptr_t)i << scan->bucket_shift)) {
+      j++;
+    }
+    scan->buckets[i] = j;
+  }
+
+  scan->level = (size_t *)keys;
+  scan->next = (size_t *)keys + scan->count;
+
+  return 0;
+}
+
+/* --------------------------------------------------------------------------
+ * Function: leak_sort
+ * --------------------------------------------------------------------------
+ *
+ * Description: Sort block starts (radix sort, `LEAK_RADIX_BITS` at a time
+ *              from the lowest). The digits are those of the offset from the
+ *              lowest start, less the low bits every start has clear (the
+ *              alignment of the allocator), so a heap of a few hundred
+ *              megabytes takes two or three passes.
+ *
+ * Parameters:
+ *       keys: Keys to sort
+ *        tmp: Scratch space for as many keys
+ *      count: Number of keys
+ *
+ * Returns: None
+ *
+ * -------------------------------------------------------------------------- */
+static void leak_sort(leak_key *keys, leak_key *tmp, size_t count) {
+  size_t counts[(size_t)1 << LEAK_RADIX_BITS];
+  const uintptr_t mask = ((uintptr_t)1 << LEAK_RADIX_BITS) - 1;
+  leak_key *from = keys;
+  leak_key *to = tmp;
+  leak_key *swap = NULL;
+  uintptr_t low = UINTPTR_MAX;
+  uintptr_t high = 0;
+  uintptr_t bits = 0;
+  unsigned align = 0;
+  unsigned shift = 0;
+  size_t offset = 0;
+  size_t digit_count = 0;
+  size_t i = 0;
+
+  for (i = 0; i < count; i++) {
+    low = keys[i].start < low ? keys[i].start : low;
+    high = keys[i].start > high ? keys[i].start : high;
+    bits |= keys[i].start;
+  }
+  while (align < 8 * sizeof(uintptr_t) - 1 && 0 == (bits >> align & 1)) {
+    align++;
+  }
+
+  for (shift = align; shift < 8 * sizeof(uintptr_t) &&
+                      0 != (high - low) >> shift;
+       shift += LEAK_RADIX_BITS) {
+    memset(counts, 0, sizeof(counts));
+    for (i = 0; i < count; i++) {
+      counts[(from[i].start - low) >> shift & mask]++;
+    }
+    for (offset = 0, i = 0; i <= mask; i++) {
+      digit_count = counts[i];
+      counts[i] = offset;
+      offset += digit_count;
+    }
+    for (i = 0; i < count; i++) {
+      to[counts[(from[i].start - low) >> shift & mask]++] = from[i];
+    }
+    swap = from;
+    from = to;
+    to = swap;
+  }
+  if (from != keys) {
+    memcpy(keys, from, count * sizeof(leak_key));
+  }
+}
+
+/* --------------------------------------------------------------------------
+ * Function: leak_find_roots
+ * --------------------------------------------------------------------------
+ *
+ * Description: Find the roots of the scan: the stack of the calling thread
+ *              from `stack_low` up, and the writable segments (data and bss)
+ *              of the program and of the libraries it loaded
+ *
+ * Parameters:
+ *          roots: Receives the roots
+ *      stack_low: Lowest stack address to scan
+ *
+ * Returns: None
+ *
+ * -------------------------------------------------------------------------- */
+static void leak_find_roots(leak_roots *roots, uintptr_t stack_low) {
+  pthread_attr_t attr;
+  void *low = NULL;
+  size_t size = 0;
+
+  roots->count = 0;
+  if (0 == pthread_getattr_np(pthread_self(), &attr)) {
+    if (0 == pthread_attr_getstack(&attr, &low, &size) &&
+        stack_low < (uintptr_t)low + size) {
+      roots->ranges[roots->count].begin = stack_low;
+      roots->ranges[roots->count].end = (uintptr_t)low + size;
+      roots->count++;
+    }
+    pthread_attr_destroy(&attr);
+  }
+
+  dl_iterate_phdr(leak_segment, roots);
+}
+
+/* --------------------------------------------------------------------------
+ * Function: leak_segment
+ * --------------------------------------------------------------------------
+ *
+ * Description: Add the writable loaded segments of an object (the program
+ *              or a library) to the roots. Called by `dl_iterate_phdr`.
+ *
+ * Parameters:
+ *      info: The object
+ *      size: Size of `info`
+ *       ctx: The roots
+ *
+ * Returns: 0, to go on with the next object
+ *
+ * -------------------------------------------------------------------------- */
+static int leak_segment(struct dl_phdr_info *info, size_t size, void *ctx) {
+  leak_roots *roots = ctx;
+  const ElfW(Phdr) *phdr = NULL;
+  int i = 0;
+
+  (void)size;
+  for (i = 0; i < info->dlpi_phnum; i++) {
+    phdr = &info->dlpi_phdr[i];
+    if (PT_LOAD != phdr->p_type || 0 == (phdr->p_flags & PF_W) ||
+        CME_LEAKCHECK_MAX_SEGMENTS + 1 <= roots->count) {
+      continue;
+    }
+    roots->ranges[roots->count].begin = info->dlpi_addr + phdr->p_vaddr;
+    roots->ranges[roots->count].end =
+        info->dlpi_addr + phdr->p_vaddr + phdr->p_memsz;
+    roots->count++;
+  }
+
+  return 0;
+}
+
+/* --------------------------------------------------------------------------
+ * Function: leak_mark
+ * --------------------------------------------------------------------------
+ *
+ * Description: Mark the blocks reachable from the roots. The roots are cut
+ *              into pieces scanned in parallel; then each level (the blocks
+ *              marked by the last one) is scanned in parallel for the next,
+ *              until no new block is marked. A block is marked (and so
+ *              scanned) once, by whichever thread marks it first. Small
+ *              levels, like those of a long list, run on the calling thread.
+ *
+ * Parameters:
+ *       scan: The scan
+ *      roots: The roots
+ *
+ * Returns: 0 on success, -1 if out of memory
+ *
+ * -------------------------------------------------------------------------- */
+static int leak_mark(leak_scan *scan, const leak_roots *roots) {
+  leak_range *chunks = NULL;
+  size_t *swap = NULL;
+  size_t num_chunks = 0;
+  size_t level_count = 0;
+  uintptr_t begin = 0;
+  size_t i = 0;
+
+  if (0 == scan->count) {
+    return 0;
+  }
+
+  for (i = 0; i < roots->count; i++) {
+    num_chunks += (roots->ranges[i].end - roots->ranges[i].begin +
+                   LEAK_ROOT_CHUNK - 1) / LEAK_ROOT_CHUNK;
+  }
+  chunks = malloc((num_chunks + 1) * sizeof(leak_range));
+  if (NULL == chunks) {
+    return -1;
+  }
+  for (num_chunks = 0, i = 0; i < roots->count; i++) {
+    for (begin = roots->ranges[i].begin; begin < roots->ranges[i].end;
+         begin += LEAK_ROOT_CHUNK) {
+      chunks[num_chunks].begin = begin;
+      chunks[num_chunks].end = roots->ranges[i].end - begin > LEAK_ROOT_CHUNK
+                                   ? begin + LEAK_ROOT_CHUNK
+                                   : roots->ranges[i].end;
+      num_chunks++;
+    }
+  }
+
+  scan->chunks = chunks;
+  atomic_store(&scan->next_count, 0);
+  cme_parallel_for(num_chunks, 1, leak_mark_roots, scan);
+  free(chunks);
+  scan->chunks = NULL;
+
+  while (0 < (level_count = atomic_load(&scan->next_count))) {
+    swap = (size_t *)scan->level;
+    scan->level = scan->next;
+    scan->next = swap;
+    atomic_store(&scan->next_count, 0);
+    if (2 * LEAK_PARALLEL_MIN > level_count) {
+      leak_mark_blocks(scan, 0, level_count); /* Not worth the threads */
+    } else {
+      cme_parallel_for(level_count, LEAK_PARALLEL_MIN, leak_mark_blocks,
+                       scan);
+    }
+  }
+
+  return 0;
+}
+
+/* --------------------------------------------------------------------------
+ * Function: leak_mark_roots
+ * --------------------------------------------------------------------------
+ *
+ * Description: Mark the blocks the pieces [begin, end) of the roots point to
+ *              (a chunk of the parallel loop)
+ *
+ * Parameters:
+ *        ctx: The scan
+ *      begin: First piece
+ *        end: Past the last piece
+ *
+ * Returns: None
+ *
+ * -------------------------------------------------------------------------- */
+static void leak_mark_roots(void *ctx, size_t begin, size_t end) {
+  leak_scan *scan = ctx;
+  size_t batch[LEAK_BATCH];
+  size_t used = 0;
+  size_t i = 0;
+
+  for (i = begin; i < end; i++) {
+    used = leak_scan_words(scan, scan->chunks[i].begin, scan->chunks[i].end,
+                           batch, used);
+  }
+  leak_publish(scan, batch, used);
+}
+
+/* --------------------------------------------------------------------------
+ * Function: leak_mark_blocks
+ * --------------------------------------------------------------------------
+ *
+ * Description: Mark the blocks the blocks [begin, end) of the last level
+ *              point to (a chunk of the parallel loop)
+ *
+ * Parameters:
+ *        ctx: The scan
+ *      begin: First block of the level
+ *        end: Past the last block of the level
+ *
+ * Returns: None
+ *
+ * -------------------------------------------------------------------------- */
+static void leak_mark_blocks(void *ctx, size_t begin, size_t end) {
+  leak_scan *scan = ctx;
+  size_t batch[LEAK_BATCH];
+  size_t used = 0;
+  size_t block = 0;
+  size_t i = 0;
+
+  for (i = begin; i < end; i++) {
+    block = scan->level[i];
+    used = leak_scan_words(scan, scan->starts[block], scan->ends[block],
+                           batch, used);
+  }
+  leak_publish(scan, batch, used);
+}
+
+/* --------------------------------------------------------------------------
+ * Function: leak_scan_words
+ * --------------------------------------------------------------------------
+ *
+ * Description: Mark the blocks the aligned words of [begin, end) point to
+ *              (at their start or inside), collecting the newly marked ones
+ *              in a batch that is added to the next level when full
+ *
+ * Parameters:
+ *       scan: The scan
+ *      begin: Start of the memory to scan
+ *        end: End of the memory to scan
+ *      batch: Newly marked blocks not added to the next level yet
+ *       used: Blocks in the batch
+ *
+ * Returns: Blocks in the batch
+ *
+ * -------------------------------------------------------------------------- */
+static size_t LEAK_NO_SANITIZE leak_scan_words(leak_scan *scan,
+                                               uintptr_t begin, uintptr_t end,
+                                               size_t *batch, size_t used) {
+  const uintptr_t align = sizeof(uintptr_t) - 1;
+  const uintptr_t *word = (const uintptr_t *)((begin + align) & ~align);
+  const uintptr_t *last = (const uintptr_t *)(end & ~align);
+  uintptr_t value = 0;
+  size_t block = 0;
+
+  for (; word < last; word++) {
+    value = *word;
+    if (value - scan->low >= scan->span) {
+      continue; /* Not into the heap (most words) */
+    }
+    block = leak_find(scan, value);
+    if (SIZE_MAX == block ||
+        atomic_exchange_explicit(&scan->marks[block], 1,
+                                 memory_order_relaxed)) {
+      continue;
+    }
+    batch[used++] = block;
+    if (LEAK_BATCH == used) {
+      leak_publish(scan, batch, used);
+      used = 0;
+    }
+  }
+
+  return used;
+}
+
+/* --------------------------------------------------------------------------
+ * Function: leak_find
+ * --------------------------------------------------------------------------
+ *
+ * Description: Block an address points into (binary search of the blocks
+ *              starting in its bucket)
+ *
+ * Parameters:
+ *      scan: The scan
+ *      addr: The address (within the range of the heap)
+ *
+ * Returns: Index of the block, or SIZE_MAX if the address is in none
+ *
+ * -------------------------------------------------------------------------- */
+static size_t leak_find(const leak_scan *scan, uintptr_t addr) {
+  size_t bucket = (addr - scan->low) >> scan->bucket_shift;
+  size_t low = scan->buckets[bucket];
+  size_t high = scan->buckets[bucket + 1];
+  size_t mid = 0;
+
+  /* Last block starting at or below the address (the one before the
+     bucket if none starts in it before the address) */
+  while (low < high) {
+    mid = low + (high - low) / 2;
+    if (scan->starts[mid] <= addr) {
+      low = mid + 1;
+    } else {
+      high = mid;
+    }
+  }
+  if (0 == low) {
+    return SIZE_MAX;
+  }
+  low--;
+
+  return addr < scan->ends[low] || addr == scan->starts[low] ? low : SIZE_MAX;
+}
+
+/* --------------------------------------------------------------------------
+ * Function: leak_publish
+ * --------------------------------------------------------------------------
+ *
+ * Description: Add a batch of newly marked blocks to the next level
+ *
+ * Parameters:
+ *       scan: The scan
+ *      batch: The blocks
+ *       used: Number of blocks
+ *
+ * Returns: None
+ *
+ * -------------------------------------------------------------------------- */
+static void leak_publish(leak_scan *scan, const size_t *batch, size_t used) {
+  size_t at = 0;
+
+  if (0 == used) {
+    return;
+  }
+  at = atomic_fetch_add_explicit(&scan->next_count, used,
+                                 memory_order_relaxed);
+  memcpy(scan->next + at, batch, used * sizeof(size_t));
+}
+
+/* --------------------------------------------------------------------------
+ * Function: leak_report
+ * --------------------------------------------------------------------------
+ *
+ * Description: Report the unmarked blocks on `stderr`, by allocation site,
+ *              most bytes first
+ *
+ * Parameters:
+ *         scan: The marked scan
+ *      dropped: Blocks that were not tracked
+ *
+ * Returns: Number of unmarked blocks
+ *
+ * -------------------------------------------------------------------------- */
+static long leak_report(const leak_scan *scan, size_t dropped) {
+  leak_site *sites = NULL;
+  const leak_entry *entry = NULL;
+  const char *file = NULL;
+  uint64_t bytes = 0;
+  size_t leaked = 0;
+  size_t num_sites = 0;
+  size_t i = 0;
+
+  for (i = 0; i < scan->count; i++) {
+    leaked += 0 == atomic_load_explicit(&scan->marks[i], memory_order_relaxed);
+  }
+  if (0 < dropped) {
+    fprintf(stderr,
+            "cme_leakcheck: %zu blocks were not tracked (out of memory)\n",
+            dropped);
+  }
+  if (0 == leaked) {
+    fprintf(stderr, "cme_leakcheck: no leaks (%zu blocks live)\n",
+            scan->count);
+    return 0;
+  }
+
+  sites = malloc(leaked * sizeof(leak_site));
+  if (NULL == sites) {
+    fprintf(stderr, "cme_leakcheck: %zu blocks unreachable\n", leaked);
+    return (long)leaked;
+  }
+  for (i = 0; i < scan->count; i++) {
+    if (0 != atomic_load_explicit(&scan->marks[i], memory_order_relaxed)) {
+      continue;
+    }
+    entry = scan->entries[i];
+    sites[num_sites].file = entry->file;
+    sites[num_sites].func = entry->func;
+    sites[num_sites].line = entry->line;
+    sites[num_sites].blocks = 1;
+    sites[num_sites].bytes = entry->size;
+    bytes += entry->size;
+    num_sites++;
+  }
+
+  /* One line per site */
+  qsort(sites, num_sites, sizeof(leak_site), leak_site_order);
+  for (num_sites = 0, i = 0; i < leaked; i++) {
+    if (0 < num_sites && 0 == leak_site_order(&sites[num_sites - 1],
+                                              &sites[i])) {
+      sites[num_sites - 1].blocks++;
+      sites[num_sites - 1].bytes += sites[i].bytes;
+    } else {
+      sites[num_sites++] = sites[i];
+    }
+  }
+  qsort(sites, num_sites, sizeof(leak_site), leak_site_bytes);
+
+  fprintf(stderr,
+          "cme_leakcheck: %zu of %zu blocks (%llu bytes) unreachable\n",
+          leaked, scan->count, (unsigned long long)bytes);
+  fprintf(stderr, "%10s %12s  %s\n", "blocks", "bytes", "allocated at");
+  for (i = 0; i < num_sites; i++) {
+    fprintf(stderr, "%10llu %12llu  ", (unsigned long long)sites[i].blocks,
+            (unsigned long long)sites[i].bytes);
+    if (NULL == sites[i].file) {
+      fprintf(stderr, "(unknown site)\n");
+      continue;
+    }
+    file = strrchr(sites[i].file, '/');
+    file = file ? file + 1 : sites[i].file;
+    fprintf(stderr, "%s:%d (%s)\n", file, sites[i].line, sites[i].func);
+  }
+
+  free(sites);
+
+  return (long)leaked;
+}
+
+/* --------------------------------------------------------------------------
+ * Function: leak_site_order
+ * --------------------------------------------------------------------------
+ *
+ * Description: Order allocation sites (by the address of their file name,
+ *              then line), so the blocks of a site end up next to each other
+ *
+ * Parameters:
+ *      a: First site
+ *      b: Second site
+ *
+ * Returns: Negative, zero or positive, as for `qsort`
+ *
+ * -------------------------------------------------------------------------- */
+static int leak_site_order(const void *a, const void *b) {
+  const leak_site *site_a = a;
+  const leak_site *site_b = b;
+  uintptr_t file_a = (uintptr_t)site_a->file;
+  uintptr_t file_b = (uintptr_t)site_b->file;
+
+  if (file_a != file_b) {
+    return (file_a > file_b) - (file_a < file_b);
+  }
+
+  return (site_a->line > site_b->line) - (site_a->line < site_b->line);
+}
+
+/* --------------------------------------------------------------------------
+ * Function: leak_site_bytes
+ * --------------------------------------------------------------------------
+ *
+ * Description: Order allocation sites by their unreachable bytes, most first
+ *
+ * Parameters:
+ *      a: First site
+ *      b: Second site
+ *
+ * Returns: Negative, zero or positive, as for `qsort`
+ *
+ * -------------------------------------------------------------------------- */
+static int leak_site_bytes(const void *a, const void *b) {
+  uint64_t bytes_a = ((const leak_site *)a)->bytes;
+  uint64_t bytes_b = ((const leak_site *)b)->bytes;
+
+  return (bytes_a < bytes_b) - (bytes_a > bytes_b);
+}
+
+#endif /* CME_HAVE_LEAKCHECK */
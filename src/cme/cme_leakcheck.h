@@ -0,0 +1,62 @@
+/* ==========================================================================
+ *  Copyright (C) 2026 Ljubomir Kurij <ljubomir_kurij@protonmail.com>
+ *
+ * This file is part of "C Common Memory Errors".
+ *
+ * "C Common Memory Errors" is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * "C Common Memory Errors" is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General
+ * Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with Focus Precision Analyze. If not, see <https://www.gnu.org/licenses/>.
+ * ========================================================================== */
+
+/* ==========================================================================
+ *
+ * 2026-10-18 Ljubomir Kurij <ljubomir_kurij@protonmail.com>
+ *
+ * * cme_leakcheck.h: created.
+ *
+ * ========================================================================== */
+
+#ifndef CME_LEAKCHECK_H_
+#define CME_LEAKCHECK_H_
+
+/* ==========================================================================
+ * Headers Include Section
+ * ========================================================================== */
+
+/* Standard Library headers */
+#include <stddef.h>
+
+/* ==========================================================================
+ * Macros Definitions Section
+ * ========================================================================== */
+
+/* Environment variable read on the first allocation: CME_LEAKS=1 tracks
+   every block and scans the heap for unreachable blocks at exit */
+#define CME_LEAKCHECK_ENV "CME_LEAKS"
+
+/* Tables the live blocks are spread over (each with a lock of its own) */
+#define CME_LEAKCHECK_SHARDS 64
+
+/* Writable segments of the program and its libraries scanned at most */
+#define CME_LEAKCHECK_MAX_SEGMENTS 256
+
+/* ==========================================================================
+ * Function Declarations Section
+ * ========================================================================== */
+
+int cme_leakcheck_start(void);
+long cme_leakcheck_run(void);
+void cme_leakcheck_track(void *ptr, size_t size, const char *file, int line,
+                         const char *func);
+void cme_leakcheck_forget(const void *ptr);
+
+#endif /* CME_LEAKCHECK_H_ */
@@ -0,0 +1,282 @@
+/* ==========================================================================
+ *  Copyright (C) 2026 Ljubomir Kurij <ljubomir_kurij@protonmail.com>
+ *
+ * This file is part of "C Common Memory Errors".
+ *
+ * "C Common Memory Errors" is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * "C Common Memory Errors" is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General
+ * Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with Focus Precision Analyze. If not, see <https://www.gnu.org/licenses/>.
+ * ========================================================================== */
+
+/* ==========================================================================
+ *
+ * 2026-10-18 Ljubomir Kurij <ljubomir_kurij@protonmail.com>
+ *
+ * * cme_leaks.c: created.
+ *
+ * ========================================================================== */
+
+/* ==========================================================================
+ * Headers Include Section
+ * ========================================================================== */
+
+/* Related header */
+#include "cme_leaks.h"
+
+/* System headers */
+
+/* Standard Library headers */
+#include <errno.h>
+#include <limits.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/* Project headers */
+#include "cme_alloc.h"
+
+/* ==========================================================================
+ * Private Function Declarations Section
+ * ========================================================================== */
+
+static int parse_int_list(const char *text, int **values, size_t *count,
+                          int buggy);
+
+/* ==========================================================================
+ * Function Definitions Section
+ * ========================================================================== */
+
+/* --------------------------------------------------------------------------
+ * Function: cme_greeting
+ * --------------------------------------------------------------------------
+ *
+ * Description: Build a greeting for a name
+ *
+ * Parameters:
+ *      name: Name to greet
+ *
+ * Returns: "Hello, NAME!" (release it with `cme_free`), or NULL on failure
+ *
+ * -------------------------------------------------------------------------- */
+char *cme_greeting(const char *name) {
+  size_t size = strlen("Hello, !") + strlen(name) + 1;
+  char *text = cme_malloc(size);
+
+  if (text) {
+    snprintf(text, size, "Hello, %s!", name);
+  }
+
+  return text;
+}
+
+/* --------------------------------------------------------------------------
+ * Function: cme_split_words
+ * --------------------------------------------------------------------------
+ *
+ * Description: Split a text into a list of its words (runs of characters
+ *              other than blanks), in order
+ *
+ * Parameters:
+ *      text: Text to split
+ *
+ * Returns: The list (release it with `cme_word_list_free`), or NULL if the
+ *          text has no words or on failure
+ *
+ * -------------------------------------------------------------------------- */
+cme_word_list *cme_split_words(const char *text) {
+  cme_word_list *head = NULL;
+  cme_word_list **tail = &head;
+  cme_word_list *node = NULL;
+  size_t length = 0;
+
+  for (text += strspn(text, " \t\n"); '\0' != *text;
+       text += strspn(text, " \t\n")) {
+    length = strcspn(text, " \t\n");
+    node = cme_malloc(sizeof(cme_word_list));
+    if (NULL == node) {
+      cme_word_list_free(head);
+      return NULL;
+    }
+    node->next = NULL;
+    node->word = cme_malloc(length + 1);
+    if (NULL == node->word) {
+      cme_free(node);
+      cme_word_list_free(head);
+      return NULL;
+    }
+    memcpy(node->word, text, length);
+    node->word[length] = '\0';
+
+    *tail = node;
+    tail = &node->next;
+    text += length;
+  }
+
+  return head;
+}
+
+/* --------------------------------------------------------------------------
+ * Function: cme_word_list_free
+ * --------------------------------------------------------------------------
+ *
+ * Description: Release a list of words: every node, and the word it holds
+ *
+ * Parameters:
+ *      list: List to release (may be NULL)
+ *
+ * Returns: None
+ *
+ * -------------------------------------------------------------------------- */
+void cme_word_list_free(cme_word_list *list) {
+  cme_word_list *next = NULL;
+
+  while (list) {
+    next = list->next;
+    cme_free(list->word);
+    cme_free(list);
+    list = next;
+  }
+}
+
+/* --------------------------------------------------------------------------
+ * Function: cme_word_list_free_buggy
+ * --------------------------------------------------------------------------
+ *
+ * Description: Same as `cme_word_list_free`, as first written: only the
+ *              nodes are released. The words they point to are left behind,
+ *              with nothing pointing to them any more.
+ *
+ * Parameters:
+ *      list: List to release (may be NULL)
+ *
+ * Returns: None
+ *
+ * -------------------------------------------------------------------------- */
+void cme_word_list_free_buggy(cme_word_list *list) {
+  cme_word_list *next = NULL;
+
+  while (list) {
+    next = list->next;
+    cme_free(list);
+    list = next;
+  }
+}
+
+/* --------------------------------------------------------------------------
+ * Function: cme_parse_int_list
+ * --------------------------------------------------------------------------
+ *
+ * Description: Parse a comma separated list of integers (e.g. "4, 8, 15")
+ *
+ * Parameters:
+ *        text: Text to parse
+ *      values: Receives the integers (release them with `cme_free`), or NULL
+ *              on failure
+ *       count: Receives the number of integers
+ *
+ * Returns: 0 on success, -1 on a malformed or out of range number, or on
+ *          failure to allocate
+ *
+ * -------------------------------------------------------------------------- */
+int cme_parse_int_list(const char *text, int **values, size_t *count) {
+  return parse_int_list(text, values, count, 0);
+}
+
+/* --------------------------------------------------------------------------
+ * Function: cme_parse_int_list_buggy
+ * --------------------------------------------------------------------------
+ *
+ * Description: Same as `cme_parse_int_list`, as first written: on a
+ *              malformed number the function returns without releasing the
+ *              integers parsed so far
+ *
+ * Parameters:
+ *        text: Text to parse
+ *      values: Receives the integers, or NULL on failure
+ *       count: Receives the number of integers
+ *
+ * Returns: 0 on success, -1 on a malformed or out of range number, or on
+ *          failure to allocate
+ *
+ * -------------------------------------------------------------------------- */
+int cme_parse_int_list_buggy(const char *text, int **values, size_t *count) {
+  return parse_int_list(text, values, count, 1);
+}
+
+/* ==========================================================================
+ * Private Function Definitions Section
+ * ========================================================================== */
+
+/* --------------------------------------------------------------------------
+ * Function: parse_int_list
+ * --------------------------------------------------------------------------
+ *
+ * Description: Parse a comma separated list of integers into an array that
+ *              doubles as it fills up
+ *
+ * Parameters:
+ *        text: Text to parse
+ *      values: Receives the integers, or NULL on failure
+ *       count: Receives the number of integers
+ *       buggy: Nonzero to leave the array behind on a malformed number
+ *
+ * Returns: 0 on success, -1 on failure
+ *
+ * -------------------------------------------------------------------------- */
+static int parse_int_list(const char *text, int **values, size_t *count,
+                          int buggy) {
+  int *array = NULL;
+  int *grown = NULL;
+  size_t cap = 0;
+  size_t used = 0;
+  char *end = NULL;
+  long value = 0;
+
+  *values = NULL;
+  *count = 0;
+  while ('\0' != *text) {
+    errno = 0;
+    value = strtol(text, &end, 10);
+    end += strspn(end, " \t");
+    if (end == text || 0 != errno || INT_MIN > value || INT_MAX < value ||
+        (',' != *end && '\0' != *end)) {
+      /* Returning here without releasing the array -------------------------
+
+         The integers parsed so far are in a block only `array` points to.
+         Returning without releasing it loses the only pointer to the block,
+         and the block is never released (a leak on the error path, the
+         kind that goes unnoticed as long as the input is well formed).
+      */
+      if (!buggy) {
+        cme_free(array);
+      }
+      return -1;
+    }
+
+    if (used == cap) {
+      cap = 0 < cap ? 2 * cap : 4;
+      grown = cme_realloc(array, cap * sizeof(int));
+      if (NULL == grown) {
+        cme_free(array);
+        return -1;
+      }
+      array = grown;
+    }
+    array[used++] = (int)value;
+    text = ',' == *end ? end + 1 : end;
+  }
+
+  *values = array;
+  *count = used;
+
+  return 0;
+}
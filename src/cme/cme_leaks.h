@@ -0,0 +1,63 @@
+/* ==========================================================================
+ *  Copyright (C) 2026 Ljubomir Kurij <ljubomir_kurij@protonmail.com>
+ *
+ * This file is part of "C Common Memory Errors".
+ *
+ * "C Common Memory Errors" is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * "C Common Memory Errors" is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General
+ * Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with Focus Precision Analyze. If not, see <https://www.gnu.org/licenses/>.
+ * ========================================================================== */
+
+/* ==========================================================================
+ *
+ * 2026-10-18 Ljubomir Kurij <ljubomir_kurij@protonmail.com>
+ *
+ * * cme_leaks.h: created.
+ *
+ * ========================================================================== */
+
+#ifndef CME_LEAKS_H_
+#define CME_LEAKS_H_
+
+/* ==========================================================================
+ * Headers Include Section
+ * ========================================================================== */
+
+/* Standard Library headers */
+#include <stddef.h>
+
+/* ==========================================================================
+ * Type Definitions Section
+ * ========================================================================== */
+
+/* Singly linked list of words. Each node and each word is a block of its
+   own. */
+typedef struct cme_word_list {
+  struct cme_word_list *next;
+  char *word;
+} cme_word_list;
+
+/* ==========================================================================
+ * Function Declarations Section
+ * ========================================================================== */
+
+/* Routines of the memory leaks demo. The `_buggy` variants keep the leak
+   the demo is about. */
+
+char *cme_greeting(const char *name);
+cme_word_list *cme_split_words(const char *text);
+void cme_word_list_free(cme_word_list *list);
+void cme_word_list_free_buggy(cme_word_list *list);
+int cme_parse_int_list(const char *text, int **values, size_t *count);
+int cme_parse_int_list_buggy(const char *text, int **values, size_t *count);
+
+#endif /* CME_LEAKS_H_ */
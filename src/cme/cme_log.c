@@ -0,0 +1,799 @@
+/* ==========================================================================
+ *  Copyright (C) 2026 Ljubomir Kurij <ljubomir_kurij@protonmail.com>
+ *
+ * This file is part of "C Common Memory Errors".
+ *
+ * "C Common Memory Errors" is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * "C Common Memory Errors" is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General
+ * Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with Focus Precision Analyze. If not, see <https://www.gnu.org/licenses/>.
+ * ========================================================================== */
+
+/* ==========================================================================
+ *
+ * 2026-10-18 Ljubomir Kurij <ljubomir_kurij@protonmail.com>
+ *
+ * * cme_log.c: created.
+ *
+ * ========================================================================== */
+
+/* ==========================================================================
+ * Headers Include Section
+ * ========================================================================== */
+
+/* Related header */
+#include "cme_log.h"
+
+/* System headers */
+#if defined(CME_HAVE_PTHREADS) && !defined(__STDC_NO_ATOMICS__)
+#define CME_LOG_ASYNC 1
+#include <pthread.h>
+#include <sched.h>
+#include <signal.h>
+#include <stdatomic.h>
+#include <time.h>
+#include <unistd.h>
+#endif /* End of platform specific headers */
+
+/* Standard Library headers */
+#include <stdarg.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/* ==========================================================================
+ * Macros Definitions Section
+ * ========================================================================== */
+
+/* Longest prefix kept (the ": " separator included) */
+#define LOG_PREFIX_SIZE 64
+
+/* Record flags */
+#define LOG_FIRST 0x1u  /* First slot of a record */
+#define LOG_STDERR 0x2u /* Goes to stderr instead of stdout */
+#define LOG_RAW 0x4u    /* No prefix */
+
+/* Smallest queue: the longest record has to fit it */
+#define LOG_MIN_SLOTS 64
+
+/* Longest a sleeping writer waits before looking at the queue again. This
+   bounds the delay of a wakeup lost to a race with a logging thread. */
+#define LOG_WAIT_NS 1000000L
+
+/* `g_taken` once a crash handler has taken the queue over */
+#define LOG_TAKEN_CRASHED SIZE_MAX
+
+/* Longest a crash handler waits, in steps of `LOG_WAIT_NS`, for the writer
+   to finish the block it is writing */
+#define LOG_CRASH_WAIT_STEPS 100
+
+/* ==========================================================================
+ * Type Definitions Section
+ * ========================================================================== */
+
+#ifdef CME_LOG_ASYNC
+/* One cache line of the queue. `seq` is the ticket protocol of a bounded
+   multi producer queue: a slot with `seq == pos` is free for the record
+   claiming position `pos`, `seq == pos + 1` means the record is published,
+   and the writer frees it for the next lap with `seq = pos + slots`. */
+typedef struct log_slot {
+  _Alignas(CME_LOG_SLOT_SIZE) atomic_size_t seq;
+  uint16_t length;
+  uint8_t flags;
+  char text[CME_LOG_SLOT_SIZE - 2 * sizeof(size_t)];
+} log_slot;
+
+_Static_assert(sizeof(log_slot) == CME_LOG_SLOT_SIZE,
+               "log slot does not fill exactly one cache line");
+_Static_assert(LOG_MIN_SLOTS * sizeof(((log_slot *)0)->text) >
+                   CME_LOG_MAX_MESSAGE,
+               "the longest record does not fit the smallest queue");
+#endif
+
+/* ==========================================================================
+ * Private Function Declarations Section
+ * ========================================================================== */
+
+static void log_va(unsigned flags, const char *format, va_list args);
+#ifdef CME_LOG_ASYNC
+static void push(unsigned flags, const char *text, size_t length);
+static void *writer(void *arg);
+static int take(size_t begin, size_t end);
+static void release(size_t begin, size_t end);
+static void wait_for(pthread_cond_t *cond);
+static void wake_writer(void);
+static void install_crash_handlers(void);
+static void crash_handler(int signal_number);
+#endif
+
+/* ==========================================================================
+ * Global Variables Section
+ * ========================================================================== */
+
+static char g_prefix[LOG_PREFIX_SIZE] = "";
+static size_t g_prefix_len = 0;
+
+#ifdef CME_LOG_ASYNC
+static log_slot *g_slots = NULL;
+static size_t g_num_slots = 0;
+static cme_log_overflow g_overflow = CME_LOG_BLOCK;
+
+static atomic_int g_running = 0;   /* Records go through the queue */
+static atomic_int g_stopping = 0;  /* Writer drains the queue and quits */
+static atomic_int g_sleeping = 0;  /* Writer waits for records */
+static atomic_int g_flushing = 0;  /* Threads wait in `cme_log_flush` */
+static atomic_size_t g_head = 0;     /* Next position to claim */
+static atomic_size_t g_taken = 0;    /* Positions before this are written
+                                        or being written */
+static atomic_size_t g_released = 0; /* Positions before this are written */
+static atomic_uint_fast64_t g_dropped = 0;
+
+static pthread_t g_thread;
+static pthread_mutex_t g_lock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t g_wake = PTHREAD_COND_INITIALIZER;
+static pthread_cond_t g_written = PTHREAD_COND_INITIALIZER;
+#endif
+
+/* ==========================================================================
+ * Function Definitions Section
+ * ========================================================================== */
+
+/* --------------------------------------------------------------------------
+ * Function: cme_log_start
+ * --------------------------------------------------------------------------
+ *
+ * Description: Set the prefix of the records and start the background
+ *              writer. From here on a logging call formats its record on
+ *              the calling thread and copies it into a bounded lock free
+ *              queue; the writer adds the prefix and writes the records out
+ *              in large blocks. Pending records are written on exit and,
+ *              as far as possible, when the program crashes. Without thread
+ *              support (or with `CME_LOG=sync`) only the prefix is set.
+ *
+ * Parameters:
+ *        prefix: Put in front of every record (e.g. `APP_NAME`)
+ *         slots: Length of the queue in slots (rounded up to a power of
+ *                two, 0 means `CME_LOG_DEFAULT_SLOTS`)
+ *      overflow: What to do when the queue is full
+ *
+ * Returns: 0 if the writer runs, -1 if records are written synchronously
+ *
+ * -------------------------------------------------------------------------- */
+int cme_log_start(const char *prefix, size_t slots,
+                  cme_log_overflow overflow) {
+#ifdef CME_LOG_ASYNC
+  static int registered = 0;
+  const char *value = getenv(CME_LOG_ENV);
+  size_t i = 0;
+#endif
+
+  snprintf(g_prefix, sizeof(g_prefix), "%s: ", prefix ? prefix : "");
+  g_prefix_len = strlen(g_prefix);
+
+#ifdef CME_LOG_ASYNC
+  if (atomic_load(&g_running)) {
+    return 0;
+  }
+
+  if (value && 0 == strcmp(value, "sync")) {
+    return -1;
+  } else if (value && 0 == strcmp(value, "block")) {
+    overflow = CME_LOG_BLOCK;
+  } else if (value && 0 == strcmp(value, "drop")) {
+    overflow = CME_LOG_DROP;
+  } else if (value) {
+    fprintf(stderr, "cme_log: unknown mode '%s', ignored\n", value);
+  }
+
+  if (0 == slots) {
+    slots = CME_LOG_DEFAULT_SLOTS;
+  }
+  g_num_slots = LOG_MIN_SLOTS;
+  while (g_num_slots < slots) {
+    g_num_slots *= 2;
+  }
+
+  g_slots = aligned_alloc(CME_LOG_SLOT_SIZE, g_num_slots * sizeof(*g_slots));
+  if (!g_slots) {
+    return -1;
+  }
+  for (i = 0; i < g_num_slots; i++) {
+    atomic_init(&g_slots[i].seq, i);
+  }
+
+  g_overflow = overflow;
+  atomic_store(&g_head, 0);
+  atomic_store(&g_taken, 0);
+  atomic_store(&g_released, 0);
+  atomic_store(&g_stopping, 0);
+  atomic_store(&g_running, 1);
+  if (0 != pthread_create(&g_thread, NULL, writer, NULL)) {
+    atomic_store(&g_running, 0);
+    free(g_slots);
+    g_slots = NULL;
+    return -1;
+  }
+
+  if (!registered) {
+    registered = 1;
+    install_crash_handlers();
+    atexit(cme_log_stop);
+  }
+
+  return 0;
+#else
+  (void)slots;
+  (void)overflow;
+
+  return -1;
+#endif /* End of platform specific code */
+}
+
+/* --------------------------------------------------------------------------
+ * Function: cme_log_stop
+ * --------------------------------------------------------------------------
+ *
+ * Description: Write the pending records and stop the background writer.
+ *              Later records are written synchronously. Called on exit.
+ *              No thread may log while the writer stops.
+ *
+ * Parameters: None
+ *
+ * Returns: None
+ *
+ * -------------------------------------------------------------------------- */
+void cme_log_stop(void) {
+#ifdef CME_LOG_ASYNC
+  uint_fast64_t dropped = 0;
+
+  if (!atomic_load(&g_running)) {
+    return;
+  }
+
+  atomic_store(&g_stopping, 1);
+  wake_writer();
+  pthread_join(g_thread, NULL);
+  atomic_store(&g_running, 0);
+  free(g_slots);
+  g_slots = NULL;
+
+  dropped = atomic_load(&g_dropped);
+  if (0 < dropped) {
+    fprintf(stderr, "%s%llu record(s) dropped on a full log queue\n",
+            g_prefix, (unsigned long long)dropped);
+  }
+#endif
+}
+
+/* --------------------------------------------------------------------------
+ * Function: cme_log_flush
+ * --------------------------------------------------------------------------
+ *
+ * Description: Wait until every record logged so far is written (e.g.
+ *              before a prompt is answered, or before output bypasses the
+ *              log)
+ *
+ * Parameters: None
+ *
+ * Returns: None
+ *
+ * -------------------------------------------------------------------------- */
+void cme_log_flush(void) {
+#ifdef CME_LOG_ASYNC
+  size_t target = 0;
+
+  if (atomic_load(&g_running)) {
+    target = atomic_load(&g_head);
+
+    pthread_mutex_lock(&g_lock);
+    atomic_fetch_add(&g_flushing, 1);
+    pthread_cond_signal(&g_wake);
+    while (0 > (ptrdiff_t)(atomic_load(&g_released) - target)) {
+      wait_for(&g_written);
+    }
+    atomic_fetch_sub(&g_flushing, 1);
+    pthread_mutex_unlock(&g_lock);
+    return;
+  }
+#endif
+
+  fflush(stdout);
+  fflush(stderr);
+}
+
+/* --------------------------------------------------------------------------
+ * Function: cme_log_dropped
+ * --------------------------------------------------------------------------
+ *
+ * Description: Number of records dropped on a full queue
+ *
+ * Parameters: None
+ *
+ * Returns: Number of records dropped since the program started
+ *
+ * -------------------------------------------------------------------------- */
+uint64_t cme_log_dropped(void) {
+#ifdef CME_LOG_ASYNC
+  return (uint64_t)atomic_load(&g_dropped);
+#else
+  return 0;
+#endif
+}
+
+/* --------------------------------------------------------------------------
+ * Function: cme_log
+ * --------------------------------------------------------------------------
+ *
+ * Description: Log a prefixed message to stdout
+ *
+ * Parameters:
+ *      format: `printf` format of the message
+ *         ...: Format arguments
+ *
+ * Returns: None
+ *
+ * -------------------------------------------------------------------------- */
+void cme_log(const char *format, ...) {
+  va_list args;
+
+  va_start(args, format);
+  log_va(0, format, args);
+  va_end(args);
+}
+
+/* --------------------------------------------------------------------------
+ * Function: cme_log_raw
+ * --------------------------------------------------------------------------
+ *
+ * Description: Log a message to stdout without the prefix (e.g. the rest of
+ *              a line, or a blank line)
+ *
+ * Parameters:
+ *      format: `printf` format of the message
+ *         ...: Format arguments
+ *
+ * Returns: None
+ *
+ * -------------------------------------------------------------------------- */
+void cme_log_raw(const char *format, ...) {
+  va_list args;
+
+  va_start(args, format);
+  log_va(LOG_RAW, format, args);
+  va_end(args);
+}
+
+/* --------------------------------------------------------------------------
+ * Function: cme_log_error
+ * --------------------------------------------------------------------------
+ *
+ * Description: Log a prefixed message to stderr
+ *
+ * Parameters:
+ *      format: `printf` format of the message
+ *         ...: Format arguments
+ *
+ * Returns: None
+ *
+ * -------------------------------------------------------------------------- */
+void cme_log_error(const char *format, ...) {
+  va_list args;
+
+  va_start(args, format);
+  log_va(LOG_STDERR, format, args);
+  va_end(args);
+}
+
+/* ==========================================================================
+ * Private Function Definitions Section
+ * ========================================================================== */
+
+/* --------------------------------------------------------------------------
+ * Function: log_va
+ * --------------------------------------------------------------------------
+ *
+ * Description: Format a record and queue it, or write it right away if the
+ *              writer does not run
+ *
+ * Parameters:
+ *       flags: Record flags
+ *      format: `printf` format of the message
+ *        args: Format arguments
+ *
+ * Returns: None
+ *
+ * -------------------------------------------------------------------------- */
+static void log_va(unsigned flags, const char *format, va_list args) {
+  FILE *stream = (flags & LOG_STDERR) ? stderr : stdout;
+#ifdef CME_LOG_ASYNC
+  char text[CME_LOG_MAX_MESSAGE];
+  int length = 0;
+
+  if (atomic_load_explicit(&g_running, memory_order_relaxed)) {
+    length = vsnprintf(text, sizeof(text), format, args);
+    if (0 < length) {
+      push(flags, text,
+           (size_t)length < sizeof(text) ? (size_t)length : sizeof(text) - 1);
+    }
+    return;
+  }
+#endif
+
+  if (!(flags & LOG_RAW)) {
+    fputs(g_prefix, stream);
+  }
+  vfprintf(stream, format, args);
+}
+
+#ifdef CME_LOG_ASYNC
+/* --------------------------------------------------------------------------
+ * Function: push
+ * --------------------------------------------------------------------------
+ *
+ * Description: Claim consecutive slots for a record, copy it in and publish
+ *              it. The claim is a single compare and swap on the head
+ *              position. Since the writer frees the slots in order, the
+ *              record fits once the last slot it needs is free.
+ *
+ * Parameters:
+ *       flags: Record flags
+ *        text: Formatted record
+ *      length: Length of the record
+ *
+ * Returns: None
+ *
+ * -------------------------------------------------------------------------- */
+static void push(unsigned flags, const char *text, size_t length) {
+  const size_t capacity = sizeof(g_slots[0].text);
+  const size_t count = (length + capacity - 1) / capacity;
+  const size_t mask = g_num_slots - 1;
+  size_t pos = atomic_load_explicit(&g_head, memory_order_relaxed);
+  size_t last = 0;
+  ptrdiff_t diff = 0;
+  log_slot *slot = NULL;
+  size_t chunk = 0;
+  size_t i = 0;
+
+  for (;;) {
+    last = pos + count - 1;
+    diff = (ptrdiff_t)(atomic_load_explicit(&g_slots[last & mask].seq,
+                                            memory_order_acquire) -
+                       last);
+    if (0 == diff) {
+      if (atomic_compare_exchange_weak_explicit(&g_head, &pos, pos + count,
+                                                memory_order_relaxed,
+                                                memory_order_relaxed)) {
+        break;
+      }
+    } else if (0 > diff) {
+      /* Queue full */
+      if (CME_LOG_DROP == g_overflow) {
+        atomic_fetch_add_explicit(&g_dropped, 1, memory_order_relaxed);
+        return;
+      }
+      wake_writer();
+      sched_yield();
+      pos = atomic_load_explicit(&g_head, memory_order_relaxed);
+    } else {
+      pos = atomic_load_explicit(&g_head, memory_order_relaxed);
+    }
+  }
+
+  for (i = 0; i < count; i++) {
+    slot = &g_slots[(pos + i) & mask];
+    chunk = length < capacity ? length : capacity;
+    memcpy(slot->text, text, chunk);
+    slot->length = (uint16_t)chunk;
+    slot->flags = (uint8_t)(flags | (0 == i ? LOG_FIRST : 0));
+    atomic_store_explicit(&slot->seq, pos + i + 1, memory_order_release);
+    text += chunk;
+    length -= chunk;
+  }
+
+  /* Only the first record after the writer went to sleep pays for the
+     wakeup */
+  if (atomic_load_explicit(&g_sleeping, memory_order_relaxed) &&
+      atomic_exchange(&g_sleeping, 0)) {
+    wake_writer();
+  }
+}
+
+/* --------------------------------------------------------------------------
+ * Function: writer
+ * --------------------------------------------------------------------------
+ *
+ * Description: Background writer. Gathers the published records, with their
+ *              prefixes, into one buffer and writes it out when it is full,
+ *              when the stream changes or when the queue runs dry. Slots
+ *              are freed only after their records are written, so a crash
+ *              handler finds every record not yet out still in the queue.
+ *              The writer quits without writing once a crash handler has
+ *              taken the queue over.
+ *
+ * Parameters:
+ *      arg: Unused
+ *
+ * Returns: NULL
+ *
+ * -------------------------------------------------------------------------- */
+static void *writer(void *arg) {
+  const size_t mask = g_num_slots - 1;
+  char *buffer = malloc(CME_LOG_BUFFER_SIZE);
+  FILE *current = stdout;
+  FILE *stream = NULL;
+  log_slot *slot = NULL;
+  size_t used = 0;
+  size_t tail = 0;
+  size_t written = 0;
+  size_t need = 0;
+
+  (void)arg;
+
+  for (;;) {
+    slot = &g_slots[tail & mask];
+    if (tail + 1 == atomic_load_explicit(&slot->seq, memory_order_acquire)) {
+      stream = (slot->flags & LOG_STDERR) ? stderr : stdout;
+      need = slot->length;
+      if ((slot->flags & LOG_FIRST) && !(slot->flags & LOG_RAW)) {
+        need += g_prefix_len;
+      }
+
+      if (!buffer) {
+        /* No buffer: write the record as is */
+        if (!take(tail, tail + 1)) {
+          break;
+        }
+        if ((slot->flags & LOG_FIRST) && !(slot->flags & LOG_RAW)) {
+          fputs(g_prefix, stream);
+        }
+        fwrite(slot->text, 1, slot->length, stream);
+        fflush(stream);
+        release(tail, tail + 1);
+        written = ++tail;
+        continue;
+      }
+
+      if (0 < used &&
+          (stream != current || CME_LOG_BUFFER_SIZE < used + need)) {
+        if (!take(written, tail)) {
+          break;
+        }
+        fwrite(buffer, 1, used, current);
+        fflush(current);
+        used = 0;
+        release(written, tail);
+        written = tail;
+      }
+      current = stream;
+
+      if ((slot->flags & LOG_FIRST) && !(slot->flags & LOG_RAW)) {
+        memcpy(buffer + used, g_prefix, g_prefix_len);
+        used += g_prefix_len;
+      }
+      memcpy(buffer + used, slot->text, slot->length);
+      used += slot->length;
+      tail++;
+      continue;
+    }
+
+    /* Queue empty (or the next record not yet published) */
+    if (0 < used) {
+      if (!take(written, tail)) {
+        break;
+      }
+      fwrite(buffer, 1, used, current);
+      fflush(current);
+      used = 0;
+      release(written, tail);
+      written = tail;
+      continue;
+    }
+    if (atomic_load(&g_stopping) && atomic_load(&g_head) == tail) {
+      break;
+    }
+
+    pthread_mutex_lock(&g_lock);
+    atomic_store(&g_sleeping, 1);
+    if (tail + 1 != atomic_load(&slot->seq) && !atomic_load(&g_stopping)) {
+      wait_for(&g_wake);
+    }
+    atomic_store(&g_sleeping, 0);
+    pthread_mutex_unlock(&g_lock);
+  }
+
+  free(buffer);
+
+  return NULL;
+}
+
+/* --------------------------------------------------------------------------
+ * Function: take
+ * --------------------------------------------------------------------------
+ *
+ * Description: Take written records for writing out. Published before the
+ *              writer writes them, so a crash handler leaves them to it.
+ *
+ * Parameters:
+ *      begin: First position to write
+ *        end: One past the last position to write
+ *
+ * Returns: Nonzero if the records are the writer's to write, zero if a
+ *          crash handler has taken the queue over
+ *
+ * -------------------------------------------------------------------------- */
+static int take(size_t begin, size_t end) {
+  size_t expected = begin;
+
+  return atomic_compare_exchange_strong(&g_taken, &expected, end);
+}
+
+/* --------------------------------------------------------------------------
+ * Function: release
+ * --------------------------------------------------------------------------
+ *
+ * Description: Free written slots for the next lap and wake the threads
+ *              waiting for a flush
+ *
+ * Parameters:
+ *      begin: First written position
+ *        end: One past the last written position
+ *
+ * Returns: None
+ *
+ * -------------------------------------------------------------------------- */
+static void release(size_t begin, size_t end) {
+  const size_t mask = g_num_slots - 1;
+  size_t pos = 0;
+
+  for (pos = begin; pos != end; pos++) {
+    atomic_store_explicit(&g_slots[pos & mask].seq, pos + g_num_slots,
+                          memory_order_release);
+  }
+  atomic_store(&g_released, end);
+
+  if (atomic_load(&g_flushing)) {
+    pthread_mutex_lock(&g_lock);
+    pthread_cond_broadcast(&g_written);
+    pthread_mutex_unlock(&g_lock);
+  }
+}
+
+/* --------------------------------------------------------------------------
+ * Function: wait_for
+ * --------------------------------------------------------------------------
+ *
+ * Description: Wait on a condition (with `g_lock` held) for at most
+ *              `LOG_WAIT_NS`
+ *
+ * Parameters:
+ *      cond: Condition to wait on
+ *
+ * Returns: None
+ *
+ * -------------------------------------------------------------------------- */
+static void wait_for(pthread_cond_t *cond) {
+  struct timespec deadline;
+
+  timespec_get(&deadline, TIME_UTC);
+  deadline.tv_nsec += LOG_WAIT_NS;
+  if (1000000000L <= deadline.tv_nsec) {
+    deadline.tv_sec++;
+    deadline.tv_nsec -= 1000000000L;
+  }
+  pthread_cond_timedwait(cond, &g_lock, &deadline);
+}
+
+/* --------------------------------------------------------------------------
+ * Function: wake_writer
+ * --------------------------------------------------------------------------
+ *
+ * Description: Wake the background writer
+ *
+ * Parameters: None
+ *
+ * Returns: None
+ *
+ * -------------------------------------------------------------------------- */
+static void wake_writer(void) {
+  pthread_mutex_lock(&g_lock);
+  pthread_cond_signal(&g_wake);
+  pthread_mutex_unlock(&g_lock);
+}
+
+/* --------------------------------------------------------------------------
+ * Function: install_crash_handlers
+ * --------------------------------------------------------------------------
+ *
+ * Description: Catch the fatal signals not handled otherwise, so the
+ *              records still in the queue get out before the program dies
+ *
+ * Parameters: None
+ *
+ * Returns: None
+ *
+ * -------------------------------------------------------------------------- */
+static void install_crash_handlers(void) {
+  static const int kSignals[] = {SIGABRT, SIGBUS, SIGFPE, SIGILL, SIGSEGV};
+  struct sigaction action;
+  struct sigaction previous;
+  size_t i = 0;
+
+  memset(&action, 0, sizeof(action));
+  action.sa_handler = crash_handler;
+  action.sa_flags = SA_RESETHAND;
+  sigemptyset(&action.sa_mask);
+
+  for (i = 0; i < sizeof(kSignals) / sizeof(kSignals[0]); i++) {
+    if (0 == sigaction(kSignals[i], NULL, &previous) &&
+        SIG_DFL == previous.sa_handler) {
+      sigaction(kSignals[i], &action, NULL);
+    }
+  }
+}
+
+/* --------------------------------------------------------------------------
+ * Function: crash_handler
+ * --------------------------------------------------------------------------
+ *
+ * Description: Take the queue over from the writer, write the records it
+ *              has not taken yet with `write` (the only output that is safe
+ *              here) and die of the original signal. The block the writer is
+ *              in the middle of is left to it (the handler waits a moment
+ *              for it), so no record comes out twice or in pieces.
+ *
+ * Parameters:
+ *      signal_number: Fatal signal
+ *
+ * Returns: None
+ *
+ * -------------------------------------------------------------------------- */
+static void crash_handler(int signal_number) {
+  const struct timespec pause = {0, LOG_WAIT_NS};
+  const size_t mask = g_num_slots - 1;
+  size_t pos = 0;
+  size_t head = 0;
+  log_slot *slot = NULL;
+  int fd = 0;
+  int i = 0;
+
+  if (atomic_load(&g_running) && g_slots) {
+    /* The handler of another thread may have taken the queue over first */
+    pos = atomic_exchange(&g_taken, LOG_TAKEN_CRASHED);
+    if (LOG_TAKEN_CRASHED != pos) {
+      for (i = 0; i < LOG_CRASH_WAIT_STEPS &&
+                  0 > (ptrdiff_t)(atomic_load(&g_released) - pos);
+           i++) {
+        nanosleep(&pause, NULL);
+      }
+
+      head = atomic_load(&g_head);
+      for (; pos != head; pos++) {
+        slot = &g_slots[pos & mask];
+        if (pos + 1 != atomic_load(&slot->seq)) {
+          break;
+        }
+        fd = (slot->flags & LOG_STDERR) ? STDERR_FILENO : STDOUT_FILENO;
+        if ((slot->flags & LOG_FIRST) && !(slot->flags & LOG_RAW)) {
+          if (0 > write(fd, g_prefix, g_prefix_len)) {
+            break;
+          }
+        }
+        if (0 > write(fd, slot->text, slot->length)) {
+          break;
+        }
+      }
+    }
+  }
+
+  raise(signal_number);
+}
+#endif /* End of background writer */
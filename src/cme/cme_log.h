@@ -0,0 +1,95 @@
+/* ==========================================================================
+ *  Copyright (C) 2026 Ljubomir Kurij <ljubomir_kurij@protonmail.com>
+ *
+ * This file is part of "C Common Memory Errors".
+ *
+ * "C Common Memory Errors" is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * "C Common Memory Errors" is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General
+ * Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with Focus Precision Analyze. If not, see <https://www.gnu.org/licenses/>.
+ * ========================================================================== */
+
+/* ==========================================================================
+ *
+ * 2026-10-18 Ljubomir Kurij <ljubomir_kurij@protonmail.com>
+ *
+ * * cme_log.h: created.
+ *
+ * ========================================================================== */
+
+#ifndef CME_LOG_H_
+#define CME_LOG_H_
+
+/* ==========================================================================
+ * Headers Include Section
+ * ========================================================================== */
+
+/* Standard Library headers */
+#include <stddef.h>
+#include <stdint.h>
+
+/* ==========================================================================
+ * Macros Definitions Section
+ * ========================================================================== */
+
+/* Environment variable read by `cme_log_start`:
+
+   CME_LOG=sync|block|drop  Write on the calling thread (`sync`), or override
+                            the overflow policy of the background writer */
+#define CME_LOG_ENV "CME_LOG"
+
+/* Size of a queue slot (one cache line). A record takes as many slots as
+   its text needs, so a short line costs a single slot write. */
+#define CME_LOG_SLOT_SIZE 64
+
+/* Queue length used when `cme_log_start` is given 0 slots */
+#define CME_LOG_DEFAULT_SLOTS 4096
+
+/* Longest record. Longer messages are truncated in the background mode. */
+#define CME_LOG_MAX_MESSAGE 1024
+
+/* Size of the buffer the writer thread gathers records in before a write */
+#define CME_LOG_BUFFER_SIZE ((size_t)1 << 16)
+
+#if defined(__GNUC__) || defined(__clang__)
+#define CME_LOG_PRINTF(fmt, args) __attribute__((format(printf, fmt, args)))
+#else
+#define CME_LOG_PRINTF(fmt, args)
+#endif
+
+/* ==========================================================================
+ * Type Definitions Section
+ * ========================================================================== */
+
+/* What a logging thread does when the queue is full */
+typedef enum cme_log_overflow {
+  CME_LOG_BLOCK, /* Wait for the writer (nothing is lost) */
+  CME_LOG_DROP,  /* Drop the record and count it (never waits) */
+} cme_log_overflow;
+
+/* ==========================================================================
+ * Function Declarations Section
+ * ========================================================================== */
+
+/* Until `cme_log_start` is called (and where threads are not available)
+   records are written on the calling thread. */
+int cme_log_start(const char *prefix, size_t slots, cme_log_overflow overflow);
+void cme_log_stop(void);
+void cme_log_flush(void);
+uint64_t cme_log_dropped(void);
+
+/* "<prefix>: <message>" to stdout, the message as is to stdout, and
+   "<prefix>: <message>" to stderr */
+void cme_log(const char *format, ...) CME_LOG_PRINTF(1, 2);
+void cme_log_raw(const char *format, ...) CME_LOG_PRINTF(1, 2);
+void cme_log_error(const char *format, ...) CME_LOG_PRINTF(1, 2);
+
+#endif /* CME_LOG_H_ */
@@ -0,0 +1,183 @@
+/* ==========================================================================
+ *  Copyright (C) 2026 Ljubomir Kurij <ljubomir_kurij@protonmail.com>
+ *
+ * This file is part of "C Common Memory Errors".
+ *
+ * "C Common Memory Errors" is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * "C Common Memory Errors" is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General
+ * Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with Focus Precision Analyze. If not, see <https://www.gnu.org/licenses/>.
+ * ========================================================================== */
+
+/* ==========================================================================
+ *
+ * 2026-10-18 Ljubomir Kurij <ljubomir_kurij@protonmail.com>
+ *
+ * * cme_parallel.c: created.
+ *
+ * ========================================================================== */
+
+/* ==========================================================================
+ * Headers Include Section
+ * ========================================================================== */
+
+/* Related header */
+#include "cme_parallel.h"
+
+/* System headers */
+#ifdef CME_HAVE_PTHREADS
+#include <pthread.h>
+#include <unistd.h>
+#endif /* End of platform specific headers */
+
+/* Standard Library headers */
+
+/* ==========================================================================
+ * Type Definitions Section
+ * ========================================================================== */
+
+typedef struct parallel_task {
+  cme_parallel_fn fn;
+  void *ctx;
+  size_t begin;
+  size_t end;
+} parallel_task;
+
+/* ==========================================================================
+ * Private Function Declarations Section
+ * ========================================================================== */
+
+#ifdef CME_HAVE_PTHREADS
+static void *run_task(void *arg);
+#endif
+
+/* ==========================================================================
+ * Function Definitions Section
+ * ========================================================================== */
+
+/* --------------------------------------------------------------------------
+ * Function: cme_cpu_count
+ * --------------------------------------------------------------------------
+ *
+ * Description: Get the number of online processors
+ *
+ * Parameters: None
+ *
+ * Returns: Number of processors (one if it can not be determined, or if the
+ *          library was built without thread support)
+ *
+ * -------------------------------------------------------------------------- */
+size_t cme_cpu_count(void) {
+#if defined(CME_HAVE_PTHREADS) && defined(_SC_NPROCESSORS_ONLN)
+  long count = sysconf(_SC_NPROCESSORS_ONLN);
+
+  return 0 < count ? (size_t)count : 1;
+#else
+  return 1;
+#endif /* End of platform specific code */
+}
+
+/* --------------------------------------------------------------------------
+ * Function: cme_parallel_for
+ * --------------------------------------------------------------------------
+ *
+ * Description: Split the range [0, count) into contiguous chunks and process
+ *              them on up to one thread per processor. The calling thread
+ *              takes the first chunk. Returns when every chunk is done. If
+ *              the range is too small to split, or threads are not available,
+ *              the whole range is processed on the calling thread.
+ *
+ * Parameters:
+ *          count: Number of items
+ *      min_chunk: Smallest number of items worth handing to a thread
+ *             fn: Loop body, called once per chunk
+ *            ctx: Context passed to the loop body
+ *
+ * Returns: None
+ *
+ * -------------------------------------------------------------------------- */
+void cme_parallel_for(size_t count, size_t min_chunk, cme_parallel_fn fn,
+                      void *ctx) {
+#ifdef CME_HAVE_PTHREADS
+  parallel_task tasks[CME_PARALLEL_MAX_THREADS];
+  pthread_t threads[CME_PARALLEL_MAX_THREADS];
+  int started[CME_PARALLEL_MAX_THREADS];
+  size_t num_tasks = cme_cpu_count();
+  size_t chunk = 0;
+  size_t i = 0;
+
+  if (0 == min_chunk) {
+    min_chunk = 1;
+  }
+  if (num_tasks > count / min_chunk) {
+    num_tasks = count / min_chunk;
+  }
+  if (num_tasks > CME_PARALLEL_MAX_THREADS) {
+    num_tasks = CME_PARALLEL_MAX_THREADS;
+  }
+  if (2 > num_tasks) {
+    fn(ctx, 0, count);
+    return;
+  }
+
+  chunk = (count + num_tasks - 1) / num_tasks;
+  for (i = 0; i < num_tasks; i++) {
+    tasks[i].fn = fn;
+    tasks[i].ctx = ctx;
+    tasks[i].begin = i * chunk < count ? i * chunk : count;
+    tasks[i].end = (i + 1) * chunk < count ? (i + 1) * chunk : count;
+    started[i] = 0;
+  }
+
+  for (i = 1; i < num_tasks; i++) {
+    started[i] = 0 == pthread_create(&threads[i], NULL, run_task, &tasks[i]);
+  }
+  fn(ctx, tasks[0].begin, tasks[0].end);
+
+  for (i = 1; i < num_tasks; i++) {
+    if (started[i]) {
+      pthread_join(threads[i], NULL);
+    } else {
+      /* Could not start the thread, do its share here */
+      fn(ctx, tasks[i].begin, tasks[i].end);
+    }
+  }
+#else
+  (void)min_chunk;
+  fn(ctx, 0, count);
+#endif /* End of platform specific code */
+}
+
+/* ==========================================================================
+ * Private Function Definitions Section
+ * ========================================================================== */
+
+#ifdef CME_HAVE_PTHREADS
+/* --------------------------------------------------------------------------
+ * Function: run_task
+ * --------------------------------------------------------------------------
+ *
+ * Description: Thread entry point running one chunk of a parallel loop
+ *
+ * Parameters:
+ *      arg: Pointer to the task
+ *
+ * Returns: NULL
+ *
+ * -------------------------------------------------------------------------- */
+static void *run_task(void *arg) {
+  parallel_task *task = arg;
+
+  task->fn(task->ctx, task->begin, task->end);
+
+  return NULL;
+}
+#endif
@@ -0,0 +1,60 @@
+/* ==========================================================================
+ *  Copyright (C) 2026 Ljubomir Kurij <ljubomir_kurij@protonmail.com>
+ *
+ * This file is part of "C Common Memory Errors".
+ *
+ * "C Common Memory Errors" is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * "C Common Memory Errors" is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General
+ * Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with Focus Precision Analyze. If not, see <https://www.gnu.org/licenses/>.
+ * ========================================================================== */
+
+/* ==========================================================================
+ *
+ * 2026-10-18 Ljubomir Kurij <ljubomir_kurij@protonmail.com>
+ *
+ * * cme_parallel.h: created.
+ *
+ * ========================================================================== */
+
+#ifndef CME_PARALLEL_H_
+#define CME_PARALLEL_H_
+
+/* ==========================================================================
+ * Headers Include Section
+ * ========================================================================== */
+
+/* Standard Library headers */
+#include <stddef.h>
+
+/* ==========================================================================
+ * Macros Definitions Section
+ * ========================================================================== */
+
+/* Upper bound on the number of threads `cme_parallel_for` starts */
+#define CME_PARALLEL_MAX_THREADS 64
+
+/* ==========================================================================
+ * Type Definitions Section
+ * ========================================================================== */
+
+/* Body of a parallel loop: process the items in [begin, end) */
+typedef void (*cme_parallel_fn)(void *ctx, size_t begin, size_t end);
+
+/* ==========================================================================
+ * Function Declarations Section
+ * ========================================================================== */
+
+size_t cme_cpu_count(void);
+void cme_parallel_for(size_t count, size_t min_chunk, cme_parallel_fn fn,
+                      void *ctx);
+
+#endif /* CME_PARALLEL_H_ */
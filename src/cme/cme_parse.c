@@ -0,0 +1,316 @@
+/* ==========================================================================
+ *  Copyright (C) 2026 Ljubomir Kurij <ljubomir_kurij@protonmail.com>
+ *
+ * This file is part of "C Common Memory Errors".
+ *
+ * "C Common Memory Errors" is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * "C Common Memory Errors" is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General
+ * Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with Focus Precision Analyze. If not, see <https://www.gnu.org/licenses/>.
+ * ========================================================================== */
+
+/* ==========================================================================
+ *
+ * 2026-10-18 Ljubomir Kurij <ljubomir_kurij@protonmail.com>
+ *
+ * * cme_parse.c: created.
+ *
+ * ========================================================================== */
+
+/* ==========================================================================
+ * Headers Include Section
+ * ========================================================================== */
+
+/* Related header */
+#include "cme_parse.h"
+
+/* Project headers */
+#include "cme_alloc.h"
+
+/* ==========================================================================
+ * Macros Definitions Section
+ * ========================================================================== */
+
+/* Magnitude limit of a token: INT32_MAX, or one more for negative values */
+#define PARSE_LIMIT(negative) ((uint64_t)INT32_MAX + ((negative) ? 1 : 0))
+
+/* ==========================================================================
+ * Type Definitions Section
+ * ========================================================================== */
+
+/* Parser state, kept across block boundaries so a number split between two
+   reads needs no copying */
+typedef struct parser {
+  cme_parse_sink sink;
+  void *ctx;
+  int32_t *batch;
+  size_t batch_len;
+  uint64_t count;
+
+  /* Current token */
+  int in_token;
+  int negative;
+  int has_digits;
+  uint64_t magnitude;
+  uint64_t token_offset;
+
+  /* Position of the next byte */
+  uint64_t offset;
+  size_t line;
+  uint64_t line_offset;
+
+  cme_parse_error error;
+} parser;
+
+/* ==========================================================================
+ * Private Function Declarations Section
+ * ========================================================================== */
+
+static int parse_block(parser *state, const char *block, size_t size);
+static int end_token(parser *state);
+static int flush_batch(parser *state);
+static int fail(parser *state, uint64_t offset, const char *reason);
+
+/* ==========================================================================
+ * Function Definitions Section
+ * ========================================================================== */
+
+/* --------------------------------------------------------------------------
+ * Function: cme_parse_ints
+ * --------------------------------------------------------------------------
+ *
+ * Description: Parse a stream of whitespace separated integers. The stream
+ *              is read in blocks of `CME_PARSE_BLOCK_SIZE` bytes and parsed
+ *              by a hand written loop (one compare per whitespace byte, one
+ *              multiply-add per digit), and the values are handed to the
+ *              sink in batches, so there is no per value library call. Out
+ *              of range numbers, lone signs and stray characters are
+ *              reported with their position.
+ *
+ * Parameters:
+ *      stream: Stream to read
+ *        sink: Receives the values
+ *         ctx: Passed to the sink
+ *       count: Receives the number of values parsed (may be NULL)
+ *       error: Receives the reason of a failure (may be NULL)
+ *
+ * Returns: 0 on success, -1 on a parse, read or sink error
+ *
+ * -------------------------------------------------------------------------- */
+int cme_parse_ints(FILE *stream, cme_parse_sink sink, void *ctx,
+                   uint64_t *count, cme_parse_error *error) {
+  parser state = {0};
+  char *block = NULL;
+  size_t size = 0;
+  int status = 0;
+
+  state.sink = sink;
+  state.ctx = ctx;
+  state.line = 1;
+
+  block = cme_malloc(CME_PARSE_BLOCK_SIZE);
+  state.batch = cme_malloc(CME_PARSE_BATCH_SIZE * sizeof(*state.batch));
+  if (!block || !state.batch) {
+    status = fail(&state, 0, "out of memory");
+  }
+
+  while (0 == status &&
+         0 < (size = fread(block, 1, CME_PARSE_BLOCK_SIZE, stream))) {
+    status = parse_block(&state, block, size);
+  }
+
+  if (0 == status && ferror(stream)) {
+    status = fail(&state, state.offset, "read error");
+  }
+  if (0 == status && state.in_token) {
+    status = end_token(&state);
+  }
+  if (0 == status) {
+    status = flush_batch(&state);
+  }
+
+  if (count) {
+    *count = state.count;
+  }
+  if (0 != status && error) {
+    *error = state.error;
+  }
+
+  cme_free(state.batch);
+  cme_free(block);
+
+  return status;
+}
+
+/* ==========================================================================
+ * Private Function Definitions Section
+ * ========================================================================== */
+
+/* --------------------------------------------------------------------------
+ * Function: parse_block
+ * --------------------------------------------------------------------------
+ *
+ * Description: Parse one block of the stream. A token still open at the end
+ *              of the block is finished by the next block (or at the end of
+ *              the stream).
+ *
+ * Parameters:
+ *      state: Parser state
+ *      block: Bytes read
+ *       size: Number of bytes read
+ *
+ * Returns: 0 on success, -1 on error
+ *
+ * -------------------------------------------------------------------------- */
+static int parse_block(parser *state, const char *block, size_t size) {
+  const char *p = block;
+  const char *end = block + size;
+  const uint64_t base = state->offset;
+  uint64_t magnitude = state->magnitude;
+  unsigned digit = 0;
+  char c = '\0';
+
+  while (p < end) {
+    if (!state->in_token) {
+      c = *p;
+      if (' ' == c || '\t' == c || '\r' == c || '\v' == c || '\f' == c) {
+        p++;
+        continue;
+      }
+      if ('\n' == c) {
+        state->line++;
+        state->line_offset = base + (uint64_t)(p - block) + 1;
+        p++;
+        continue;
+      }
+
+      state->in_token = 1;
+      state->negative = '-' == c;
+      state->has_digits = 0;
+      state->token_offset = base + (uint64_t)(p - block);
+      magnitude = 0;
+      if ('-' == c || '+' == c) {
+        p++;
+      }
+    }
+
+    /* Digits of the current token */
+    while (p < end && 9 >= (digit = (unsigned)(*p - '0'))) {
+      magnitude = magnitude * 10 + digit;
+      if (PARSE_LIMIT(1) < magnitude) {
+        return fail(state, state->token_offset, "value out of range");
+      }
+      state->has_digits = 1;
+      p++;
+    }
+    if (p == end) {
+      break;
+    }
+
+    c = *p;
+    if (' ' != c && '\n' != c && '\t' != c && '\r' != c && '\v' != c &&
+        '\f' != c) {
+      return fail(state, base + (uint64_t)(p - block), "invalid character");
+    }
+    state->magnitude = magnitude;
+    if (0 != end_token(state)) {
+      return -1;
+    }
+  }
+
+  state->magnitude = magnitude;
+  state->offset = base + size;
+
+  return 0;
+}
+
+/* --------------------------------------------------------------------------
+ * Function: end_token
+ * --------------------------------------------------------------------------
+ *
+ * Description: Check the token just read and append it to the batch
+ *
+ * Parameters:
+ *      state: Parser state
+ *
+ * Returns: 0 on success, -1 on error
+ *
+ * -------------------------------------------------------------------------- */
+static int end_token(parser *state) {
+  uint32_t magnitude = 0;
+
+  state->in_token = 0;
+  if (!state->has_digits) {
+    return fail(state, state->token_offset, "sign without digits");
+  }
+  if (PARSE_LIMIT(state->negative) < state->magnitude) {
+    return fail(state, state->token_offset, "value out of range");
+  }
+
+  magnitude = (uint32_t)state->magnitude;
+  state->batch[state->batch_len++] =
+      (int32_t)(state->negative ? 0u - magnitude : magnitude);
+  if (CME_PARSE_BATCH_SIZE == state->batch_len) {
+    return flush_batch(state);
+  }
+
+  return 0;
+}
+
+/* --------------------------------------------------------------------------
+ * Function: flush_batch
+ * --------------------------------------------------------------------------
+ *
+ * Description: Hand the batched values to the sink
+ *
+ * Parameters:
+ *      state: Parser state
+ *
+ * Returns: 0 on success, -1 if the sink stopped the parse
+ *
+ * -------------------------------------------------------------------------- */
+static int flush_batch(parser *state) {
+  size_t n = state->batch_len;
+
+  state->batch_len = 0;
+  if (0 == n) {
+    return 0;
+  }
+  if (0 != state->sink(state->ctx, state->batch, n)) {
+    return fail(state, state->offset, "stopped by the sink");
+  }
+  state->count += n;
+
+  return 0;
+}
+
+/* --------------------------------------------------------------------------
+ * Function: fail
+ * --------------------------------------------------------------------------
+ *
+ * Description: Record the reason and position of a failure
+ *
+ * Parameters:
+ *       state: Parser state
+ *      offset: Stream offset of the offending byte
+ *      reason: What went wrong
+ *
+ * Returns: -1
+ *
+ * -------------------------------------------------------------------------- */
+static int fail(parser *state, uint64_t offset, const char *reason) {
+  state->error.offset = offset;
+  state->error.line = state->line;
+  state->error.column = (size_t)(offset - state->line_offset) + 1;
+  state->error.reason = reason;
+
+  return -1;
+}
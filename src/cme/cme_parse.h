@@ -0,0 +1,78 @@
+/* ==========================================================================
+ *  Copyright (C) 2026 Ljubomir Kurij <ljubomir_kurij@protonmail.com>
+ *
+ * This file is part of "C Common Memory Errors".
+ *
+ * "C Common Memory Errors" is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * "C Common Memory Errors" is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General
+ * Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with Focus Precision Analyze. If not, see <https://www.gnu.org/licenses/>.
+ * ========================================================================== */
+
+/* ==========================================================================
+ *
+ * 2026-10-18 Ljubomir Kurij <ljubomir_kurij@protonmail.com>
+ *
+ * * cme_parse.h: created.
+ *
+ * ========================================================================== */
+
+#ifndef CME_PARSE_H_
+#define CME_PARSE_H_
+
+/* ==========================================================================
+ * Headers Include Section
+ * ========================================================================== */
+
+/* Standard Library headers */
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+
+/* ==========================================================================
+ * Macros Definitions Section
+ * ========================================================================== */
+
+/* Bytes read from the stream at a time */
+#define CME_PARSE_BLOCK_SIZE ((size_t)1 << 18)
+
+/* Values handed to the sink at a time */
+#define CME_PARSE_BATCH_SIZE ((size_t)1 << 12)
+
+/* ==========================================================================
+ * Type Definitions Section
+ * ========================================================================== */
+
+/* Receives the parsed values in batches of up to `CME_PARSE_BATCH_SIZE`.
+   A nonzero return value stops the parse. */
+typedef int (*cme_parse_sink)(void *ctx, const int32_t *values, size_t n);
+
+/* Where and why a parse stopped. Lines and columns count from 1. */
+typedef struct cme_parse_error {
+  uint64_t offset;
+  size_t line;
+  size_t column;
+  const char *reason;
+} cme_parse_error;
+
+/* ==========================================================================
+ * Function Declarations Section
+ * ========================================================================== */
+
+/* Parse whitespace separated decimal integers (an optional sign followed by
+   digits, in the range of `int32_t`). Returns 0 when the whole stream was
+   parsed, otherwise -1 with `error` (if not NULL) describing what stopped
+   it. `count` (if not NULL) receives the number of values passed to the
+   sink. */
+int cme_parse_ints(FILE *stream, cme_parse_sink sink, void *ctx,
+                   uint64_t *count, cme_parse_error *error);
+
+#endif /* CME_PARSE_H_ */
@@ -0,0 +1,254 @@
+/* ==========================================================================
+ *  Copyright (C) 2026 Ljubomir Kurij <ljubomir_kurij@protonmail.com>
+ *
+ * This file is part of "C Common Memory Errors".
+ *
+ * "C Common Memory Errors" is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * "C Common Memory Errors" is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General
+ * Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with Focus Precision Analyze. If not, see <https://www.gnu.org/licenses/>.
+ * ========================================================================== */
+
+/* ==========================================================================
+ *
+ * 2026-10-18 Ljubomir Kurij <ljubomir_kurij@protonmail.com>
+ *
+ * * cme_poison.c: created.
+ *
+ * ========================================================================== */
+
+/* ==========================================================================
+ * Headers Include Section
+ * ========================================================================== */
+
+/* Related header */
+#include "cme_poison.h"
+
+/* System headers */
+#if defined(__SSE2__) || defined(_M_X64) ||                                    \
+    (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define CME_HAVE_SSE2 1
+#include <emmintrin.h>
+#endif /* End of SSE2 headers */
+
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
+/* Standard Library headers */
+#include <string.h>
+
+/* ==========================================================================
+ * Private Function Declarations Section
+ * ========================================================================== */
+
+static size_t find_poison(const unsigned char *p, size_t i, size_t size);
+static size_t run_end(const unsigned char *p, size_t i, size_t size,
+                      unsigned char byte);
+#ifdef CME_HAVE_SSE2
+static unsigned first_set(unsigned mask);
+#endif
+
+/* ==========================================================================
+ * Function Definitions Section
+ * ========================================================================== */
+
+/* --------------------------------------------------------------------------
+ * Function: cme_poison_fill
+ * --------------------------------------------------------------------------
+ *
+ * Description: Fill a block with the pattern of the given kind. The fill is
+ *              a single `memset`, which the C library implements with the
+ *              widest stores the processor has.
+ *
+ * Parameters:
+ *      dest: Block to fill
+ *      size: Size of the block in bytes
+ *      kind: Which pattern to use
+ *
+ * Returns: None
+ *
+ * -------------------------------------------------------------------------- */
+void cme_poison_fill(void *dest, size_t size, cme_poison_kind kind) {
+  memset(dest, CME_POISON_FREED == kind ? CME_POISON_FREE_BYTE
+                                        : CME_POISON_ALLOC_BYTE,
+         size);
+}
+
+/* --------------------------------------------------------------------------
+ * Function: cme_poison_scan
+ * --------------------------------------------------------------------------
+ *
+ * Description: Find the runs of poison fill bytes in a memory region (e.g.
+ *              an output buffer before it is written out). The region is
+ *              skipped 16 bytes at a time until a fill byte turns up, and a
+ *              run is measured the same way, so clean data costs about one
+ *              compare per 16 bytes.
+ *
+ * Parameters:
+ *          data: Region to scan
+ *          size: Size of the region in bytes
+ *       min_run: Shortest run to report (0 means `CME_POISON_MIN_RUN`)
+ *          hits: Array receiving the runs found (may be NULL)
+ *      max_hits: Size of the `hits` array
+ *
+ * Returns: Number of runs found. Only the first `max_hits` are stored.
+ *
+ * -------------------------------------------------------------------------- */
+size_t cme_poison_scan(const void *data, size_t size, size_t min_run,
+                       cme_poison_hit *hits, size_t max_hits) {
+  const unsigned char *p = data;
+  size_t found = 0;
+  size_t i = 0;
+  size_t end = 0;
+
+  if (0 == min_run) {
+    min_run = CME_POISON_MIN_RUN;
+  }
+
+  while (size > (i = find_poison(p, i, size))) {
+    end = run_end(p, i, size, p[i]);
+    if (end - i >= min_run) {
+      if (hits && found < max_hits) {
+        hits[found].offset = i;
+        hits[found].length = end - i;
+        hits[found].kind = CME_POISON_FREE_BYTE == p[i] ? CME_POISON_FREED
+                                                        : CME_POISON_UNINIT;
+      }
+      found++;
+    }
+    i = end;
+  }
+
+  return found;
+}
+
+/* --------------------------------------------------------------------------
+ * Function: cme_poison_kind_name
+ * --------------------------------------------------------------------------
+ *
+ * Description: Describe a poison kind
+ *
+ * Parameters:
+ *      kind: Poison kind
+ *
+ * Returns: Static string
+ *
+ * -------------------------------------------------------------------------- */
+const char *cme_poison_kind_name(cme_poison_kind kind) {
+  return CME_POISON_FREED == kind ? "freed" : "uninitialized";
+}
+
+/* ==========================================================================
+ * Private Function Definitions Section
+ * ========================================================================== */
+
+/* --------------------------------------------------------------------------
+ * Function: find_poison
+ * --------------------------------------------------------------------------
+ *
+ * Description: Find the next poison fill byte
+ *
+ * Parameters:
+ *         p: Region
+ *         i: Where to start
+ *      size: Size of the region
+ *
+ * Returns: Index of the next fill byte, or `size` if there is none
+ *
+ * -------------------------------------------------------------------------- */
+static size_t find_poison(const unsigned char *p, size_t i, size_t size) {
+#ifdef CME_HAVE_SSE2
+  const __m128i alloc_byte = _mm_set1_epi8((char)CME_POISON_ALLOC_BYTE);
+  const __m128i free_byte = _mm_set1_epi8((char)CME_POISON_FREE_BYTE);
+
+  for (; i + 16 <= size; i += 16) {
+    const __m128i v = _mm_loadu_si128((const __m128i *)(p + i));
+    const unsigned mask = (unsigned)_mm_movemask_epi8(_mm_or_si128(
+        _mm_cmpeq_epi8(v, alloc_byte), _mm_cmpeq_epi8(v, free_byte)));
+
+    if (0 != mask) {
+      return i + first_set(mask);
+    }
+  }
+#endif /* End of SSE2 code */
+
+  for (; i < size; i++) {
+    if (CME_POISON_ALLOC_BYTE == p[i] || CME_POISON_FREE_BYTE == p[i]) {
+      return i;
+    }
+  }
+
+  return size;
+}
+
+/* --------------------------------------------------------------------------
+ * Function: run_end
+ * --------------------------------------------------------------------------
+ *
+ * Description: Find the end of a run of equal bytes
+ *
+ * Parameters:
+ *         p: Region
+ *         i: Start of the run
+ *      size: Size of the region
+ *      byte: Byte value of the run
+ *
+ * Returns: Index of the first byte past the run
+ *
+ * -------------------------------------------------------------------------- */
+static size_t run_end(const unsigned char *p, size_t i, size_t size,
+                      unsigned char byte) {
+#ifdef CME_HAVE_SSE2
+  const __m128i b = _mm_set1_epi8((char)byte);
+
+  for (; i + 16 <= size; i += 16) {
+    const __m128i v = _mm_loadu_si128((const __m128i *)(p + i));
+    const unsigned mask = (unsigned)_mm_movemask_epi8(_mm_cmpeq_epi8(v, b));
+
+    if (0xFFFF != mask) {
+      return i + first_set(~mask & 0xFFFF);
+    }
+  }
+#endif /* End of SSE2 code */
+
+  while (i < size && byte == p[i]) {
+    i++;
+  }
+
+  return i;
+}
+
+#ifdef CME_HAVE_SSE2
+/* --------------------------------------------------------------------------
+ * Function: first_set
+ * --------------------------------------------------------------------------
+ *
+ * Description: Index of the lowest set bit
+ *
+ * Parameters:
+ *      mask: Nonzero bit mask
+ *
+ * Returns: Bit index
+ *
+ * -------------------------------------------------------------------------- */
+static unsigned first_set(unsigned mask) {
+#ifdef _MSC_VER
+  unsigned long index = 0;
+
+  _BitScanForward(&index, mask);
+
+  return (unsigned)index;
+#else
+  return (unsigned)__builtin_ctz(mask);
+#endif /* End of compiler specific code */
+}
+#endif
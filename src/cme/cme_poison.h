@@ -0,0 +1,78 @@
+/* ==========================================================================
+ *  Copyright (C) 2026 Ljubomir Kurij <ljubomir_kurij@protonmail.com>
+ *
+ * This file is part of "C Common Memory Errors".
+ *
+ * "C Common Memory Errors" is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * "C Common Memory Errors" is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General
+ * Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with Focus Precision Analyze. If not, see <https://www.gnu.org/licenses/>.
+ * ========================================================================== */
+
+/* ==========================================================================
+ *
+ * 2026-10-18 Ljubomir Kurij <ljubomir_kurij@protonmail.com>
+ *
+ * * cme_poison.h: created.
+ *
+ * ========================================================================== */
+
+#ifndef CME_POISON_H_
+#define CME_POISON_H_
+
+/* ==========================================================================
+ * Headers Include Section
+ * ========================================================================== */
+
+/* Standard Library headers */
+#include <stddef.h>
+
+/* ==========================================================================
+ * Macros Definitions Section
+ * ========================================================================== */
+
+/* Fill bytes of newly allocated and of freed blocks. Read back as integers
+   they give the tell-tale "fishy" values (e.g. 0xCDCDCDCD, -842150451 as a
+   32 bit int), and as pointers they are non-canonical addresses on x86-64,
+   so dereferencing one faults. */
+#define CME_POISON_ALLOC_BYTE 0xCD
+#define CME_POISON_FREE_BYTE 0xDD
+
+/* Shortest run of fill bytes `cme_poison_scan` reports by default (shorter
+   runs occur in ordinary data too often) */
+#define CME_POISON_MIN_RUN 4
+
+/* ==========================================================================
+ * Type Definitions Section
+ * ========================================================================== */
+
+typedef enum cme_poison_kind {
+  CME_POISON_UNINIT, /* Allocated but never written */
+  CME_POISON_FREED,  /* Written after (or read from) a freed block */
+} cme_poison_kind;
+
+/* A run of fill bytes found by `cme_poison_scan` */
+typedef struct cme_poison_hit {
+  size_t offset;
+  size_t length;
+  cme_poison_kind kind;
+} cme_poison_hit;
+
+/* ==========================================================================
+ * Function Declarations Section
+ * ========================================================================== */
+
+void cme_poison_fill(void *dest, size_t size, cme_poison_kind kind);
+size_t cme_poison_scan(const void *data, size_t size, size_t min_run,
+                       cme_poison_hit *hits, size_t max_hits);
+const char *cme_poison_kind_name(cme_poison_kind kind);
+
+#endif /* CME_POISON_H_ */
@@ -0,0 +1,372 @@
+/* ==========================================================================
+ *  Copyright (C) 2026 Ljubomir Kurij <ljubomir_kurij@protonmail.com>
+ *
+ * This file is part of "C Common Memory Errors".
+ *
+ * "C Common Memory Errors" is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * "C Common Memory Errors" is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General
+ * Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with Focus Precision Analyze. If not, see <https://www.gnu.org/licenses/>.
+ * ========================================================================== */
+
+/* ==========================================================================
+ *
+ * 2026-10-18 Ljubomir Kurij <ljubomir_kurij@protonmail.com>
+ *
+ * * cme_pool.c: created.
+ *
+ * ========================================================================== */
+
+/* ==========================================================================
+ * Headers Include Section
+ * ========================================================================== */
+
+/* Related header */
+#include "cme_pool.h"
+
+/* Standard Library headers */
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+/* ==========================================================================
+ * Macros Definitions Section
+ * ========================================================================== */
+
+/* Size of a block, from the header in front of it */
+#define POOL_SIZE(ptr) (*(size_t *)((char *)(ptr) - CME_POOL_ALIGN))
+
+/* ==========================================================================
+ * Private Function Declarations Section
+ * ========================================================================== */
+
+static size_t pool_class(size_t size);
+static void *pool_large(cme_pool *pool, size_t size);
+
+/* ==========================================================================
+ * Global Variables Section
+ * ========================================================================== */
+
+/* Block sizes of the classes */
+static const size_t kClassSizes[CME_POOL_CLASSES] = {
+    16,  32,  48,  64,   96,   128,  192,  256,
+    384, 512, 768, 1024, 1536, 2048, 3072, 4096,
+};
+
+/* ==========================================================================
+ * Function Definitions Section
+ * ========================================================================== */
+
+/* --------------------------------------------------------------------------
+ * Function: cme_pool_init
+ * --------------------------------------------------------------------------
+ *
+ * Description: Initialize an empty pool (no memory is allocated until the
+ *              first block)
+ *
+ * Parameters:
+ *      pool: The pool
+ *
+ * Returns: None
+ *
+ * -------------------------------------------------------------------------- */
+void cme_pool_init(cme_pool *pool) { memset(pool, 0, sizeof(*pool)); }
+
+/* --------------------------------------------------------------------------
+ * Function: cme_pool_malloc
+ * --------------------------------------------------------------------------
+ *
+ * Description: Allocate a block from the free list of its class, or cut a
+ *              new one from the newest slab
+ *
+ * Parameters:
+ *      pool: The pool
+ *      size: Number of bytes
+ *
+ * Returns: Pointer to the block, or NULL if out of memory
+ *
+ * -------------------------------------------------------------------------- */
+void *cme_pool_malloc(cme_pool *pool, size_t size) {
+  size_t cls = 0;
+  size_t need = 0;
+  char *block = NULL;
+  void *slab = NULL;
+
+  if (size > CME_POOL_MAX_SIZE) {
+    return pool_large(pool, size);
+  }
+
+  cls = pool_class(size);
+  block = pool->free_lists[cls];
+  if (block) {
+    pool->free_lists[cls] = *(void **)block;
+    POOL_SIZE(block) = size;
+    return block;
+  }
+
+  need = CME_POOL_ALIGN + kClassSizes[cls];
+  if (need > (size_t)(pool->end - pool->top)) {
+    slab = malloc(CME_POOL_SLAB_SIZE);
+    if (NULL == slab) {
+      return NULL;
+    }
+    *(void **)slab = pool->slabs;
+    pool->slabs = slab;
+    pool->footprint += CME_POOL_SLAB_SIZE;
+    pool->top = (char *)slab + CME_POOL_ALIGN;
+    pool->end = (char *)slab + CME_POOL_SLAB_SIZE;
+  }
+
+  block = pool->top + CME_POOL_ALIGN;
+  pool->top += need;
+  POOL_SIZE(block) = size;
+
+  return block;
+}
+
+/* --------------------------------------------------------------------------
+ * Function: cme_pool_calloc
+ * --------------------------------------------------------------------------
+ *
+ * Description: Allocate a zeroed array from the pool
+ *
+ * Parameters:
+ *       pool: The pool
+ *      count: Number of elements
+ *       size: Size of an element
+ *
+ * Returns: Pointer to the block, or NULL if out of memory or on overflow
+ *
+ * -------------------------------------------------------------------------- */
+void *cme_pool_calloc(cme_pool *pool, size_t count, size_t size) {
+  void *ptr = NULL;
+
+  if (0 != size && count > SIZE_MAX / size) {
+    return NULL;
+  }
+  ptr = cme_pool_malloc(pool, count * size);
+  if (ptr) {
+    memset(ptr, 0, count * size);
+  }
+
+  return ptr;
+}
+
+/* --------------------------------------------------------------------------
+ * Function: cme_pool_realloc
+ * --------------------------------------------------------------------------
+ *
+ * Description: Resize a block of the pool: in place if the new size is of
+ *              the same class, with `realloc` if both sizes are large, and
+ *              by copying otherwise
+ *
+ * Parameters:
+ *      pool: The pool
+ *       ptr: Block to resize (NULL allocates a new one)
+ *      size: New size in bytes
+ *
+ * Returns: Pointer to the resized block, or NULL if out of memory (the old
+ *          block is left untouched)
+ *
+ * -------------------------------------------------------------------------- */
+void *cme_pool_realloc(cme_pool *pool, void *ptr, size_t size) {
+  size_t old = 0;
+  char *header = NULL;
+  char *copy = NULL;
+
+  if (NULL == ptr) {
+    return cme_pool_malloc(pool, size);
+  }
+
+  old = POOL_SIZE(ptr);
+  if (old <= CME_POOL_MAX_SIZE && size <= CME_POOL_MAX_SIZE &&
+      pool_class(old) == pool_class(size)) {
+    POOL_SIZE(ptr) = size;
+    return ptr;
+  }
+  if (old > CME_POOL_MAX_SIZE && size > CME_POOL_MAX_SIZE &&
+      size <= SIZE_MAX - CME_POOL_ALIGN) {
+    header = realloc((char *)ptr - CME_POOL_ALIGN, CME_POOL_ALIGN + size);
+    if (NULL == header) {
+      return NULL;
+    }
+    pool->footprint = pool->footprint - old + size;
+    *(size_t *)header = size;
+    return header + CME_POOL_ALIGN;
+  }
+
+  copy = cme_pool_malloc(pool, size);
+  if (copy) {
+    memcpy(copy, ptr, old < size ? old : size);
+    cme_pool_free(pool, ptr);
+  }
+
+  return copy;
+}
+
+/* --------------------------------------------------------------------------
+ * Function: cme_pool_strdup
+ * --------------------------------------------------------------------------
+ *
+ * Description: Copy a string into the pool
+ *
+ * Parameters:
+ *      pool: The pool
+ *       str: String to copy
+ *
+ * Returns: Pointer to the copy, or NULL if out of memory
+ *
+ * -------------------------------------------------------------------------- */
+char *cme_pool_strdup(cme_pool *pool, const char *str) {
+  size_t size = strlen(str) + 1;
+  char *copy = cme_pool_malloc(pool, size);
+
+  if (copy) {
+    memcpy(copy, str, size);
+  }
+
+  return copy;
+}
+
+/* --------------------------------------------------------------------------
+ * Function: cme_pool_free
+ * --------------------------------------------------------------------------
+ *
+ * Description: Put a block on the free list of its class (a large block is
+ *              freed with `free`)
+ *
+ * Parameters:
+ *      pool: The pool
+ *       ptr: Block to free (may be NULL)
+ *
+ * Returns: None
+ *
+ * -------------------------------------------------------------------------- */
+void cme_pool_free(cme_pool *pool, void *ptr) {
+  size_t size = 0;
+  size_t cls = 0;
+
+  if (NULL == ptr) {
+    return;
+  }
+
+  size = POOL_SIZE(ptr);
+  if (size > CME_POOL_MAX_SIZE) {
+    pool->footprint -= CME_POOL_ALIGN + size;
+    free((char *)ptr - CME_POOL_ALIGN);
+    return;
+  }
+  cls = pool_class(size);
+  *(void **)ptr = pool->free_lists[cls];
+  pool->free_lists[cls] = ptr;
+}
+
+/* --------------------------------------------------------------------------
+ * Function: cme_pool_release
+ * --------------------------------------------------------------------------
+ *
+ * Description: Release every slab of the pool, and with them all of its
+ *              blocks of the size classes (large blocks must have been freed
+ *              first). The pool can be used again.
+ *
+ * Parameters:
+ *      pool: The pool
+ *
+ * Returns: None
+ *
+ * -------------------------------------------------------------------------- */
+void cme_pool_release(cme_pool *pool) {
+  void *slab = pool->slabs;
+  void *next = NULL;
+
+  while (slab) {
+    next = *(void **)slab;
+    free(slab);
+    slab = next;
+  }
+  cme_pool_init(pool);
+}
+
+/* --------------------------------------------------------------------------
+ * Function: cme_pool_footprint
+ * --------------------------------------------------------------------------
+ *
+ * Description: Memory the pool holds
+ *
+ * Parameters:
+ *      pool: The pool
+ *
+ * Returns: Bytes of its slabs and of its large blocks
+ *
+ * -------------------------------------------------------------------------- */
+size_t cme_pool_footprint(const cme_pool *pool) { return pool->footprint; }
+
+/* ==========================================================================
+ * Private Function Definitions Section
+ * ========================================================================== */
+
+/* --------------------------------------------------------------------------
+ * Function: pool_class
+ * --------------------------------------------------------------------------
+ *
+ * Description: Class of a block of at most CME_POOL_MAX_SIZE bytes: 16 and
+ *              32, then for every power of two P from 32 on, P * 3 / 2 and
+ *              2 * P (two classes a doubling)
+ *
+ * Parameters:
+ *      size: Size of the block
+ *
+ * Returns: Index into `kClassSizes`
+ *
+ * -------------------------------------------------------------------------- */
+static size_t pool_class(size_t size) {
+  size_t power = 32;
+  size_t cls = 2;
+
+  if (size <= 32) {
+    return size <= 16 ? 0 : 1;
+  }
+  while (size > 2 * power) {
+    power *= 2;
+    cls += 2;
+  }
+
+  return size <= power + power / 2 ? cls : cls + 1;
+}
+
+/* --------------------------------------------------------------------------
+ * Function: pool_large
+ * --------------------------------------------------------------------------
+ *
+ * Description: Allocate a block too large for the classes with `malloc`
+ *
+ * Parameters:
+ *      pool: The pool
+ *      size: Number of bytes
+ *
+ * Returns: Pointer to the block, or NULL if out of memory
+ *
+ * -------------------------------------------------------------------------- */
+static void *pool_large(cme_pool *pool, size_t size) {
+  char *header = NULL;
+
+  if (size > SIZE_MAX - CME_POOL_ALIGN) {
+    return NULL;
+  }
+  header = malloc(CME_POOL_ALIGN + size);
+  if (NULL == header) {
+    return NULL;
+  }
+  *(size_t *)header = size;
+  pool->footprint += CME_POOL_ALIGN + size;
+
+  return header + CME_POOL_ALIGN;
+}
@@ -0,0 +1,85 @@
+/* ==========================================================================
+ *  Copyright (C) 2026 Ljubomir Kurij <ljubomir_kurij@protonmail.com>
+ *
+ * This file is part of "C Common Memory Errors".
+ *
+ * "C Common Memory Errors" is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * "C Common Memory Errors" is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General
+ * Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with Focus Precision Analyze. If not, see <https://www.gnu.org/licenses/>.
+ * ========================================================================== */
+
+/* ==========================================================================
+ *
+ * 2026-10-18 Ljubomir Kurij <ljubomir_kurij@protonmail.com>
+ *
+ * * cme_pool.h: created.
+ *
+ * ========================================================================== */
+
+#ifndef CME_POOL_H_
+#define CME_POOL_H_
+
+/* ==========================================================================
+ * Headers Include Section
+ * ========================================================================== */
+
+/* Standard Library headers */
+#include <stddef.h>
+
+/* ==========================================================================
+ * Macros Definitions Section
+ * ========================================================================== */
+
+/* Alignment of the blocks (and size of the header in front of each) */
+#define CME_POOL_ALIGN 16
+
+/* Size classes: 16 and 32, then powers of two and one and a half times
+   powers of two, up to CME_POOL_MAX_SIZE */
+#define CME_POOL_CLASSES 16
+
+/* Largest block served from the size classes; bigger blocks are allocated
+   with `malloc` */
+#define CME_POOL_MAX_SIZE 4096
+
+/* Size of the slabs the blocks of the classes are cut from */
+#define CME_POOL_SLAB_SIZE ((size_t)64 * 1024)
+
+/* ==========================================================================
+ * Type Definitions Section
+ * ========================================================================== */
+
+/* Size class allocator: a block is rounded up to its class, and a freed
+   block goes to the free list of its class, to be handed out again by the
+   next allocation of the class. Slabs are only given back when the pool is
+   released. A pool of all zeros is empty. */
+typedef struct cme_pool {
+  void *free_lists[CME_POOL_CLASSES]; /* Freed blocks of each class */
+  char *top;        /* Next free byte of the newest slab */
+  char *end;        /* End of the newest slab */
+  void *slabs;      /* Newest first, linked through their first word */
+  size_t footprint; /* Bytes of the slabs and the large blocks */
+} cme_pool;
+
+/* ==========================================================================
+ * Function Declarations Section
+ * ========================================================================== */
+
+void cme_pool_init(cme_pool *pool);
+void *cme_pool_malloc(cme_pool *pool, size_t size);
+void *cme_pool_calloc(cme_pool *pool, size_t count, size_t size);
+void *cme_pool_realloc(cme_pool *pool, void *ptr, size_t size);
+char *cme_pool_strdup(cme_pool *pool, const char *str);
+void cme_pool_free(cme_pool *pool, void *ptr);
+void cme_pool_release(cme_pool *pool);
+size_t cme_pool_footprint(const cme_pool *pool);
+
+#endif /* CME_POOL_H_ */
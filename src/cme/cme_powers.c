@@ -0,0 +1,332 @@
+/* ==========================================================================
+ *  Copyright (C) 2026 Ljubomir Kurij <ljubomir_kurij@protonmail.com>
+ *
+ * This file is part of "C Common Memory Errors".
+ *
+ * "C Common Memory Errors" is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * "C Common Memory Errors" is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General
+ * Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with Focus Precision Analyze. If not, see <https://www.gnu.org/licenses/>.
+ * ========================================================================== */
+
+/* ==========================================================================
+ *
+ * 2026-10-18 Ljubomir Kurij <ljubomir_kurij@protonmail.com>
+ *
+ * * cme_powers.c: created.
+ *
+ * ========================================================================== */
+
+/* ==========================================================================
+ * Headers Include Section
+ * ========================================================================== */
+
+/* Related header */
+#include "cme_powers.h"
+
+/* System headers */
+
+/* Standard Library headers */
+#include <string.h>
+
+/* ==========================================================================
+ * Private Function Declarations Section
+ * ========================================================================== */
+
+static const cme_powers_table *find_table(const cme_powers_table *tables,
+                                          int64_t base);
+static size_t copy_from_table(const cme_powers_table *table,
+                              unsigned first_exp, size_t n, size_t elem_size,
+                              void *out);
+static int mul_i64(int64_t a, int64_t b, int64_t *res);
+static int mul_u64(uint64_t a, uint64_t b, uint64_t *res);
+static int pow_i64(int64_t base, unsigned exp, int64_t *res);
+static int pow_u64(uint64_t base, unsigned exp, uint64_t *res);
+
+/* ==========================================================================
+ * Function Definitions Section
+ * ========================================================================== */
+
+/* --------------------------------------------------------------------------
+ * Function: cme_powers_i32
+ * --------------------------------------------------------------------------
+ *
+ * Description: Compute consecutive integer powers of a base as 32 bit
+ *              signed integers. For the bases that have a precomputed table
+ *              the powers are copied out of it, otherwise they are computed
+ *              with repeated multiplication, checked for overflow.
+ *
+ * Parameters:
+ *           base: Base of the powers
+ *      first_exp: Exponent of the first power
+ *              n: Number of powers to compute
+ *            out: Pointer to an array of at least `n` elements
+ *
+ * Returns: Number of powers written. If less than `n`, the next power does
+ *          not fit into the output type.
+ *
+ * -------------------------------------------------------------------------- */
+size_t cme_powers_i32(int32_t base, unsigned first_exp, size_t n,
+                      int32_t *out) {
+  const cme_powers_table *table = find_table(cme_powers_tables_i32, base);
+  int64_t value = 0;
+  size_t i = 0;
+
+  if (NULL != table) {
+    return copy_from_table(table, first_exp, n, sizeof(*out), out);
+  }
+
+  if (0 == n || pow_i64(base, first_exp, &value) ||
+      value < INT32_MIN || value > INT32_MAX) {
+    return 0;
+  }
+
+  /* The product of two 32 bit values always fits into 64 bits, so only the
+     range of the result has to be checked */
+  out[0] = (int32_t)value;
+  for (i = 1; i < n; i++) {
+    value *= base;
+    if (value < INT32_MIN || value > INT32_MAX) {
+      break;
+    }
+    out[i] = (int32_t)value;
+  }
+
+  return i;
+}
+
+/* --------------------------------------------------------------------------
+ * Function: cme_powers_i64
+ * --------------------------------------------------------------------------
+ *
+ * Description: Same as `cme_powers_i32`, for 64 bit signed integers.
+ *
+ * -------------------------------------------------------------------------- */
+size_t cme_powers_i64(int64_t base, unsigned first_exp, size_t n,
+                      int64_t *out) {
+  const cme_powers_table *table = find_table(cme_powers_tables_i64, base);
+  int64_t value = 0;
+  size_t i = 0;
+
+  if (NULL != table) {
+    return copy_from_table(table, first_exp, n, sizeof(*out), out);
+  }
+
+  if (0 == n || pow_i64(base, first_exp, &value)) {
+    return 0;
+  }
+
+  out[0] = value;
+  for (i = 1; i < n; i++) {
+    if (mul_i64(value, base, &value)) {
+      break;
+    }
+    out[i] = value;
+  }
+
+  return i;
+}
+
+/* --------------------------------------------------------------------------
+ * Function: cme_powers_u64
+ * --------------------------------------------------------------------------
+ *
+ * Description: Same as `cme_powers_i32`, for 64 bit unsigned integers.
+ *
+ * -------------------------------------------------------------------------- */
+size_t cme_powers_u64(uint64_t base, unsigned first_exp, size_t n,
+                      uint64_t *out) {
+  const cme_powers_table *table = NULL;
+  uint64_t value = 0;
+  size_t i = 0;
+
+  if (base <= INT64_MAX) {
+    table = find_table(cme_powers_tables_u64, (int64_t)base);
+  }
+  if (NULL != table) {
+    return copy_from_table(table, first_exp, n, sizeof(*out), out);
+  }
+
+  if (0 == n || pow_u64(base, first_exp, &value)) {
+    return 0;
+  }
+
+  out[0] = value;
+  for (i = 1; i < n; i++) {
+    if (mul_u64(value, base, &value)) {
+      break;
+    }
+    out[i] = value;
+  }
+
+  return i;
+}
+
+/* ==========================================================================
+ * Private Function Definitions Section
+ * ========================================================================== */
+
+/* --------------------------------------------------------------------------
+ * Function: find_table
+ * --------------------------------------------------------------------------
+ *
+ * Description: Look up the precomputed table for a base
+ *
+ * Parameters:
+ *      tables: Tables for one of the output types
+ *        base: Base of the powers
+ *
+ * Returns: Pointer to the table, or NULL if the base has none
+ *
+ * -------------------------------------------------------------------------- */
+static const cme_powers_table *find_table(const cme_powers_table *tables,
+                                          int64_t base) {
+  size_t i = 0;
+
+  for (i = 0; i < cme_powers_num_tables; i++) {
+    if (tables[i].base == base) {
+      return &tables[i];
+    }
+  }
+
+  return NULL;
+}
+
+/* --------------------------------------------------------------------------
+ * Function: copy_from_table
+ * --------------------------------------------------------------------------
+ *
+ * Description: Copy a run of powers out of a precomputed table
+ *
+ * Parameters:
+ *          table: Precomputed table
+ *      first_exp: Exponent of the first power
+ *              n: Number of powers requested
+ *      elem_size: Size of one element of the table in bytes
+ *            out: Destination array
+ *
+ * Returns: Number of powers copied
+ *
+ * -------------------------------------------------------------------------- */
+static size_t copy_from_table(const cme_powers_table *table,
+                              unsigned first_exp, size_t n, size_t elem_size,
+                              void *out) {
+  if (first_exp >= table->count) {
+    return 0;
+  }
+
+  if (n > table->count - first_exp) {
+    n = table->count - first_exp;
+  }
+  if (0 < n) {
+    memcpy(out, (const char *)table->values + first_exp * elem_size,
+           n * elem_size);
+  }
+
+  return n;
+}
+
+/* --------------------------------------------------------------------------
+ * Functions: mul_i64, mul_u64
+ * --------------------------------------------------------------------------
+ *
+ * Description: Multiply two integers, detecting overflow
+ *
+ * Parameters:
+ *        a: First factor
+ *        b: Second factor
+ *      res: Pointer to store the product
+ *
+ * Returns: Zero on success, non-zero if the product overflows (in that case
+ *          `res` is left unchanged)
+ *
+ * -------------------------------------------------------------------------- */
+static int mul_i64(int64_t a, int64_t b, int64_t *res) {
+#if defined(__GNUC__) || defined(__clang__)
+  int64_t product = 0;
+
+  if (__builtin_mul_overflow(a, b, &product)) {
+    return 1;
+  }
+  *res = product;
+#else
+  if (0 < a) {
+    if ((0 < b && a > INT64_MAX / b) || (0 >= b && b < INT64_MIN / a)) {
+      return 1;
+    }
+  } else if (0 != a) {
+    if ((0 < b && a < INT64_MIN / b) || (0 >= b && b < INT64_MAX / a)) {
+      return 1;
+    }
+  }
+  *res = a * b;
+#endif /* End of compiler specific code */
+
+  return 0;
+}
+
+static int mul_u64(uint64_t a, uint64_t b, uint64_t *res) {
+  if (0 != b && a > UINT64_MAX / b) {
+    return 1;
+  }
+  *res = a * b;
+
+  return 0;
+}
+
+/* --------------------------------------------------------------------------
+ * Functions: pow_i64, pow_u64
+ * --------------------------------------------------------------------------
+ *
+ * Description: Raise an integer to a power by squaring, detecting overflow
+ *
+ * Parameters:
+ *      base: Base
+ *       exp: Exponent
+ *       res: Pointer to store the power
+ *
+ * Returns: Zero on success, non-zero if the power overflows
+ *
+ * -------------------------------------------------------------------------- */
+static int pow_i64(int64_t base, unsigned exp, int64_t *res) {
+  int64_t result = 1;
+
+  while (0 != exp) {
+    if ((exp & 1) && mul_i64(result, base, &result)) {
+      return 1;
+    }
+    exp >>= 1;
+    /* Once |base| >= 2 squaring overflows only when the result would */
+    if (0 != exp && mul_i64(base, base, &base)) {
+      return 1;
+    }
+  }
+  *res = result;
+
+  return 0;
+}
+
+static int pow_u64(uint64_t base, unsigned exp, uint64_t *res) {
+  uint64_t result = 1;
+
+  while (0 != exp) {
+    if ((exp & 1) && mul_u64(result, base, &result)) {
+      return 1;
+    }
+    exp >>= 1;
+    if (0 != exp && mul_u64(base, base, &base)) {
+      return 1;
+    }
+  }
+  *res = result;
+
+  return 0;
+}
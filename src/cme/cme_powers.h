@@ -0,0 +1,82 @@
+/* ==========================================================================
+ *  Copyright (C) 2026 Ljubomir Kurij <ljubomir_kurij@protonmail.com>
+ *
+ * This file is part of "C Common Memory Errors".
+ *
+ * "C Common Memory Errors" is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * "C Common Memory Errors" is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General
+ * Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with Focus Precision Analyze. If not, see <https://www.gnu.org/licenses/>.
+ * ========================================================================== */
+
+/* ==========================================================================
+ *
+ * 2026-10-18 Ljubomir Kurij <ljubomir_kurij@protonmail.com>
+ *
+ * * cme_powers.h: created.
+ *
+ * ========================================================================== */
+
+#ifndef CME_POWERS_H_
+#define CME_POWERS_H_
+
+/* ==========================================================================
+ * Headers Include Section
+ * ========================================================================== */
+
+/* Standard Library headers */
+#include <stddef.h>
+#include <stdint.h>
+
+/* ==========================================================================
+ * Type Definitions Section
+ * ========================================================================== */
+
+/* --------------------------------------------------------------------------
+ * Type: cme_powers_table
+ * --------------------------------------------------------------------------
+ *
+ * Description: Precomputed powers of a base: `values[k]` is `base^k` for
+ *              every `k` below `count`, i.e. for every power that fits into
+ *              the element type of the table. The tables are generated at
+ *              build time by `cme_gen_powers`.
+ *
+ * -------------------------------------------------------------------------- */
+typedef struct cme_powers_table {
+  int64_t base;
+  size_t count;
+  const void *values;
+} cme_powers_table;
+
+/* ==========================================================================
+ * Global Variables Section
+ * ========================================================================== */
+
+extern const cme_powers_table cme_powers_tables_i32[];
+extern const cme_powers_table cme_powers_tables_i64[];
+extern const cme_powers_table cme_powers_tables_u64[];
+extern const size_t cme_powers_num_tables;
+
+/* ==========================================================================
+ * Function Declarations Section
+ * ========================================================================== */
+
+/* Write `base^first_exp ... base^(first_exp + n - 1)` to `out`. The return
+   value is the number of powers written, which is less than `n` if the
+   sequence overflows the output type. */
+size_t cme_powers_i32(int32_t base, unsigned first_exp, size_t n,
+                      int32_t *out);
+size_t cme_powers_i64(int64_t base, unsigned first_exp, size_t n,
+                      int64_t *out);
+size_t cme_powers_u64(uint64_t base, unsigned first_exp, size_t n,
+                      uint64_t *out);
+
+#endif /* CME_POWERS_H_ */
@@ -0,0 +1,196 @@
+/* ==========================================================================
+ *  Copyright (C) 2026 Ljubomir Kurij <ljubomir_kurij@protonmail.com>
+ *
+ * This file is part of "C Common Memory Errors".
+ *
+ * "C Common Memory Errors" is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * "C Common Memory Errors" is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General
+ * Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with Focus Precision Analyze. If not, see <https://www.gnu.org/licenses/>.
+ * ========================================================================== */
+
+/* ==========================================================================
+ *
+ * 2026-10-18 Ljubomir Kurij <ljubomir_kurij@protonmail.com>
+ *
+ * * cme_reads.c: created.
+ *
+ * ========================================================================== */
+
+/* ==========================================================================
+ * Headers Include Section
+ * ========================================================================== */
+
+/* Related header */
+#include "cme_reads.h"
+
+/* System headers */
+
+/* Standard Library headers */
+#include <string.h>
+
+/* Project headers */
+#include "cme_alloc.h"
+#include "cme_fill.h"
+
+/* ==========================================================================
+ * Global Variables Section
+ * ========================================================================== */
+
+static const char kAlphabet[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZ";
+
+/* ==========================================================================
+ * Function Definitions Section
+ * ========================================================================== */
+
+/* --------------------------------------------------------------------------
+ * Function: cme_get_powers_of_7
+ * --------------------------------------------------------------------------
+ *
+ * Description: Get the first n powers of 7 (7^1 ... 7^n). The powers are
+ *              computed with integer arithmetic (copied from a precomputed
+ *              table), so they are exact, and stored in the narrowest integer
+ *              type that holds them.
+ *
+ * Parameters:
+ *     n: Number of powers to calculate
+ *
+ * Returns: Sequence (fat array) of n integers. The sequence is empty (its
+ *          data is NULL) if the allocation failed or 7^n does not fit into 64
+ *          bits.
+ *
+ * -------------------------------------------------------------------------- */
+cme_seq cme_get_powers_of_7(int n) {
+  cme_seq ret = {CME_INT_U8, NULL, 0, 0};
+
+  if (0 < n) {
+    ret = cme_seq_powers(7, 1, (size_t)n);
+  }
+
+  return ret;
+}
+
+/* --------------------------------------------------------------------------
+ * Function: cme_get_alpha_letters
+ * --------------------------------------------------------------------------
+ *
+ * Description: Get the first len letters of the alphabet, cycling through
+ *              it if len is larger than 26
+ *
+ * Parameters:
+ *     len: Number of letters to generate
+ *
+ * Returns: Pointer to a string of len characters (release it with
+ *          `cme_free`), or NULL if the allocation failed
+ *
+ * -------------------------------------------------------------------------- */
+char *cme_get_alpha_letters(int len) {
+  char *text = NULL;
+
+  text = cme_calloc(len + 1, sizeof(char));
+  if (text) {
+    /* Cycle through the alphabet, without a `% 26` per letter */
+    cme_fill_pattern(text, (size_t)len, kAlphabet, sizeof(kAlphabet) - 1);
+  }
+
+  return text;
+}
+
+/* --------------------------------------------------------------------------
+ * Function: cme_get_alpha_letters_buggy
+ * --------------------------------------------------------------------------
+ *
+ * Description: Same as `cme_get_alpha_letters`, but the string is freed
+ *              before it is returned. Every read of the result is a read
+ *              from freed memory, and freeing it is a double free. DrMemory
+ *              reports the reads as `UNINITIALIZED READ` without pointing at
+ *              a line of code.
+ *
+ * Parameters:
+ *     len: Number of letters to generate
+ *
+ * Returns: Dangling pointer to a string of len characters
+ *
+ * -------------------------------------------------------------------------- */
+char *cme_get_alpha_letters_buggy(int len) {
+  char *text = NULL;
+
+  text = cme_calloc(len + 1, sizeof(char));
+  if (text) {
+    cme_fill_pattern(text, (size_t)len, kAlphabet, sizeof(kAlphabet) - 1);
+    cme_free(text);
+  }
+
+  return text;
+}
+
+/* --------------------------------------------------------------------------
+ * Function: cme_get_sentence
+ * --------------------------------------------------------------------------
+ *
+ * Description: Get the first sentence from a text
+ *
+ * Parameters:
+ *      text: String containing the text
+ *
+ * Returns: Heap allocated copy of the first sentence. The caller is
+ *          responsible for releasing it with `cme_str_free`.
+ *
+ * -------------------------------------------------------------------------- */
+cme_str cme_get_sentence(cme_str text) {
+  size_t len = 0;
+
+  /* find period or end of string */
+  len = cme_str_find(text, '.');
+  if (len < text.len) {
+    len++; /* Add one to len to account for the period */
+  }
+
+  /* Copy only up to period (if found). The copy is null terminated and sized
+     from the known length, so no further scans of the text are needed.
+  */
+  return cme_str_dup(cme_str_sub(text, 0, len));
+}
+
+/* --------------------------------------------------------------------------
+ * Function: cme_get_sentence_buggy
+ * --------------------------------------------------------------------------
+ *
+ * Description: Same as `cme_get_sentence` on a null terminated string, but
+ *              no room is allocated for the terminator. The copy is not
+ *              terminated, so printing it or taking its length reads past
+ *              the end of the block.
+ *
+ * Parameters:
+ *      text: Null terminated text
+ *
+ * Returns: Unterminated copy of the first sentence (release it with
+ *          `cme_free`), or NULL if the allocation failed
+ *
+ * -------------------------------------------------------------------------- */
+char *cme_get_sentence_buggy(const char *text) {
+  char *ret = NULL;
+  size_t len = 0;
+
+  while (text[len] != '\0' && text[len] != '.') {
+    len++;
+  }
+  if (text[len] == '.') {
+    len++; /* Add one to len to account for the period */
+  }
+
+  ret = cme_malloc(len > 0 ? len : 1);
+  if (ret) {
+    memcpy(ret, text, len);
+  }
+
+  return ret;
+}
@@ -0,0 +1,53 @@
+/* ==========================================================================
+ *  Copyright (C) 2026 Ljubomir Kurij <ljubomir_kurij@protonmail.com>
+ *
+ * This file is part of "C Common Memory Errors".
+ *
+ * "C Common Memory Errors" is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * "C Common Memory Errors" is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General
+ * Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with Focus Precision Analyze. If not, see <https://www.gnu.org/licenses/>.
+ * ========================================================================== */
+
+/* ==========================================================================
+ *
+ * 2026-10-18 Ljubomir Kurij <ljubomir_kurij@protonmail.com>
+ *
+ * * cme_reads.h: created.
+ *
+ * ========================================================================== */
+
+#ifndef CME_READS_H_
+#define CME_READS_H_
+
+/* ==========================================================================
+ * Headers Include Section
+ * ========================================================================== */
+
+/* Project headers */
+#include "cme_seq.h"
+#include "cme_string.h"
+
+/* ==========================================================================
+ * Function Declarations Section
+ * ========================================================================== */
+
+/* Routines of the invalid reads demo and exercise. The `_buggy` variants
+   keep the error the demo is about, so they are only safe to call under a
+   memory checker. */
+
+cme_seq cme_get_powers_of_7(int n);
+char *cme_get_alpha_letters(int len);
+char *cme_get_alpha_letters_buggy(int len);
+cme_str cme_get_sentence(cme_str text);
+char *cme_get_sentence_buggy(const char *text);
+
+#endif /* CME_READS_H_ */
@@ -0,0 +1,189 @@
+/* ==========================================================================
+ *  Copyright (C) 2026 Ljubomir Kurij <ljubomir_kurij@protonmail.com>
+ *
+ * This file is part of "C Common Memory Errors".
+ *
+ * "C Common Memory Errors" is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * "C Common Memory Errors" is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General
+ * Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with Focus Precision Analyze. If not, see <https://www.gnu.org/licenses/>.
+ * ========================================================================== */
+
+/* ==========================================================================
+ *
+ * 2026-10-18 Ljubomir Kurij <ljubomir_kurij@protonmail.com>
+ *
+ * * cme_scenario.c: created.
+ *
+ * ========================================================================== */
+
+/* ==========================================================================
+ * Headers Include Section
+ * ========================================================================== */
+
+/* Related header */
+#include "cme_scenario.h"
+
+/* System headers */
+
+/* Standard Library headers */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+/* Project headers */
+#include "cme_log.h"
+
+/* ==========================================================================
+ * Private Function Declarations Section
+ * ========================================================================== */
+
+static double scenario_now_ms(void);
+
+/* ==========================================================================
+ * Function Definitions Section
+ * ========================================================================== */
+
+/* --------------------------------------------------------------------------
+ * Function: cme_scenario_find
+ * --------------------------------------------------------------------------
+ *
+ * Description: Look up a scenario by name
+ *
+ * Parameters:
+ *     scenarios: Table of scenarios
+ *         count: Number of scenarios in the table
+ *          name: Name of the scenario
+ *
+ * Returns: Pointer to the scenario, or NULL if there is none of that name
+ *
+ * -------------------------------------------------------------------------- */
+const cme_scenario *cme_scenario_find(const cme_scenario *scenarios,
+                                      size_t count, const char *name) {
+  size_t i = 0;
+
+  for (i = 0; i < count; i++) {
+    if (0 == strcmp(scenarios[i].name, name)) {
+      return &scenarios[i];
+    }
+  }
+
+  return NULL;
+}
+
+/* --------------------------------------------------------------------------
+ * Function: cme_scenario_list
+ * --------------------------------------------------------------------------
+ *
+ * Description: Print the names and the descriptions of the scenarios
+ *
+ * Parameters:
+ *     scenarios: Table of scenarios
+ *         count: Number of scenarios in the table
+ *
+ * Returns: None
+ *
+ * -------------------------------------------------------------------------- */
+void cme_scenario_list(const cme_scenario *scenarios, size_t count) {
+  size_t i = 0;
+
+  for (i = 0; i < count; i++) {
+    cme_log_raw("%-20s %s\n", scenarios[i].name, scenarios[i].description);
+  }
+}
+
+/* --------------------------------------------------------------------------
+ * Function: cme_scenario_run
+ * --------------------------------------------------------------------------
+ *
+ * Description: Run the correct or the buggy variant of a scenario a number
+ *              of times. The name `list` (CME_SCENARIO_LIST) lists the
+ *              scenarios instead. With `CME_SCENARIO_TIME` set, the time of
+ *              the iterations is reported on `stderr` once they are done
+ *              (a line starting with `CME_SCENARIO_TIME_TAG`), so that it can
+ *              be told apart from the time of starting the program.
+ *
+ * Parameters:
+ *      scenarios: Table of scenarios
+ *          count: Number of scenarios in the table
+ *           name: Name of the scenario
+ *          buggy: Nonzero to run the buggy variant
+ *     iterations: Number of runs (at least 1)
+ *
+ * Returns: 0 on success, -1 if there is no such scenario or the number of
+ *          iterations is invalid
+ *
+ * -------------------------------------------------------------------------- */
+int cme_scenario_run(const cme_scenario *scenarios, size_t count,
+                     const char *name, int buggy, int iterations) {
+  const cme_scenario *scenario = NULL;
+  const char *timed = getenv(CME_SCENARIO_TIME_ENV);
+  double start = 0.0;
+  int i = 0;
+
+  if (0 == strcmp(name, CME_SCENARIO_LIST)) {
+    cme_scenario_list(scenarios, count);
+    return 0;
+  }
+
+  scenario = cme_scenario_find(scenarios, count, name);
+  if (NULL == scenario) {
+    cme_log_error("Unknown scenario `%s' (try `--scenario %s')\n", name,
+                  CME_SCENARIO_LIST);
+    return -1;
+  }
+  if (1 > iterations) {
+    cme_log_error("Invalid number of iterations: %d\n", iterations);
+    return -1;
+  }
+
+  cme_log("Running the %s variant of `%s', %d iteration(s)\n",
+          buggy ? "buggy" : "correct", scenario->name, iterations);
+  start = scenario_now_ms();
+  for (i = 0; i < iterations; i++) {
+    scenario->run(buggy);
+  }
+  if (timed && '\0' != *timed) {
+    fprintf(stderr, CME_SCENARIO_TIME_TAG " %.6f\n",
+            scenario_now_ms() - start);
+  }
+
+  return 0;
+}
+
+/* ==========================================================================
+ * Private Function Definitions Section
+ * ========================================================================== */
+
+/* --------------------------------------------------------------------------
+ * Function: scenario_now_ms
+ * --------------------------------------------------------------------------
+ *
+ * Description: Read a monotonic clock where there is one, the calendar
+ *              clock otherwise
+ *
+ * Parameters: None
+ *
+ * Returns: Time in milliseconds, from an arbitrary start
+ *
+ * -------------------------------------------------------------------------- */
+static double scenario_now_ms(void) {
+  struct timespec ts;
+
+#ifdef CLOCK_MONOTONIC
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+#else
+  timespec_get(&ts, TIME_UTC);
+#endif
+
+  return (double)ts.tv_sec * 1e3 + (double)ts.tv_nsec * 1e-6;
+}
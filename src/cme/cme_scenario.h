@@ -0,0 +1,77 @@
+/* ==========================================================================
+ *  Copyright (C) 2026 Ljubomir Kurij <ljubomir_kurij@protonmail.com>
+ *
+ * This file is part of "C Common Memory Errors".
+ *
+ * "C Common Memory Errors" is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * "C Common Memory Errors" is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General
+ * Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with Focus Precision Analyze. If not, see <https://www.gnu.org/licenses/>.
+ * ========================================================================== */
+
+/* ==========================================================================
+ *
+ * 2026-10-18 Ljubomir Kurij <ljubomir_kurij@protonmail.com>
+ *
+ * * cme_scenario.h: created.
+ *
+ * ========================================================================== */
+
+#ifndef CME_SCENARIO_H_
+#define CME_SCENARIO_H_
+
+/* ==========================================================================
+ * Headers Include Section
+ * ========================================================================== */
+
+/* Standard Library headers */
+#include <stddef.h>
+
+/* ==========================================================================
+ * Macros Definitions Section
+ * ========================================================================== */
+
+/* Scenario name that lists the scenarios instead of running one */
+#define CME_SCENARIO_LIST "list"
+
+/* Environment variable that has `cme_scenario_run` report the time of the
+   iterations on `stderr`, as the tag and the milliseconds */
+#define CME_SCENARIO_TIME_ENV "CME_SCENARIO_TIME"
+#define CME_SCENARIO_TIME_TAG "cme_scenario: iterations took (ms)"
+
+/* Number of scenarios in a table (an array, not a pointer) */
+#define CME_SCENARIO_COUNT(table) (sizeof(table) / sizeof((table)[0]))
+
+/* ==========================================================================
+ * Type Definitions Section
+ * ========================================================================== */
+
+/* Runs the correct (buggy == 0) or the buggy variant of a scenario */
+typedef void (*cme_scenario_fn)(int buggy);
+
+/* One error of a demo program, runnable on its own */
+typedef struct cme_scenario {
+  const char *name;
+  const char *description;
+  cme_scenario_fn run;
+} cme_scenario;
+
+/* ==========================================================================
+ * Function Declarations Section
+ * ========================================================================== */
+
+const cme_scenario *cme_scenario_find(const cme_scenario *scenarios,
+                                      size_t count, const char *name);
+void cme_scenario_list(const cme_scenario *scenarios, size_t count);
+int cme_scenario_run(const cme_scenario *scenarios, size_t count,
+                     const char *name, int buggy, int iterations);
+
+#endif /* CME_SCENARIO_H_ */
@@ -0,0 +1,498 @@
+/* ==========================================================================
+ *  Copyright (C) 2026 Ljubomir Kurij <ljubomir_kurij@protonmail.com>
+ *
+ * This file is part of "C Common Memory Errors".
+ *
+ * "C Common Memory Errors" is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * "C Common Memory Errors" is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General
+ * Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with Focus Precision Analyze. If not, see <https://www.gnu.org/licenses/>.
+ * ========================================================================== */
+
+/* ==========================================================================
+ *
+ * 2026-10-18 Ljubomir Kurij <ljubomir_kurij@protonmail.com>
+ *
+ * * cme_seq.c: created.
+ *
+ * ========================================================================== */
+
+/* ==========================================================================
+ * Headers Include Section
+ * ========================================================================== */
+
+/* Related header */
+#include "cme_seq.h"
+
+/* System headers */
+
+/* Standard Library headers */
+#include <inttypes.h>
+#include <stdlib.h>
+
+/* Project headers */
+#include "cme_alloc.h"
+#include "cme_powers.h"
+
+/* ==========================================================================
+ * Macros Definitions Section
+ * ========================================================================== */
+
+/* Number of powers computed in one go before narrowing to the element type */
+#define CME_SEQ_CHUNK 64
+
+/* Does `v` fit into the range [min, max] (`v < 1` rather than `v < 0`, so
+   an unsigned `v` is not compared against zero) */
+#define CME_SEQ_FITS(v, min, max)                                              \
+  ((v) < 1 ? (int64_t)(v) >= (min) : (uint64_t)(v) <= (max))
+
+/* --------------------------------------------------------------------------
+ * Macro: CME_SEQ_DEFINE
+ * --------------------------------------------------------------------------
+ *
+ * Description: Define the functions declared by `CME_SEQ_DECLARE` for one
+ *              element type.
+ *
+ * Parameters:
+ *          sfx: Suffix of the function names
+ *          tag: Element type tag (`cme_int_kind`)
+ *         type: Element type
+ *         minv: Minimum value of the element type
+ *         maxv: Maximum value of the element type
+ *         wide: 64 bit type the values are computed and printed in
+ *         pfmt: `printf` conversion for the `wide` type
+ *    powers_fn: 64 bit power generator taking an `int64_t` base
+ *
+ * -------------------------------------------------------------------------- */
+#define CME_SEQ_DEFINE(sfx, tag, type, minv, maxv, wide, pfmt, powers_fn)      \
+  size_t cme_seq_odds_##sfx(type *out, size_t n) {                             \
+    const uint64_t max_count = ((uint64_t)(maxv) - 1) / 2 + 1;                 \
+    size_t i = 0;                                                              \
+                                                                               \
+    if ((uint64_t)n > max_count) {                                             \
+      n = (size_t)max_count;                                                   \
+    }                                                                          \
+    for (i = 0; i < n; i++) {                                                  \
+      out[i] = (type)(2 * i + 1);                                              \
+    }                                                                          \
+                                                                               \
+    return n;                                                                  \
+  }                                                                            \
+                                                                               \
+  size_t cme_seq_powers_##sfx(int64_t base, unsigned first_exp, size_t n,      \
+                              type *out) {                                     \
+    wide chunk[CME_SEQ_CHUNK];                                                 \
+    size_t done = 0;                                                           \
+    size_t want = 0;                                                           \
+    size_t got = 0;                                                            \
+    size_t i = 0;                                                              \
+                                                                               \
+    while (done < n) {                                                         \
+      want = n - done < CME_SEQ_CHUNK ? n - done : CME_SEQ_CHUNK;              \
+      got = powers_fn(base, first_exp + (unsigned)done, want, chunk);          \
+      for (i = 0; i < got; i++) {                                              \
+        if (!CME_SEQ_FITS(chunk[i], (minv), (maxv))) {                         \
+          return done + i;                                                     \
+        }                                                                      \
+        out[done + i] = (type)chunk[i];                                        \
+      }                                                                        \
+      done += got;                                                             \
+      if (got < want) {                                                        \
+        break;                                                                 \
+      }                                                                        \
+    }                                                                          \
+                                                                               \
+    return done;                                                               \
+  }                                                                            \
+                                                                               \
+  void cme_seq_print_##sfx(FILE *f, cme_array_##sfx values, size_t n,         \
+                           const char *prefix, const char *label,              \
+                           unsigned first_index) {                             \
+    size_t i = 0;                                                              \
+    wide value = 0;                                                            \
+                                                                               \
+    if (!CME_ARRAY_CHECKED) {                                                  \
+      (void)cme_array_range(sfx, values, 0, n);                                \
+    }                                                                          \
+    for (i = 0; i < n; i++) {                                                  \
+      value = (wide)*cme_array_at(sfx, values, i);                             \
+      if (NULL != label) {                                                     \
+        fprintf(f, "%s%s%u = %" pfmt "\n", prefix, label,                      \
+                first_index + (unsigned)i, value);                             \
+      } else {                                                                 \
+        fprintf(f, "%s%" pfmt "\n", prefix, value);                            \
+      }                                                                        \
+    }                                                                          \
+  }                                                                            \
+                                                                               \
+  cme_array_##sfx cme_seq_as_##sfx(cme_seq seq) {                              \
+    cme_array_##sfx arr = {NULL, 0, 0};                                        \
+                                                                               \
+    if ((tag) == seq.kind) {                                                   \
+      arr.data = seq.data;                                                     \
+      arr.len = seq.len;                                                       \
+      arr.cap = seq.cap;                                                       \
+    }                                                                          \
+                                                                               \
+    return arr;                                                                \
+  }
+
+/* ==========================================================================
+ * Private Function Declarations Section
+ * ========================================================================== */
+
+static size_t seq_powers_u64(int64_t base, unsigned first_exp, size_t n,
+                             uint64_t *out);
+
+/* ==========================================================================
+ * Template Instantiations Section
+ * ========================================================================== */
+
+CME_SEQ_DEFINE(u8, CME_INT_U8, uint8_t, 0, UINT8_MAX, int64_t, PRId64,
+               cme_powers_i64)
+CME_SEQ_DEFINE(u16, CME_INT_U16, uint16_t, 0, UINT16_MAX, int64_t, PRId64,
+               cme_powers_i64)
+CME_SEQ_DEFINE(u32, CME_INT_U32, uint32_t, 0, UINT32_MAX, int64_t, PRId64,
+               cme_powers_i64)
+CME_SEQ_DEFINE(u64, CME_INT_U64, uint64_t, 0, UINT64_MAX, uint64_t, PRIu64,
+               seq_powers_u64)
+CME_SEQ_DEFINE(i8, CME_INT_I8, int8_t, INT8_MIN, INT8_MAX, int64_t, PRId64,
+               cme_powers_i64)
+CME_SEQ_DEFINE(i16, CME_INT_I16, int16_t, INT16_MIN, INT16_MAX, int64_t,
+               PRId64, cme_powers_i64)
+CME_SEQ_DEFINE(i32, CME_INT_I32, int32_t, INT32_MIN, INT32_MAX, int64_t,
+               PRId64, cme_powers_i64)
+CME_SEQ_DEFINE(i64, CME_INT_I64, int64_t, INT64_MIN, INT64_MAX, int64_t,
+               PRId64, cme_powers_i64)
+
+/* ==========================================================================
+ * Function Definitions Section
+ * ========================================================================== */
+
+/* --------------------------------------------------------------------------
+ * Function: cme_int_kind_for_range
+ * --------------------------------------------------------------------------
+ *
+ * Description: Pick the narrowest element type that holds every value of
+ *              the given range. Non-negative ranges get an unsigned type.
+ *
+ * Parameters:
+ *      min: Smallest value of the range
+ *      max: Largest value of the range
+ *
+ * Returns: Element type
+ *
+ * -------------------------------------------------------------------------- */
+cme_int_kind cme_int_kind_for_range(int64_t min, uint64_t max) {
+  if (0 <= min) {
+    if (UINT8_MAX >= max) {
+      return CME_INT_U8;
+    } else if (UINT16_MAX >= max) {
+      return CME_INT_U16;
+    } else if (UINT32_MAX >= max) {
+      return CME_INT_U32;
+    }
+    return CME_INT_U64;
+  }
+
+  if (INT8_MIN <= min && INT8_MAX >= max) {
+    return CME_INT_I8;
+  } else if (INT16_MIN <= min && INT16_MAX >= max) {
+    return CME_INT_I16;
+  } else if (INT32_MIN <= min && INT32_MAX >= max) {
+    return CME_INT_I32;
+  }
+
+  return CME_INT_I64;
+}
+
+/* --------------------------------------------------------------------------
+ * Function: cme_int_kind_size
+ * --------------------------------------------------------------------------
+ *
+ * Description: Size of an element type
+ *
+ * Parameters:
+ *      kind: Element type
+ *
+ * Returns: Size in bytes
+ *
+ * -------------------------------------------------------------------------- */
+size_t cme_int_kind_size(cme_int_kind kind) {
+  switch (kind) {
+  case CME_INT_U8:
+  case CME_INT_I8:
+    return 1;
+  case CME_INT_U16:
+  case CME_INT_I16:
+    return 2;
+  case CME_INT_U32:
+  case CME_INT_I32:
+    return 4;
+  default:
+    return 8;
+  }
+}
+
+/* --------------------------------------------------------------------------
+ * Function: cme_seq_odds
+ * --------------------------------------------------------------------------
+ *
+ * Description: Get the odd numbers up to a given number, stored in the
+ *              narrowest type that holds them.
+ *
+ * Parameters:
+ *      highest: Highest number of the range
+ *
+ * Returns: Sequence of odd numbers. On failure (or if there are no odd
+ *          numbers in the range) the sequence is empty and its data NULL.
+ *
+ * -------------------------------------------------------------------------- */
+cme_seq cme_seq_odds(uint64_t highest) {
+  cme_seq ret = {CME_INT_U8, NULL, 0, 0};
+  uint64_t count = highest / 2 + (highest & 1);
+
+  if (0 == count || SIZE_MAX / 8 < count) {
+    return ret;
+  }
+
+  ret.kind = cme_int_kind_for_range(1, 2 * count - 1);
+  ret.data = cme_malloc((size_t)count * cme_int_kind_size(ret.kind));
+  if (NULL == ret.data) {
+    return ret;
+  }
+  ret.cap = (size_t)count;
+
+  switch (ret.kind) {
+  case CME_INT_U8:
+    ret.len = cme_seq_odds_u8(ret.data, (size_t)count);
+    break;
+  case CME_INT_U16:
+    ret.len = cme_seq_odds_u16(ret.data, (size_t)count);
+    break;
+  case CME_INT_U32:
+    ret.len = cme_seq_odds_u32(ret.data, (size_t)count);
+    break;
+  default:
+    ret.len = cme_seq_odds_u64(ret.data, (size_t)count);
+    break;
+  }
+
+  return ret;
+}
+
+/* --------------------------------------------------------------------------
+ * Function: cme_seq_powers
+ * --------------------------------------------------------------------------
+ *
+ * Description: Get the powers `base^first_exp ... base^(first_exp + n - 1)`,
+ *              stored in the narrowest type that holds them.
+ *
+ * Parameters:
+ *           base: Base of the powers
+ *      first_exp: Exponent of the first power
+ *              n: Number of powers
+ *
+ * Returns: Sequence of powers. If the powers do not fit into 64 bits, or the
+ *          allocation failed, the sequence is empty and its data NULL.
+ *
+ * -------------------------------------------------------------------------- */
+cme_seq cme_seq_powers(int64_t base, unsigned first_exp, size_t n) {
+  cme_seq ret = {CME_INT_U8, NULL, 0, 0};
+  int64_t ends[3] = {0, 0, 0};
+  uint64_t last = 0;
+  int64_t min = 0;
+  uint64_t max = 0;
+  size_t i = 0;
+
+  if (0 == n || SIZE_MAX / 8 < n) {
+    return ret;
+  }
+
+  /* For |base| >= 1 the extremes are the first and the last two powers (the
+     last two, since for a negative base the signs alternate). */
+  if (1 == cme_powers_i64(base, first_exp, 1, &ends[0]) &&
+      (1 == n ||
+       2 == cme_powers_i64(base, first_exp + (unsigned)(n - 2), 2, &ends[1]))) {
+    if (1 == n) {
+      ends[1] = ends[2] = ends[0];
+    }
+    min = ends[0];
+    max = 0;
+    for (i = 0; i < 3; i++) {
+      min = ends[i] < min ? ends[i] : min;
+      if (0 <= ends[i] && (uint64_t)ends[i] > max) {
+        max = (uint64_t)ends[i];
+      }
+    }
+    ret.kind = cme_int_kind_for_range(min, max);
+  } else if (0 < base && 1 == cme_powers_u64((uint64_t)base,
+                                             first_exp + (unsigned)(n - 1), 1,
+                                             &last)) {
+    ret.kind = CME_INT_U64;
+  } else {
+    return ret;
+  }
+
+  ret.data = cme_malloc(n * cme_int_kind_size(ret.kind));
+  if (NULL == ret.data) {
+    return ret;
+  }
+  ret.cap = n;
+
+  switch (ret.kind) {
+  case CME_INT_U8:
+    ret.len = cme_seq_powers_u8(base, first_exp, n, ret.data);
+    break;
+  case CME_INT_U16:
+    ret.len = cme_seq_powers_u16(base, first_exp, n, ret.data);
+    break;
+  case CME_INT_U32:
+    ret.len = cme_seq_powers_u32(base, first_exp, n, ret.data);
+    break;
+  case CME_INT_U64:
+    ret.len = cme_seq_powers_u64(base, first_exp, n, ret.data);
+    break;
+  case CME_INT_I8:
+    ret.len = cme_seq_powers_i8(base, first_exp, n, ret.data);
+    break;
+  case CME_INT_I16:
+    ret.len = cme_seq_powers_i16(base, first_exp, n, ret.data);
+    break;
+  case CME_INT_I32:
+    ret.len = cme_seq_powers_i32(base, first_exp, n, ret.data);
+    break;
+  default:
+    ret.len = cme_seq_powers_i64(base, first_exp, n, ret.data);
+    break;
+  }
+
+  return ret;
+}
+
+/* --------------------------------------------------------------------------
+ * Function: cme_seq_print
+ * --------------------------------------------------------------------------
+ *
+ * Description: Print the first `n` values of a sequence, one per line, using
+ *              the printer specialized for its element type. Each line is
+ *              `<prefix><value>`, or `<prefix><label><index> = <value>` if a
+ *              label is given.
+ *
+ * Parameters:
+ *                f: Output stream
+ *              seq: Sequence to print
+ *                n: Number of values to print. Printing more values than
+ *                   the sequence holds is reported as an out of bounds
+ *                   access (see `cme_array.h`) and aborts the program.
+ *           prefix: Text put at the start of every line
+ *            label: Text put in front of the index (can be NULL)
+ *      first_index: Index printed for the first value
+ *
+ * Returns: None
+ *
+ * -------------------------------------------------------------------------- */
+void cme_seq_print(FILE *f, cme_seq seq, size_t n, const char *prefix,
+                   const char *label, unsigned first_index) {
+  switch (seq.kind) {
+  case CME_INT_U8:
+    cme_seq_print_u8(f, cme_seq_as_u8(seq), n, prefix, label,
+                     first_index);
+    break;
+  case CME_INT_U16:
+    cme_seq_print_u16(f, cme_seq_as_u16(seq), n, prefix, label,
+                     first_index);
+    break;
+  case CME_INT_U32:
+    cme_seq_print_u32(f, cme_seq_as_u32(seq), n, prefix, label,
+                     first_index);
+    break;
+  case CME_INT_U64:
+    cme_seq_print_u64(f, cme_seq_as_u64(seq), n, prefix, label,
+                     first_index);
+    break;
+  case CME_INT_I8:
+    cme_seq_print_i8(f, cme_seq_as_i8(seq), n, prefix, label,
+                     first_index);
+    break;
+  case CME_INT_I16:
+    cme_seq_print_i16(f, cme_seq_as_i16(seq), n, prefix, label,
+                     first_index);
+    break;
+  case CME_INT_I32:
+    cme_seq_print_i32(f, cme_seq_as_i32(seq), n, prefix, label,
+                     first_index);
+    break;
+  default:
+    cme_seq_print_i64(f, cme_seq_as_i64(seq), n, prefix, label,
+                     first_index);
+    break;
+  }
+}
+
+/* --------------------------------------------------------------------------
+ * Function: cme_seq_free
+ * --------------------------------------------------------------------------
+ *
+ * Description: Release a sequence and reset it to an empty one
+ *
+ * Parameters:
+ *      seq: Pointer to the sequence
+ *
+ * Returns: None
+ *
+ * -------------------------------------------------------------------------- */
+void cme_seq_free(cme_seq *seq) {
+  if (NULL != seq) {
+    cme_free(seq->data);
+    seq->data = NULL;
+    seq->len = 0;
+    seq->cap = 0;
+  }
+}
+
+/* ==========================================================================
+ * Private Function Definitions Section
+ * ========================================================================== */
+
+/* --------------------------------------------------------------------------
+ * Function: seq_powers_u64
+ * --------------------------------------------------------------------------
+ *
+ * Description: `cme_powers_u64` for a signed base. The powers of a negative
+ *              base are those of its magnitude up to the first odd one,
+ *              which is negative.
+ *
+ * Parameters:
+ *           base: Base
+ *      first_exp: Exponent of the first power
+ *              n: Number of powers wanted
+ *            out: Receives the powers
+ *
+ * Returns: Number of powers written
+ *
+ * -------------------------------------------------------------------------- */
+static size_t seq_powers_u64(int64_t base, unsigned first_exp, size_t n,
+                             uint64_t *out) {
+  const uint64_t magnitude = 0 > base ? 0 - (uint64_t)base : (uint64_t)base;
+  size_t got = cme_powers_u64(magnitude, first_exp, n, out);
+  size_t i = 0;
+
+  if (0 > base) {
+    for (i = 0; i < got; i++) {
+      if (1u & (first_exp + (unsigned)i)) {
+        return i;
+      }
+    }
+  }
+
+  return got;
+}
@@ -0,0 +1,132 @@
+/* ==========================================================================
+ *  Copyright (C) 2026 Ljubomir Kurij <ljubomir_kurij@protonmail.com>
+ *
+ * This file is part of "C Common Memory Errors".
+ *
+ * "C Common Memory Errors" is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * "C Common Memory Errors" is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General
+ * Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with Focus Precision Analyze. If not, see <https://www.gnu.org/licenses/>.
+ * ========================================================================== */
+
+/* ==========================================================================
+ *
+ * 2026-10-18 Ljubomir Kurij <ljubomir_kurij@protonmail.com>
+ *
+ * * cme_seq.h: created.
+ *
+ * ========================================================================== */
+
+#ifndef CME_SEQ_H_
+#define CME_SEQ_H_
+
+/* ==========================================================================
+ * Headers Include Section
+ * ========================================================================== */
+
+/* Standard Library headers */
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+
+/* Project headers */
+#include "cme_array.h"
+
+/* ==========================================================================
+ * Type Definitions Section
+ * ========================================================================== */
+
+/* Element types a sequence can be stored in */
+typedef enum cme_int_kind {
+  CME_INT_U8,
+  CME_INT_U16,
+  CME_INT_U32,
+  CME_INT_U64,
+  CME_INT_I8,
+  CME_INT_I16,
+  CME_INT_I32,
+  CME_INT_I64,
+} cme_int_kind;
+
+/* --------------------------------------------------------------------------
+ * Type: cme_seq
+ * --------------------------------------------------------------------------
+ *
+ * Description: Heap allocated integer sequence stored in the narrowest
+ *              element type that holds all of its values. Like the fat
+ *              arrays of `cme_array.h` it carries its length and capacity
+ *              with the pointer; `cme_seq_as_<sfx>` gives the typed fat
+ *              array view. Release it with `cme_seq_free`.
+ *
+ * -------------------------------------------------------------------------- */
+typedef struct cme_seq {
+  cme_int_kind kind;
+  void *data;
+  size_t len;
+  size_t cap;
+} cme_seq;
+
+/* ==========================================================================
+ * Macros Definitions Section
+ * ========================================================================== */
+
+/* --------------------------------------------------------------------------
+ * Macro: CME_SEQ_DECLARE
+ * --------------------------------------------------------------------------
+ *
+ * Description: Declare the sequence generators and the printer specialized
+ *              for one element type:
+ *
+ *              cme_seq_odds_<sfx>    First `n` odd numbers
+ *              cme_seq_powers_<sfx>  Powers `base^first_exp` onwards
+ *              cme_seq_print_<sfx>   Print one value per line
+ *              cme_seq_as_<sfx>      Typed fat array view of a sequence
+ *
+ *              The generators return the number of values written, which is
+ *              less than `n` if the sequence does not fit the type. The view
+ *              is empty if the sequence has a different element type.
+ *
+ * Parameters:
+ *      sfx: Suffix of the function names
+ *     type: Element type
+ *
+ * -------------------------------------------------------------------------- */
+#define CME_SEQ_DECLARE(sfx, type)                                             \
+  size_t cme_seq_odds_##sfx(type *out, size_t n);                              \
+  size_t cme_seq_powers_##sfx(int64_t base, unsigned first_exp, size_t n,      \
+                              type *out);                                      \
+  void cme_seq_print_##sfx(FILE *f, cme_array_##sfx values, size_t n,         \
+                           const char *prefix, const char *label,              \
+                           unsigned first_index);                              \
+  cme_array_##sfx cme_seq_as_##sfx(cme_seq seq)
+
+CME_SEQ_DECLARE(u8, uint8_t);
+CME_SEQ_DECLARE(u16, uint16_t);
+CME_SEQ_DECLARE(u32, uint32_t);
+CME_SEQ_DECLARE(u64, uint64_t);
+CME_SEQ_DECLARE(i8, int8_t);
+CME_SEQ_DECLARE(i16, int16_t);
+CME_SEQ_DECLARE(i32, int32_t);
+CME_SEQ_DECLARE(i64, int64_t);
+
+/* ==========================================================================
+ * Function Declarations Section
+ * ========================================================================== */
+
+cme_int_kind cme_int_kind_for_range(int64_t min, uint64_t max);
+size_t cme_int_kind_size(cme_int_kind kind);
+cme_seq cme_seq_odds(uint64_t highest);
+cme_seq cme_seq_powers(int64_t base, unsigned first_exp, size_t n);
+void cme_seq_print(FILE *f, cme_seq seq, size_t n, const char *prefix,
+                   const char *label, unsigned first_index);
+void cme_seq_free(cme_seq *seq);
+
+#endif /* CME_SEQ_H_ */
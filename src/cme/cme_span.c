@@ -0,0 +1,307 @@
+/* ==========================================================================
+ *  Copyright (C) 2026 Ljubomir Kurij <ljubomir_kurij@protonmail.com>
+ *
+ * This file is part of "C Common Memory Errors".
+ *
+ * "C Common Memory Errors" is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * "C Common Memory Errors" is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General
+ * Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with Focus Precision Analyze. If not, see <https://www.gnu.org/licenses/>.
+ * ========================================================================== */
+
+/* ==========================================================================
+ *
+ * 2026-10-18 Ljubomir Kurij <ljubomir_kurij@protonmail.com>
+ *
+ * * cme_span.c: created.
+ *
+ * ========================================================================== */
+
+/* ==========================================================================
+ * Headers Include Section
+ * ========================================================================== */
+
+/* Related header */
+#include "cme_span.h"
+
+/* Standard Library headers */
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+/* Project headers */
+#include "cme_alloc.h"
+#include "cme_parallel.h"
+
+/* ==========================================================================
+ * Type Definitions Section
+ * ========================================================================== */
+
+/* State shared by the two passes of `cme_str_span_format` */
+typedef struct format_job {
+  const char *prefix;
+  size_t prefix_len;
+  const cme_str_span *columns;
+  size_t num_columns;
+  size_t *offsets; /* Row lengths in pass one, row offsets in pass two */
+  size_t *lengths; /* Of the strings, row by row, measured in pass one */
+  char *out;
+} format_job;
+
+/* ==========================================================================
+ * Private Function Declarations Section
+ * ========================================================================== */
+
+static void measure_rows(void *ctx, size_t begin, size_t end);
+static void write_rows(void *ctx, size_t begin, size_t end);
+
+/* ==========================================================================
+ * Function Definitions Section
+ * ========================================================================== */
+
+/* --------------------------------------------------------------------------
+ * Function: cme_str_span_make
+ * --------------------------------------------------------------------------
+ *
+ * Description: Make a span over the first `count` strings of an array
+ *
+ * Parameters:
+ *       data: Array of strings
+ *      count: Number of strings in the array
+ *
+ * Returns: The span
+ *
+ * -------------------------------------------------------------------------- */
+cme_str_span cme_str_span_make(char *const *data, size_t count) {
+  cme_str_span span = {data, data ? count : 0};
+
+  return span;
+}
+
+/* --------------------------------------------------------------------------
+ * Function: cme_str_span_sub
+ * --------------------------------------------------------------------------
+ *
+ * Description: Make a span over a part of another span. The part is clamped
+ *              to the bounds of the source span.
+ *
+ * Parameters:
+ *       span: Source span
+ *      first: Index of the first string of the part
+ *      count: Number of strings in the part
+ *
+ * Returns: The span over the part
+ *
+ * -------------------------------------------------------------------------- */
+cme_str_span cme_str_span_sub(cme_str_span span, size_t first, size_t count) {
+  cme_str_span sub = {span.data, 0};
+
+  if (first > span.count) {
+    first = span.count;
+  }
+  if (count > span.count - first) {
+    count = span.count - first;
+  }
+  sub.data = span.data ? span.data + first : NULL;
+  sub.count = count;
+
+  return sub;
+}
+
+/* --------------------------------------------------------------------------
+ * Function: cme_str_span_format
+ * --------------------------------------------------------------------------
+ *
+ * Description: Format spans of strings as a table into a single buffer. Row
+ *              `i` is `prefix`, followed by the `i`-th string of each column
+ *              separated by tabs, followed by a newline. The number of rows
+ *              is the count of the shortest column, and NULL strings are
+ *              formatted as empty ones.
+ *
+ *              The total size is computed up front so the buffer is allocated
+ *              once, and the rows are copied straight into place with the
+ *              lengths measured for it. Both passes are split across threads
+ *              for large tables.
+ *
+ * Parameters:
+ *         prefix: String written at the start of every row (may be NULL)
+ *        columns: Array of columns
+ *    num_columns: Number of columns
+ *         length: Set to the length of the formatted text (may be NULL)
+ *
+ * Returns: Pointer to the null terminated text, which must be released by
+ *          the caller with `cme_free`, or NULL if the memory can not be
+ *          allocated
+ *
+ * -------------------------------------------------------------------------- */
+char *cme_str_span_format(const char *prefix, const cme_str_span *columns,
+                          size_t num_columns, size_t *length) {
+  format_job job = {NULL, 0, NULL, 0, NULL, NULL, NULL};
+  size_t rows = 0 < num_columns ? columns[0].count : 0;
+  size_t cells = 0;
+  size_t total = 0;
+  size_t i = 0;
+
+  for (i = 1; i < num_columns; i++) {
+    if (rows > columns[i].count) {
+      rows = columns[i].count;
+    }
+  }
+
+  job.prefix = prefix ? prefix : "";
+  job.prefix_len = strlen(job.prefix);
+  job.columns = columns;
+  job.num_columns = num_columns;
+
+  /* The offsets and the lengths of the strings share an allocation */
+  if (rows >= SIZE_MAX / sizeof(size_t) ||
+      (0 < num_columns &&
+       rows > (SIZE_MAX / sizeof(size_t) - rows - 1) / num_columns)) {
+    return NULL;
+  }
+  cells = rows * num_columns;
+  job.offsets = cme_malloc((rows + 1 + cells) * sizeof(size_t));
+  if (!job.offsets) {
+    return NULL;
+  }
+  job.lengths = job.offsets + rows + 1;
+
+  /* Pass one: length of every row, stored one slot ahead so the running sum
+     below turns it into the offset of the next row in place */
+  job.offsets[0] = 0;
+  cme_parallel_for(rows, CME_SPAN_PARALLEL_MIN_ROWS, measure_rows, &job);
+  for (i = 1; i <= rows; i++) {
+    total += job.offsets[i];
+    job.offsets[i] = total;
+  }
+
+  job.out = cme_malloc(total + 1);
+  if (job.out) {
+    /* Pass two: every row is copied to its own offset */
+    cme_parallel_for(rows, CME_SPAN_PARALLEL_MIN_ROWS, write_rows, &job);
+    job.out[total] = '\0';
+    if (length) {
+      *length = total;
+    }
+  }
+
+  cme_free(job.offsets);
+
+  return job.out;
+}
+
+/* --------------------------------------------------------------------------
+ * Function: cme_str_span_print
+ * --------------------------------------------------------------------------
+ *
+ * Description: Print spans of strings as a table (see `cme_str_span_format`)
+ *              with a single write to the stream
+ *
+ * Parameters:
+ *         stream: Stream to print to
+ *         prefix: String written at the start of every row (may be NULL)
+ *        columns: Array of columns
+ *    num_columns: Number of columns
+ *
+ * Returns: 0 on success, -1 if the memory can not be allocated or the write
+ *          fails
+ *
+ * -------------------------------------------------------------------------- */
+int cme_str_span_print(FILE *stream, const char *prefix,
+                       const cme_str_span *columns, size_t num_columns) {
+  size_t length = 0;
+  char *text = cme_str_span_format(prefix, columns, num_columns, &length);
+  int status = -1;
+
+  if (text) {
+    status = length == fwrite(text, 1, length, stream) ? 0 : -1;
+    cme_free(text);
+  }
+
+  return status;
+}
+
+/* ==========================================================================
+ * Private Function Definitions Section
+ * ========================================================================== */
+
+/* --------------------------------------------------------------------------
+ * Function: measure_rows
+ * --------------------------------------------------------------------------
+ *
+ * Description: Compute the formatted length of the rows in [begin, end),
+ *              keeping the length of every string for `write_rows`
+ *
+ * Parameters:
+ *        ctx: Pointer to the format job
+ *      begin: First row
+ *        end: One past the last row
+ *
+ * Returns: None
+ *
+ * -------------------------------------------------------------------------- */
+static void measure_rows(void *ctx, size_t begin, size_t end) {
+  format_job *job = ctx;
+  size_t *lengths = job->lengths + begin * job->num_columns;
+  size_t row = 0;
+  size_t col = 0;
+
+  for (row = begin; row < end; row++) {
+    /* Prefix, a tab or a newline after every column */
+    size_t len = job->prefix_len + job->num_columns;
+
+    for (col = 0; col < job->num_columns; col++) {
+      const char *str = job->columns[col].data[row];
+
+      *lengths = str ? strlen(str) : 0;
+      len += *lengths++;
+    }
+    job->offsets[row + 1] = len;
+  }
+}
+
+/* --------------------------------------------------------------------------
+ * Function: write_rows
+ * --------------------------------------------------------------------------
+ *
+ * Description: Copy the rows in [begin, end) to their offsets in the output
+ *              buffer
+ *
+ * Parameters:
+ *        ctx: Pointer to the format job
+ *      begin: First row
+ *        end: One past the last row
+ *
+ * Returns: None
+ *
+ * -------------------------------------------------------------------------- */
+static void write_rows(void *ctx, size_t begin, size_t end) {
+  format_job *job = ctx;
+  const size_t *lengths = job->lengths + begin * job->num_columns;
+  size_t row = 0;
+  size_t col = 0;
+
+  for (row = begin; row < end; row++) {
+    char *dest = job->out + job->offsets[row];
+
+    memcpy(dest, job->prefix, job->prefix_len);
+    dest += job->prefix_len;
+    for (col = 0; col < job->num_columns; col++) {
+      size_t len = *lengths++;
+
+      if (0 < len) {
+        memcpy(dest, job->columns[col].data[row], len);
+        dest += len;
+      }
+      *dest++ = col + 1 < job->num_columns ? '\t' : '\n';
+    }
+  }
+}
@@ -0,0 +1,73 @@
+/* ==========================================================================
+ *  Copyright (C) 2026 Ljubomir Kurij <ljubomir_kurij@protonmail.com>
+ *
+ * This file is part of "C Common Memory Errors".
+ *
+ * "C Common Memory Errors" is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * "C Common Memory Errors" is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General
+ * Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with Focus Precision Analyze. If not, see <https://www.gnu.org/licenses/>.
+ * ========================================================================== */
+
+/* ==========================================================================
+ *
+ * 2026-10-18 Ljubomir Kurij <ljubomir_kurij@protonmail.com>
+ *
+ * * cme_span.h: created.
+ *
+ * ========================================================================== */
+
+#ifndef CME_SPAN_H_
+#define CME_SPAN_H_
+
+/* ==========================================================================
+ * Headers Include Section
+ * ========================================================================== */
+
+/* Standard Library headers */
+#include <stddef.h>
+#include <stdio.h>
+
+/* ==========================================================================
+ * Macros Definitions Section
+ * ========================================================================== */
+
+/* Span over a whole array of strings (`arr` must be an array, not a pointer;
+   the element count is taken from its type) */
+#define CME_SPAN_OF(arr) \
+  ((cme_str_span){(arr), sizeof(arr) / sizeof((arr)[0])})
+
+/* Tables with fewer rows than this are formatted on the calling thread */
+#define CME_SPAN_PARALLEL_MIN_ROWS ((size_t)16 << 10)
+
+/* ==========================================================================
+ * Type Definitions Section
+ * ========================================================================== */
+
+/* Counted array of strings. The element count travels with the pointer, so
+   no NULL sentinel is needed to find the end of the array */
+typedef struct cme_str_span {
+  char *const *data;
+  size_t count;
+} cme_str_span;
+
+/* ==========================================================================
+ * Function Declarations Section
+ * ========================================================================== */
+
+cme_str_span cme_str_span_make(char *const *data, size_t count);
+cme_str_span cme_str_span_sub(cme_str_span span, size_t first, size_t count);
+char *cme_str_span_format(const char *prefix, const cme_str_span *columns,
+                          size_t num_columns, size_t *length);
+int cme_str_span_print(FILE *stream, const char *prefix,
+                       const cme_str_span *columns, size_t num_columns);
+
+#endif /* CME_SPAN_H_ */
@@ -0,0 +1,336 @@
+/* ==========================================================================
+ *  Copyright (C) 2026 Ljubomir Kurij <ljubomir_kurij@protonmail.com>
+ *
+ * This file is part of "C Common Memory Errors".
+ *
+ * "C Common Memory Errors" is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * "C Common Memory Errors" is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General
+ * Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with Focus Precision Analyze. If not, see <https://www.gnu.org/licenses/>.
+ * ========================================================================== */
+
+/* ==========================================================================
+ *
+ * 2026-10-18 Ljubomir Kurij <ljubomir_kurij@protonmail.com>
+ *
+ * * cme_string.c: created.
+ *
+ * ========================================================================== */
+
+/* ==========================================================================
+ * Headers Include Section
+ * ========================================================================== */
+
+/* Related header */
+#include "cme_string.h"
+
+/* System headers */
+
+/* Standard Library headers */
+#include <stdlib.h>
+#include <string.h>
+
+/* Project headers */
+#include "cme_alloc.h"
+
+/* ==========================================================================
+ * Macros Definitions Section
+ * ========================================================================== */
+
+/* Size of the blocks `cme_strlcpy` scans and copies in one go */
+#define CME_STRLCPY_CHUNK ((size_t)4096)
+
+/* ==========================================================================
+ * Function Definitions Section
+ * ========================================================================== */
+
+/* --------------------------------------------------------------------------
+ * Function: cme_strlcpy
+ * --------------------------------------------------------------------------
+ *
+ * Description: Copy a null terminated string into a buffer of a given size.
+ *              If the source does not fit it is truncated. Unlike `strncpy`,
+ *              the destination is always null terminated, and the unused part
+ *              of the buffer is left untouched (no zero padding).
+ *
+ * Parameters:
+ *         dest: Pointer to the destination buffer
+ *          src: Pointer to the null terminated source string
+ *    dest_size: Size of the destination buffer in bytes
+ *
+ * Returns: Length of the source string. If the returned value is not less
+ *          than `dest_size` the copy was truncated.
+ *
+ * Note: The terminator is searched with `memchr` and the bytes are moved with
+ *       `memcpy`, one cache sized block at a time. Both are word (or vector)
+ *       wide in every C library we target, so the copy never falls back to a
+ *       byte by byte loop. Only when the source got truncated the rest of it
+ *       is scanned to compute the return value.
+ *
+ * -------------------------------------------------------------------------- */
+size_t cme_strlcpy(char *dest, const char *src, size_t dest_size) {
+  const char *end = NULL;
+  size_t offset = 0;
+  size_t chunk = 0;
+
+  if (0 == dest_size) {
+    return strlen(src);
+  }
+
+  /* Scan and copy in chunks that fit into L1 cache, so the copy reads the
+     bytes the scan has just brought in instead of going to memory twice */
+  for (;;) {
+    chunk = dest_size - offset;
+    if (chunk > CME_STRLCPY_CHUNK) {
+      chunk = CME_STRLCPY_CHUNK;
+    }
+
+    end = memchr(src + offset, '\0', chunk);
+    if (NULL != end) {
+      /* The rest of the source fits, terminator included */
+      chunk = (size_t)(end - src) - offset;
+      memcpy(dest + offset, src + offset, chunk + 1);
+
+      return offset + chunk;
+    }
+
+    if (offset + chunk == dest_size) {
+      /* Out of room, truncate */
+      memcpy(dest + offset, src + offset, chunk - 1);
+      dest[dest_size - 1] = '\0';
+
+      return dest_size + strlen(src + dest_size);
+    }
+
+    memcpy(dest + offset, src + offset, chunk);
+    offset += chunk;
+  }
+}
+
+/* --------------------------------------------------------------------------
+ * Function: cme_str_view
+ * --------------------------------------------------------------------------
+ *
+ * Description: Make a read-only counted string out of a null terminated
+ *              string. This is the only place where the length of the string
+ *              gets computed by scanning for the terminator.
+ *
+ * Parameters:
+ *      cstr: Pointer to a null terminated string (can be NULL)
+ *
+ * Returns: Read-only counted string
+ *
+ * -------------------------------------------------------------------------- */
+cme_str cme_str_view(const char *cstr) {
+  cme_str ret = {NULL, 0, 0};
+
+  if (NULL != cstr) {
+    ret.data = (char *)cstr;
+    ret.len = strlen(cstr);
+  }
+
+  return ret;
+}
+
+/* --------------------------------------------------------------------------
+ * Function: cme_str_sub
+ * --------------------------------------------------------------------------
+ *
+ * Description: Make a read-only view of a part of the given string. Offset
+ *              and length are clamped to the bounds of the string.
+ *
+ * Parameters:
+ *         str: Source string
+ *      offset: Index of the first character of the substring
+ *         len: Number of characters in the substring
+ *
+ * Returns: Read-only counted string
+ *
+ * Note: The view is not null terminated unless it extends to the end of the
+ *       source string. Use the `%.*s` format to print it.
+ *
+ * -------------------------------------------------------------------------- */
+cme_str cme_str_sub(cme_str str, size_t offset, size_t len) {
+  cme_str ret = {NULL, 0, 0};
+
+  if (NULL != str.data) {
+    if (offset > str.len) {
+      offset = str.len;
+    }
+    if (len > str.len - offset) {
+      len = str.len - offset;
+    }
+    ret.data = str.data + offset;
+    ret.len = len;
+  }
+
+  return ret;
+}
+
+/* --------------------------------------------------------------------------
+ * Function: cme_str_wrap
+ * --------------------------------------------------------------------------
+ *
+ * Description: Make an empty writable string on top of a caller supplied
+ *              buffer. The buffer is set to an empty string.
+ *
+ * Parameters:
+ *       buf: Pointer to the buffer
+ *       cap: Size of the buffer in bytes
+ *
+ * Returns: Writable counted string of zero length
+ *
+ * -------------------------------------------------------------------------- */
+cme_str cme_str_wrap(char *buf, size_t cap) {
+  cme_str ret = {NULL, 0, 0};
+
+  if (NULL != buf && 0 < cap) {
+    buf[0] = '\0';
+    ret.data = buf;
+    ret.cap = cap;
+  }
+
+  return ret;
+}
+
+/* --------------------------------------------------------------------------
+ * Function: cme_str_find
+ * --------------------------------------------------------------------------
+ *
+ * Description: Find the first occurrence of a character in the string.
+ *
+ * Parameters:
+ *       str: String to search
+ *         c: Character to look for
+ *
+ * Returns: Index of the character, or `str.len` if it was not found
+ *
+ * -------------------------------------------------------------------------- */
+size_t cme_str_find(cme_str str, char c) {
+  const char *found = NULL;
+
+  if (0 == str.len) {
+    return 0;
+  }
+
+  found = memchr(str.data, c, str.len);
+
+  return found ? (size_t)(found - str.data) : str.len;
+}
+
+/* --------------------------------------------------------------------------
+ * Function: cme_str_copy
+ * --------------------------------------------------------------------------
+ *
+ * Description: Replace the content of the destination string with the source
+ *              string. If the source does not fit it is truncated. The
+ *              destination is always null terminated.
+ *
+ * Parameters:
+ *      dest: Pointer to the writable destination string
+ *       src: Source string
+ *
+ * Returns: Number of characters copied
+ *
+ * -------------------------------------------------------------------------- */
+size_t cme_str_copy(cme_str *dest, cme_str src) {
+  if (NULL == dest || 0 == dest->cap) {
+    return 0;
+  }
+
+  dest->len = 0;
+  dest->data[0] = '\0';
+
+  return cme_str_append(dest, src);
+}
+
+/* --------------------------------------------------------------------------
+ * Function: cme_str_append
+ * --------------------------------------------------------------------------
+ *
+ * Description: Append the source string to the destination string. Only as
+ *              many characters as there is room for are appended. The
+ *              destination is always null terminated.
+ *
+ * Parameters:
+ *      dest: Pointer to the writable destination string
+ *       src: Source string
+ *
+ * Returns: Number of characters appended
+ *
+ * -------------------------------------------------------------------------- */
+size_t cme_str_append(cme_str *dest, cme_str src) {
+  size_t room = 0;
+  size_t count = 0;
+
+  if (NULL == dest || 0 == dest->cap) {
+    return 0;
+  }
+
+  room = dest->cap - dest->len - 1;
+  count = src.len < room ? src.len : room;
+  if (0 < count) {
+    /* memmove, since the source can be a view of the destination itself */
+    memmove(dest->data + dest->len, src.data, count);
+  }
+  dest->len += count;
+  dest->data[dest->len] = '\0';
+
+  return count;
+}
+
+/* --------------------------------------------------------------------------
+ * Function: cme_str_dup
+ * --------------------------------------------------------------------------
+ *
+ * Description: Make a heap allocated, null terminated copy of the string. The
+ *              caller is responsible for releasing it with `cme_str_free`.
+ *
+ * Parameters:
+ *       src: Source string
+ *
+ * Returns: Writable counted string, or a string with NULL data if the
+ *          allocation failed
+ *
+ * -------------------------------------------------------------------------- */
+cme_str cme_str_dup(cme_str src) {
+  cme_str ret = {NULL, 0, 0};
+
+  ret.data = cme_malloc(src.len + 1);
+  if (ret.data) {
+    ret.cap = src.len + 1;
+    cme_str_copy(&ret, src);
+  }
+
+  return ret;
+}
+
+/* --------------------------------------------------------------------------
+ * Function: cme_str_free
+ * --------------------------------------------------------------------------
+ *
+ * Description: Release a string allocated with `cme_str_dup` and reset it to
+ *              an empty string.
+ *
+ * Parameters:
+ *       str: Pointer to the string to release
+ *
+ * Returns: None
+ *
+ * -------------------------------------------------------------------------- */
+void cme_str_free(cme_str *str) {
+  if (NULL != str) {
+    cme_free(str->data);
+    str->data = NULL;
+    str->len = 0;
+    str->cap = 0;
+  }
+}
@@ -0,0 +1,81 @@
+/* ==========================================================================
+ *  Copyright (C) 2026 Ljubomir Kurij <ljubomir_kurij@protonmail.com>
+ *
+ * This file is part of "C Common Memory Errors".
+ *
+ * "C Common Memory Errors" is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * "C Common Memory Errors" is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General
+ * Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with Focus Precision Analyze. If not, see <https://www.gnu.org/licenses/>.
+ * ========================================================================== */
+
+/* ==========================================================================
+ *
+ * 2026-10-18 Ljubomir Kurij <ljubomir_kurij@protonmail.com>
+ *
+ * * cme_string.h: created.
+ *
+ * ========================================================================== */
+
+#ifndef CME_STRING_H_
+#define CME_STRING_H_
+
+/* ==========================================================================
+ * Headers Include Section
+ * ========================================================================== */
+
+/* Standard Library headers */
+#include <stddef.h>
+
+/* ==========================================================================
+ * Macros Definitions Section
+ * ========================================================================== */
+
+/* Build a read-only counted string from a string literal. The length is taken
+   from `sizeof` at compile time, so no scan is needed at run time. */
+#define CME_STR_LIT(lit) ((cme_str){(char *)("" lit ""), sizeof(lit) - 1, 0})
+
+/* ==========================================================================
+ * Type Definitions Section
+ * ========================================================================== */
+
+/* --------------------------------------------------------------------------
+ * Type: cme_str
+ * --------------------------------------------------------------------------
+ *
+ * Description: Length carrying string. `len` is the number of characters
+ *              stored (without the null terminator), and `cap` is the size of
+ *              the buffer pointed to by `data` in bytes (including the room
+ *              for the null terminator). A string with `cap` equal to zero is
+ *              a read-only view and can not be written to.
+ *
+ * -------------------------------------------------------------------------- */
+typedef struct cme_str {
+  char *data;
+  size_t len;
+  size_t cap;
+} cme_str;
+
+/* ==========================================================================
+ * Function Declarations Section
+ * ========================================================================== */
+
+size_t cme_strlcpy(char *dest, const char *src, size_t dest_size);
+cme_str cme_str_view(const char *cstr);
+cme_str cme_str_sub(cme_str str, size_t offset, size_t len);
+cme_str cme_str_wrap(char *buf, size_t cap);
+size_t cme_str_find(cme_str str, char c);
+size_t cme_str_copy(cme_str *dest, cme_str src);
+size_t cme_str_append(cme_str *dest, cme_str src);
+cme_str cme_str_dup(cme_str src);
+void cme_str_free(cme_str *str);
+
+#endif /* CME_STRING_H_ */
@@ -0,0 +1,796 @@
+/* ==========================================================================
+ *  Copyright (C) 2026 Ljubomir Kurij <ljubomir_kurij@protonmail.com>
+ *
+ * This file is part of "C Common Memory Errors".
+ *
+ * "C Common Memory Errors" is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * "C Common Memory Errors" is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General
+ * Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with Focus Precision Analyze. If not, see <https://www.gnu.org/licenses/>.
+ * ========================================================================== */
+
+/* ==========================================================================
+ *
+ * 2026-10-18 Ljubomir Kurij <ljubomir_kurij@protonmail.com>
+ *
+ * * cme_trace.c: created.
+ *
+ * ========================================================================== */
+
+/* ==========================================================================
+ * Headers Include Section
+ * ========================================================================== */
+
+/* Related header */
+#include "cme_trace.h"
+
+/* System headers */
+#if defined(CME_HAVE_PTHREADS) && !defined(__STDC_NO_ATOMICS__)
+#define CME_HAVE_TRACE 1
+#include <pthread.h>
+#include <stdatomic.h>
+#endif /* End of platform specific headers */
+
+#if defined(CME_HAVE_TRACE) && (defined(__unix__) || defined(__APPLE__))
+#define CME_TRACE_CRASH_FLUSH 1
+#include <signal.h>
+#include <unistd.h>
+#endif /* End of crash handler headers */
+
+/* Standard Library headers */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+/* Project headers */
+#include "cme_alloc.h"
+
+#ifdef CME_HAVE_TRACE
+
+/* ==========================================================================
+ * Macros Definitions Section
+ * ========================================================================== */
+
+/* Bytes of events collected before they are written out */
+#define TRACE_BUFFER_SIZE ((size_t)64 * 1024)
+
+/* Most bytes an event takes (an operation and three varints) */
+#define TRACE_EVENT_MAX 31
+
+/* Slots the block table starts with (a power of two); it doubles when half
+   full */
+#define TRACE_SLOTS 1024
+
+/* States of the recorder */
+#define TRACE_UNSET 0 /* Environment not read yet */
+#define TRACE_OFF 1
+#define TRACE_ON 2
+
+/* ==========================================================================
+ * Type Definitions Section
+ * ========================================================================== */
+
+/* A live block and its number in the trace */
+typedef struct trace_entry {
+  uintptr_t ptr; /* 0 for an empty slot */
+  uint64_t block;
+} trace_entry;
+
+/* ==========================================================================
+ * Private Function Declarations Section
+ * ========================================================================== */
+
+static int trace_enabled(void);
+static int trace_setup(const char *path);
+static void trace_close(void);
+static void trace_at_exit(void);
+static size_t trace_home(uintptr_t ptr, size_t cap);
+static int trace_insert(uintptr_t ptr, uint64_t block);
+static uint64_t trace_remove(uintptr_t ptr);
+static int trace_grow(void);
+static void trace_event(int op, uint64_t back, int has_size, size_t size);
+static void trace_varint(uint64_t value);
+static void trace_flush(void);
+#ifdef CME_TRACE_CRASH_FLUSH
+static void trace_install_crash_handlers(void);
+static void trace_on_crash(int signal_number);
+#endif
+
+/* ==========================================================================
+ * Global Variables Section
+ * ========================================================================== */
+
+static pthread_mutex_t g_setup_lock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_mutex_t g_lock = PTHREAD_MUTEX_INITIALIZER; /* The rest */
+static atomic_int g_state = TRACE_UNSET;
+static int g_at_exit = 0; /* Stop registered with `atexit` */
+static FILE *g_file = NULL;
+static unsigned char g_buffer[TRACE_BUFFER_SIZE];
+static size_t g_used = 0;
+static uint64_t g_last_time = 0; /* Of the event before, in nanoseconds */
+static size_t g_last_size = 0;   /* Of the allocation or resize before */
+static uint64_t g_next_block = 1;
+static trace_entry *g_slots = NULL; /* Live blocks of the trace */
+static size_t g_cap = 0;
+static size_t g_count = 0;
+
+#ifdef CME_TRACE_CRASH_FLUSH
+/* What a fatal signal writes out: the start of the buffer that holds whole
+   events, to the file while it is open (-1 otherwise) */
+static const int kCrashSignals[] = {SIGABRT, SIGBUS, SIGFPE, SIGILL, SIGSEGV};
+static struct sigaction g_previous[sizeof(kCrashSignals) /
+                                   sizeof(kCrashSignals[0])];
+static int g_handlers = 0; /* Crash handlers installed */
+static atomic_int g_fd = -1;
+static atomic_size_t g_whole = 0;
+#endif
+
+#endif /* CME_HAVE_TRACE */
+
+/* ==========================================================================
+ * Function Definitions Section
+ * ========================================================================== */
+
+/* --------------------------------------------------------------------------
+ * Function: cme_trace_start
+ * --------------------------------------------------------------------------
+ *
+ * Description: Start recording the allocations, resizes and frees of the
+ *              `cme` allocator into a file, as setting `CME_TRACE=FILE`
+ *              would. The trace is written out at exit (or by
+ *              `cme_trace_stop`). Blocks allocated before are not in the
+ *              trace, and neither are their frees.
+ *
+ * Parameters:
+ *      path: File to write the trace to (truncated)
+ *
+ * Returns: 0 on success (or if a trace is being recorded already), -1 if
+ *          the recorder is not supported here or the file can not be opened
+ *
+ * -------------------------------------------------------------------------- */
+int cme_trace_start(const char *path) {
+#ifdef CME_HAVE_TRACE
+  int status = 0;
+
+  cme_alloc_watch();
+  pthread_mutex_lock(&g_setup_lock);
+  status = trace_setup(path);
+  pthread_mutex_unlock(&g_setup_lock);
+
+  return status;
+#else
+  (void)path;
+  return -1;
+#endif /* End of platform specific code */
+}
+
+/* --------------------------------------------------------------------------
+ * Function: cme_trace_stop
+ * --------------------------------------------------------------------------
+ *
+ * Description: Stop recording, and write out and close the trace. Blocks
+ *              still live are left out of the trace with no free.
+ *
+ * Parameters: None
+ *
+ * Returns: None
+ *
+ * -------------------------------------------------------------------------- */
+void cme_trace_stop(void) {
+#ifdef CME_HAVE_TRACE
+  if (TRACE_ON != atomic_load_explicit(&g_state, memory_order_acquire)) {
+    return;
+  }
+
+  pthread_mutex_lock(&g_lock);
+  trace_close();
+  pthread_mutex_unlock(&g_lock);
+#endif /* End of platform specific code */
+}
+
+/* --------------------------------------------------------------------------
+ * Function: cme_trace_alloc
+ * --------------------------------------------------------------------------
+ *
+ * Description: Called by the allocator for every new block: record it and
+ *              give it the next block number. The first call reads the
+ *              environment.
+ *
+ * Parameters:
+ *       ptr: The new block
+ *      size: Its size
+ *        op: CME_TRACE_MALLOC, or CME_TRACE_CALLOC for a zeroed block
+ *
+ * Returns: None
+ *
+ * -------------------------------------------------------------------------- */
+void cme_trace_alloc(void *ptr, size_t size, int op) {
+#ifdef CME_HAVE_TRACE
+  if (!trace_enabled()) {
+    return;
+  }
+
+  pthread_mutex_lock(&g_lock);
+  if (TRACE_ON == atomic_load(&g_state) &&
+      0 == trace_insert((uintptr_t)ptr, g_next_block)) {
+    g_next_block++;
+    trace_event(op, 0, 1, size);
+  }
+  pthread_mutex_unlock(&g_lock);
+#else
+  (void)ptr;
+  (void)size;
+  (void)op;
+#endif /* End of platform specific code */
+}
+
+/* --------------------------------------------------------------------------
+ * Function: cme_trace_detach
+ * --------------------------------------------------------------------------
+ *
+ * Description: Called by the allocator before a block is resized: take it
+ *              out of the table (before its address can be handed out
+ *              again), for `cme_trace_realloc` to record the resize
+ *
+ * Parameters:
+ *      ptr: Block about to be resized
+ *
+ * Returns: Number of the block, or 0 if it is not in the trace
+ *
+ * -------------------------------------------------------------------------- */
+uint64_t cme_trace_detach(const void *ptr) {
+#ifdef CME_HAVE_TRACE
+  uint64_t block = 0;
+
+  if (TRACE_ON != atomic_load_explicit(&g_state, memory_order_acquire)) {
+    return 0;
+  }
+
+  pthread_mutex_lock(&g_lock);
+  if (TRACE_ON == atomic_load(&g_state)) {
+    block = trace_remove((uintptr_t)ptr);
+  }
+  pthread_mutex_unlock(&g_lock);
+
+  return block;
+#else
+  (void)ptr;
+  return 0;
+#endif /* End of platform specific code */
+}
+
+/* --------------------------------------------------------------------------
+ * Function: cme_trace_realloc
+ * --------------------------------------------------------------------------
+ *
+ * Description: Called by the allocator after a resize: record it, and give
+ *              the resized block the next block number. A failed resize is
+ *              not recorded, and the old block is put back.
+ *
+ * Parameters:
+ *      block: Number of the old block, from `cme_trace_detach`
+ *        old: The old block
+ *        ptr: The resized block (NULL if the resize failed)
+ *       size: Its size
+ *
+ * Returns: None
+ *
+ * -------------------------------------------------------------------------- */
+void cme_trace_realloc(uint64_t block, void *old, void *ptr, size_t size) {
+#ifdef CME_HAVE_TRACE
+  if (!trace_enabled()) {
+    return;
+  }
+
+  pthread_mutex_lock(&g_lock);
+  if (TRACE_ON != atomic_load(&g_state)) {
+    pthread_mutex_unlock(&g_lock);
+    return;
+  }
+  if (NULL == ptr) {
+    if (0 != block) {
+      trace_insert((uintptr_t)old, block);
+    }
+  } else if (0 == trace_insert((uintptr_t)ptr, g_next_block)) {
+    g_next_block++;
+    trace_event(CME_TRACE_REALLOC, block ? g_next_block - 1 - block : 0, 1,
+                size);
+  }
+  pthread_mutex_unlock(&g_lock);
+#else
+  (void)block;
+  (void)old;
+  (void)ptr;
+  (void)size;
+#endif /* End of platform specific code */
+}
+
+/* --------------------------------------------------------------------------
+ * Function: cme_trace_free
+ * --------------------------------------------------------------------------
+ *
+ * Description: Called by the allocator before a block is freed: record the
+ *              free if the block is in the trace
+ *
+ * Parameters:
+ *      ptr: Block about to be freed
+ *
+ * Returns: None
+ *
+ * -------------------------------------------------------------------------- */
+void cme_trace_free(const void *ptr) {
+#ifdef CME_HAVE_TRACE
+  uint64_t block = 0;
+
+  if (TRACE_ON != atomic_load_explicit(&g_state, memory_order_acquire)) {
+    return;
+  }
+
+  pthread_mutex_lock(&g_lock);
+  if (TRACE_ON == atomic_load(&g_state)) {
+    block = trace_remove((uintptr_t)ptr);
+    if (0 != block) {
+      trace_event(CME_TRACE_FREE, g_next_block - block, 0, 0);
+    }
+  }
+  pthread_mutex_unlock(&g_lock);
+#else
+  (void)ptr;
+#endif /* End of platform specific code */
+}
+
+#ifdef CME_HAVE_TRACE
+
+/* ==========================================================================
+ * Private Function Definitions Section
+ * ========================================================================== */
+
+/* --------------------------------------------------------------------------
+ * Function: trace_enabled
+ * --------------------------------------------------------------------------
+ *
+ * Description: Tell whether a trace is being recorded, reading the
+ *              environment on the first call
+ *
+ * Parameters: None
+ *
+ * Returns: 1 if recording, 0 otherwise
+ *
+ * -------------------------------------------------------------------------- */
+static int trace_enabled(void) {
+  const char *value = NULL;
+
+  if (TRACE_UNSET == atomic_load_explicit(&g_state, memory_order_acquire)) {
+    pthread_mutex_lock(&g_setup_lock);
+    if (TRACE_UNSET == atomic_load(&g_state)) {
+      value = getenv(CME_TRACE_ENV);
+      if (value && '\0' != *value) {
+        trace_setup(value);
+      } else {
+        atomic_store(&g_state, TRACE_OFF);
+      }
+    }
+    pthread_mutex_unlock(&g_setup_lock);
+  }
+
+  return TRACE_ON == atomic_load_explicit(&g_state, memory_order_acquire);
+}
+
+/* --------------------------------------------------------------------------
+ * Function: trace_setup
+ * --------------------------------------------------------------------------
+ *
+ * Description: Open the trace and allocate the block table, have the trace
+ *              written out at exit, and turn the recorder on. Called with the
+ *              setup lock held.
+ *
+ * Parameters:
+ *      path: File to write the trace to
+ *
+ * Returns: 0 on success, -1 on failure (the recorder is turned off)
+ *
+ * -------------------------------------------------------------------------- */
+static int trace_setup(const char *path) {
+  struct timespec ts;
+  FILE *file = NULL;
+
+  if (TRACE_ON == atomic_load(&g_state)) {
+    return 0;
+  }
+
+  /* The table comes from the system allocator, so it is not in the trace */
+  file = fopen(path, "wb");
+  if (file) {
+    /* Events are collected in `g_buffer` already, and a crash can write
+       out only what is there */
+    setvbuf(file, NULL, _IONBF, 0);
+  }
+  g_slots = calloc(TRACE_SLOTS, sizeof(trace_entry));
+  if (NULL == file || NULL == g_slots ||
+      1 != fwrite(CME_TRACE_MAGIC, CME_TRACE_MAGIC_SIZE, 1, file)) {
+    fprintf(stderr, "cme_trace: can not record a trace to %s\n", path);
+    if (file) {
+      fclose(file);
+    }
+    free(g_slots);
+    g_slots = NULL;
+    atomic_store(&g_state, TRACE_OFF);
+    return -1;
+  }
+
+  pthread_mutex_lock(&g_lock);
+  g_file = file;
+  g_cap = TRACE_SLOTS;
+  g_count = 0;
+  g_used = 0;
+  g_last_size = 0;
+  g_next_block = 1;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  g_last_time = (uint64_t)ts.tv_sec * 1000000000u + (uint64_t)ts.tv_nsec;
+#ifdef CME_TRACE_CRASH_FLUSH
+  atomic_store(&g_whole, 0);
+  atomic_store(&g_fd, fileno(file));
+#endif
+  pthread_mutex_unlock(&g_lock);
+
+  if (!g_at_exit) {
+    atexit(trace_at_exit);
+    g_at_exit = 1;
+  }
+#ifdef CME_TRACE_CRASH_FLUSH
+  if (!g_handlers) {
+    trace_install_crash_handlers();
+    g_handlers = 1;
+  }
+#endif
+  atomic_store(&g_state, TRACE_ON);
+
+  return 0;
+}
+
+/* --------------------------------------------------------------------------
+ * Function: trace_close
+ * --------------------------------------------------------------------------
+ *
+ * Description: Write out and close the trace, release the table, and turn
+ *              the recorder off. Called with the lock held.
+ *
+ * Parameters: None
+ *
+ * Returns: None
+ *
+ * -------------------------------------------------------------------------- */
+static void trace_close(void) {
+  if (TRACE_ON != atomic_load(&g_state)) {
+    return;
+  }
+
+  trace_flush();
+#ifdef CME_TRACE_CRASH_FLUSH
+  atomic_store(&g_fd, -1);
+#endif
+  if (g_file && 0 != fclose(g_file)) {
+    fprintf(stderr, "cme_trace: error writing the trace\n");
+  }
+  g_file = NULL;
+  free(g_slots);
+  g_slots = NULL;
+  g_cap = 0;
+  g_count = 0;
+  atomic_store(&g_state, TRACE_OFF);
+}
+
+/* --------------------------------------------------------------------------
+ * Function: trace_at_exit
+ * --------------------------------------------------------------------------
+ *
+ * Description: Write out the trace at exit
+ *
+ * Parameters: None
+ *
+ * Returns: None
+ *
+ * -------------------------------------------------------------------------- */
+static void trace_at_exit(void) { cme_trace_stop(); }
+
+/* --------------------------------------------------------------------------
+ * Function: trace_home
+ * --------------------------------------------------------------------------
+ *
+ * Description: Home slot of a block in the table
+ *
+ * Parameters:
+ *      ptr: Block address
+ *      cap: Slots of the table (a power of two)
+ *
+ * Returns: Slot index
+ *
+ * -------------------------------------------------------------------------- */
+static size_t trace_home(uintptr_t ptr, size_t cap) {
+  uint64_t hash = (uint64_t)(ptr >> 4) * UINT64_C(0x9E3779B97F4A7C15);
+
+  return (size_t)(hash >> 16) & (cap - 1);
+}
+
+/* --------------------------------------------------------------------------
+ * Function: trace_insert
+ * --------------------------------------------------------------------------
+ *
+ * Description: Enter a block into the table. If the table can not grow the
+ *              trace is cut short (closed). Called with the lock held.
+ *
+ * Parameters:
+ *        ptr: Block address
+ *      block: Its number
+ *
+ * Returns: 0 on success, -1 if out of memory
+ *
+ * -------------------------------------------------------------------------- */
+static int trace_insert(uintptr_t ptr, uint64_t block) {
+  size_t slot = 0;
+
+  if (2 * (g_count + 1) > g_cap && 0 != trace_grow()) {
+    fprintf(stderr, "cme_trace: no memory for the block table, the trace "
+                    "ends here\n");
+    trace_close();
+    return -1;
+  }
+
+  for (slot = trace_home(ptr, g_cap); 0 != g_slots[slot].ptr;
+       slot = (slot + 1) & (g_cap - 1)) {
+  }
+  g_slots[slot].ptr = ptr;
+  g_slots[slot].block = block;
+  g_count++;
+
+  return 0;
+}
+
+/* --------------------------------------------------------------------------
+ * Function: trace_remove
+ * --------------------------------------------------------------------------
+ *
+ * Description: Take a block out of the table. Called with the lock held.
+ *
+ * Parameters:
+ *      ptr: Block address
+ *
+ * Returns: Number of the block, or 0 if it is not in the table
+ *
+ * -------------------------------------------------------------------------- */
+static uint64_t trace_remove(uintptr_t ptr) {
+  size_t mask = g_cap - 1;
+  size_t slot = 0;
+  size_t next = 0;
+  size_t home = 0;
+  uint64_t block = 0;
+
+  for (slot = trace_home(ptr, g_cap); 0 != g_slots[slot].ptr;
+       slot = (slot + 1) & mask) {
+    if (ptr != g_slots[slot].ptr) {
+      continue;
+    }
+    block = g_slots[slot].block;
+    g_count--;
+
+    /* Shift the following entries back into the hole (no tombstones) */
+    g_slots[slot].ptr = 0;
+    for (next = (slot + 1) & mask; 0 != g_slots[next].ptr;
+         next = (next + 1) & mask) {
+      home = trace_home(g_slots[next].ptr, g_cap);
+      if (((next - home) & mask) >= ((next - slot) & mask)) {
+        g_slots[slot] = g_slots[next];
+        g_slots[next].ptr = 0;
+        slot = next;
+      }
+    }
+    break;
+  }
+
+  return block;
+}
+
+/* --------------------------------------------------------------------------
+ * Function: trace_grow
+ * --------------------------------------------------------------------------
+ *
+ * Description: Double the slots of the table. Called with the lock held.
+ *
+ * Parameters: None
+ *
+ * Returns: 0 on success, -1 if out of memory (the table is left as it was)
+ *
+ * -------------------------------------------------------------------------- */
+static int trace_grow(void) {
+  size_t cap = 2 * g_cap;
+  trace_entry *slots = calloc(cap, sizeof(trace_entry));
+  size_t slot = 0;
+  size_t i = 0;
+
+  if (NULL == slots) {
+    return -1;
+  }
+  for (i = 0; i < g_cap; i++) {
+    if (0 == g_slots[i].ptr) {
+      continue;
+    }
+    for (slot = trace_home(g_slots[i].ptr, cap); 0 != slots[slot].ptr;
+         slot = (slot + 1) & (cap - 1)) {
+    }
+    slots[slot] = g_slots[i];
+  }
+  free(g_slots);
+  g_slots = slots;
+  g_cap = cap;
+
+  return 0;
+}
+
+/* --------------------------------------------------------------------------
+ * Function: trace_event
+ * --------------------------------------------------------------------------
+ *
+ * Description: Append an event to the buffer, timed now. Called with the
+ *              lock held.
+ *
+ * Parameters:
+ *            op: Operation
+ *          back: Distance back to the block (CME_TRACE_REALLOC and
+ *                CME_TRACE_FREE)
+ *      has_size: Whether the event has a size (all but CME_TRACE_FREE)
+ *          size: The size
+ *
+ * Returns: None
+ *
+ * -------------------------------------------------------------------------- */
+static void trace_event(int op, uint64_t back, int has_size, size_t size) {
+  struct timespec ts;
+  uint64_t now = 0;
+  int64_t delta = 0;
+
+  if (g_used + TRACE_EVENT_MAX > TRACE_BUFFER_SIZE) {
+    trace_flush();
+  }
+
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  now = (uint64_t)ts.tv_sec * 1000000000u + (uint64_t)ts.tv_nsec;
+  g_buffer[g_used++] = (unsigned char)op;
+  trace_varint(now > g_last_time ? now - g_last_time : 0);
+  g_last_time = now > g_last_time ? now : g_last_time;
+  if (CME_TRACE_MALLOC != op && CME_TRACE_CALLOC != op) {
+    trace_varint(back);
+  }
+  if (has_size) {
+    delta = (int64_t)(size - g_last_size);
+    trace_varint(((uint64_t)delta << 1) ^ (uint64_t)(delta >> 63));
+    g_last_size = size;
+  }
+#ifdef CME_TRACE_CRASH_FLUSH
+  atomic_store_explicit(&g_whole, g_used, memory_order_release);
+#endif
+}
+
+/* --------------------------------------------------------------------------
+ * Function: trace_varint
+ * --------------------------------------------------------------------------
+ *
+ * Description: Append an unsigned LEB128 varint to the buffer (7 bits a
+ *              byte, low bits first, the high bit set on all but the last)
+ *
+ * Parameters:
+ *      value: The value
+ *
+ * Returns: None
+ *
+ * -------------------------------------------------------------------------- */
+static void trace_varint(uint64_t value) {
+  while (value >= 0x80) {
+    g_buffer[g_used++] = (unsigned char)(value | 0x80);
+    value >>= 7;
+  }
+  g_buffer[g_used++] = (unsigned char)value;
+}
+
+/* --------------------------------------------------------------------------
+ * Function: trace_flush
+ * --------------------------------------------------------------------------
+ *
+ * Description: Write the buffer out. Called with the lock held.
+ *
+ * Parameters: None
+ *
+ * Returns: None
+ *
+ * -------------------------------------------------------------------------- */
+static void trace_flush(void) {
+#ifdef CME_TRACE_CRASH_FLUSH
+  atomic_store(&g_whole, 0); /* A crash from here on writes nothing twice */
+#endif
+  if (g_used > 0 && g_file && 1 != fwrite(g_buffer, g_used, 1, g_file)) {
+    fprintf(stderr, "cme_trace: error writing the trace\n");
+  }
+  g_used = 0;
+}
+
+#ifdef CME_TRACE_CRASH_FLUSH
+/* --------------------------------------------------------------------------
+ * Function: trace_install_crash_handlers
+ * --------------------------------------------------------------------------
+ *
+ * Description: Catch the fatal signals, so the events still in the buffer
+ *              get out before the program dies. A handler installed before
+ *              (e.g. the one of `cme_log`) runs after, unless it takes
+ *              `siginfo_t` (the sanitizers'), which is left alone; so are
+ *              ignored signals.
+ *
+ * Parameters: None
+ *
+ * Returns: None
+ *
+ * -------------------------------------------------------------------------- */
+static void trace_install_crash_handlers(void) {
+  struct sigaction action;
+  struct sigaction previous;
+  size_t i = 0;
+
+  memset(&action, 0, sizeof(action));
+  action.sa_handler = trace_on_crash;
+  action.sa_flags = SA_RESETHAND;
+  sigemptyset(&action.sa_mask);
+
+  for (i = 0; i < sizeof(kCrashSignals) / sizeof(kCrashSignals[0]); i++) {
+    if (0 == sigaction(kCrashSignals[i], NULL, &previous) &&
+        SIG_IGN != previous.sa_handler && !(previous.sa_flags & SA_SIGINFO)) {
+      g_previous[i] = previous;
+      sigaction(kCrashSignals[i], &action, NULL);
+    }
+  }
+}
+
+/* --------------------------------------------------------------------------
+ * Function: trace_on_crash
+ * --------------------------------------------------------------------------
+ *
+ * Description: Write the whole events in the buffer to the trace with
+ *              `write` (the only output that is safe here), then hand the
+ *              signal to the handler installed before. An event being
+ *              appended is left out, so the trace ends at an event boundary
+ *              (see `cme_replay`). Only the first thread to get here writes.
+ *
+ * Parameters:
+ *      signal_number: Fatal signal
+ *
+ * Returns: None
+ *
+ * -------------------------------------------------------------------------- */
+static void trace_on_crash(int signal_number) {
+  int fd = atomic_exchange(&g_fd, -1);
+  size_t whole = atomic_load_explicit(&g_whole, memory_order_acquire);
+  size_t done = 0;
+  ssize_t written = 0;
+  size_t i = 0;
+
+  while (0 <= fd && done < whole &&
+         0 < (written = write(fd, g_buffer + done, whole - done))) {
+    done += (size_t)written;
+  }
+
+  for (i = 0; i < sizeof(kCrashSignals) / sizeof(kCrashSignals[0]); i++) {
+    if (kCrashSignals[i] == signal_number) {
+      sigaction(signal_number, &g_previous[i], NULL);
+    }
+  }
+  raise(signal_number);
+}
+#endif
+
+#endif /* CME_HAVE_TRACE */
@@ -0,0 +1,80 @@
+/* ==========================================================================
+ *  Copyright (C) 2026 Ljubomir Kurij <ljubomir_kurij@protonmail.com>
+ *
+ * This file is part of "C Common Memory Errors".
+ *
+ * "C Common Memory Errors" is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * "C Common Memory Errors" is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General
+ * Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with Focus Precision Analyze. If not, see <https://www.gnu.org/licenses/>.
+ * ========================================================================== */
+
+/* ==========================================================================
+ *
+ * 2026-10-18 Ljubomir Kurij <ljubomir_kurij@protonmail.com>
+ *
+ * * cme_trace.h: created.
+ *
+ * ========================================================================== */
+
+#ifndef CME_TRACE_H_
+#define CME_TRACE_H_
+
+/* ==========================================================================
+ * Headers Include Section
+ * ========================================================================== */
+
+/* Standard Library headers */
+#include <stddef.h>
+#include <stdint.h>
+
+/* ==========================================================================
+ * Macros Definitions Section
+ * ========================================================================== */
+
+/* Environment variable read on the first allocation: CME_TRACE=FILE records
+   every allocation, resize and free of the `cme` allocator into FILE */
+#define CME_TRACE_ENV "CME_TRACE"
+
+/* The trace starts with this magic (8 bytes), followed by the events. An
+   event is an operation byte and unsigned LEB128 varints:
+
+     CME_TRACE_MALLOC, CME_TRACE_CALLOC  time, size
+     CME_TRACE_REALLOC                   time, block, size
+     CME_TRACE_FREE                      time, block
+
+   The time is in nanoseconds since the event before. Every block allocated
+   (or moved by a resize) takes the next block number, starting at 1, and a
+   block is given as the distance back from the next number (0 for none, as
+   when resizing NULL). A size is zigzag encoded, relative to the size of
+   the allocation or resize before. Frees of NULL and of blocks not in the
+   trace are not recorded, nor are failed allocations. */
+#define CME_TRACE_MAGIC "CMETRC01"
+#define CME_TRACE_MAGIC_SIZE 8
+
+/* Operations of the events */
+#define CME_TRACE_MALLOC 0
+#define CME_TRACE_CALLOC 1
+#define CME_TRACE_REALLOC 2
+#define CME_TRACE_FREE 3
+
+/* ==========================================================================
+ * Function Declarations Section
+ * ========================================================================== */
+
+int cme_trace_start(const char *path);
+void cme_trace_stop(void);
+void cme_trace_alloc(void *ptr, size_t size, int op);
+uint64_t cme_trace_detach(const void *ptr);
+void cme_trace_realloc(uint64_t block, void *old, void *ptr, size_t size);
+void cme_trace_free(const void *ptr);
+
+#endif /* CME_TRACE_H_ */
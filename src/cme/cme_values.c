@@ -0,0 +1,185 @@
+/* ==========================================================================
+ *  Copyright (C) 2026 Ljubomir Kurij <ljubomir_kurij@protonmail.com>
+ *
+ * This file is part of "C Common Memory Errors".
+ *
+ * "C Common Memory Errors" is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * "C Common Memory Errors" is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General
+ * Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with Focus Precision Analyze. If not, see <https://www.gnu.org/licenses/>.
+ * ========================================================================== */
+
+/* ==========================================================================
+ *
+ * 2026-10-18 Ljubomir Kurij <ljubomir_kurij@protonmail.com>
+ *
+ * * cme_values.c: created.
+ *
+ * ========================================================================== */
+
+/* ==========================================================================
+ * Headers Include Section
+ * ========================================================================== */
+
+/* Related header */
+#include "cme_values.h"
+
+/* System headers */
+
+/* Standard Library headers */
+#include <stdio.h>
+
+/* Project headers */
+#include "cme_abs_sum.h"
+#include "cme_alloc.h"
+
+/* ==========================================================================
+ * Private Function Declarations Section
+ * ========================================================================== */
+
+static cme_reading *readings_alloc(size_t count, int clear);
+
+/* ==========================================================================
+ * Function Definitions Section
+ * ========================================================================== */
+
+/* --------------------------------------------------------------------------
+ * Function: cme_abs_sum_two
+ * --------------------------------------------------------------------------
+ *
+ * Description: Calculate the absolute sum of two integers. The sum is
+ *              widened to 64 bits, so `INT_MIN` and large operands no longer
+ *              overflow. Arrays of values go through `cme_abs_sum` directly.
+ *
+ * Parameters:
+ *      a: First integer
+ *      b: Second integer
+ *
+ * Returns: Absolute sum of `a` and `b`
+ *
+ * -------------------------------------------------------------------------- */
+int64_t cme_abs_sum_two(int a, int b) {
+  const int32_t values[2] = {a, b};
+
+  return (int64_t)cme_abs_sum(values, 2);
+}
+
+/* --------------------------------------------------------------------------
+ * Function: cme_abs_sum_two_buggy
+ * --------------------------------------------------------------------------
+ *
+ * Description: Same as `cme_abs_sum_two`, as first written: the operands are
+ *              negated and summed as `int`. Negating `INT_MIN`, or a sum
+ *              larger than `INT_MAX`, is a signed overflow (undefined
+ *              behavior, usually a negative result).
+ *
+ * Parameters:
+ *      a: First integer
+ *      b: Second integer
+ *
+ * Returns: Absolute sum of `a` and `b` if it fits into an `int`
+ *
+ * -------------------------------------------------------------------------- */
+int cme_abs_sum_two_buggy(int a, int b) {
+  if (a < 0) {
+    a *= -1;
+  }
+
+  if (b < 0) {
+    b *= -1;
+  }
+
+  return a + b;
+}
+
+/* --------------------------------------------------------------------------
+ * Function: cme_get_readings
+ * --------------------------------------------------------------------------
+ *
+ * Description: Get the sensor readings, with every field set. The block is
+ *              cleared first, so the unused tails of the sensor names hold
+ *              zeros as well.
+ *
+ * Parameters:
+ *     count: Number of readings
+ *
+ * Returns: Pointer to the array of readings (release it with `cme_free`), or
+ *          NULL if the allocation failed
+ *
+ * -------------------------------------------------------------------------- */
+cme_reading *cme_get_readings(size_t count) {
+  cme_reading *readings = readings_alloc(count, 1);
+  size_t i = 0;
+
+  if (readings) {
+    for (i = 0; i < count; i++) {
+      readings[i].scale = 1;
+    }
+  }
+
+  return readings;
+}
+
+/* --------------------------------------------------------------------------
+ * Function: cme_get_readings_buggy
+ * --------------------------------------------------------------------------
+ *
+ * Description: Same as `cme_get_readings`, but the `scale` field is never
+ *              set, and the block is not cleared. The value of the field,
+ *              and the unused tails of the sensor names (`snprintf` does
+ *              not clear them), are whatever the block held when it was
+ *              allocated (0xCD bytes with the heap poisoned).
+ *
+ * Parameters:
+ *     count: Number of readings
+ *
+ * Returns: Pointer to the array of readings (release it with `cme_free`), or
+ *          NULL if the allocation failed
+ *
+ * -------------------------------------------------------------------------- */
+cme_reading *cme_get_readings_buggy(size_t count) {
+  return readings_alloc(count, 0);
+}
+
+/* ==========================================================================
+ * Private Function Definitions Section
+ * ========================================================================== */
+
+/* --------------------------------------------------------------------------
+ * Function: readings_alloc
+ * --------------------------------------------------------------------------
+ *
+ * Description: Allocate the sensor readings and set every field but `scale`
+ *
+ * Parameters:
+ *     count: Number of readings
+ *     clear: Nonzero to clear the block first
+ *
+ * Returns: Pointer to the array of readings, or NULL if the allocation
+ *          failed
+ *
+ * -------------------------------------------------------------------------- */
+static cme_reading *readings_alloc(size_t count, int clear) {
+  cme_reading *readings = clear ? cme_calloc(count, sizeof(cme_reading))
+                                : cme_malloc(count * sizeof(cme_reading));
+  size_t i = 0;
+
+  if (readings) {
+    for (i = 0; i < count; i++) {
+      /* The names wrap after T999999, the longest `sensor` holds */
+      snprintf(readings[i].sensor, sizeof(readings[i].sensor), "T%zu",
+               i % 999999 + 1);
+      readings[i].value = 20 + (int32_t)i;
+    }
+  }
+
+  return readings;
+}
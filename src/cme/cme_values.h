@@ -0,0 +1,63 @@
+/* ==========================================================================
+ *  Copyright (C) 2026 Ljubomir Kurij <ljubomir_kurij@protonmail.com>
+ *
+ * This file is part of "C Common Memory Errors".
+ *
+ * "C Common Memory Errors" is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * "C Common Memory Errors" is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General
+ * Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with Focus Precision Analyze. If not, see <https://www.gnu.org/licenses/>.
+ * ========================================================================== */
+
+/* ==========================================================================
+ *
+ * 2026-10-18 Ljubomir Kurij <ljubomir_kurij@protonmail.com>
+ *
+ * * cme_values.h: created.
+ *
+ * ========================================================================== */
+
+#ifndef CME_VALUES_H_
+#define CME_VALUES_H_
+
+/* ==========================================================================
+ * Headers Include Section
+ * ========================================================================== */
+
+/* Standard Library headers */
+#include <stddef.h>
+#include <stdint.h>
+
+/* ==========================================================================
+ * Type Definitions Section
+ * ========================================================================== */
+
+/* A sensor reading as stored in the output file */
+typedef struct cme_reading {
+  char sensor[8];
+  int32_t value;
+  int32_t scale;
+} cme_reading;
+
+/* ==========================================================================
+ * Function Declarations Section
+ * ========================================================================== */
+
+/* Routines of the uninitialized and fishy values demos and exercise. The
+   `_buggy` variants keep the error the demo is about, so they are only safe
+   to call under a memory checker. */
+
+int64_t cme_abs_sum_two(int a, int b);
+int cme_abs_sum_two_buggy(int a, int b);
+cme_reading *cme_get_readings(size_t count);
+cme_reading *cme_get_readings_buggy(size_t count);
+
+#endif /* CME_VALUES_H_ */
@@ -0,0 +1,139 @@
+/* ==========================================================================
+ *  Copyright (C) 2026 Ljubomir Kurij <ljubomir_kurij@protonmail.com>
+ *
+ * This file is part of "C Common Memory Errors".
+ *
+ * "C Common Memory Errors" is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * "C Common Memory Errors" is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General
+ * Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with Focus Precision Analyze. If not, see <https://www.gnu.org/licenses/>.
+ * ========================================================================== */
+
+/* ==========================================================================
+ *
+ * 2026-10-18 Ljubomir Kurij <ljubomir_kurij@protonmail.com>
+ *
+ * * cme_writes.c: created.
+ *
+ * ========================================================================== */
+
+/* ==========================================================================
+ * Headers Include Section
+ * ========================================================================== */
+
+/* Related header */
+#include "cme_writes.h"
+
+/* System headers */
+
+/* Standard Library headers */
+
+/* Project headers */
+#include "cme_zero.h"
+
+/* ==========================================================================
+ * Function Definitions Section
+ * ========================================================================== */
+
+/* --------------------------------------------------------------------------
+ * Function: cme_set_zero
+ * --------------------------------------------------------------------------
+ *
+ * Description: Set a block of memory to zero. The zeroing strategy (scalar,
+ *              vector or streaming stores) is chosen by `cme_zero` based on
+ *              the size of the block. Note that the size of the block has to
+ *              be passed explicitly: `sizeof` of a pointer to the block is
+ *              the size of the pointer.
+ *
+ * Parameters:
+ *      dest: Pointer to the memory block
+ * num_bytes: Number of bytes to set to zero
+ *
+ * Returns: None
+ *
+ * -------------------------------------------------------------------------- */
+void cme_set_zero(char *dest, size_t num_bytes) { cme_zero(dest, num_bytes); }
+
+/* --------------------------------------------------------------------------
+ * Function: cme_write_quote
+ * --------------------------------------------------------------------------
+ *
+ * Description: Write a quote to a file, framed by lines of equal signs. The
+ *              file is left open, it belongs to the caller.
+ *
+ * Parameters:
+ *      f: Pointer to the file
+ *   text: The quote
+ *
+ * Returns: None
+ *
+ * -------------------------------------------------------------------------- */
+void cme_write_quote(FILE *f, cme_str text) {
+  size_t i = 0;
+
+  /* put out a line of equal signs before the quote */
+  for (i = 0; i < text.len; i++) {
+    fputc('=', f);
+  }
+  fputc('\n', f);
+
+  /* put out the actual quote */
+  fwrite(text.data, sizeof(char), text.len, f);
+
+  /* terminate with another line of equal signs */
+  fputc('\n', f);
+  for (i = 0; i < text.len; i++) {
+    fputc('=', f);
+  }
+  fputc('\n', f);
+}
+
+/* --------------------------------------------------------------------------
+ * Function: cme_write_quote_buggy
+ * --------------------------------------------------------------------------
+ *
+ * Description: Same as `cme_write_quote`, but the file is closed when the
+ *              quote is written. Every later use of the file by the caller,
+ *              including its own `fclose`, is a use of a freed stream.
+ *
+ * Parameters:
+ *      f: Pointer to the file
+ *   text: The quote
+ *
+ * Returns: None
+ *
+ * -------------------------------------------------------------------------- */
+void cme_write_quote_buggy(FILE *f, cme_str text) {
+  cme_write_quote(f, text);
+
+  /* all done! */
+  fclose(f);
+}
+
+/* --------------------------------------------------------------------------
+ * Function: cme_get_quote
+ * --------------------------------------------------------------------------
+ *
+ * Description: Get a quote. If the quote does not fit into the buffer it is
+ *              truncated.
+ *
+ * Parameters:
+ *      buf: Pointer to the counted string to store the quote
+ *
+ * Returns: Number of characters copied
+ *
+ * -------------------------------------------------------------------------- */
+size_t cme_get_quote(cme_str *buf) {
+  cme_str quote = CME_STR_LIT(
+      "My Software never has bugs. It just develops random features.");
+
+  return cme_str_copy(buf, quote);
+}
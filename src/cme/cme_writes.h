@@ -0,0 +1,55 @@
+/* ==========================================================================
+ *  Copyright (C) 2026 Ljubomir Kurij <ljubomir_kurij@protonmail.com>
+ *
+ * This file is part of "C Common Memory Errors".
+ *
+ * "C Common Memory Errors" is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * "C Common Memory Errors" is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General
+ * Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with Focus Precision Analyze. If not, see <https://www.gnu.org/licenses/>.
+ * ========================================================================== */
+
+/* ==========================================================================
+ *
+ * 2026-10-18 Ljubomir Kurij <ljubomir_kurij@protonmail.com>
+ *
+ * * cme_writes.h: created.
+ *
+ * ========================================================================== */
+
+#ifndef CME_WRITES_H_
+#define CME_WRITES_H_
+
+/* ==========================================================================
+ * Headers Include Section
+ * ========================================================================== */
+
+/* Standard Library headers */
+#include <stddef.h>
+#include <stdio.h>
+
+/* Project headers */
+#include "cme_string.h"
+
+/* ==========================================================================
+ * Function Declarations Section
+ * ========================================================================== */
+
+/* Routines of the invalid writes demo and exercise. The `_buggy` variants
+   keep the error the demo is about, so they are only safe to call under a
+   memory checker. */
+
+void cme_set_zero(char *dest, size_t num_bytes);
+void cme_write_quote(FILE *f, cme_str text);
+void cme_write_quote_buggy(FILE *f, cme_str text);
+size_t cme_get_quote(cme_str *buf);
+
+#endif /* CME_WRITES_H_ */
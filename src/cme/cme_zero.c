@@ -0,0 +1,313 @@
+/* ==========================================================================
+ *  Copyright (C) 2026 Ljubomir Kurij <ljubomir_kurij@protonmail.com>
+ *
+ * This file is part of "C Common Memory Errors".
+ *
+ * "C Common Memory Errors" is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * "C Common Memory Errors" is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General
+ * Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with Focus Precision Analyze. If not, see <https://www.gnu.org/licenses/>.
+ * ========================================================================== */
+
+/* ==========================================================================
+ *
+ * 2026-10-18 Ljubomir Kurij <ljubomir_kurij@protonmail.com>
+ *
+ * * cme_zero.c: created.
+ *
+ * ========================================================================== */
+
+/* ==========================================================================
+ * Headers Include Section
+ * ========================================================================== */
+
+/* Related header */
+#include "cme_zero.h"
+
+/* System headers */
+#ifdef _WIN32
+#include <windows.h>
+#elif defined(__unix__) || defined(__APPLE__)
+#include <unistd.h>
+#endif /* End of platform specific headers */
+
+#if defined(__SSE2__) || defined(_M_X64) ||                                    \
+    (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define CME_HAVE_SSE2 1
+#include <emmintrin.h>
+#endif /* End of SSE2 headers */
+
+/* Standard Library headers */
+#include <stdint.h>
+#include <string.h>
+
+/* ==========================================================================
+ * Global Variables Section
+ * ========================================================================== */
+
+/* Zero means "not yet queried" */
+static size_t g_stream_threshold = 0;
+
+/* Calling `memset` through a volatile pointer keeps the compiler from
+   proving the call has no observable effect and dropping it */
+static void *(*volatile g_secure_memset)(void *, int, size_t) = memset;
+
+/* ==========================================================================
+ * Function Definitions Section
+ * ========================================================================== */
+
+/* --------------------------------------------------------------------------
+ * Function: cme_zero
+ * --------------------------------------------------------------------------
+ *
+ * Description: Set a block of memory to zero, choosing the store strategy by
+ *              the size of the block (see `cme_zero.h`).
+ *
+ * Parameters:
+ *      dest: Pointer to the memory block
+ *      size: Size of the memory block in bytes
+ *
+ * Returns: None
+ *
+ * -------------------------------------------------------------------------- */
+void cme_zero(void *dest, size_t size) {
+  if (size <= CME_ZERO_SMALL_MAX) {
+    cme_zero_scalar(dest, size);
+  } else if (size <= CME_ZERO_VECTOR_MAX) {
+    cme_zero_vector(dest, size);
+  } else if (size < cme_zero_stream_threshold()) {
+    /* The C library `memset` uses the widest vector stores the CPU has (or
+       `rep stosb` where that is faster), which beats our 16 byte loop once
+       its setup cost is paid off */
+    memset(dest, 0, size);
+  } else {
+    cme_zero_stream(dest, size);
+  }
+}
+
+/* --------------------------------------------------------------------------
+ * Function: cme_secure_zero
+ * --------------------------------------------------------------------------
+ *
+ * Description: Set a block of memory holding sensitive data to zero. Unlike
+ *              `cme_zero` and `memset` the stores are guaranteed to happen
+ *              even if the block is never read again.
+ *
+ * Parameters:
+ *      dest: Pointer to the memory block
+ *      size: Size of the memory block in bytes
+ *
+ * Returns: None
+ *
+ * -------------------------------------------------------------------------- */
+void cme_secure_zero(void *dest, size_t size) {
+#ifdef _WIN32
+  SecureZeroMemory(dest, size);
+#else
+  g_secure_memset(dest, 0, size);
+#if defined(__GNUC__) || defined(__clang__)
+  /* Make the compiler assume the zeroed memory is read afterwards */
+  __asm__ __volatile__("" : : "r"(dest) : "memory");
+#endif
+#endif /* End of platform specific code */
+}
+
+/* --------------------------------------------------------------------------
+ * Function: cme_zero_stream_threshold
+ * --------------------------------------------------------------------------
+ *
+ * Description: Get the size from which on `cme_zero` uses streaming stores.
+ *              Unless set explicitly, it is the measured crossover with
+ *              `memset`, or the size of the last level cache as reported by
+ *              the system where that is larger.
+ *
+ * Parameters: None
+ *
+ * Returns: Threshold in bytes
+ *
+ * -------------------------------------------------------------------------- */
+size_t cme_zero_stream_threshold(void) {
+  if (0 == g_stream_threshold) {
+    size_t threshold = CME_ZERO_MIN_STREAM_THRESHOLD;
+#ifdef _SC_LEVEL3_CACHE_SIZE
+    long l3_size = sysconf(_SC_LEVEL3_CACHE_SIZE);
+    if (0 < l3_size && (size_t)l3_size > threshold) {
+      threshold = (size_t)l3_size;
+    }
+#endif /* End of platform specific code */
+    g_stream_threshold = threshold;
+  }
+
+  return g_stream_threshold;
+}
+
+/* --------------------------------------------------------------------------
+ * Function: cme_zero_set_stream_threshold
+ * --------------------------------------------------------------------------
+ *
+ * Description: Override the size from which on `cme_zero` uses streaming
+ *              stores. Passing zero restores the default.
+ *
+ * Parameters:
+ *      threshold: Threshold in bytes
+ *
+ * Returns: None
+ *
+ * -------------------------------------------------------------------------- */
+void cme_zero_set_stream_threshold(size_t threshold) {
+  g_stream_threshold = threshold;
+}
+
+/* --------------------------------------------------------------------------
+ * Function: cme_zero_scalar
+ * --------------------------------------------------------------------------
+ *
+ * Description: Set a block of memory to zero using 8 byte stores. The stores
+ *              at the end are allowed to overlap the ones at the start, so
+ *              there is no byte by byte tail loop.
+ *
+ * Parameters:
+ *      dest: Pointer to the memory block
+ *      size: Size of the memory block in bytes
+ *
+ * Returns: None
+ *
+ * -------------------------------------------------------------------------- */
+void cme_zero_scalar(void *dest, size_t size) {
+  unsigned char *p = dest;
+  const uint64_t zero8 = 0;
+  const uint32_t zero4 = 0;
+  size_t i = 0;
+
+  /* Straight line code up to CME_ZERO_SMALL_MAX. A loop here gets turned into
+     `rep stos` by the compiler, which has a high startup cost. */
+  if (64 < size) {
+    for (i = 0; i + 8 <= size; i += 8) {
+      memcpy(p + i, &zero8, sizeof(zero8));
+    }
+    memcpy(p + size - 8, &zero8, sizeof(zero8));
+  } else if (32 < size) {
+    memcpy(p, &zero8, sizeof(zero8));
+    memcpy(p + 8, &zero8, sizeof(zero8));
+    memcpy(p + 16, &zero8, sizeof(zero8));
+    memcpy(p + 24, &zero8, sizeof(zero8));
+    memcpy(p + size - 32, &zero8, sizeof(zero8));
+    memcpy(p + size - 24, &zero8, sizeof(zero8));
+    memcpy(p + size - 16, &zero8, sizeof(zero8));
+    memcpy(p + size - 8, &zero8, sizeof(zero8));
+  } else if (16 < size) {
+    memcpy(p, &zero8, sizeof(zero8));
+    memcpy(p + 8, &zero8, sizeof(zero8));
+    memcpy(p + size - 16, &zero8, sizeof(zero8));
+    memcpy(p + size - 8, &zero8, sizeof(zero8));
+  } else if (8 <= size) {
+    memcpy(p, &zero8, sizeof(zero8));
+    memcpy(p + size - 8, &zero8, sizeof(zero8));
+  } else if (4 <= size) {
+    memcpy(p, &zero4, sizeof(zero4));
+    memcpy(p + size - 4, &zero4, sizeof(zero4));
+  } else if (0 < size) {
+    p[0] = 0;
+    p[size - 1] = 0;
+    p[size / 2] = 0;
+  }
+}
+
+/* --------------------------------------------------------------------------
+ * Function: cme_zero_vector
+ * --------------------------------------------------------------------------
+ *
+ * Description: Set a block of memory to zero using 16 byte vector stores,
+ *              four per loop iteration. The tail is covered by one
+ *              overlapping unaligned store.
+ *
+ * Parameters:
+ *      dest: Pointer to the memory block
+ *      size: Size of the memory block in bytes
+ *
+ * Returns: None
+ *
+ * -------------------------------------------------------------------------- */
+void cme_zero_vector(void *dest, size_t size) {
+#ifdef CME_HAVE_SSE2
+  unsigned char *p = dest;
+  const __m128i zero = _mm_setzero_si128();
+  size_t i = 0;
+
+  if (16 > size) {
+    cme_zero_scalar(dest, size);
+    return;
+  }
+
+  for (i = 0; i + 64 <= size; i += 64) {
+    _mm_storeu_si128((__m128i *)(p + i), zero);
+    _mm_storeu_si128((__m128i *)(p + i + 16), zero);
+    _mm_storeu_si128((__m128i *)(p + i + 32), zero);
+    _mm_storeu_si128((__m128i *)(p + i + 48), zero);
+  }
+  for (; i + 16 <= size; i += 16) {
+    _mm_storeu_si128((__m128i *)(p + i), zero);
+  }
+  _mm_storeu_si128((__m128i *)(p + size - 16), zero);
+#else
+  memset(dest, 0, size);
+#endif /* End of SSE2 specific code */
+}
+
+/* --------------------------------------------------------------------------
+ * Function: cme_zero_stream
+ * --------------------------------------------------------------------------
+ *
+ * Description: Set a block of memory to zero using non-temporal (streaming)
+ *              stores, which write around the caches. Worth it only for
+ *              blocks too big to stay cached.
+ *
+ * Parameters:
+ *      dest: Pointer to the memory block
+ *      size: Size of the memory block in bytes
+ *
+ * Returns: None
+ *
+ * -------------------------------------------------------------------------- */
+void cme_zero_stream(void *dest, size_t size) {
+#ifdef CME_HAVE_SSE2
+  unsigned char *p = dest;
+  const __m128i zero = _mm_setzero_si128();
+  size_t head = 0;
+  size_t i = 0;
+
+  if (64 > size) {
+    cme_zero_vector(dest, size);
+    return;
+  }
+
+  /* Streaming stores need 16 byte alignment. Cover the unaligned head and
+     tail with ordinary stores. */
+  head = (16 - ((uintptr_t)p & 15)) & 15;
+  _mm_storeu_si128((__m128i *)p, zero);
+  _mm_storeu_si128((__m128i *)(p + size - 16), zero);
+
+  for (i = head; i + 64 <= size; i += 64) {
+    _mm_stream_si128((__m128i *)(p + i), zero);
+    _mm_stream_si128((__m128i *)(p + i + 16), zero);
+    _mm_stream_si128((__m128i *)(p + i + 32), zero);
+    _mm_stream_si128((__m128i *)(p + i + 48), zero);
+  }
+  for (; i + 16 <= size; i += 16) {
+    _mm_stream_si128((__m128i *)(p + i), zero);
+  }
+
+  /* Streaming stores are weakly ordered, make them visible before return */
+  _mm_sfence();
+#else
+  memset(dest, 0, size);
+#endif /* End of SSE2 specific code */
+}
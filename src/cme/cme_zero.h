@@ -0,0 +1,94 @@
+/* ==========================================================================
+ *  Copyright (C) 2026 Ljubomir Kurij <ljubomir_kurij@protonmail.com>
+ *
+ * This file is part of "C Common Memory Errors".
+ *
+ * "C Common Memory Errors" is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * "C Common Memory Errors" is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General
+ * Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with Focus Precision Analyze. If not, see <https://www.gnu.org/licenses/>.
+ * ========================================================================== */
+
+/* ==========================================================================
+ *
+ * 2026-10-18 Ljubomir Kurij <ljubomir_kurij@protonmail.com>
+ *
+ * * cme_zero.h: created.
+ *
+ * ========================================================================== */
+
+#ifndef CME_ZERO_H_
+#define CME_ZERO_H_
+
+/* ==========================================================================
+ * Headers Include Section
+ * ========================================================================== */
+
+/* Standard Library headers */
+#include <stddef.h>
+
+/* ==========================================================================
+ * Macros Definitions Section
+ * ========================================================================== */
+
+/* Blocks up to this size are cleared with a handful of inline scalar stores */
+#define CME_ZERO_SMALL_MAX ((size_t)64)
+
+/* Blocks up to this size are cleared with an unrolled 16 byte vector loop */
+#define CME_ZERO_VECTOR_MAX ((size_t)256)
+
+/* Least streaming store threshold by default: the crossover with `memset`
+   measured with `bench_zero` (see below) */
+#define CME_ZERO_MIN_STREAM_THRESHOLD ((size_t)32 << 20)
+
+/* ==========================================================================
+ * Function Declarations Section
+ * ========================================================================== */
+
+/* --------------------------------------------------------------------------
+ * `cme_zero` picks a strategy by size:
+ *
+ *   size <= CME_ZERO_SMALL_MAX      overlapping scalar stores
+ *   size <= CME_ZERO_VECTOR_MAX     unrolled 16 byte vector stores
+ *   size <  streaming threshold     C library `memset` (AVX / `rep stosb`)
+ *   size >= streaming threshold     non-temporal (streaming) stores
+ *
+ * The streaming threshold defaults to the measured crossover with `memset`
+ * (CME_ZERO_MIN_STREAM_THRESHOLD), or to the size of the last level cache
+ * where that is larger, so a buffer that could stay cached is not sent to
+ * memory. Crossover points measured with `bench_zero` on an x86-64 host
+ * (48 KiB L1d, 2 MiB L2, glibc 2.36):
+ *
+ *   scalar stores vs `memset`            64 B   (4 ns vs 8 ns at 16 B)
+ *   vector stores vs `memset`            256 B  (`memset` ahead from 512 B)
+ *   `memset` vs streaming stores         32 - 64 MiB  (about even from
+ *                                        4 MiB, streaming 50 % ahead at
+ *                                        64 MiB)
+ *
+ * Streaming stores are much slower when the block is read back right away
+ * (it has to come back from memory), which is why the default threshold is
+ * the top of the crossover range rather than where the two are even. Use
+ * `cme_zero_set_stream_threshold` to tune it.
+ *
+ * `cme_secure_zero` is for secrets (keys, passwords): it is never removed by
+ * dead store elimination, even when the buffer is freed right after.
+ * -------------------------------------------------------------------------- */
+void cme_zero(void *dest, size_t size);
+void cme_secure_zero(void *dest, size_t size);
+size_t cme_zero_stream_threshold(void);
+void cme_zero_set_stream_threshold(size_t threshold);
+
+/* Individual strategies, exposed for benchmarking */
+void cme_zero_scalar(void *dest, size_t size);
+void cme_zero_vector(void *dest, size_t size);
+void cme_zero_stream(void *dest, size_t size);
+
+#endif /* CME_ZERO_H_ */
@@ -0,0 +1,398 @@
+/* ==========================================================================
+ *  Copyright (C) 2026 Ljubomir Kurij <ljubomir_kurij@protonmail.com>
+ *
+ * This file is part of "C Common Memory Errors".
+ *
+ * "C Common Memory Errors" is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * "C Common Memory Errors" is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General
+ * Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with Focus Precision Analyze. If not, see <https://www.gnu.org/licenses/>.
+ * ========================================================================== */
+
+/* ==========================================================================
+ *
+ * 2026-10-18 Ljubomir Kurij <ljubomir_kurij@protonmail.com>
+ *
+ * * fishy_values.c: created.
+ *
+ * ========================================================================== */
+
+/* ==========================================================================
+ * Headers Include Section
+ * ========================================================================== */
+
+/* Related header */
+
+/* System headers */
+
+/* Standard Library headers */
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/* External libraries headers */
+#include <argparse.h>
+
+/* Project headers */
+#include "cme_alloc.h"
+#include "cme_log.h"
+#include "cme_poison.h"
+#include "cme_scenario.h"
+#include "cme_values.h"
+
+/* ==========================================================================
+ * Macros Definitions Section
+ * ========================================================================== */
+
+#define APP_NAME "fishy_values"
+#define APP_VERSION "1.0"
+#define APP_AUTHOR "Ljubomir Kurij"
+#define APP_EMAIL "ljubomir_kurij@protonmail.com"
+#define APP_COPYRIGHT_YEAR "2026"
+#define APP_COPYRIGHT_HOLDER APP_AUTHOR
+#define APP_LICENSE "GPLv3+"
+#define APP_LICENSE_URL "http://gnu.org/licenses/gpl.html"
+#define APP_DESCRIPTION                                                        \
+  "This code explores \"fishy values\": seemingly valid values that point\n"  \
+  "to an underlying memory error. Blocks are filled with recognizable\n"      \
+  "patterns when they are allocated (0xCD) and freed (0xDD), so a value\n"    \
+  "that was never written, or was read from freed memory, shows up as\n"      \
+  "e.g. -842150451 (0xCDCDCDCD). The goal is to twofold:\n\n"                \
+  "  1. Learn to recognize the fill patterns in the program output and in\n"  \
+  "     a debugger.\n"                                                        \
+  "  2. Find them automatically: the output buffer is scanned for the\n"      \
+  "     patterns before it is written out."
+#ifdef _WIN32
+#define APP_USAGE_A APP_NAME ".exe [OPTION]..."
+#else
+#define APP_USAGE_A APP_NAME " [OPTION]..."
+#endif /* End of platform specific macro definition */
+#define APP_EPILOGUE "\nReport bugs to <" APP_EMAIL ">."
+
+#define NUM_READINGS 4
+
+/* ==========================================================================
+ * Utility Function Declarations Section
+ * ========================================================================== */
+
+int short_usage(struct argparse *self, const struct argparse_option *option);
+int version_info(struct argparse *self, const struct argparse_option *option);
+
+/* ==========================================================================
+ * User Defined Function Declarations Section
+ * ========================================================================== */
+
+static void print_readings(const cme_reading *readings, size_t count);
+static size_t check_output(const void *buf, size_t size);
+
+static void scenario_unset_field(int buggy);
+static void scenario_read_freed(int buggy);
+
+/* ==========================================================================
+ * Global Variables Section
+ * ========================================================================== */
+
+static const char *const kUsages[] = {
+    APP_USAGE_A,
+    NULL,
+};
+
+static const cme_scenario kScenarios[] = {
+    {"unset-field", "print and check readings with a field never written",
+     scenario_unset_field},
+    {"read-freed", "read a reading from a freed block", scenario_read_freed},
+};
+
+/* ==========================================================================
+ * Main Function Section
+ * ========================================================================== */
+
+int main(int argc, char **argv) {
+
+  int usage = 0;
+  int version = 0;
+  int stats = 0;
+  const char *scenario = NULL;
+  int buggy = 0;
+  int iterations = 1;
+
+  /* Define command line options */
+  struct argparse_option options[] = {
+      OPT_GROUP("general options"),
+      OPT_HELP(),
+      OPT_BOOLEAN('\0', "usage", &usage, "give a short usage message",
+                  &short_usage, 0, 0),
+      OPT_BOOLEAN('V', "version", &version, "print program version",
+                  &version_info, 0, 0),
+      OPT_BOOLEAN('\0', "stats", &stats,
+                  "print the allocations per call site at exit", NULL, 0, 0),
+      OPT_GROUP("scenario options"),
+      OPT_STRING('s', "scenario", &scenario,
+                 "run only the scenario NAME (`list' shows the scenarios)",
+                 NULL, 0, 0),
+      OPT_BOOLEAN('\0', "buggy", &buggy,
+                  "run the buggy variant of the scenario", NULL, 0, 0),
+      OPT_INTEGER('i', "iterations", &iterations,
+                  "run the scenario N times (default 1)", NULL, 0, 0),
+      OPT_END(),
+  };
+
+  /* Parse command line arguments */
+  struct argparse argparse;
+  argparse_init(&argparse, options, kUsages, 0);
+  argparse_describe(&argparse, APP_DESCRIPTION, APP_EPILOGUE);
+  argc = argparse_parse(&argparse, argc, argv);
+
+  /* Check if usage or version options were given */
+  if (usage != 0 || version != 0) {
+    exit(EXIT_SUCCESS);
+  }
+
+  /* Count the allocations per call site, printed at exit */
+  if (stats != 0 && 0 != cme_alloc_stats_enable(1)) {
+    fprintf(stderr, "%s: --stats is not available with CME_ALLOCATOR=%s\n",
+            APP_NAME, CME_ALLOCATOR_NAME);
+    exit(EXIT_FAILURE);
+  }
+
+  /* Main module code */
+  int status = EXIT_SUCCESS;
+
+  /* Hand the output over to the background writer */
+  cme_log_start(APP_NAME, 0, CME_LOG_BLOCK);
+
+  /* Poison the heap blocks, whatever the environment says, so the fishy
+     values show up on every run (`CME_POISON=1` does the same for the other
+     programs) */
+  cme_alloc_set_poison(1);
+
+  if (argc == 0 && NULL != scenario) {
+    /* Run a single scenario instead of the whole program */
+    if (0 != cme_scenario_run(kScenarios, CME_SCENARIO_COUNT(kScenarios),
+                              scenario, buggy, iterations)) {
+      status = EXIT_FAILURE;
+    }
+  } else if (argc == 0) {
+    /* No arguments were given */
+    cme_reading *readings = NULL;
+
+    readings = cme_get_readings_buggy(NUM_READINGS);
+    if (readings) {
+      /* Print a field that was never written ---------------------------------
+
+         The `scale` field of the readings is never set, so its value is
+         whatever the block held when it was allocated. Without poisoning
+         that is often zero, and the bug goes unnoticed. With poisoning
+         every `scale` prints as -842150451 (0xCDCDCDCD), a value that
+         should raise eyebrows in any output.
+      */
+      print_readings(readings, NUM_READINGS);
+
+      /* Check the output before it is written ---------------------------------
+
+         The records are about to be written to a file as they are. Scanning
+         them for the fill patterns finds the uninitialized bytes before they
+         end up on disk: the `scale` fields, and also the unused tails of the
+         `sensor` names, which `snprintf` does not clear.
+      */
+      check_output(readings, NUM_READINGS * sizeof(cme_reading));
+
+      cme_free(readings);
+
+      /* Read from a freed block -----------------------------------------------
+
+         This is a read from freed memory. With poisoning on, the freed block
+         is filled with 0xDD, so the value printed would be -572662307
+         (0xDDDDDDDD), unless the allocator has already reused the memory.
+         If we run this code with a memory profiling tool like DrMemory, we'll
+         see an error message like this:
+
+         ```
+         Error #1: UNADDRESSABLE ACCESS of freed memory: reading ...
+         ```
+
+         The buggy variant of the `read-freed` scenario makes the read.
+      */
+      readings = NULL;
+    }
+
+    cme_log("Program execution complete!\n");
+  }
+
+  cme_log_stop();
+
+  return status;
+}
+
+/* ==========================================================================
+ * Utility Function Definitions Section
+ * ========================================================================== */
+
+/* --------------------------------------------------------------------------
+ * Function: short_usage
+ * --------------------------------------------------------------------------
+ *
+ * Description: Print a short usage message
+ *
+ * Parameters:
+ *      self: Pointer to argparse structure
+ *    option: Pointer to argparse option structure
+ *
+ * Returns: Number of characters printed
+ *
+ * -------------------------------------------------------------------------- */
+int short_usage(struct argparse *self, const struct argparse_option *option) {
+#ifdef _WIN32
+  return fprintf(stdout, "%s %s\n%s%s%s\n", "Usage:", APP_USAGE_A, "Try `",
+                 APP_NAME, ".exe -h' for more information.");
+#else
+  return fprintf(stdout, "%s %s\n%s%s%s\n", "Usage:", APP_USAGE_A, "Try `",
+                 APP_NAME, " -h' for more information.");
+#endif /* End of platform specific code */
+}
+
+/* --------------------------------------------------------------------------
+ * Function: version_info
+ * --------------------------------------------------------------------------
+ *
+ * Description: Print program version information
+ *
+ * Parameters:
+ *      self: Pointer to argparse structure
+ *    option: Pointer to argparse option structure
+ *
+ * Returns: Number of characters printed
+ *
+ * -------------------------------------------------------------------------- */
+int version_info(struct argparse *self, const struct argparse_option *option) {
+  return fprintf(stdout, "%s %s %s %s %s\n%s %s: %s <%s>\n%s\n%s\n", APP_NAME,
+                 APP_VERSION, "Copyright (c)", APP_COPYRIGHT_YEAR, APP_AUTHOR,
+                 "License", APP_LICENSE, "GNU GPL version 3 or later",
+                 APP_LICENSE_URL,
+                 "This is free software: you are free "
+                 "to change and redistribute it.",
+                 "There is NO WARRANTY, to the extent permitted by law.");
+}
+
+/* ==========================================================================
+ * User Defined Function Definitions Section
+ * ========================================================================== */
+
+/* --------------------------------------------------------------------------
+ * Function: print_readings
+ * --------------------------------------------------------------------------
+ *
+ * Description: Print the sensor readings
+ *
+ * Parameters:
+ *     readings: Array of readings
+ *        count: Number of readings
+ *
+ * Returns: None
+ *
+ * -------------------------------------------------------------------------- */
+static void print_readings(const cme_reading *readings, size_t count) {
+  size_t i = 0;
+
+  cme_log("Readings\n");
+  cme_log("========\n");
+  for (i = 0; i < count; i++) {
+    cme_log_raw(APP_NAME ":\t%-4s value %4d scale %11d (0x%08X)\n",
+                readings[i].sensor, (int)readings[i].value,
+                (int)readings[i].scale, (unsigned)readings[i].scale);
+  }
+  cme_log_raw("\n");
+}
+
+/* --------------------------------------------------------------------------
+ * Function: check_output
+ * --------------------------------------------------------------------------
+ *
+ * Description: Scan an output buffer for the poison fill patterns and report
+ *              the runs found
+ *
+ * Parameters:
+ *      buf: Output buffer
+ *     size: Size of the buffer in bytes
+ *
+ * Returns: Number of runs of fill bytes found
+ *
+ * -------------------------------------------------------------------------- */
+static size_t check_output(const void *buf, size_t size) {
+  cme_poison_hit hits[16];
+  const size_t max_hits = sizeof(hits) / sizeof(hits[0]);
+  size_t found = cme_poison_scan(buf, size, 0, hits, max_hits);
+  size_t i = 0;
+
+  cme_log("Output check\n");
+  cme_log("============\n");
+  for (i = 0; i < found && i < max_hits; i++) {
+    cme_log_raw(APP_NAME ":\t%zu %s bytes at offset %zu\n", hits[i].length,
+                cme_poison_kind_name(hits[i].kind), hits[i].offset);
+  }
+  cme_log_raw(APP_NAME ":\t%zu suspicious run(s) in %zu bytes\n", found,
+              size);
+  cme_log_raw("\n");
+
+  return found;
+}
+
+/* --------------------------------------------------------------------------
+ * Function: scenario_unset_field
+ * --------------------------------------------------------------------------
+ *
+ * Description: Print and check the readings. The buggy variant never sets
+ *              their `scale` field.
+ *
+ * Parameters:
+ *     buggy: Nonzero to run the buggy variant
+ *
+ * Returns: None
+ *
+ * -------------------------------------------------------------------------- */
+static void scenario_unset_field(int buggy) {
+  cme_reading *readings = buggy ? cme_get_readings_buggy(NUM_READINGS)
+                                : cme_get_readings(NUM_READINGS);
+
+  if (readings) {
+    print_readings(readings, NUM_READINGS);
+    check_output(readings, NUM_READINGS * sizeof(cme_reading));
+    cme_free(readings);
+  }
+}
+
+/* --------------------------------------------------------------------------
+ * Function: scenario_read_freed
+ * --------------------------------------------------------------------------
+ *
+ * Description: Print a reading. The buggy variant prints it after its block
+ *              has been freed.
+ *
+ * Parameters:
+ *     buggy: Nonzero to run the buggy variant
+ *
+ * Returns: None
+ *
+ * -------------------------------------------------------------------------- */
+static void scenario_read_freed(int buggy) {
+  cme_reading *readings = cme_get_readings(NUM_READINGS);
+
+  if (readings) {
+    if (!buggy) {
+      cme_log("Value %d\n", readings[1].value);
+    }
+    cme_free(readings);
+    if (buggy) {
+      cme_log("Freed value %d\n", readings[1].value);
+    }
+  }
+}
\ No newline at end of file
@@ -34,6 +34,7 @@
 /* System headers */
 
 /* Standard Library headers */
+#include <stdint.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
@@ -41,6 +42,14 @@
 /* External libraries headers */
 #include <argparse.h>
 
+/* Project headers */
+#include "cme_alloc.h"
+#include "cme_frees.h"
+#include "cme_log.h"
+#include "cme_scenario.h"
+#include "cme_seq.h"
+#include "cme_span.h"
+
 /* ==========================================================================
  * Macros Definitions Section
  * ========================================================================== */
@@ -76,13 +85,15 @@
 #define APP_EPILOGUE "\nReport bugs to <" APP_EMAIL ">."
 
 /* ==========================================================================
- * Global Variables Section
+ * Type Definitions Section
  * ========================================================================== */
 
-static const char *const kUsages[] = {
-    APP_USAGE_A,
-    NULL,
-};
+/* Error `print_and_free_ids` makes when a scenario asks for it */
+typedef enum free_bug {
+  FREE_BUG_NONE,
+  FREE_BUG_DOUBLE_FREE, /* Free the suffixes as well as the prefixes */
+  FREE_BUG_STACK        /* Free the arrays of the parts (on the stack) */
+} free_bug;
 
 /* ==========================================================================
  * Utility Function Declarations Section
@@ -95,13 +106,35 @@ int version_info(struct argparse *self, const struct argparse_option *option);
  * User Defined Function Declarations Section
  * ========================================================================== */
 
-static char *even_or_blank(int i, char **err);
-static void print_evens(int highest);
-static int *get_odds(int highest, long int *num_odds);
-static void show_odds(int highest);
-static void splitter(char *input, char **prefix, char **suffix);
-static void print_and_free_ids(char **alphas, char **nums, int num_ids);
-static void do_the_splits();
+static void print_evens(int highest, int buggy);
+static void show_odds(int highest, int buggy);
+static void print_and_free_ids(cme_str_span alphas, cme_str_span nums,
+                               free_bug bug);
+static void do_the_splits(free_bug bug);
+
+static void scenario_free_literal(int buggy);
+static void scenario_free_integer(int buggy);
+static void scenario_double_free(int buggy);
+static void scenario_free_stack(int buggy);
+
+/* ==========================================================================
+ * Global Variables Section
+ * ========================================================================== */
+
+static const char *const kUsages[] = {
+    APP_USAGE_A,
+    NULL,
+};
+
+static const cme_scenario kScenarios[] = {
+    {"free-literal", "free the strings of `even_or_blank` (string literals)",
+     scenario_free_literal},
+    {"free-integer", "free an integer cast to a pointer",
+     scenario_free_integer},
+    {"double-free", "free a block inside an already freed block",
+     scenario_double_free},
+    {"free-stack", "free arrays on the stack", scenario_free_stack},
+};
 
 /* ==========================================================================
  * Main Function Section
@@ -111,6 +144,10 @@ int main(int argc, char **argv) {
 
   int usage = 0;
   int version = 0;
+  int stats = 0;
+  const char *scenario = NULL;
+  int buggy = 0;
+  int iterations = 1;
 
   /* Define command line options */
   struct argparse_option options[] = {
@@ -120,6 +157,16 @@ int main(int argc, char **argv) {
                   &short_usage, 0, 0),
       OPT_BOOLEAN('V', "version", &version, "print program version",
                   &version_info, 0, 0),
+      OPT_BOOLEAN('\0', "stats", &stats,
+                  "print the allocations per call site at exit", NULL, 0, 0),
+      OPT_GROUP("scenario options"),
+      OPT_STRING('s', "scenario", &scenario,
+                 "run only the scenario NAME (`list' shows the scenarios)",
+                 NULL, 0, 0),
+      OPT_BOOLEAN('\0', "buggy", &buggy,
+                  "run the buggy variant of the scenario", NULL, 0, 0),
+      OPT_INTEGER('i', "iterations", &iterations,
+                  "run the scenario N times (default 1)", NULL, 0, 0),
       OPT_END(),
   };
 
@@ -134,19 +181,37 @@ int main(int argc, char **argv) {
     exit(EXIT_SUCCESS);
   }
 
+  /* Count the allocations per call site, printed at exit */
+  if (stats != 0 && 0 != cme_alloc_stats_enable(1)) {
+    fprintf(stderr, "%s: --stats is not available with CME_ALLOCATOR=%s\n",
+            APP_NAME, CME_ALLOCATOR_NAME);
+    exit(EXIT_FAILURE);
+  }
+
   /* Main module code */
   int status = EXIT_SUCCESS;
 
-  if (argc == 0) {
+  /* Hand the output over to the background writer */
+  cme_log_start(APP_NAME, 0, CME_LOG_BLOCK);
+
+  if (argc == 0 && NULL != scenario) {
+    /* Run a single scenario instead of the whole program */
+    if (0 != cme_scenario_run(kScenarios, CME_SCENARIO_COUNT(kScenarios),
+                              scenario, buggy, iterations)) {
+      status = EXIT_FAILURE;
+    }
+  } else if (argc == 0) {
     /* No arguments were given */
-    print_evens(110);
-    show_odds(13);
-    do_the_splits();
+    print_evens(110, 0);
+    show_odds(13, 0);
+    do_the_splits(FREE_BUG_NONE);
 
     /* End of main module code. Print exit message -------------------------- */
-    printf("%s: Program execution complete!\n", APP_NAME);
+    cme_log("Program execution complete!\n");
   }
 
+  cme_log_stop();
+
   return status;
 }
 
@@ -204,79 +269,42 @@ int version_info(struct argparse *self, const struct argparse_option *option) {
  * User Defined Function Definitions Section
  * ========================================================================== */
 
-/* --------------------------------------------------------------------------
- * Function: even_or_blank
- * --------------------------------------------------------------------------
- *
- * Description: Return a string representation of an even number or an empty
- *              string for an odd number. If the number is too large (>= 100),
- *              return an NULL reference, and set the error message.
- * Parameters:
- *      i: Integer number to check
- *
- * Returns: String representation of the number or an empty string
- *
- * Note: The function returns a reference to allocated memory when the input
- *       number is even, and a reference to a read-only memory location when the
- *       number is odd, or the number is too large. This is a common source of
- *       memory errors in C. To prevent this, the returned reference should be
- *       consistent, either by allocating memory for all cases, or by returning
- *       a reference to a read-only memory location for all cases.
- *
- * -------------------------------------------------------------------------- */
-static char *even_or_blank(int i, char **err) {
-  char buf[4] = ""; // big enough for 2 digits + null terminator
-
-  *err = NULL;
-  if (i >= 100) {
-    /* return "Sorry, this number is too large."; */
-    *err = "Sorry, this number is too large.";
-    return NULL;
-  }
-
-  if (i % 2 == 0) {
-    snprintf(buf, sizeof(buf), "%d", i);
-    return strdup(buf);
-  } else {
-    /* return ""; */
-    return strdup("");
-  }
-}
-
 /* --------------------------------------------------------------------------
  * Function: print_evens
  * --------------------------------------------------------------------------
  *
  * Description: Print even numbers up to a given number. If the number is too
  *              large, print an error message. The function uses the
- *              `even_or_blank` function to determine if a number is even or
- *              too large. The function is responsible for freeing the memory
- *              allocated by the `even_or_blank` function.
+ *              `cme_even_or_blank` function to determine if a number is even
+ *              or too large. The function is responsible for freeing the
+ *              memory allocated by the `cme_even_or_blank` function.
  *
  * Parameters:
  *      highest: Highest number to print
+ *        buggy: Nonzero to use `cme_even_or_blank_buggy`
  *
  * Returns: None
  *
  * -------------------------------------------------------------------------- */
-static void print_evens(int highest) {
+static void print_evens(int highest, int buggy) {
   char *text = NULL;
   char *err = NULL;
   int i = 0;
 
   for (i = 0; i <= highest; i++) {
-    text = even_or_blank(i, &err);
+    text = buggy ? cme_even_or_blank_buggy(i, &err)
+                 : cme_even_or_blank(i, &err);
     if (text) {
       if (strlen(text) > 0) {
-        printf("%s\n", text);
+        cme_log_raw("%s\n", text);
       }
       /* Trying to free a string literal -------------------------------------
 
-         The function even_or_blank() returns a reference to allocated memory
-         when the input number is odd, and a reference to a read-only memory
-         location when the number is even, or the number is too large. Trying
-         to free a read-only memory location will result in a error and a
-         program crash.
+         The function cme_even_or_blank_buggy() returns a reference to
+         allocated memory when the input number is odd, and a reference to a
+         read-only memory location when the number is even, or the number is
+         too large. Trying to free a read-only memory location will result in
+         a error and a program crash.
 
          If we run original part of this code with a memory profiler (i.e.
          DrMemory) we will see an error message like this:
@@ -292,81 +320,44 @@ static void print_evens(int highest) {
          when the number is even, or the number is too large. We can then free
          the allocated memory after we are done with it.
       */
-      free(text);
+      cme_free(text);
       text = NULL;
     } else if (err) {
-      printf("Error: %s\n", err);
+      cme_log_raw("Error: %s\n", err);
     }
   }
 }
 
-/* --------------------------------------------------------------------------
- * Function: get_odds
- * --------------------------------------------------------------------------
- *
- * Description: Return an array of odd numbers up to a given number. The
- *              function returns pointer to allocated memory that stores the
- *              odd numbers. It is up to the caller to free the memory when
- *              done with it.
- *
- * Parameters:
- *      highest: Highest number to print
- *     num_odds: Pointer to store the number of odd numbers
- *
- * Returns: Array of odd numbers
- *
- * -------------------------------------------------------------------------- */
-static int *get_odds(int highest, long int *num_odds) {
-  int *odds = NULL;
-  long int i = 0;
-
-  *num_odds = (highest + 1) / 2;
-  if (*num_odds <= 0) {
-    return NULL;
-  }
-
-  odds = calloc(*num_odds, sizeof(int));
-  if (odds) {
-    for (i = 0; i < *num_odds; i++) {
-      odds[i] = i * 2 + 1;
-    }
-  }
-
-  return odds;
-}
-
 /* --------------------------------------------------------------------------
  * Function: show_odds
  * --------------------------------------------------------------------------
  *
  * Description: Print odd numbers up to a given number. The function uses the
- *              `get_odds` function to get the odd numbers. The function is
- *              responsible for freeing the memory allocated by the
- *              `get_odds` function.
+ *              `cme_get_odds` function to get the odd numbers. The function
+ *              is responsible for freeing the memory allocated by the
+ *              `cme_get_odds` function.
  *
  * Parameters:
  *      highest: Highest number to print
+ *        buggy: Nonzero to free the number of odd numbers as well
  *
  * Returns: None
  *
  * -------------------------------------------------------------------------- */
-static void show_odds(int highest) {
-  int *odds = NULL;
-  int i = 0;
-  long int num_odds = 0;
+static void show_odds(int highest, int buggy) {
+  cme_seq odds = {CME_INT_U8, NULL, 0, 0};
 
-  odds = get_odds(highest, &num_odds);
-  if (odds) {
-    for (i = 0; i < num_odds; i++) {
-      printf("%d\n", odds[i]);
-    }
+  odds = cme_get_odds(highest);
+  if (odds.data) {
+    cme_log_flush(); /* The sequence bypasses the log */
+    cme_seq_print(stdout, odds, odds.len, "", NULL, 0);
     /* Trynig to free invalid memory reference -------------------------------
 
        The code here is trying to free something that is not a reference to
        allocated memory. In particular case we are trying to free a variable
        that stores integer value instead of a reference to allocated memory.
        Microsoft's C compiler will raise an warning when trying to free a
-       non-pointer variable, even though the `num_odds` variable is casted to
+       non-pointer variable, even though the `odds.len` variable is casted to
        a pointer type. E.g.:
 
        ```
@@ -375,43 +366,10 @@ static void show_odds(int highest) {
            greater size
        ```
     */
-    /* free((void *) num_odds); */
-    free(odds);
-  }
-}
-
-/* --------------------------------------------------------------------------
- * Function: splitter
- * --------------------------------------------------------------------------
- *
- * Description: Split a string into two parts: prefix and suffix. The function
- *              modifies the input string by replacing the first dash character
- *              with a null terminator. The function returns the prefix and
- *              suffix parts of the string. The caller is responsible for
- *              freeing the memory allocated by the function.
- *
- * Parameters:
- *      input: Input string to split
- *     prefix: Pointer to store the prefix part of the string
- *     suffix: Pointer to store the suffix part of the string
- *
- * Returns: None
- *
- * -------------------------------------------------------------------------- */
-static void splitter(char *input, char **prefix, char **suffix) {
-  char *copied = NULL;
-
-  copied = strdup(input);
-  if (copied) {
-    *prefix = copied;
-    while (*copied) {
-      if (*copied == '-') {
-        *copied = '\0';
-        *suffix = copied + 1;
-        break;
-      }
-      copied++;
+    if (buggy) {
+      cme_free((void *)(uintptr_t)odds.len);
     }
+    cme_seq_free(&odds);
   }
 }
 
@@ -421,38 +379,41 @@ static void splitter(char *input, char **prefix, char **suffix) {
  *
  * Description: Print and free the prefix and suffix parts of the identifiers.
  *              The function prints the prefix and suffix parts of the
- *              identifiers and frees the memory allocated by the `splitter`
- *              function. The function is responsible for freeing the memory
- *              allocated by the `splitter` function (this is a typical example
- *              of a double free error, and a bad programming practice, since
- *              the given function should not be responsible for freeing the
- *              memory for wich it does not know if it is dynamically allocated
- *              or not).
+ *              identifiers and frees the memory allocated by the
+ *              `cme_splitter` function. The function is responsible for
+ *              freeing the memory allocated by the `cme_splitter` function
+ *              (this is a typical example of a double free error, and a bad
+ *              programming practice, since the given function should not be
+ *              responsible for freeing the memory for wich it does not know
+ *              if it is dynamically allocated or not).
  *
  * Parameters:
- *      alphas: Array of prefix parts of the identifiers
- *       nums: Array of suffix parts of the identifiers
- *   num_ids: Number of identifiers
+ *      alphas: Span of prefix parts of the identifiers
+ *        nums: Span of suffix parts of the identifiers
+ *         bug: Error to make (FREE_BUG_NONE for none)
  *
  * Returns: None
  *
  * -------------------------------------------------------------------------- */
-static void print_and_free_ids(char **alphas, char **nums, int num_ids) {
-  int i = 0;
-
-  for (i = 0; i < num_ids; i++) {
-    printf("%s\t%s\n", alphas[i], nums[i]);
-    free(alphas[i]);
+static void print_and_free_ids(cme_str_span alphas, cme_str_span nums,
+                               free_bug bug) {
+  const cme_str_span columns[] = {alphas, nums};
+  size_t i = 0;
+
+  cme_log_flush(); /* The table bypasses the log */
+  cme_str_span_print(stdout, NULL, columns, 2);
+  for (i = 0; i < alphas.count; i++) {
+    cme_free(alphas.data[i]);
     /* Trying to free a block of memory inside the already freed block --------
 
        The code here is trying to free a block of memory that is already freed.
        This is due `alphas` and `nums` arrays are parts of the same block of
-       memory that is allocated by the `splitter()` function. When we free the
-       `alphas` array, we are also freeing the `nums` array. If we try to free
-       the `nums` array after we have already freed the `alphas` array, this
-       will result in a memory error and a program crash. If we run this code
-       with a memory profiler (i.e. DrMemory) we will see an error message
-       like this:
+       memory that is allocated by the `cme_splitter()` function. When we
+       free the `alphas` array, we are also freeing the `nums` array. If we
+       try to free the `nums` array after we have already freed the `alphas`
+       array, this will result in a memory error and a program crash. If we
+       run this code with a memory profiler (i.e. DrMemory) we will see an
+       error message like this:
 
        ```
        Error #1: INVALID HEAP ARGUMENT to free ...
@@ -461,7 +422,9 @@ static void print_and_free_ids(char **alphas, char **nums, int num_ids) {
        with a stack trace that points to the line where the free() function is
        called.
     */
-    /* free(nums[i]); */
+    if (FREE_BUG_DOUBLE_FREE == bug) {
+      cme_free(nums.data[i]);
+    }
   }
 
   /* Trying to free the memory that is not dynamically allocated --------------
@@ -479,10 +442,10 @@ static void print_and_free_ids(char **alphas, char **nums, int num_ids) {
      with a stack trace that points to the line where the free() function is
      called.
   */
-  /*
-  free(alphas);
-  free(nums);
-  */
+  if (FREE_BUG_STACK == bug) {
+    cme_free((void *)alphas.data);
+    cme_free((void *)nums.data);
+  }
 }
 
 /* --------------------------------------------------------------------------
@@ -492,23 +455,88 @@ static void print_and_free_ids(char **alphas, char **nums, int num_ids) {
  * Description: Split the identifiers into prefix and suffix parts. The
  *              function splits the identifiers into prefix and suffix parts
  *              and prints them. The function is responsible for freeing the
- *              memory allocated by the `splitter` function.
+ *              memory allocated by the `cme_splitter` function.
  *
- * Parameters: None
+ * Parameters:
+ *      bug: Error `print_and_free_ids` makes (FREE_BUG_NONE for none)
  *
  * Returns: None
  *
  * -------------------------------------------------------------------------- */
-static void do_the_splits() {
-  char *ids[] = {"THX-1138", "U-62", "DS-9", "FN-2187", NULL};
-  const int num_ids = sizeof(ids) / sizeof(char *) - 1;
-  char *alphas[4] = {};
-  char *nums[4] = {};
-  int i = 0;
-
-  for (i = 0; i < num_ids; i++) {
-    splitter(ids[i], &alphas[i], &nums[i]);
+static void do_the_splits(free_bug bug) {
+  char *ids[] = {"THX-1138", "U-62", "DS-9", "FN-2187"};
+  const cme_str_span id_span = CME_SPAN_OF(ids);
+  char *alphas[sizeof(ids) / sizeof(ids[0])] = {};
+  char *nums[sizeof(ids) / sizeof(ids[0])] = {};
+  size_t i = 0;
+
+  for (i = 0; i < id_span.count; i++) {
+    cme_splitter(id_span.data[i], &alphas[i], &nums[i]);
   }
 
-  print_and_free_ids(alphas, nums, num_ids);
+  print_and_free_ids(CME_SPAN_OF(alphas), CME_SPAN_OF(nums), bug);
+}
+
+/* --------------------------------------------------------------------------
+ * Function: scenario_free_literal
+ * --------------------------------------------------------------------------
+ *
+ * Description: Print the even numbers, freeing every string `even_or_blank`
+ *              returns (string literals in the buggy variant)
+ *
+ * Parameters:
+ *     buggy: Nonzero to run the buggy variant
+ *
+ * Returns: None
+ *
+ * -------------------------------------------------------------------------- */
+static void scenario_free_literal(int buggy) { print_evens(110, buggy); }
+
+/* --------------------------------------------------------------------------
+ * Function: scenario_free_integer
+ * --------------------------------------------------------------------------
+ *
+ * Description: Show the odd numbers. The buggy variant frees their count,
+ *              an integer cast to a pointer
+ *
+ * Parameters:
+ *     buggy: Nonzero to run the buggy variant
+ *
+ * Returns: None
+ *
+ * -------------------------------------------------------------------------- */
+static void scenario_free_integer(int buggy) { show_odds(13, buggy); }
+
+/* --------------------------------------------------------------------------
+ * Function: scenario_double_free
+ * --------------------------------------------------------------------------
+ *
+ * Description: Split the ids. The buggy variant frees the suffixes, which
+ *              are inside the blocks of the already freed prefixes
+ *
+ * Parameters:
+ *     buggy: Nonzero to run the buggy variant
+ *
+ * Returns: None
+ *
+ * -------------------------------------------------------------------------- */
+static void scenario_double_free(int buggy) {
+  do_the_splits(buggy ? FREE_BUG_DOUBLE_FREE : FREE_BUG_NONE);
+}
+
+/* --------------------------------------------------------------------------
+ * Function: scenario_free_stack
+ * --------------------------------------------------------------------------
+ *
+ * Description: Split the ids. The buggy variant frees the arrays of the
+ *              parts, which are on the stack
+ *
+ * Parameters:
+ *     buggy: Nonzero to run the buggy variant
+ *
+ * Returns: None
+ *
+ * -------------------------------------------------------------------------- */
+static void scenario_free_stack(int buggy) {
+  do_the_splits(buggy ? FREE_BUG_STACK : FREE_BUG_NONE);
 }
\ No newline at end of file
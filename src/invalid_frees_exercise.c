@@ -42,6 +42,12 @@
 /* External libraries headers */
 #include <argparse.h>
 
+/* Project headers */
+#include "cme_alloc.h"
+#include "cme_frees.h"
+#include "cme_log.h"
+#include "cme_scenario.h"
+
 /* ==========================================================================
  * Macros Definitions Section
  * ========================================================================== */
@@ -64,15 +70,6 @@
 
 #define MY_DEBUG 0
 
-/* ==========================================================================
- * Global Variables Section
- * ========================================================================== */
-
-static const char *const kUsages[] = {
-    APP_USAGE_A,
-    NULL,
-};
-
 /* ==========================================================================
  * Utility Function Declarations Section
  * ========================================================================== */
@@ -84,9 +81,24 @@ int version_info(struct argparse *self, const struct argparse_option *option);
  * User Defined Function Declarations Section
  * ========================================================================== */
 
-static void my_free(void *ptr);
-static char *fix_amp(char *src);
 static char *get_user_text();
+static char *double_encode(char *s, int buggy);
+
+static void scenario_double_encode(int buggy);
+
+/* ==========================================================================
+ * Global Variables Section
+ * ========================================================================== */
+
+static const char *const kUsages[] = {
+    APP_USAGE_A,
+    NULL,
+};
+
+static const cme_scenario kScenarios[] = {
+    {"double-encode", "double encode the ampersands of a text",
+     scenario_double_encode},
+};
 
 /* ==========================================================================
  * Main Function Section
@@ -96,6 +108,10 @@ int main(int argc, char **argv) {
 
   int usage = 0;
   int version = 0;
+  int stats = 0;
+  const char *scenario = NULL;
+  int buggy = 0;
+  int iterations = 1;
 
   /* Define command line options */
   struct argparse_option options[] = {
@@ -105,6 +121,16 @@ int main(int argc, char **argv) {
                   &short_usage, 0, 0),
       OPT_BOOLEAN('V', "version", &version, "print program version",
                   &version_info, 0, 0),
+      OPT_BOOLEAN('\0', "stats", &stats,
+                  "print the allocations per call site at exit", NULL, 0, 0),
+      OPT_GROUP("scenario options"),
+      OPT_STRING('s', "scenario", &scenario,
+                 "run only the scenario NAME (`list' shows the scenarios)",
+                 NULL, 0, 0),
+      OPT_BOOLEAN('\0', "buggy", &buggy,
+                  "run the buggy variant of the scenario", NULL, 0, 0),
+      OPT_INTEGER('i', "iterations", &iterations,
+                  "run the scenario N times (default 1)", NULL, 0, 0),
       OPT_END(),
   };
 
@@ -119,29 +145,43 @@ int main(int argc, char **argv) {
     exit(EXIT_SUCCESS);
   }
 
+  /* Count the allocations per call site, printed at exit */
+  if (stats != 0 && 0 != cme_alloc_stats_enable(1)) {
+    fprintf(stderr, "%s: --stats is not available with CME_ALLOCATOR=%s\n",
+            APP_NAME, CME_ALLOCATOR_NAME);
+    exit(EXIT_FAILURE);
+  }
+
   /* Main module code */
   int status = EXIT_SUCCESS;
 
-  if (argc == 0) {
+  /* Hand the output over to the background writer */
+  cme_log_start(APP_NAME, 0, CME_LOG_BLOCK);
+
+  if (argc == 0 && NULL != scenario) {
+    /* Run a single scenario instead of the whole program */
+    if (0 != cme_scenario_run(kScenarios, CME_SCENARIO_COUNT(kScenarios),
+                              scenario, buggy, iterations)) {
+      status = EXIT_FAILURE;
+    }
+  } else if (argc == 0) {
     /* No arguments were given */
     char *s = get_user_text();
-    char *fixed = fix_amp(s);
-    free(s);
-    s = fixed;
-    fixed = fix_amp(s);
-    free(s);
+    char *fixed = double_encode(s, 0);
     s = NULL;
 
-    printf("Encoded: %s\n", fixed);
+    cme_log_raw("Encoded: %s\n", fixed);
 
     /* Free the last pointer */
-    free(fixed);
+    cme_free(fixed);
     fixed = NULL;
 
     /* Execution of the main code section is complete. Print the exit message */
-    printf("%s: Program execution complete!\n", APP_NAME);
+    cme_log("Program execution complete!\n");
   }
 
+  cme_log_stop();
+
   return status;
 }
 
@@ -200,65 +240,69 @@ int version_info(struct argparse *self, const struct argparse_option *option) {
  * ========================================================================== */
 
 /* --------------------------------------------------------------------------
- * Function: fix_amp
+ * Function: get_user_text
+ * --------------------------------------------------------------------------
+ *
+ * Description: Get text input from the user.
+ *
+ * Returns: Pointer to the user input text
+ *
+ * -------------------------------------------------------------------------- */
+static char *get_user_text() {
+  char buf[1024] = "";
+  char *input_txt = "Enter text to double-encode: ";
+  char *text_input = NULL;
+
+  cme_log_raw("%s", input_txt);
+  cme_log_flush(); /* Show the prompt before waiting for the answer */
+  fgets(buf, sizeof(buf), stdin);
+  text_input = cme_strdup(buf);
+
+  return text_input;
+}
+
+/* --------------------------------------------------------------------------
+ * Function: double_encode
  * --------------------------------------------------------------------------
  *
- * Description: Fix ampersands in a string by double-encoding them.
+ * Description: Double encode the ampersands of a text. The text and the
+ *              intermediate encoding are freed.
  *
  * Parameters:
- *     src: Pointer to the source string
+ *         s: Text to encode (allocated, freed by the function)
+ *     buggy: Nonzero to forget moving on to the intermediate encoding: the
+ *            text is freed twice and the intermediate encoding leaks
  *
- * Returns: Pointer to the fixed string
+ * Returns: Pointer to the encoded text
  *
  * -------------------------------------------------------------------------- */
-static char *fix_amp(char *src) {
-  char *fixed = NULL;
-  int i = 0;
-  int new_len = 0;
-
-  for (i = 0; src[i] != '\0'; i++) {
-    if (src[i] == '&') {
-      new_len += 5;
-    } else {
-      new_len++;
-    }
-  }
-
-  fixed = calloc(new_len + 1, sizeof(char));
-  if (fixed) {
-    int j = 0;
-    for (i = 0; src[i] != '\0'; i++) {
-      if (src[i] == '&') {
-        memcpy(fixed + j, "&amp;", 5);
-        j += 5;
-      } else {
-        fixed[j] = src[i];
-        j++;
-      }
-    }
-    fixed[j] = '\0';
+static char *double_encode(char *s, int buggy) {
+  char *fixed = cme_fix_amp(s);
+  cme_free(s);
+  if (!buggy) {
+    s = fixed;
   }
+  fixed = cme_fix_amp(s);
+  cme_free(s);
 
   return fixed;
 }
 
 /* --------------------------------------------------------------------------
- * Function: get_user_text
+ * Function: scenario_double_encode
  * --------------------------------------------------------------------------
  *
- * Description: Get text input from the user.
+ * Description: Double encode the ampersands of a fixed text
  *
- * Returns: Pointer to the user input text
+ * Parameters:
+ *     buggy: Nonzero to run the buggy variant
+ *
+ * Returns: None
  *
  * -------------------------------------------------------------------------- */
-static char *get_user_text() {
-  char buf[1024] = "";
-  char *input_txt = "Enter text to double-encode: ";
-  char *text_input = NULL;
-
-  printf("%s", input_txt);
-  fgets(buf, sizeof(buf), stdin);
-  text_input = strdup(buf);
+static void scenario_double_encode(int buggy) {
+  char *fixed = double_encode(cme_strdup("Fish & Chips"), buggy);
 
-  return text_input;
+  cme_log_raw("Encoded: %s\n", fixed);
+  cme_free(fixed);
 }
\ No newline at end of file
@@ -34,7 +34,6 @@
 /* System headers */
 
 /* Standard Library headers */
-#include <math.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
@@ -42,6 +41,14 @@
 /* External libraries headers */
 #include <argparse.h>
 
+/* Project headers */
+#include "cme_alloc.h"
+#include "cme_log.h"
+#include "cme_reads.h"
+#include "cme_scenario.h"
+#include "cme_seq.h"
+#include "cme_span.h"
+
 /* ==========================================================================
  * Macros Definitions Section
  * ========================================================================== */
@@ -71,15 +78,6 @@
 #endif /* End of platform specific macro definition */
 #define APP_EPILOGUE "\nReport bugs to <" APP_EMAIL ">."
 
-/* ==========================================================================
- * Global Variables Section
- * ========================================================================== */
-
-static const char *const kUsages[] = {
-    APP_USAGE_A,
-    NULL,
-};
-
 /* ==========================================================================
  * Utility Function Declarations Section
  * ========================================================================== */
@@ -91,10 +89,27 @@ int version_info(struct argparse *self, const struct argparse_option *option);
  * User Defined Function Declarations Section
  * ========================================================================== */
 
-static int *get_powers_of_7(int n);
-static void output_powers(int *powers, int n);
-static char *get_alpha_letters(int len);
-static void output_flavors(char **flavors);
+static void output_powers(cme_seq powers, int n);
+static void output_flavors(cme_str_span flavors);
+
+static void scenario_read_past_end(int buggy);
+static void scenario_read_freed(int buggy);
+
+/* ==========================================================================
+ * Global Variables Section
+ * ========================================================================== */
+
+static const char *const kUsages[] = {
+    APP_USAGE_A,
+    NULL,
+};
+
+static const cme_scenario kScenarios[] = {
+    {"read-past-end", "read 10 powers of 7 from a sequence of 7",
+     scenario_read_past_end},
+    {"read-freed", "read letters freed before they were returned",
+     scenario_read_freed},
+};
 
 /* ==========================================================================
  * Main Function Section
@@ -104,6 +119,10 @@ int main(int argc, char **argv) {
 
   int usage = 0;
   int version = 0;
+  int stats = 0;
+  const char *scenario = NULL;
+  int buggy = 0;
+  int iterations = 1;
 
   /* Define command line options */
   struct argparse_option options[] = {
@@ -113,6 +132,16 @@ int main(int argc, char **argv) {
                   &short_usage, 0, 0),
       OPT_BOOLEAN('V', "version", &version, "print program version",
                   &version_info, 0, 0),
+      OPT_BOOLEAN('\0', "stats", &stats,
+                  "print the allocations per call site at exit", NULL, 0, 0),
+      OPT_GROUP("scenario options"),
+      OPT_STRING('s', "scenario", &scenario,
+                 "run only the scenario NAME (`list' shows the scenarios)",
+                 NULL, 0, 0),
+      OPT_BOOLEAN('\0', "buggy", &buggy,
+                  "run the buggy variant of the scenario", NULL, 0, 0),
+      OPT_INTEGER('i', "iterations", &iterations,
+                  "run the scenario N times (default 1)", NULL, 0, 0),
       OPT_END(),
   };
 
@@ -127,27 +156,44 @@ int main(int argc, char **argv) {
     exit(EXIT_SUCCESS);
   }
 
+  /* Count the allocations per call site, printed at exit */
+  if (stats != 0 && 0 != cme_alloc_stats_enable(1)) {
+    fprintf(stderr, "%s: --stats is not available with CME_ALLOCATOR=%s\n",
+            APP_NAME, CME_ALLOCATOR_NAME);
+    exit(EXIT_FAILURE);
+  }
+
   /* Main module code */
   int status = EXIT_SUCCESS;
 
-  if (argc == 0) {
+  /* Hand the output over to the background writer */
+  cme_log_start(APP_NAME, 0, CME_LOG_BLOCK);
+
+  if (argc == 0 && NULL != scenario) {
+    /* Run a single scenario instead of the whole program */
+    if (0 != cme_scenario_run(kScenarios, CME_SCENARIO_COUNT(kScenarios),
+                              scenario, buggy, iterations)) {
+      status = EXIT_FAILURE;
+    }
+  } else if (argc == 0) {
     /* No arguments were given */
-    int *numbers = NULL;
+    cme_seq numbers = {CME_INT_U8, NULL, 0, 0};
     char *text = NULL;
-    char *flavors[] = {
-        "Chocolate", "Strawberry", "Vanilla",
-        /* NULL terminator for the array of strings --------------------------
-
-           This is a common mistake in C programs. The array of strings is not
-           terminated with a NULL pointer. This is the reason we have a
-           `Error #1: UNINITIALIZED READ: ...` error when we run this code with
-           DrMemory. Note that the in this case, DrMemory will not report any
-           line of code that caused the error.
-        */
-        NULL};
-
-    numbers = get_powers_of_7(7); /* Allocate memory for 7 integers */
-    if (numbers) {
+    char *flavors[] = {"Chocolate", "Strawberry", "Vanilla"};
+    /* No NULL terminator for the array of strings -------------------------
+
+       A NULL terminated array of strings is a common source of invalid reads
+       in C programs: forget the terminator and the printing loop walks off
+       the end of the array. This is the reason we would have a
+       `Error #1: UNINITIALIZED READ: ...` error when we run such code with
+       DrMemory. Note that the in this case, DrMemory will not report any
+       line of code that caused the error. Passing the array as a counted
+       span (`CME_SPAN_OF`) carries the number of elements along with the
+       pointer, so no terminator is needed.
+    */
+
+    numbers = cme_get_powers_of_7(7); /* Allocate memory for 7 integers */
+    if (numbers.data) {
       /* Try to read 10 first elements from the allocated memory -------------
 
          This is an invalid read because we allocated memory for 7 integers,
@@ -163,24 +209,39 @@ int main(int argc, char **argv) {
 
          with a stack trace that shows the exact line where
          the error occurred.
+
+         The sequence is a fat array (it carries its length with the pointer),
+         so the read is caught without any external tool: debug builds check
+         every element and stop at `7^8`, release builds check the whole range
+         once before printing. Either way the program aborts with an
+         `out of bounds` message instead of reading past the allocation.
+         The buggy variant of the `read-past-end` scenario makes the read.
       */
-      /* output_powers(numbers, 10); */
       output_powers(numbers, 7);
-      free(numbers); /* Free the allocated memory */
+      cme_seq_free(&numbers); /* Free the allocated memory */
     }
 
-    text = get_alpha_letters(19);
-    printf("%s: Alpha characters\n", APP_NAME);
-    printf("%s: =================\n", APP_NAME);
-    printf("%s: %s\n", APP_NAME, text);
-    puts("");
-    free(text);
+    /* Read the letters ------------------------------------------------------
+
+       Freeing the string before returning it (`cme_get_alpha_letters_buggy`,
+       the `read-freed` scenario) makes every read below a read of freed
+       memory. DrMemory reports it as `Error #1: UNINITIALIZED READ: ...`,
+       without pointing at the line of code that caused the error.
+    */
+    text = cme_get_alpha_letters(19);
+    cme_log("Alpha characters\n");
+    cme_log("=================\n");
+    cme_log("%s\n", text);
+    cme_log_raw("\n");
+    cme_free(text);
 
-    output_flavors(flavors);
+    output_flavors(CME_SPAN_OF(flavors));
 
-    printf("%s: Program execution complete!\n", APP_NAME);
+    cme_log("Program execution complete!\n");
   }
 
+  cme_log_stop();
+
   return status;
 }
 
@@ -239,108 +300,88 @@ int version_info(struct argparse *self, const struct argparse_option *option) {
  * ========================================================================== */
 
 /* --------------------------------------------------------------------------
- * Function: get_powers_of_7
+ * Function: output_powers
  * --------------------------------------------------------------------------
  *
- * Description: Get the first n powers of 7
+ * Description: Output the powers of 7 (print n elements of the sequence to
+ *              stdout)
  *
  * Parameters:
- *     n: Number of powers to calculate
+ *     powers: Sequence of powers
+ *          n: Number of elements to print (bounds checked against the
+ *             length of the sequence)
  *
- * Returns: Pointer to an array of n integers
+ * Returns: void
  *
  * -------------------------------------------------------------------------- */
-static int *get_powers_of_7(int n) {
-  int *ret = NULL;
-  int i = 0;
-
-  ret = calloc(n, sizeof(int));
-  if (ret) {
-    for (i = 0; i < n; i++) {
-      ret[i] = (int)round(pow(7.0, 1.0 + (float)i));
-    }
-  }
-
-  return ret;
+static void output_powers(cme_seq powers, int n) {
+  cme_log("Powers of 7\n");
+  cme_log("==========\n");
+  cme_log_flush(); /* The table bypasses the log */
+  cme_seq_print(stdout, powers, (size_t)n, APP_NAME ":\t", "7^", 1);
+  cme_log_raw("\n");
 }
 
 /* --------------------------------------------------------------------------
- * Function: output_powers
+ * Function: output_flavors
  * --------------------------------------------------------------------------
  *
- * Description: Output the powers of 7 (print array of n floats to stdout)
+ * Description: Output the flavors (print array of strings to stdout)
  *
  * Parameters:
- *     powers: Pointer to an array of integers
- *          n: Number of elements in the array
+ *     flavors: Span of strings
  *
  * Returns: void
  *
  * -------------------------------------------------------------------------- */
-static void output_powers(int *powers, int n) {
-  int i = 0;
-
-  printf("%s: Powers of 7\n", APP_NAME);
-  printf("%s: ==========\n", APP_NAME);
-  for (i = 0; i < n; i++) {
-    printf("%s:\t7^%d = %d\n", APP_NAME, 1 + i, powers[i]);
-  }
-  puts("");
+static void output_flavors(cme_str_span flavors) {
+  cme_log("Flavors\n");
+  cme_log("========\n");
+  cme_log_flush(); /* The table bypasses the log */
+  cme_str_span_print(stdout, APP_NAME ":\t", &flavors, 1);
 }
 
 /* --------------------------------------------------------------------------
- * Function: get_alpha_letters
+ * Function: scenario_read_past_end
  * --------------------------------------------------------------------------
  *
- * Description: Get the first len letters of the alphabet
+ * Description: Print the first powers of 7. The buggy variant prints 10
+ *              elements of a sequence of 7
  *
  * Parameters:
- *     len: Number of letters to generate
+ *     buggy: Nonzero to run the buggy variant
  *
- * Returns: Pointer to a string of len characters
+ * Returns: None
  *
  * -------------------------------------------------------------------------- */
-static char *get_alpha_letters(int len) {
-  char *text = NULL;
-  int i = 0;
-
-  text = calloc(len + 1, sizeof(char));
-  if (text) {
-    for (i = 0; i < len; i++) {
-      /* NOTE: This is handy for cycling through the range (i % 26) */
-      text[i] = 65 + (i % 26);
-    }
-
-    /* Free the memory allocated for the string before returning it ---------
+static void scenario_read_past_end(int buggy) {
+  cme_seq numbers = cme_get_powers_of_7(7);
 
-       This is a common mistake in C programs. The memory allocated for the
-       string is not freed before returning it. This is the reason we have a
-       `Error #1: UNINITIALIZED READ: ...` error when we run this code with
-       DrMemory. Note that the in this case, DrMemory will not report any
-       line of code that caused the error.                                    */
-    /* free(text); */
+  if (numbers.data) {
+    output_powers(numbers, buggy ? 10 : 7);
+    cme_seq_free(&numbers);
   }
-
-  return text;
 }
 
 /* --------------------------------------------------------------------------
- * Function: output_flavors
+ * Function: scenario_read_freed
  * --------------------------------------------------------------------------
  *
- * Description: Output the flavors (print array of strings to stdout)
+ * Description: Print the first letters of the alphabet. The buggy variant
+ *              prints a string freed before it was returned
  *
  * Parameters:
- *     flavors: Pointer to an array of strings
+ *     buggy: Nonzero to run the buggy variant
  *
- * Returns: void
+ * Returns: None
  *
  * -------------------------------------------------------------------------- */
-static void output_flavors(char **flavors) {
-  printf("%s: Flavors\n", APP_NAME);
-  printf("%s: ========\n", APP_NAME);
-  while (*flavors) {
-    printf("%s:\t%s\n", APP_NAME, *flavors);
-    flavors++;
+static void scenario_read_freed(int buggy) {
+  char *text = buggy ? cme_get_alpha_letters_buggy(19)
+                     : cme_get_alpha_letters(19);
+
+  cme_log("%s\n", text);
+  if (!buggy) {
+    cme_free(text); /* The buggy variant has freed it already */
   }
 }
\ No newline at end of file
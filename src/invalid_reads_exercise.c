@@ -43,6 +43,13 @@
 /* External libraries headers */
 #include <argparse.h>
 
+/* Project headers */
+#include "cme_alloc.h"
+#include "cme_log.h"
+#include "cme_reads.h"
+#include "cme_scenario.h"
+#include "cme_string.h"
+
 /* ==========================================================================
  * Macros Definitions Section
  * ========================================================================== */
@@ -63,15 +70,6 @@
 #endif /* End of platform specific macro definition */
 #define APP_EPILOGUE "\nReport bugs to <" APP_EMAIL ">."
 
-/* ==========================================================================
- * Global Variables Section
- * ========================================================================== */
-
-static const char *const kUsages[] = {
-    APP_USAGE_A,
-    NULL,
-};
-
 /* ==========================================================================
  * Utility Function Declarations Section
  * ========================================================================== */
@@ -83,7 +81,21 @@ int version_info(struct argparse *self, const struct argparse_option *option);
  * User Defined Function Declarations Section
  * ========================================================================== */
 
-static char *get_sentence(char *text);
+static void scenario_first_sentence(int buggy);
+
+/* ==========================================================================
+ * Global Variables Section
+ * ========================================================================== */
+
+static const char *const kUsages[] = {
+    APP_USAGE_A,
+    NULL,
+};
+
+static const cme_scenario kScenarios[] = {
+    {"first-sentence", "copy the first sentence of a text",
+     scenario_first_sentence},
+};
 
 /* ==========================================================================
  * Main Function Section
@@ -93,6 +105,10 @@ int main(int argc, char **argv) {
 
   int usage = 0;
   int version = 0;
+  int stats = 0;
+  const char *scenario = NULL;
+  int buggy = 0;
+  int iterations = 1;
 
   /* Define command line options */
   struct argparse_option options[] = {
@@ -102,6 +118,16 @@ int main(int argc, char **argv) {
                   &short_usage, 0, 0),
       OPT_BOOLEAN('V', "version", &version, "print program version",
                   &version_info, 0, 0),
+      OPT_BOOLEAN('\0', "stats", &stats,
+                  "print the allocations per call site at exit", NULL, 0, 0),
+      OPT_GROUP("scenario options"),
+      OPT_STRING('s', "scenario", &scenario,
+                 "run only the scenario NAME (`list' shows the scenarios)",
+                 NULL, 0, 0),
+      OPT_BOOLEAN('\0', "buggy", &buggy,
+                  "run the buggy variant of the scenario", NULL, 0, 0),
+      OPT_INTEGER('i', "iterations", &iterations,
+                  "run the scenario N times (default 1)", NULL, 0, 0),
       OPT_END(),
   };
 
@@ -116,10 +142,26 @@ int main(int argc, char **argv) {
     exit(EXIT_SUCCESS);
   }
 
+  /* Count the allocations per call site, printed at exit */
+  if (stats != 0 && 0 != cme_alloc_stats_enable(1)) {
+    fprintf(stderr, "%s: --stats is not available with CME_ALLOCATOR=%s\n",
+            APP_NAME, CME_ALLOCATOR_NAME);
+    exit(EXIT_FAILURE);
+  }
+
   /* Main module code */
   int status = EXIT_SUCCESS;
 
-  if (argc == 0) {
+  /* Hand the output over to the background writer */
+  cme_log_start(APP_NAME, 0, CME_LOG_BLOCK);
+
+  if (argc == 0 && NULL != scenario) {
+    /* Run a single scenario instead of the whole program */
+    if (0 != cme_scenario_run(kScenarios, CME_SCENARIO_COUNT(kScenarios),
+                              scenario, buggy, iterations)) {
+      status = EXIT_FAILURE;
+    }
+  } else if (argc == 0) {
     /* No arguments were given */
     char *full_texts[] = {
         "A single sentence", "A single sentence with a period.",
@@ -127,18 +169,21 @@ int main(int argc, char **argv) {
         "system of government. Supreme executive power derives from a "
         "mandate from the masses, not from some farcical aquatic ceremony.",
         NULL};
-    char *sentence = NULL;
+    cme_str sentence = {NULL, 0, 0};
     int i = 0;
 
     for (i = 0; full_texts[i] != NULL; i++) {
-      sentence = get_sentence(full_texts[i]);
-      printf("%s: %s\n", APP_NAME, sentence);
-      free(sentence);
+      sentence = cme_get_sentence(cme_str_view(full_texts[i]));
+      cme_log("len: %zu\n", sentence.len);
+      cme_log("%.*s\n", (int)sentence.len, sentence.data);
+      cme_str_free(&sentence);
     }
 
-    printf("%s: Program execution complete!\n", APP_NAME);
+    cme_log("Program execution complete!\n");
   }
 
+  cme_log_stop();
+
   return status;
 }
 
@@ -197,42 +242,32 @@ int version_info(struct argparse *self, const struct argparse_option *option) {
  * ========================================================================== */
 
 /* --------------------------------------------------------------------------
- * Function: get_sentence
+ * Function: scenario_first_sentence
  * --------------------------------------------------------------------------
  *
- * Description: Get the first sentence from a text
+ * Description: Print the first sentence of a text. The buggy variant copies
+ *              it without the null terminator and prints the copy, reading
+ *              past the end of the block
  *
  * Parameters:
- *      text: Pointer to a string containing the text
+ *     buggy: Nonzero to run the buggy variant
  *
- * Returns: Pointer to a string containing the first sentence
+ * Returns: None
  *
  * -------------------------------------------------------------------------- */
-static char *get_sentence(char *text) {
-  char *ret = NULL;
-  int len = 0;
-  int i = 0;
-
-  // find period or end of string
-  for (i = 0; text[i] != '\0' && text[i] != '.'; i++) {
-    len++;
-  }
-  if (text[i] == '.') {
-    len++; /* Add one to len to account for the period */
-  }
-
-  printf("%s: len: %d\n", APP_NAME, len);
-
-  /* Copy only up to period (if found). Since we are using we don't nedd to
-     explicitly add the null terminator at the end of the string, we just
-     need to allocate the memory for it.
-  */
-  ret = calloc(len + 1, sizeof(char));
-  if (ret) {
-    for (i = 0; i < len; i++) {
-      ret[i] = text[i];
-    }
+static void scenario_first_sentence(int buggy) {
+  const char *text = "Strange women lying in ponds distributing swords is no "
+                     "basis for a system of government.";
+  cme_str sentence = {NULL, 0, 0};
+  char *copy = NULL;
+
+  if (buggy) {
+    copy = cme_get_sentence_buggy(text);
+    cme_log("%s\n", copy);
+    cme_free(copy);
+  } else {
+    sentence = cme_get_sentence(cme_str_view(text));
+    cme_log("%.*s\n", (int)sentence.len, sentence.data);
+    cme_str_free(&sentence);
   }
-
-  return ret;
 }
\ No newline at end of file
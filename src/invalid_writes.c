@@ -41,6 +41,14 @@
 /* External libraries headers */
 #include <argparse.h>
 
+/* Project headers */
+#include "cme_alloc.h"
+#include "cme_fixbuf.h"
+#include "cme_log.h"
+#include "cme_scenario.h"
+#include "cme_string.h"
+#include "cme_writes.h"
+
 /* ==========================================================================
  * Macros Definitions Section
  * ========================================================================== */
@@ -71,14 +79,25 @@
 #endif /* End of platform specific macro definition */
 #define APP_EPILOGUE "\nReport bugs to <" APP_EMAIL ">."
 
-/* ==========================================================================
- * Global Variables Section
- * ========================================================================== */
+/* --------------------------------------------------------------------------
+ * Macro: GET_MESSAGE
+ * --------------------------------------------------------------------------
+ *
+ * Description: Get a message. The destination has to be an array that is
+ *              big enough to hold the whole message (26 letters and the null
+ *              terminator), otherwise the code does not compile.
+ *
+ * Parameters:
+ *      message: Array to store the message
+ *
+ * -------------------------------------------------------------------------- */
+#define MESSAGE_TEXT "ABCDEFGHIJKLMNOPQRSTUVWXYZ"
+#define GET_MESSAGE(message) CME_FIXBUF_STRCPY(message, MESSAGE_TEXT)
 
-static const char *const kUsages[] = {
-    APP_USAGE_A,
-    NULL,
-};
+#define QUOTE_TEXT                                                             \
+  "If we knew what it was we were doing, it would not be called research, "   \
+  "would it?"
+#define BUF_SIZE 100
 
 /* ==========================================================================
  * Utility Function Declarations Section
@@ -91,9 +110,28 @@ int version_info(struct argparse *self, const struct argparse_option *option);
  * User Defined Function Declarations Section
  * ========================================================================== */
 
-static void set_zero(char *dest, int num_bytes);
-static void get_message(char *message);
-static void write_quote(FILE *f, char *text);
+static void copy_message(char *dest);
+static void scenario_write_unallocated(int buggy);
+static void scenario_write_past_end(int buggy);
+static void scenario_write_closed_file(int buggy);
+
+/* ==========================================================================
+ * Global Variables Section
+ * ========================================================================== */
+
+static const char *const kUsages[] = {
+    APP_USAGE_A,
+    NULL,
+};
+
+static const cme_scenario kScenarios[] = {
+    {"write-unallocated", "zero a block that was never allocated (NULL)",
+     scenario_write_unallocated},
+    {"write-past-end", "copy 27 bytes into a 10 bytes array on the stack",
+     scenario_write_past_end},
+    {"write-closed-file", "write to a file closed by `write_quote`",
+     scenario_write_closed_file},
+};
 
 /* ==========================================================================
  * Main Function Section
@@ -103,6 +141,10 @@ int main(int argc, char **argv) {
 
   int usage = 0;
   int version = 0;
+  int stats = 0;
+  const char *scenario = NULL;
+  int buggy = 0;
+  int iterations = 1;
 
   /* Define command line options */
   struct argparse_option options[] = {
@@ -112,6 +154,16 @@ int main(int argc, char **argv) {
                   &short_usage, 0, 0),
       OPT_BOOLEAN('V', "version", &version, "print program version",
                   &version_info, 0, 0),
+      OPT_BOOLEAN('\0', "stats", &stats,
+                  "print the allocations per call site at exit", NULL, 0, 0),
+      OPT_GROUP("scenario options"),
+      OPT_STRING('s', "scenario", &scenario,
+                 "run only the scenario NAME (`list' shows the scenarios)",
+                 NULL, 0, 0),
+      OPT_BOOLEAN('\0', "buggy", &buggy,
+                  "run the buggy variant of the scenario", NULL, 0, 0),
+      OPT_INTEGER('i', "iterations", &iterations,
+                  "run the scenario N times (default 1)", NULL, 0, 0),
       OPT_END(),
   };
 
@@ -126,20 +178,35 @@ int main(int argc, char **argv) {
     exit(EXIT_SUCCESS);
   }
 
+  /* Count the allocations per call site, printed at exit */
+  if (stats != 0 && 0 != cme_alloc_stats_enable(1)) {
+    fprintf(stderr, "%s: --stats is not available with CME_ALLOCATOR=%s\n",
+            APP_NAME, CME_ALLOCATOR_NAME);
+    exit(EXIT_FAILURE);
+  }
+
   /* Main module code */
   int status = EXIT_SUCCESS;
 
-  if (argc == 0) {
+  /* Hand the output over to the background writer */
+  cme_log_start(APP_NAME, 0, CME_LOG_BLOCK);
+
+  if (argc == 0 && NULL != scenario) {
+    /* Run a single scenario instead of the whole program */
+    if (0 != cme_scenario_run(kScenarios, CME_SCENARIO_COUNT(kScenarios),
+                              scenario, buggy, iterations)) {
+      status = EXIT_FAILURE;
+    }
+  } else if (argc == 0) {
     /* No arguments were given */
     char *buf = NULL;
-    /* char message[10] = ""; */
     FILE *outfile = NULL;
 
     /* Try to write to an invalid memory location ---------------------------
 
        This is the `invalid write` because we are trying to write to a memory
        location that has not been allocated. The `buf` pointer is initialized
-       to `NULL` and then passed to the `set_zero` function.
+       to `NULL` and then passed to the `cme_set_zero` function.
 
        If we run this part of the code with a memory profiling tool like
        DrMemory, it will throw following errors:
@@ -152,17 +219,22 @@ int main(int argc, char **argv) {
 
        with a stack trace that shows the exact line of code that caused the
        error.
+
+       Note that the size of the block has to be passed explicitly. Passing
+       `sizeof(buf)` gives the size of the pointer (i.e. 8 bytes), not the
+       size of the allocated block. The buggy variant of the
+       `write-unallocated` scenario makes the write.
     */
-    buf = (char *)malloc(100);
-    set_zero(buf, sizeof(buf));
-    free(buf);
+    buf = (char *)cme_malloc(BUF_SIZE);
+    cme_set_zero(buf, BUF_SIZE);
+    cme_free(buf);
 
     /* Try to write past the end of a buffer --------------------------------
 
        This is the `invalid write` because we are trying to write past the
        end of the buffer. Our buffer is only 10 bytes long, but we are trying
-       to write 26 bytes to it (see the function defintion for the
-       `get_message`). This will cause a corruption of the stack and a
+       to write 26 bytes to it (see the macro defintion for the
+       `GET_MESSAGE`). This will cause a corruption of the stack and a
        crash.
 
        If we run this part of the code with a memory profiling tool like
@@ -175,9 +247,20 @@ int main(int argc, char **argv) {
        ```
 
        with a stack trace that points to the end of the `main` function.
+
+       Since `GET_MESSAGE` takes the buffer as an array, the size of the
+       buffer is checked against the size of the message at compile time.
+       With a 10 bytes buffer the code does not compile any more:
+
+       ```
+       error: static assertion failed: "destination array is too small"
+       ```
+
+       The buggy variant of the `write-past-end` scenario makes the write
+       with an unchecked copy.
     */
     char message[50] = "";
-    get_message(message);
+    GET_MESSAGE(message);
 
     outfile = fopen("outfile.txt", "w");
     if (outfile) {
@@ -185,7 +268,7 @@ int main(int argc, char **argv) {
 
          This is the `invalid write` because we are trying to write to a file
          after it has been closed (see the function definition for the
-         `write_quote`).
+         `cme_write_quote_buggy`).
 
          Interestingly, this will not cause a crash or a memory error on the
          Windows platform. The file will be created and the quote will be
@@ -195,21 +278,22 @@ int main(int argc, char **argv) {
          However, if we examine the return value of the `fputs` function, we
          will see that it returns `EOF`, which indicates an error. This is
          because the file has been closed and we are trying to write to it
-         after it has been closed.
+         after it has been closed. The buggy variant of the
+         `write-closed-file` scenario makes the write.
       */
-      write_quote(outfile, "If we knew what it was we were doing,"
-                           " it would not be called research, would it?");
+      cme_write_quote(outfile, CME_STR_LIT(QUOTE_TEXT));
       int result = fputs("\tAlbert Einstein", outfile);
-      printf("%s: %s\n", APP_NAME,
-             result == EOF ? "Error writing to file"
-                           : "File written successfully");
+      cme_log("%s\n", result == EOF ? "Error writing to file"
+                                     : "File written successfully");
       fclose(outfile);
     }
 
     /* End of main module code. Print exit message -------------------------- */
-    printf("%s: Program execution complete!\n", APP_NAME);
+    cme_log("Program execution complete!\n");
   }
 
+  cme_log_stop();
+
   return status;
 }
 
@@ -268,77 +352,100 @@ int version_info(struct argparse *self, const struct argparse_option *option) {
  * ========================================================================== */
 
 /* --------------------------------------------------------------------------
- * Function: set_zero
+ * Function: copy_message
  * --------------------------------------------------------------------------
  *
- * Description: Set a block of memory to zero
+ * Description: Copy the message without checking the size of the
+ *              destination (unlike `GET_MESSAGE`)
  *
  * Parameters:
- *      dest: Pointer to the memory block
- * num_bytes: Number of bytes to set to zero
+ *      dest: Destination of the message
  *
  * Returns: None
  *
  * -------------------------------------------------------------------------- */
-static void set_zero(char *dest, int num_bytes) {
-  int i = 0;
+static void copy_message(char *dest) {
+  const char *src = MESSAGE_TEXT;
 
-  for (i = 0; i < num_bytes; i++) {
-    dest[i] = 0;
+  while ('\0' != (*dest++ = *src++)) {
   }
 }
 
 /* --------------------------------------------------------------------------
- * Function: get_message
+ * Function: scenario_write_unallocated
  * --------------------------------------------------------------------------
  *
- * Description: Get a message
+ * Description: Zero a block of memory. The buggy variant zeroes through a
+ *              pointer that was never allocated (NULL).
  *
  * Parameters:
- *      message: Pointer to the buffer to store the message
+ *     buggy: Nonzero to run the buggy variant
  *
  * Returns: None
  *
  * -------------------------------------------------------------------------- */
-static void get_message(char *message) {
-  char *alphabet = "ABCDEFGHIJKLMNOPQRSTUVWXYZ";
+static void scenario_write_unallocated(int buggy) {
+  char *buf = buggy ? NULL : (char *)cme_malloc(BUF_SIZE);
 
-  strncpy(message, alphabet, strlen(alphabet));
+  cme_set_zero(buf, BUF_SIZE);
+  cme_free(buf);
 }
 
 /* --------------------------------------------------------------------------
- * Function: write_quote
+ * Function: scenario_write_past_end
  * --------------------------------------------------------------------------
  *
- * Description: Write a quote to a file
+ * Description: Copy the message. The buggy variant copies it into a 10 bytes
+ *              array, past the end of the array.
  *
  * Parameters:
- *      f: Pointer to the file
- *   text: Pointer to the quote
+ *     buggy: Nonzero to run the buggy variant
  *
  * Returns: None
  *
  * -------------------------------------------------------------------------- */
-static void write_quote(FILE *f, char *text) {
-  int len = strlen(text);
-  int i = 0;
-
-  /* put out a line of equal signs before the quote */
-  for (i = 0; i < len; i++) {
-    fputc('=', f);
+static void scenario_write_past_end(int buggy) {
+  char message[50] = "";
+  char short_message[10] = "";
+
+  if (buggy) {
+    copy_message(short_message);
+    cme_log("%s\n", short_message);
+  } else {
+    GET_MESSAGE(message);
+    cme_log("%s\n", message);
   }
-  fputc('\n', f);
-
-  /* put out the actual quote */
-  fputs(text, f);
+}
 
-  /* terminate with another line of equal signs */
-  fputc('\n', f);
-  for (i = 0; i < len; i++) {
-    fputc('=', f);
+/* --------------------------------------------------------------------------
+ * Function: scenario_write_closed_file
+ * --------------------------------------------------------------------------
+ *
+ * Description: Write the quote to a file, and the author after it. In the
+ *              buggy variant the quote writer closes the file, so the
+ *              author is written to a closed file.
+ *
+ * Parameters:
+ *     buggy: Nonzero to run the buggy variant
+ *
+ * Returns: None
+ *
+ * -------------------------------------------------------------------------- */
+static void scenario_write_closed_file(int buggy) {
+  FILE *outfile = fopen("outfile.txt", "w");
+  int result = 0;
+
+  if (outfile) {
+    if (buggy) {
+      cme_write_quote_buggy(outfile, CME_STR_LIT(QUOTE_TEXT));
+    } else {
+      cme_write_quote(outfile, CME_STR_LIT(QUOTE_TEXT));
+    }
+    result = fputs("\tAlbert Einstein", outfile);
+    cme_log("%s\n", result == EOF ? "Error writing to file"
+                                   : "File written successfully");
+    if (!buggy) {
+      fclose(outfile); /* The buggy variant has closed it already */
+    }
   }
-  fputc('\n', f);
-
-  /* all done! */
-  /* fclose(f); */
 }
\ No newline at end of file
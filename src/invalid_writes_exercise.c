@@ -42,6 +42,13 @@
 /* External libraries headers */
 #include <argparse.h>
 
+/* Project headers */
+#include "cme_alloc.h"
+#include "cme_log.h"
+#include "cme_scenario.h"
+#include "cme_string.h"
+#include "cme_writes.h"
+
 /* ==========================================================================
  * Macros Definitions Section
  * ========================================================================== */
@@ -62,14 +69,7 @@
 #endif /* End of platform specific macro definition */
 #define APP_EPILOGUE "\nReport bugs to <" APP_EMAIL ">."
 
-/* ==========================================================================
- * Global Variables Section
- * ========================================================================== */
-
-static const char *const kUsages[] = {
-    APP_USAGE_A,
-    NULL,
-};
+#define CONTENT_SIZE 256
 
 /* ==========================================================================
  * Utility Function Declarations Section
@@ -82,9 +82,24 @@ int version_info(struct argparse *self, const struct argparse_option *option);
  * User Defined Function Declarations Section
  * ========================================================================== */
 
-static void get_quote(char *buf, size_t buf_size);
 static void write_files(char **filenames, char *content);
 
+static void scenario_write_files(int buggy);
+
+/* ==========================================================================
+ * Global Variables Section
+ * ========================================================================== */
+
+static const char *const kUsages[] = {
+    APP_USAGE_A,
+    NULL,
+};
+
+static const cme_scenario kScenarios[] = {
+    {"write-files", "copy a quote into a block and write it to three files",
+     scenario_write_files},
+};
+
 /* ==========================================================================
  * Main Function Section
  * ========================================================================== */
@@ -93,6 +108,10 @@ int main(int argc, char **argv) {
 
   int usage = 0;
   int version = 0;
+  int stats = 0;
+  const char *scenario = NULL;
+  int buggy = 0;
+  int iterations = 1;
 
   /* Define command line options */
   struct argparse_option options[] = {
@@ -102,6 +121,16 @@ int main(int argc, char **argv) {
                   &short_usage, 0, 0),
       OPT_BOOLEAN('V', "version", &version, "print program version",
                   &version_info, 0, 0),
+      OPT_BOOLEAN('\0', "stats", &stats,
+                  "print the allocations per call site at exit", NULL, 0, 0),
+      OPT_GROUP("scenario options"),
+      OPT_STRING('s', "scenario", &scenario,
+                 "run only the scenario NAME (`list' shows the scenarios)",
+                 NULL, 0, 0),
+      OPT_BOOLEAN('\0', "buggy", &buggy,
+                  "run the buggy variant of the scenario", NULL, 0, 0),
+      OPT_INTEGER('i', "iterations", &iterations,
+                  "run the scenario N times (default 1)", NULL, 0, 0),
       OPT_END(),
   };
 
@@ -116,10 +145,26 @@ int main(int argc, char **argv) {
     exit(EXIT_SUCCESS);
   }
 
+  /* Count the allocations per call site, printed at exit */
+  if (stats != 0 && 0 != cme_alloc_stats_enable(1)) {
+    fprintf(stderr, "%s: --stats is not available with CME_ALLOCATOR=%s\n",
+            APP_NAME, CME_ALLOCATOR_NAME);
+    exit(EXIT_FAILURE);
+  }
+
   /* Main module code */
   int status = EXIT_SUCCESS;
 
-  if (argc == 0) {
+  /* Hand the output over to the background writer */
+  cme_log_start(APP_NAME, 0, CME_LOG_BLOCK);
+
+  if (argc == 0 && NULL != scenario) {
+    /* Run a single scenario instead of the whole program */
+    if (0 != cme_scenario_run(kScenarios, CME_SCENARIO_COUNT(kScenarios),
+                              scenario, buggy, iterations)) {
+      status = EXIT_FAILURE;
+    }
+  } else if (argc == 0) {
     /* No arguments were given */
     char *filenames[] = {
         "first.txt",
@@ -127,16 +172,19 @@ int main(int argc, char **argv) {
         "third.txt",
         NULL,
     };
-    char *content = (char *)calloc(256, sizeof(char));
+    char *content = (char *)cme_calloc(CONTENT_SIZE, sizeof(char));
+    cme_str content_str = cme_str_wrap(content, CONTENT_SIZE);
 
-    get_quote(content, 256);
+    cme_get_quote(&content_str);
 
     write_files(filenames, content);
 
     /* Execution of the main code section is complete. Print the exit message */
-    printf("%s: Program execution complete!\n", APP_NAME);
+    cme_log("Program execution complete!\n");
   }
 
+  cme_log_stop();
+
   return status;
 }
 
@@ -194,30 +242,6 @@ int version_info(struct argparse *self, const struct argparse_option *option) {
  * User Defined Function Definitions Section
  * ========================================================================== */
 
-/* --------------------------------------------------------------------------
- * Function: get_quote
- * --------------------------------------------------------------------------
- *
- * Description: Get a quote
- *
- * Parameters:
- *      buf: Buffer to store the quote
- * buf_size: Size of the buffer
- *
- * Returns: None
- *
- * -------------------------------------------------------------------------- */
-static void get_quote(char *buf, size_t buf_size) {
-  const char *quote =
-      "My Software never has bugs. It just develops random features.";
-
-  if (strlen(quote) >= buf_size) {
-    strncpy(buf, quote, strlen(buf));
-  } else {
-    strncpy(buf, quote, strlen(quote));
-  }
-}
-
 /* --------------------------------------------------------------------------
  * Function: write_files
  * --------------------------------------------------------------------------
@@ -236,7 +260,7 @@ static void write_files(char **filenames, char *content) {
   long int i;
 
   for (i = 0; filenames[i] != NULL; i++) {
-    printf("%s: Writing to file: %s\n", APP_NAME, filenames[i]);
+    cme_log("Writing to file: %s\n", filenames[i]);
     f = fopen(filenames[i], "w");
     if (f) {
       fprintf(f, "Quote #%d: ", i + 1);
@@ -244,4 +268,30 @@ static void write_files(char **filenames, char *content) {
       fclose(f);
     }
   }
+}
+
+/* --------------------------------------------------------------------------
+ * Function: scenario_write_files
+ * --------------------------------------------------------------------------
+ *
+ * Description: Copy the quote into a block and write it to the files. The
+ *              buggy variant allocates a 16 bytes block but tells the copy
+ *              it holds 256 bytes, so the copy writes past its end.
+ *
+ * Parameters:
+ *     buggy: Nonzero to run the buggy variant
+ *
+ * Returns: None
+ *
+ * -------------------------------------------------------------------------- */
+static void scenario_write_files(int buggy) {
+  char *filenames[] = {"first.txt", "second.txt", "third.txt", NULL};
+  char *content = (char *)cme_calloc(buggy ? 16 : CONTENT_SIZE, sizeof(char));
+  cme_str content_str = cme_str_wrap(content, CONTENT_SIZE);
+
+  if (content) {
+    cme_get_quote(&content_str);
+    write_files(filenames, content);
+    cme_free(content);
+  }
 }
\ No newline at end of file
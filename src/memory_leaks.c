@@ -0,0 +1,486 @@
+/* ==========================================================================
+ *  Copyright (C) 2026 Ljubomir Kurij <ljubomir_kurij@protonmail.com>
+ *
+ * This file is part of "C Common Memory Errors".
+ *
+ * "C Common Memory Errors" is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * "C Common Memory Errors" is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General
+ * Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with Focus Precision Analyze. If not, see <https://www.gnu.org/licenses/>.
+ * ========================================================================== */
+
+/* ==========================================================================
+ *
+ * 2026-10-18 Ljubomir Kurij <ljubomir_kurij@protonmail.com>
+ *
+ * * memory_leaks.c: created.
+ *
+ * ========================================================================== */
+
+/* ==========================================================================
+ * Headers Include Section
+ * ========================================================================== */
+
+/* Related header */
+
+/* System headers */
+
+/* Standard Library headers */
+#include <stdio.h>
+#include <stdlib.h>
+
+/* External libraries headers */
+#include <argparse.h>
+
+/* Project headers */
+#include "cme_alloc.h"
+#include "cme_leakcheck.h"
+#include "cme_leaks.h"
+#include "cme_log.h"
+#include "cme_scenario.h"
+
+/* ==========================================================================
+ * Macros Definitions Section
+ * ========================================================================== */
+
+#define APP_NAME "memory_leaks"
+#define APP_VERSION "1.0"
+#define APP_AUTHOR "Ljubomir Kurij"
+#define APP_EMAIL "ljubomir_kurij@protonmail.com"
+#define APP_COPYRIGHT_YEAR "2026"
+#define APP_COPYRIGHT_HOLDER APP_AUTHOR
+#define APP_LICENSE "GPLv3+"
+#define APP_LICENSE_URL "http://gnu.org/licenses/gpl.html"
+#define APP_DESCRIPTION                                                        \
+  "This code explores memory leaks: allocated memory that is never freed\n"   \
+  "once the program has lost every pointer to it. In particular, we'll\n"     \
+  "look at the following cases:\n"                                            \
+  "  1. Dropping the result of a function that returns allocated memory\n"    \
+  "  2. Overwriting the only pointer to a block with a new one\n"             \
+  "  3. Returning on an error without releasing what was allocated\n"         \
+  "  4. Freeing the nodes of a list, but not the blocks they point to\n"      \
+  "  5. Dropping a cycle of blocks that point to each other\n"                \
+  "\n"                                                                         \
+  "The goal is to twofold:\n\n"                                                \
+  "  1. Observe compiler warnings: We'll compile the code and see what\n"      \
+  "     warnings the compiler generates for this practice.\n"                  \
+  "  2. Explore memory profiling tool output: We'll use a memory profiling\n"  \
+  "     tool like DrMemory, or the leak checker of the cme library\n"         \
+  "     (`--leaks'), to see if it detects any issues."
+#ifdef _WIN32
+#define APP_USAGE_A APP_NAME ".exe [OPTION]..."
+#else
+#define APP_USAGE_A APP_NAME " [OPTION]..."
+#endif /* End of platform specific macro definition */
+#define APP_EPILOGUE "\nReport bugs to <" APP_EMAIL ">."
+
+/* ==========================================================================
+ * Utility Function Declarations Section
+ * ========================================================================== */
+
+int short_usage(struct argparse *self, const struct argparse_option *option);
+int version_info(struct argparse *self, const struct argparse_option *option);
+
+/* ==========================================================================
+ * User Defined Function Declarations Section
+ * ========================================================================== */
+
+static void greet_all(int buggy);
+static void greet_in_turn(int buggy);
+static void sum_lists(int buggy);
+static void count_words(int buggy);
+static void go_round(int buggy);
+
+/* ==========================================================================
+ * Global Variables Section
+ * ========================================================================== */
+
+static const char *const kUsages[] = {
+    APP_USAGE_A,
+    NULL,
+};
+
+static const char *const kNames[] = {"Ada", "Brian", "Dennis", "Grace"};
+
+static const cme_scenario kScenarios[] = {
+    {"lost-result", "print greetings without keeping the allocated strings",
+     greet_all},
+    {"overwritten-pointer", "reuse the pointer to a greeting without freeing",
+     greet_in_turn},
+    {"error-path", "return on a malformed number without freeing the array",
+     sum_lists},
+    {"shallow-free", "free the nodes of a word list but not the words",
+     count_words},
+    {"lost-cycle", "drop a ring of words whose nodes point to each other",
+     go_round},
+};
+
+/* ==========================================================================
+ * Main Function Section
+ * ========================================================================== */
+
+int main(int argc, char **argv) {
+
+  int usage = 0;
+  int version = 0;
+  int stats = 0;
+  int leaks = 0;
+  const char *scenario = NULL;
+  int buggy = 0;
+  int iterations = 1;
+
+  /* Define command line options */
+  struct argparse_option options[] = {
+      OPT_GROUP("general options"),
+      OPT_HELP(),
+      OPT_BOOLEAN('\0', "usage", &usage, "give a short usage message",
+                  &short_usage, 0, 0),
+      OPT_BOOLEAN('V', "version", &version, "print program version",
+                  &version_info, 0, 0),
+      OPT_BOOLEAN('\0', "stats", &stats,
+                  "print the allocations per call site at exit", NULL, 0, 0),
+      OPT_BOOLEAN('\0', "leaks", &leaks,
+                  "scan the heap for unreachable blocks at exit", NULL, 0, 0),
+      OPT_GROUP("scenario options"),
+      OPT_STRING('s', "scenario", &scenario,
+                 "run only the scenario NAME (`list' shows the scenarios)",
+                 NULL, 0, 0),
+      OPT_BOOLEAN('\0', "buggy", &buggy,
+                  "run the buggy variant of the scenario", NULL, 0, 0),
+      OPT_INTEGER('i', "iterations", &iterations,
+                  "run the scenario N times (default 1)", NULL, 0, 0),
+      OPT_END(),
+  };
+
+  /* Parse command line arguments */
+  struct argparse argparse;
+  argparse_init(&argparse, options, kUsages, 0);
+  argparse_describe(&argparse, APP_DESCRIPTION, APP_EPILOGUE);
+  argc = argparse_parse(&argparse, argc, argv);
+
+  /* Check if usage or version options were given */
+  if (usage != 0 || version != 0) {
+    exit(EXIT_SUCCESS);
+  }
+
+  /* Count the allocations per call site, printed at exit */
+  if (stats != 0 && 0 != cme_alloc_stats_enable(1)) {
+    fprintf(stderr, "%s: --stats is not available with CME_ALLOCATOR=%s\n",
+            APP_NAME, CME_ALLOCATOR_NAME);
+    exit(EXIT_FAILURE);
+  }
+
+  /* Track every block from here on, and report the unreachable ones at
+     exit */
+  if (leaks != 0 && !CME_ALLOC_TRACKED) {
+    fprintf(stderr, "%s: --leaks is not available with CME_ALLOCATOR=%s\n",
+            APP_NAME, CME_ALLOCATOR_NAME);
+    exit(EXIT_FAILURE);
+  }
+  if (leaks != 0 && 0 != cme_leakcheck_start()) {
+    fprintf(stderr, "%s: the leak checker is not supported here\n",
+            APP_NAME);
+  }
+
+  /* Main module code */
+  int status = EXIT_SUCCESS;
+
+  /* Hand the output over to the background writer */
+  cme_log_start(APP_NAME, 0, CME_LOG_BLOCK);
+
+  if (argc == 0 && NULL != scenario) {
+    /* Run a single scenario instead of the whole program */
+    if (0 != cme_scenario_run(kScenarios, CME_SCENARIO_COUNT(kScenarios),
+                              scenario, buggy, iterations)) {
+      status = EXIT_FAILURE;
+    }
+  } else if (argc == 0) {
+    /* No arguments were given */
+    greet_all(0);
+    greet_in_turn(0);
+    sum_lists(0);
+    count_words(0);
+    go_round(0);
+
+    /* End of main module code. Print exit message -------------------------- */
+    cme_log("Program execution complete!\n");
+  }
+
+  cme_log_stop();
+
+  return status;
+}
+
+/* ==========================================================================
+ * Utility Function Definitions Section
+ * ========================================================================== */
+
+/* --------------------------------------------------------------------------
+ * Function: short_usage
+ * --------------------------------------------------------------------------
+ *
+ * Description: Print a short usage message
+ *
+ * Parameters:
+ *      self: Pointer to argparse structure
+ *    option: Pointer to argparse option structure
+ *
+ * Returns: Number of characters printed
+ *
+ * -------------------------------------------------------------------------- */
+int short_usage(struct argparse *self, const struct argparse_option *option) {
+#ifdef _WIN32
+  return fprintf(stdout, "%s %s\n%s%s%s\n", "Usage:", APP_USAGE_A, "Try `",
+                 APP_NAME, ".exe -h' for more information.");
+#else
+  return fprintf(stdout, "%s %s\n%s%s%s\n", "Usage:", APP_USAGE_A, "Try `",
+                 APP_NAME, " -h' for more information.");
+#endif /* End of platform specific code */
+}
+
+/* --------------------------------------------------------------------------
+ * Function: version_info
+ * --------------------------------------------------------------------------
+ *
+ * Description: Print program version information
+ *
+ * Parameters:
+ *      self: Pointer to argparse structure
+ *    option: Pointer to argparse option structure
+ *
+ * Returns: Number of characters printed
+ *
+ * -------------------------------------------------------------------------- */
+int version_info(struct argparse *self, const struct argparse_option *option) {
+  return fprintf(stdout, "%s %s %s %s %s\n%s %s: %s <%s>\n%s\n%s\n", APP_NAME,
+                 APP_VERSION, "Copyright (c)", APP_COPYRIGHT_YEAR, APP_AUTHOR,
+                 "License", APP_LICENSE, "GNU GPL version 3 or later",
+                 APP_LICENSE_URL,
+                 "This is free software: you are free "
+                 "to change and redistribute it.",
+                 "There is NO WARRANTY, to the extent permitted by law.");
+}
+
+/* ==========================================================================
+ * User Defined Function Definitions Section
+ * ========================================================================== */
+
+/* --------------------------------------------------------------------------
+ * Function: greet_all
+ * --------------------------------------------------------------------------
+ *
+ * Description: Print a greeting for every name. The greetings are built by
+ *              `cme_greeting`, so the function is responsible for freeing
+ *              them.
+ *
+ * Parameters:
+ *      buggy: Nonzero to print the greetings straight from the calls
+ *
+ * Returns: None
+ *
+ * -------------------------------------------------------------------------- */
+static void greet_all(int buggy) {
+  char *text = NULL;
+  size_t i = 0;
+
+  for (i = 0; i < sizeof(kNames) / sizeof(kNames[0]); i++) {
+    /* Dropping the result of a function that returns allocated memory -----
+
+       `cme_greeting` returns a block the caller owns. Passing the result
+       straight on to the log keeps no pointer to the block, so it can never
+       be freed. If we run this code with a memory profiler (i.e. DrMemory)
+       we will see an error message like this at exit:
+
+       ```
+       Error #1: LEAK 14 direct bytes ... + 0 indirect bytes
+       ```
+
+       with a stack trace that points to the allocation in `cme_greeting`.
+    */
+    if (buggy) {
+      cme_log("%s\n", cme_greeting(kNames[i]));
+      continue;
+    }
+
+    text = cme_greeting(kNames[i]);
+    if (text) {
+      cme_log("%s\n", text);
+    }
+    cme_free(text);
+  }
+}
+
+/* --------------------------------------------------------------------------
+ * Function: greet_in_turn
+ * --------------------------------------------------------------------------
+ *
+ * Description: Greet the names one after the other, keeping only the last
+ *              greeting, and print it
+ *
+ * Parameters:
+ *      buggy: Nonzero to overwrite the pointer to a greeting without freeing
+ *             the greeting first
+ *
+ * Returns: None
+ *
+ * -------------------------------------------------------------------------- */
+static void greet_in_turn(int buggy) {
+  char *last = NULL;
+  size_t i = 0;
+
+  for (i = 0; i < sizeof(kNames) / sizeof(kNames[0]); i++) {
+    /* Overwriting the only pointer to a block -----------------------------
+
+       `last` holds the only pointer to the greeting of the previous name.
+       Assigning it the next greeting loses the previous one: every greeting
+       but the last leaks. The block has to be freed before the pointer to
+       it is overwritten.
+    */
+    if (!buggy) {
+      cme_free(last);
+    }
+    last = cme_greeting(kNames[i]);
+  }
+
+  if (last) {
+    cme_log("Last: %s\n", last);
+  }
+  cme_free(last);
+}
+
+/* --------------------------------------------------------------------------
+ * Function: sum_lists
+ * --------------------------------------------------------------------------
+ *
+ * Description: Parse lists of integers and print their sums. One of the
+ *              lists has a malformed number.
+ *
+ * Parameters:
+ *      buggy: Nonzero to parse with `cme_parse_int_list_buggy`, which leaks
+ *             the integers parsed before the malformed one
+ *
+ * Returns: None
+ *
+ * -------------------------------------------------------------------------- */
+static void sum_lists(int buggy) {
+  const char *const lists[] = {"4, 8, 15, 16, 23, 42", "1, 1, 2, 3, 5, 8, x",
+                               "1138, 2187"};
+  int *values = NULL;
+  size_t count = 0;
+  size_t i = 0;
+  size_t j = 0;
+  long sum = 0;
+
+  for (i = 0; i < sizeof(lists) / sizeof(lists[0]); i++) {
+    if (0 != (buggy ? cme_parse_int_list_buggy(lists[i], &values, &count)
+                    : cme_parse_int_list(lists[i], &values, &count))) {
+      cme_log("Malformed list: %s\n", lists[i]);
+      continue;
+    }
+    for (sum = 0, j = 0; j < count; j++) {
+      sum += values[j];
+    }
+    cme_log("Sum of %s: %ld\n", lists[i], sum);
+    cme_free(values);
+  }
+}
+
+/* --------------------------------------------------------------------------
+ * Function: count_words
+ * --------------------------------------------------------------------------
+ *
+ * Description: Split a sentence into words, print them and their count, and
+ *              free the list
+ *
+ * Parameters:
+ *      buggy: Nonzero to free the list with `cme_word_list_free_buggy`,
+ *             which leaves the words behind
+ *
+ * Returns: None
+ *
+ * -------------------------------------------------------------------------- */
+static void count_words(int buggy) {
+  cme_word_list *words = cme_split_words("Memory is allocated in blocks");
+  const cme_word_list *node = NULL;
+  size_t count = 0;
+
+  for (node = words; node; node = node->next) {
+    cme_log("%s\n", node->word);
+    count++;
+  }
+  cme_log("%zu words\n", count);
+
+  /* Freeing the nodes, but not the blocks they point to -------------------
+
+     Every node points to a word in a block of its own. Freeing a node loses
+     the only pointer to its word. If we run this code with a memory profiler
+     (i.e. DrMemory) we will see a leak of every word, allocated in
+     `cme_split_words`.
+  */
+  if (buggy) {
+    cme_word_list_free_buggy(words);
+  } else {
+    cme_word_list_free(words);
+  }
+}
+
+/* --------------------------------------------------------------------------
+ * Function: go_round
+ * --------------------------------------------------------------------------
+ *
+ * Description: Link the words of a sentence into a ring (the last node
+ *              points back to the first) and go round it twice
+ *
+ * Parameters:
+ *      buggy: Nonzero to drop the ring instead of breaking and freeing it
+ *
+ * Returns: None
+ *
+ * -------------------------------------------------------------------------- */
+static void go_round(int buggy) {
+  cme_word_list *ring = cme_split_words("round and round it goes");
+  cme_word_list *last = ring;
+  const cme_word_list *node = ring;
+  size_t steps = 0;
+
+  if (NULL == ring) {
+    return;
+  }
+  while (last->next) {
+    last = last->next;
+  }
+  last->next = ring;
+
+  for (steps = 0; steps < 10; steps++) {
+    cme_log_raw("%s%s", 0 < steps ? " " : "", node->word);
+    node = node->next;
+  }
+  cme_log_raw("\n");
+
+  /* Dropping a cycle of blocks that point to each other -------------------
+
+     Every node of the ring is pointed to by another node, so counting the
+     references to the blocks would never find them unused. Once the program
+     drops `ring` and `last`, though, no pointer the program can reach leads
+     to the ring: the whole ring leaks. A tracing leak checker (DrMemory, or
+     `--leaks`) follows the pointers from the stack and the globals, and
+     reports every node and word of the ring. The ring has to be broken
+     before the list can be freed.
+  */
+  if (buggy) {
+    ring = NULL;
+    last = NULL;
+    return;
+  }
+
+  last->next = NULL;
+  cme_word_list_free(ring);
+}
@@ -0,0 +1,1273 @@
+/* ==========================================================================
+ *  Copyright (C) 2026 Ljubomir Kurij <ljubomir_kurij@protonmail.com>
+ *
+ * This file is part of "C Common Memory Errors".
+ *
+ * "C Common Memory Errors" is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * "C Common Memory Errors" is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General
+ * Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with Focus Precision Analyze. If not, see <https://www.gnu.org/licenses/>.
+ * ========================================================================== */
+
+/* ==========================================================================
+ *
+ * 2026-10-18 Ljubomir Kurij <ljubomir_kurij@protonmail.com>
+ *
+ * * cme_replay.c: created.
+ *
+ * ========================================================================== */
+
+/* ==========================================================================
+ * Headers Include Section
+ * ========================================================================== */
+
+/* Related header */
+
+/* System headers */
+#include <sys/resource.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#if defined(__GLIBC__)
+#include <malloc.h>
+#if __GLIBC_PREREQ(2, 33)
+#define REPLAY_MALLINFO mallinfo2
+#else
+#define REPLAY_MALLINFO mallinfo
+#endif
+#endif /* End of heap statistics headers */
+
+/* Standard Library headers */
+#include <errno.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+/* External libraries headers */
+#include <argparse.h>
+
+/* Project headers (the checked allocators are the `cme` allocator whatever
+   the build, hence no call site macros) */
+#define CME_ALLOC_NO_SITES
+#include "cme_alloc.h"
+#include "cme_arena.h"
+#include "cme_pool.h"
+#include "cme_trace.h"
+
+/* ==========================================================================
+ * Macros Definitions Section
+ * ========================================================================== */
+
+#define APP_NAME "cme_replay"
+#define APP_DESCRIPTION                                                        \
+  "Replays allocation traces, recorded from any of the programs with\n"        \
+  "CME_TRACE=FILE, against several allocators, and reports how each does:\n"   \
+  "the throughput, the peak resident set size and the fragmentation. Every\n"  \
+  "allocator replays in a process of its own, so the resident set sizes do\n"  \
+  "not mix. A trace is replayed in the order it was recorded, on one\n"        \
+  "thread, and every block is written to (a byte a page) as it is\n"           \
+  "allocated."
+#define APP_USAGE_A APP_NAME " [OPTION]... TRACE..."
+#define APP_EPILOGUE                                                           \
+  "\nThe allocators are:\n"                                                    \
+  "  system    malloc and free of the C library\n"                             \
+  "  arena     bump allocator, freeing only the last block (cme_arena.h)\n"    \
+  "  pool      size classes with free lists (cme_pool.h)\n"                    \
+  "  guard     cme allocator, a guard page after every block\n"                \
+  "  redzone   cme allocator, canaries around every block\n"                   \
+  "The fragmentation is 1 - peak live bytes / peak footprint, where the\n"     \
+  "footprint is the memory the allocator holds (sampled every 256 events),\n"  \
+  "or the growth of the resident set size where the allocator can not\n"       \
+  "tell (guard)."
+#define DEFAULT_ALLOCATORS "system,arena,pool,guard,redzone"
+#define MAX_LIST 16 /* Most entries of a comma separated list */
+#define SAMPLE_EVERY 256 /* Events between samples of the footprint */
+#define TOUCH_STRIDE 4096 /* Bytes between the writes to a new block */
+
+/* The magic of a trace ends with the version of the format (two digits) */
+#define VERSION_SIZE 2
+
+/* Outcomes of decoding a trace */
+#define TRACE_OK 0
+#define TRACE_TRUNCATED 1   /* Cut short in an event, the ones before kept */
+#define TRACE_BAD_HEADER -1 /* Not a trace */
+#define TRACE_BAD_VERSION -2
+#define TRACE_BAD_EVENT -3  /* Invalid operation or block */
+#define TRACE_NO_MEMORY -4
+
+/* ==========================================================================
+ * Type Definitions Section
+ * ========================================================================== */
+
+/* An event of a trace, decoded */
+typedef struct replay_event {
+  unsigned op;    /* CME_TRACE_* */
+  uint32_t block; /* Block allocated, resized to or freed */
+  uint32_t old;   /* Block resized (0 for none) */
+  size_t size;
+} replay_event;
+
+/* A decoded trace */
+typedef struct replay_trace {
+  replay_event *events;
+  size_t count;
+  size_t num_blocks;  /* Blocks are numbered 1 to `num_blocks` */
+  size_t ops[4];      /* Events of each operation */
+  uint64_t duration;  /* Recorded time from the first event to the last (ns) */
+  size_t peak_live;   /* Most bytes live at once */
+  size_t end_live;    /* Bytes still live at the end of the trace */
+} replay_trace;
+
+/* An allocator to replay against */
+typedef struct replay_allocator {
+  const char *name;
+  int (*create)(void **ctx);
+  void (*destroy)(void *ctx);
+  void *(*malloc_fn)(void *ctx, size_t size);
+  void *(*calloc_fn)(void *ctx, size_t size);
+  void *(*realloc_fn)(void *ctx, void *ptr, size_t size);
+  void (*free_fn)(void *ctx, void *ptr);
+  size_t (*footprint)(void *ctx); /* NULL if the allocator can not tell */
+} replay_allocator;
+
+/* Outcome of the replays against an allocator, sent back by the child */
+typedef struct replay_result {
+  int supported;
+  double seconds;         /* Of the timed replays */
+  size_t failures;        /* Allocations that returned NULL */
+  long base_rss_kb;       /* Resident set size before the replays */
+  long peak_rss_kb;       /* Peak resident set size of a replay */
+  int has_footprint;
+  size_t peak_footprint;  /* Growth of the footprint over the replay */
+} replay_result;
+
+/* ==========================================================================
+ * User Defined Function Declarations Section
+ * ========================================================================== */
+
+static size_t split_list(char *list, char **items, size_t max_items);
+static double now_seconds(void);
+static unsigned char *read_file(const char *path, size_t *size);
+static int read_varint(const unsigned char **pos, const unsigned char *end,
+                       uint64_t *value);
+static int decode_trace(const unsigned char *data, size_t size,
+                        replay_trace *trace, size_t *offset);
+static const replay_allocator *find_allocator(const char *name);
+static int run_allocator(const replay_trace *trace,
+                         const replay_allocator *alloc, int iterations,
+                         replay_result *result, int *status);
+static void replay_child(const replay_trace *trace,
+                         const replay_allocator *alloc, int iterations,
+                         replay_result *result);
+static void replay(const replay_trace *trace, const replay_allocator *alloc,
+                   void *ctx, void **blocks, replay_result *result,
+                   size_t base_footprint);
+static void release_blocks(const replay_trace *trace,
+                           const replay_allocator *alloc, void *ctx,
+                           void **blocks);
+static void touch(void *ptr, size_t size);
+static void write_trace_text(FILE *f, const char *path,
+                             const replay_trace *trace);
+static void write_result(FILE *f, const char *path, const replay_trace *trace,
+                         const replay_allocator *alloc,
+                         const replay_result *result, int status,
+                         int iterations, int csv);
+
+static int no_create(void **ctx);
+static void no_destroy(void *ctx);
+static void *system_malloc(void *ctx, size_t size);
+static void *system_calloc(void *ctx, size_t size);
+static void *system_realloc(void *ctx, void *ptr, size_t size);
+static void system_free(void *ctx, void *ptr);
+static int arena_create(void **ctx);
+static void arena_destroy(void *ctx);
+static void *arena_malloc(void *ctx, size_t size);
+static void *arena_calloc(void *ctx, size_t size);
+static void *arena_realloc(void *ctx, void *ptr, size_t size);
+static void arena_free(void *ctx, void *ptr);
+static size_t arena_footprint(void *ctx);
+static int pool_create(void **ctx);
+static void pool_destroy(void *ctx);
+static void *pool_malloc(void *ctx, size_t size);
+static void *pool_calloc(void *ctx, size_t size);
+static void *pool_realloc(void *ctx, void *ptr, size_t size);
+static void pool_free(void *ctx, void *ptr);
+static size_t pool_footprint(void *ctx);
+static int guard_create(void **ctx);
+static int redzone_create(void **ctx);
+static void *checked_malloc(void *ctx, size_t size);
+static void *checked_calloc(void *ctx, size_t size);
+static void *checked_realloc(void *ctx, void *ptr, size_t size);
+static void checked_free(void *ctx, void *ptr);
+#ifdef REPLAY_MALLINFO
+static size_t heap_footprint(void *ctx);
+#define HEAP_FOOTPRINT heap_footprint
+#else
+#define HEAP_FOOTPRINT NULL
+#endif
+
+/* ==========================================================================
+ * Global Variables Section
+ * ========================================================================== */
+
+static const char *const kUsages[] = {
+    APP_USAGE_A,
+    NULL,
+};
+
+static const replay_allocator kAllocators[] = {
+    {"system", no_create, no_destroy, system_malloc, system_calloc,
+     system_realloc, system_free, HEAP_FOOTPRINT},
+    {"arena", arena_create, arena_destroy, arena_malloc, arena_calloc,
+     arena_realloc, arena_free, arena_footprint},
+    {"pool", pool_create, pool_destroy, pool_malloc, pool_calloc,
+     pool_realloc, pool_free, pool_footprint},
+    {"guard", guard_create, no_destroy, checked_malloc, checked_calloc,
+     checked_realloc, checked_free, NULL},
+    {"redzone", redzone_create, no_destroy, checked_malloc, checked_calloc,
+     checked_realloc, checked_free, HEAP_FOOTPRINT},
+};
+
+/* ==========================================================================
+ * Main Function Section
+ * ========================================================================== */
+
+int main(int argc, char **argv) {
+  const char *allocator_list = DEFAULT_ALLOCATORS;
+  const char *format = "text";
+  const char *output = NULL;
+  int iterations = 5;
+  char *names[MAX_LIST];
+  const replay_allocator *allocs[MAX_LIST];
+  char *allocator_buf = NULL;
+  size_t num_allocs = 0;
+  unsigned char *data = NULL;
+  size_t size = 0;
+  replay_trace trace;
+  replay_result result;
+  FILE *out = stdout;
+  int csv = 0;
+  size_t offset = 0;
+  int status = 0;
+  int decoded = 0;
+  int failed = 0;
+  int i = 0;
+  size_t j = 0;
+
+  /* Define command line options */
+  struct argparse_option options[] = {
+      OPT_GROUP("general options"),
+      OPT_HELP(),
+      OPT_GROUP("replay options"),
+      OPT_STRING('a', "allocators", &allocator_list,
+                 "comma separated allocators (default all)", NULL, 0, 0),
+      OPT_INTEGER('i', "iterations", &iterations,
+                  "timed replays per allocator (default 5)", NULL, 0, 0),
+      OPT_GROUP("output options"),
+      OPT_STRING('\0', "format", &format, "text (default) or csv", NULL, 0, 0),
+      OPT_STRING('o', "output", &output, "write the results to a file", NULL,
+                 0, 0),
+      OPT_END(),
+  };
+
+  /* Parse command line arguments */
+  struct argparse argparse;
+  argparse_init(&argparse, options, kUsages, 0);
+  argparse_describe(&argparse, APP_DESCRIPTION, APP_EPILOGUE);
+  argc = argparse_parse(&argparse, argc, (const char **)argv);
+
+  csv = 0 == strcmp(format, "csv");
+  if (0 >= iterations || (!csv && 0 != strcmp(format, "text"))) {
+    fprintf(stderr, "%s: Invalid iterations or format\n", APP_NAME);
+    return EXIT_FAILURE;
+  }
+  if (0 == argc) {
+    argparse_usage(&argparse);
+    return EXIT_FAILURE;
+  }
+
+  allocator_buf = strdup(allocator_list);
+  num_allocs = allocator_buf ? split_list(allocator_buf, names, MAX_LIST) : 0;
+  if (0 == num_allocs) {
+    fprintf(stderr, "%s: Invalid list of allocators\n", APP_NAME);
+    return EXIT_FAILURE;
+  }
+  for (j = 0; j < num_allocs; j++) {
+    allocs[j] = find_allocator(names[j]);
+    if (NULL == allocs[j]) {
+      fprintf(stderr, "%s: Unknown allocator %s\n", APP_NAME, names[j]);
+      return EXIT_FAILURE;
+    }
+  }
+
+  /* The checked allocators would otherwise record the replay into a trace
+     of their own (or over the one being replayed) */
+  unsetenv(CME_TRACE_ENV);
+
+  if (output) {
+    out = fopen(output, "w");
+    if (NULL == out) {
+      fprintf(stderr, "%s: Can not open %s\n", APP_NAME, output);
+      return EXIT_FAILURE;
+    }
+  }
+  if (csv) {
+    fprintf(out, "trace,allocator,events,events_per_s,ns_per_event,"
+                 "peak_rss_kb,rss_growth_kb,peak_footprint_kb,peak_live_kb,"
+                 "fragmentation,failures,result\n");
+  }
+
+  for (i = 0; i < argc; i++) {
+    data = read_file(argv[i], &size);
+    if (NULL == data) {
+      fprintf(stderr, "%s: Can not read %s\n", APP_NAME, argv[i]);
+      failed = 1;
+      continue;
+    }
+    decoded = decode_trace(data, size, &trace, &offset);
+    if (TRACE_OK > decoded) {
+      if (TRACE_BAD_HEADER == decoded) {
+        fprintf(stderr, "%s: %s is not a trace\n", APP_NAME, argv[i]);
+      } else if (TRACE_BAD_VERSION == decoded) {
+        fprintf(stderr, "%s: %s is a trace of another version (%.*s)\n",
+                APP_NAME, argv[i], VERSION_SIZE,
+                (const char *)data + CME_TRACE_MAGIC_SIZE - VERSION_SIZE);
+      } else if (TRACE_BAD_EVENT == decoded) {
+        fprintf(stderr, "%s: %s has an invalid event at byte %zu\n",
+                APP_NAME, argv[i], offset);
+      } else {
+        fprintf(stderr, "%s: Out of memory decoding %s\n", APP_NAME, argv[i]);
+      }
+      free(data);
+      failed = 1;
+      continue;
+    }
+    free(data);
+    if (TRACE_TRUNCATED == decoded) {
+      fprintf(stderr,
+              "%s: %s is cut short in an event at byte %zu, replaying the "
+              "%zu events before it\n",
+              APP_NAME, argv[i], offset, trace.count);
+    }
+
+    if (!csv) {
+      write_trace_text(out, argv[i], &trace);
+    }
+    for (j = 0; j < num_allocs; j++) {
+      if (0 != run_allocator(&trace, allocs[j], iterations, &result,
+                             &status)) {
+        failed = 1;
+      }
+      write_result(out, argv[i], &trace, allocs[j], &result, status,
+                   iterations, csv);
+    }
+    if (!csv && i + 1 < argc) {
+      fprintf(out, "\n");
+    }
+    free(trace.events);
+  }
+
+  if (out != stdout) {
+    fclose(out);
+  }
+  free(allocator_buf);
+
+  return failed ? EXIT_FAILURE : EXIT_SUCCESS;
+}
+
+/* ==========================================================================
+ * User Defined Function Definitions Section
+ * ========================================================================== */
+
+/* --------------------------------------------------------------------------
+ * Function: split_list
+ * --------------------------------------------------------------------------
+ *
+ * Description: Split a comma separated list in place
+ *
+ * Parameters:
+ *          list: List to split (modified)
+ *         items: Receives the items
+ *     max_items: Capacity of `items`
+ *
+ * Returns: Number of items (0 if the list is empty, too long or has an
+ *          empty item)
+ *
+ * -------------------------------------------------------------------------- */
+static size_t split_list(char *list, char **items, size_t max_items) {
+  size_t count = 0;
+  char *comma = NULL;
+
+  while (*list) {
+    if (count == max_items) {
+      return 0;
+    }
+    items[count++] = list;
+    comma = strchr(list, ',');
+    if (NULL == comma) {
+      break;
+    }
+    *comma = '\0';
+    list = comma + 1;
+    if ('\0' == *list || ',' == *list) {
+      return 0;
+    }
+  }
+
+  return 0 < count && '\0' != *items[0] ? count : 0;
+}
+
+/* --------------------------------------------------------------------------
+ * Function: now_seconds
+ * --------------------------------------------------------------------------
+ *
+ * Description: Current time of a monotonic clock
+ *
+ * Returns: Time in seconds
+ *
+ * -------------------------------------------------------------------------- */
+static double now_seconds(void) {
+  struct timespec ts;
+
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+
+  return (double)ts.tv_sec + (double)ts.tv_nsec * 1e-9;
+}
+
+/* --------------------------------------------------------------------------
+ * Function: read_file
+ * --------------------------------------------------------------------------
+ *
+ * Description: Read a whole file into memory
+ *
+ * Parameters:
+ *      path: The file
+ *      size: Receives its size
+ *
+ * Returns: Allocated contents (release them with `free`), or NULL
+ *
+ * -------------------------------------------------------------------------- */
+static unsigned char *read_file(const char *path, size_t *size) {
+  FILE *f = fopen(path, "rb");
+  unsigned char *data = NULL;
+  unsigned char *grown = NULL;
+  size_t capacity = 0;
+  size_t got = 0;
+
+  if (NULL == f) {
+    return NULL;
+  }
+
+  *size = 0;
+  do {
+    if (*size == capacity) {
+      capacity = capacity ? 2 * capacity : (size_t)64 * 1024;
+      grown = realloc(data, capacity);
+      if (NULL == grown) {
+        free(data);
+        fclose(f);
+        return NULL;
+      }
+      data = grown;
+    }
+    got = fread(data + *size, 1, capacity - *size, f);
+    *size += got;
+  } while (0 < got);
+
+  if (ferror(f)) {
+    free(data);
+    data = NULL;
+  }
+  fclose(f);
+
+  return data;
+}
+
+/* --------------------------------------------------------------------------
+ * Function: read_varint
+ * --------------------------------------------------------------------------
+ *
+ * Description: Decode an unsigned LEB128 varint
+ *
+ * Parameters:
+ *        pos: Position in the trace (advanced past the varint)
+ *        end: End of the trace
+ *      value: Receives the value
+ *
+ * Returns: 0 on success, -1 if the varint is cut short or too long
+ *
+ * -------------------------------------------------------------------------- */
+static int read_varint(const unsigned char **pos, const unsigned char *end,
+                       uint64_t *value) {
+  unsigned shift = 0;
+
+  *value = 0;
+  while (*pos < end && shift < 64) {
+    *value |= (uint64_t)(**pos & 0x7F) << shift;
+    if (0 == (*(*pos)++ & 0x80)) {
+      return 0;
+    }
+    shift += 7;
+  }
+
+  return -1;
+}
+
+/* --------------------------------------------------------------------------
+ * Function: decode_trace
+ * --------------------------------------------------------------------------
+ *
+ * Description: Decode a trace into events numbering their blocks, and
+ *              total up the operations, the recorded time and the live
+ *              bytes. The block numbers are checked, so the replay can trust
+ *              them (a free of a block not live is an error). A trace cut
+ *              short in an event, as by a program killed while writing it,
+ *              keeps the events before.
+ *
+ * Parameters:
+ *       data: The trace
+ *       size: Its size
+ *      trace: Receives the events (release them with `free`)
+ *     offset: Receives the byte where the trace is cut short or invalid
+ *
+ * Returns: TRACE_OK, TRACE_TRUNCATED (the trace has the events before the
+ *          offset), or TRACE_BAD_HEADER, TRACE_BAD_VERSION, TRACE_BAD_EVENT
+ *          or TRACE_NO_MEMORY (the trace has no events)
+ *
+ * -------------------------------------------------------------------------- */
+static int decode_trace(const unsigned char *data, size_t size,
+                        replay_trace *trace, size_t *offset) {
+  const unsigned char *pos = data + CME_TRACE_MAGIC_SIZE;
+  const unsigned char *end = data + size;
+  const unsigned char *start = pos; /* Of the event being decoded */
+  size_t *sizes = NULL; /* Of the live blocks, SIZE_MAX for the others */
+  size_t capacity = 0;
+  size_t last_size = 0;
+  size_t live = 0;
+  size_t start_live = 0;
+  uint64_t start_duration = 0;
+  uint64_t delta = 0;
+  uint64_t back = 0;
+  uint64_t value = 0;
+  replay_event *event = NULL;
+  void *grown = NULL;
+  int outcome = TRACE_BAD_EVENT;
+
+  memset(trace, 0, sizeof(*trace));
+  *offset = 0;
+  if (size < CME_TRACE_MAGIC_SIZE ||
+      0 != memcmp(data, CME_TRACE_MAGIC, CME_TRACE_MAGIC_SIZE - VERSION_SIZE)) {
+    return TRACE_BAD_HEADER;
+  }
+  if (0 != memcmp(data, CME_TRACE_MAGIC, CME_TRACE_MAGIC_SIZE)) {
+    *offset = CME_TRACE_MAGIC_SIZE - VERSION_SIZE;
+    return TRACE_BAD_VERSION;
+  }
+
+  /* At least two bytes an event */
+  trace->events = malloc((size / 2 + 1) * sizeof(replay_event));
+  if (NULL == trace->events) {
+    return TRACE_NO_MEMORY;
+  }
+
+  while (pos < end) {
+    start = pos;
+    start_live = live;
+    start_duration = trace->duration;
+    event = &trace->events[trace->count];
+    event->op = *pos++;
+    event->old = 0;
+    if (CME_TRACE_FREE < event->op) {
+      goto invalid;
+    }
+    if (0 != read_varint(&pos, end, &delta)) {
+      goto cut;
+    }
+    trace->duration += delta;
+
+    /* The block resized or freed, as a distance back from the next number */
+    if (CME_TRACE_REALLOC == event->op || CME_TRACE_FREE == event->op) {
+      if (0 != read_varint(&pos, end, &back)) {
+        goto cut;
+      }
+      if (back > trace->num_blocks ||
+          (CME_TRACE_FREE == event->op && 0 == back)) {
+        goto invalid;
+      }
+      if (0 != back) {
+        event->old = (uint32_t)(trace->num_blocks + 1 - back);
+        if (SIZE_MAX == sizes[event->old]) {
+          goto invalid;
+        }
+        live -= sizes[event->old];
+        sizes[event->old] = SIZE_MAX;
+      }
+    }
+    if (CME_TRACE_FREE == event->op) {
+      event->block = event->old;
+      event->size = 0;
+      trace->ops[event->op]++;
+      trace->count++;
+      continue;
+    }
+
+    /* A new block, and its size relative to the one before */
+    if (0 != read_varint(&pos, end, &value)) {
+      goto cut;
+    }
+    if (UINT32_MAX == trace->num_blocks) {
+      goto invalid;
+    }
+    last_size += (size_t)((value >> 1) ^ (~(value & 1) + 1));
+    event->size = last_size;
+    event->block = (uint32_t)++trace->num_blocks;
+    if (trace->num_blocks >= capacity) {
+      capacity = capacity ? 2 * capacity : 1024;
+      grown = realloc(sizes, capacity * sizeof(size_t));
+      if (NULL == grown) {
+        outcome = TRACE_NO_MEMORY;
+        goto invalid;
+      }
+      sizes = grown;
+    }
+    sizes[event->block] = event->size;
+    live += event->size;
+    if (live > trace->peak_live) {
+      trace->peak_live = live;
+    }
+    trace->ops[event->op]++;
+    trace->count++;
+  }
+
+  trace->end_live = live;
+  free(sizes);
+
+  return TRACE_OK;
+
+cut:
+  /* A varint running to the end of the trace is cut short, any other is
+     too long. The event is dropped, with what it did to the totals. */
+  if (pos < end) {
+    goto invalid;
+  }
+  trace->duration = start_duration;
+  trace->end_live = start_live;
+  *offset = (size_t)(start - data);
+  free(sizes);
+
+  return TRACE_TRUNCATED;
+
+invalid:
+  *offset = (size_t)(start - data);
+  free(sizes);
+  free(trace->events);
+  memset(trace, 0, sizeof(*trace));
+
+  return outcome;
+}
+
+/* --------------------------------------------------------------------------
+ * Function: find_allocator
+ * --------------------------------------------------------------------------
+ *
+ * Description: Look an allocator up by name
+ *
+ * Parameters:
+ *      name: Its name
+ *
+ * Returns: The allocator, or NULL if there is none of that name
+ *
+ * -------------------------------------------------------------------------- */
+static const replay_allocator *find_allocator(const char *name) {
+  size_t i = 0;
+
+  for (i = 0; i < sizeof(kAllocators) / sizeof(kAllocators[0]); i++) {
+    if (0 == strcmp(name, kAllocators[i].name)) {
+      return &kAllocators[i];
+    }
+  }
+
+  return NULL;
+}
+
+/* --------------------------------------------------------------------------
+ * Function: run_allocator
+ * --------------------------------------------------------------------------
+ *
+ * Description: Replay a trace against an allocator in a child process, and
+ *              collect the result it sends back over a pipe
+ *
+ * Parameters:
+ *           trace: The trace
+ *           alloc: The allocator
+ *      iterations: Timed replays
+ *          result: Receives the result
+ *          status: Receives the wait status of the child
+ *
+ * Returns: 0 on success, -1 if the child could not run or did not finish
+ *
+ * -------------------------------------------------------------------------- */
+static int run_allocator(const replay_trace *trace,
+                         const replay_allocator *alloc, int iterations,
+                         replay_result *result, int *status) {
+  int fds[2] = {-1, -1};
+  size_t got = 0;
+  ssize_t n = 0;
+  pid_t pid = 0;
+
+  memset(result, 0, sizeof(*result));
+  *status = 0;
+  fflush(NULL);
+  if (0 != pipe(fds)) {
+    return -1;
+  }
+
+  pid = fork();
+  if (0 > pid) {
+    close(fds[0]);
+    close(fds[1]);
+    return -1;
+  }
+  if (0 == pid) {
+    close(fds[0]);
+    replay_child(trace, alloc, iterations, result);
+    n = write(fds[1], result, sizeof(*result));
+    _exit(sizeof(*result) == (size_t)n ? EXIT_SUCCESS : EXIT_FAILURE);
+  }
+
+  close(fds[1]);
+  while (got < sizeof(*result)) {
+    n = read(fds[0], (char *)result + got, sizeof(*result) - got);
+    if (0 > n && EINTR == errno) {
+      continue;
+    }
+    if (0 >= n) {
+      break;
+    }
+    got += (size_t)n;
+  }
+  close(fds[0]);
+  while (0 > waitpid(pid, status, 0) && EINTR == errno) {
+  }
+
+  if (sizeof(*result) != got || !WIFEXITED(*status) ||
+      0 != WEXITSTATUS(*status)) {
+    memset(result, 0, sizeof(*result));
+    return -1;
+  }
+
+  return 0;
+}
+
+/* --------------------------------------------------------------------------
+ * Function: replay_child
+ * --------------------------------------------------------------------------
+ *
+ * Description: Replay a trace against an allocator, in the child process:
+ *              once sampling the footprint, for the resident set size and
+ *              the fragmentation, then timed, the given number of times.
+ *              Every replay starts with a fresh allocator.
+ *
+ * Parameters:
+ *           trace: The trace
+ *           alloc: The allocator
+ *      iterations: Timed replays
+ *          result: Receives the result
+ *
+ * Returns: None
+ *
+ * -------------------------------------------------------------------------- */
+static void replay_child(const replay_trace *trace,
+                         const replay_allocator *alloc, int iterations,
+                         replay_result *result) {
+  struct rusage usage;
+  void **blocks = calloc(trace->num_blocks + 1, sizeof(void *));
+  void *ctx = NULL;
+  size_t base_footprint = 0;
+  double start = 0.0;
+  int i = 0;
+
+  if (NULL == blocks || 0 != alloc->create(&ctx)) {
+    free(blocks);
+    return; /* Not supported */
+  }
+  result->supported = 1;
+  result->has_footprint = NULL != alloc->footprint;
+
+  /* The table of the blocks and the free memory of the heap left from the
+     parent are not the replay's doing, so they are out of the baseline */
+  touch(blocks, (trace->num_blocks + 1) * sizeof(void *));
+#ifdef REPLAY_MALLINFO
+  malloc_trim(0);
+#endif
+  getrusage(RUSAGE_SELF, &usage);
+  result->base_rss_kb = usage.ru_maxrss;
+  if (alloc->footprint) {
+    base_footprint = alloc->footprint(ctx);
+  }
+  replay(trace, alloc, ctx, blocks, result, base_footprint);
+  release_blocks(trace, alloc, ctx, blocks);
+  alloc->destroy(ctx);
+  getrusage(RUSAGE_SELF, &usage);
+  result->peak_rss_kb = usage.ru_maxrss;
+
+  for (i = 0; i < iterations; i++) {
+    if (0 != alloc->create(&ctx)) {
+      break;
+    }
+    start = now_seconds();
+    replay(trace, alloc, ctx, blocks, NULL, 0);
+    result->seconds += now_seconds() - start;
+    release_blocks(trace, alloc, ctx, blocks);
+    alloc->destroy(ctx);
+  }
+  free(blocks);
+}
+
+/* --------------------------------------------------------------------------
+ * Function: replay
+ * --------------------------------------------------------------------------
+ *
+ * Description: Replay the events of a trace against an allocator. Blocks
+ *              still live at the end are left in `blocks`.
+ *
+ * Parameters:
+ *               trace: The trace
+ *               alloc: The allocator
+ *                 ctx: Its context
+ *              blocks: Pointers of the blocks, by number (all NULL)
+ *              result: Receives the failures and the peak footprint, or
+ *                      NULL for a timed replay (no sampling)
+ *      base_footprint: Footprint before the replay
+ *
+ * Returns: None
+ *
+ * -------------------------------------------------------------------------- */
+static void replay(const replay_trace *trace, const replay_allocator *alloc,
+                   void *ctx, void **blocks, replay_result *result,
+                   size_t base_footprint) {
+  const replay_event *event = NULL;
+  size_t footprint = 0;
+  void *ptr = NULL;
+  size_t i = 0;
+
+  for (i = 0; i < trace->count; i++) {
+    event = &trace->events[i];
+    switch (event->op) {
+    case CME_TRACE_MALLOC:
+      ptr = alloc->malloc_fn(ctx, event->size);
+      break;
+    case CME_TRACE_CALLOC:
+      ptr = alloc->calloc_fn(ctx, event->size);
+      break;
+    case CME_TRACE_REALLOC:
+      ptr = alloc->realloc_fn(ctx, blocks[event->old], event->size);
+      if (ptr) {
+        blocks[event->old] = NULL;
+      }
+      break;
+    default:
+      alloc->free_fn(ctx, blocks[event->block]);
+      blocks[event->block] = NULL;
+      continue;
+    }
+
+    blocks[event->block] = ptr;
+    if (ptr) {
+      touch(ptr, event->size);
+    } else if (result && 0 < event->size) {
+      result->failures++;
+    }
+    if (result && alloc->footprint && 0 == i % SAMPLE_EVERY) {
+      footprint = alloc->footprint(ctx) - base_footprint;
+      if (footprint > result->peak_footprint) {
+        result->peak_footprint = footprint;
+      }
+    }
+  }
+  if (result && alloc->footprint) {
+    footprint = alloc->footprint(ctx) - base_footprint;
+    if (footprint > result->peak_footprint) {
+      result->peak_footprint = footprint;
+    }
+  }
+}
+
+/* --------------------------------------------------------------------------
+ * Function: release_blocks
+ * --------------------------------------------------------------------------
+ *
+ * Description: Free the blocks a replay left live (and those a failed
+ *              resize kept)
+ *
+ * Parameters:
+ *       trace: The trace
+ *       alloc: The allocator
+ *         ctx: Its context
+ *      blocks: Pointers of the blocks, by number (all NULL afterwards)
+ *
+ * Returns: None
+ *
+ * -------------------------------------------------------------------------- */
+static void release_blocks(const replay_trace *trace,
+                           const replay_allocator *alloc, void *ctx,
+                           void **blocks) {
+  size_t i = 0;
+
+  for (i = 1; i <= trace->num_blocks; i++) {
+    if (blocks[i]) {
+      alloc->free_fn(ctx, blocks[i]);
+      blocks[i] = NULL;
+    }
+  }
+}
+
+/* --------------------------------------------------------------------------
+ * Function: touch
+ * --------------------------------------------------------------------------
+ *
+ * Description: Write a zero byte to every page of a new block (and its
+ *              last byte), as the program that allocated it would, so its
+ *              pages count in the resident set size
+ *
+ * Parameters:
+ *       ptr: The block
+ *      size: Its size
+ *
+ * Returns: None
+ *
+ * -------------------------------------------------------------------------- */
+static void touch(void *ptr, size_t size) {
+  volatile unsigned char *bytes = ptr;
+  size_t i = 0;
+
+  for (i = 0; i < size; i += TOUCH_STRIDE) {
+    bytes[i] = 0;
+  }
+  if (0 < size) {
+    bytes[size - 1] = 0;
+  }
+}
+
+/* --------------------------------------------------------------------------
+ * Function: write_trace_text
+ * --------------------------------------------------------------------------
+ *
+ * Description: Write what a trace holds, and the header of its results
+ *
+ * Parameters:
+ *          f: Output stream
+ *       path: File of the trace
+ *      trace: The trace
+ *
+ * Returns: None
+ *
+ * -------------------------------------------------------------------------- */
+static void write_trace_text(FILE *f, const char *path,
+                             const replay_trace *trace) {
+  fprintf(f,
+          "%s: %zu events (%zu malloc, %zu calloc, %zu realloc, %zu free) "
+          "over %.3f ms\n",
+          path, trace->count, trace->ops[CME_TRACE_MALLOC],
+          trace->ops[CME_TRACE_CALLOC], trace->ops[CME_TRACE_REALLOC],
+          trace->ops[CME_TRACE_FREE], (double)trace->duration * 1e-6);
+  fprintf(f, "%zu blocks, %zu bytes live at the peak, %zu at the end\n",
+          trace->num_blocks, trace->peak_live, trace->end_live);
+  fprintf(f, "%-10s %12s %10s %12s %12s %14s %8s\n", "allocator",
+          "events/s", "ns/event", "peak RSS KiB", "RSS grow KiB",
+          "footprint KiB", "frag");
+}
+
+/* --------------------------------------------------------------------------
+ * Function: write_result
+ * --------------------------------------------------------------------------
+ *
+ * Description: Write the result of the replays against an allocator
+ *
+ * Parameters:
+ *               f: Output stream
+ *            path: File of the trace
+ *           trace: The trace
+ *           alloc: The allocator
+ *          result: Its result
+ *          status: Wait status of the child that replayed
+ *      iterations: Timed replays
+ *             csv: Nonzero for CSV, otherwise a row of text
+ *
+ * Returns: None
+ *
+ * -------------------------------------------------------------------------- */
+static void write_result(FILE *f, const char *path, const replay_trace *trace,
+                         const replay_allocator *alloc,
+                         const replay_result *result, int status,
+                         int iterations, int csv) {
+  double events = (double)trace->count * (double)iterations;
+  double rate = 0.0 < result->seconds ? events / result->seconds : 0.0;
+  double ns = 0.0 < events ? result->seconds * 1e9 / events : 0.0;
+  long growth = result->peak_rss_kb - result->base_rss_kb;
+  double footprint = result->has_footprint ? (double)result->peak_footprint
+                                           : (double)growth * 1024.0;
+  double frag = -1.0; /* Unknown: the allocator took no more memory */
+  char outcome[32] = "ok";
+
+  if (0.0 < footprint && (double)trace->peak_live <= footprint) {
+    frag = 1.0 - (double)trace->peak_live / footprint;
+  }
+  if (WIFSIGNALED(status)) {
+    snprintf(outcome, sizeof(outcome), "signal %d", WTERMSIG(status));
+  } else if (WIFEXITED(status) && 0 != WEXITSTATUS(status)) {
+    snprintf(outcome, sizeof(outcome), "exit %d", WEXITSTATUS(status));
+  } else if (!result->supported) {
+    snprintf(outcome, sizeof(outcome), "not supported here");
+  }
+
+  if (csv) {
+    fprintf(f, "%s,%s,%zu,%.0f,%.2f,%ld,%ld,%.1f,%.1f,", path, alloc->name,
+            trace->count, rate, ns, result->peak_rss_kb, growth,
+            footprint / 1024.0, (double)trace->peak_live / 1024.0);
+    if (0.0 <= frag) {
+      fprintf(f, "%.4f", frag);
+    }
+    fprintf(f, ",%zu,%s\n", result->failures, outcome);
+    return;
+  }
+  if (!result->supported) {
+    fprintf(f, "%-10s %s\n", alloc->name, outcome);
+    return;
+  }
+  fprintf(f, "%-10s %12.0f %10.1f %12ld %12ld %14.1f", alloc->name, rate, ns,
+          result->peak_rss_kb, growth, footprint / 1024.0);
+  if (0.0 <= frag) {
+    fprintf(f, " %7.1f%%", frag * 100.0);
+  } else {
+    fprintf(f, " %8s", "-");
+  }
+  if (0 < result->failures) {
+    fprintf(f, "  (%zu allocations failed)", result->failures);
+  }
+  fprintf(f, "\n");
+}
+
+/* --------------------------------------------------------------------------
+ * Function: no_create
+ * --------------------------------------------------------------------------
+ *
+ * Description: Create the context of an allocator that needs none
+ *
+ * Parameters:
+ *      ctx: Receives NULL
+ *
+ * Returns: 0
+ *
+ * -------------------------------------------------------------------------- */
+static int no_create(void **ctx) {
+  *ctx = NULL;
+  return 0;
+}
+
+/* --------------------------------------------------------------------------
+ * Function: no_destroy
+ * --------------------------------------------------------------------------
+ *
+ * Description: Destroy the context of an allocator that needs none
+ *
+ * Parameters:
+ *      ctx: Unused
+ *
+ * Returns: None
+ *
+ * -------------------------------------------------------------------------- */
+static void no_destroy(void *ctx) { (void)ctx; }
+
+/* --------------------------------------------------------------------------
+ * Functions: system_malloc, system_calloc, system_realloc, system_free
+ * --------------------------------------------------------------------------
+ *
+ * Description: The C library allocator
+ *
+ * -------------------------------------------------------------------------- */
+static void *system_malloc(void *ctx, size_t size) {
+  (void)ctx;
+  return malloc(size);
+}
+
+static void *system_calloc(void *ctx, size_t size) {
+  (void)ctx;
+  return calloc(1, size);
+}
+
+static void *system_realloc(void *ctx, void *ptr, size_t size) {
+  (void)ctx;
+  return realloc(ptr, size);
+}
+
+static void system_free(void *ctx, void *ptr) {
+  (void)ctx;
+  free(ptr);
+}
+
+/* --------------------------------------------------------------------------
+ * Functions: arena_create, arena_destroy, arena_malloc, arena_calloc,
+ *            arena_realloc, arena_free, arena_footprint
+ * --------------------------------------------------------------------------
+ *
+ * Description: A `cme_arena` with chunks of the default size
+ *
+ * -------------------------------------------------------------------------- */
+static int arena_create(void **ctx) {
+  cme_arena *arena = malloc(sizeof(cme_arena));
+
+  if (NULL == arena) {
+    return -1;
+  }
+  cme_arena_init(arena, 0);
+  *ctx = arena;
+
+  return 0;
+}
+
+static void arena_destroy(void *ctx) {
+  cme_arena_release(ctx);
+  free(ctx);
+}
+
+static void *arena_malloc(void *ctx, size_t size) {
+  return cme_arena_malloc(ctx, size);
+}
+
+static void *arena_calloc(void *ctx, size_t size) {
+  return cme_arena_calloc(ctx, 1, size);
+}
+
+static void *arena_realloc(void *ctx, void *ptr, size_t size) {
+  return cme_arena_realloc(ctx, ptr, size);
+}
+
+static void arena_free(void *ctx, void *ptr) { cme_arena_free(ctx, ptr); }
+
+static size_t arena_footprint(void *ctx) { return cme_arena_footprint(ctx); }
+
+/* --------------------------------------------------------------------------
+ * Functions: pool_create, pool_destroy, pool_malloc, pool_calloc,
+ *            pool_realloc, pool_free, pool_footprint
+ * --------------------------------------------------------------------------
+ *
+ * Description: A `cme_pool`
+ *
+ * -------------------------------------------------------------------------- */
+static int pool_create(void **ctx) {
+  cme_pool *pool = malloc(sizeof(cme_pool));
+
+  if (NULL == pool) {
+    return -1;
+  }
+  cme_pool_init(pool);
+  *ctx = pool;
+
+  return 0;
+}
+
+static void pool_destroy(void *ctx) {
+  cme_pool_release(ctx);
+  free(ctx);
+}
+
+static void *pool_malloc(void *ctx, size_t size) {
+  return cme_pool_malloc(ctx, size);
+}
+
+static void *pool_calloc(void *ctx, size_t size) {
+  return cme_pool_calloc(ctx, 1, size);
+}
+
+static void *pool_realloc(void *ctx, void *ptr, size_t size) {
+  return cme_pool_realloc(ctx, ptr, size);
+}
+
+static void pool_free(void *ctx, void *ptr) { cme_pool_free(ctx, ptr); }
+
+static size_t pool_footprint(void *ctx) { return cme_pool_footprint(ctx); }
+
+/* --------------------------------------------------------------------------
+ * Functions: guard_create, redzone_create
+ * --------------------------------------------------------------------------
+ *
+ * Description: Switch the `cme` allocator to the guard or the redzone mode
+ *
+ * Parameters:
+ *      ctx: Receives NULL
+ *
+ * Returns: 0 on success, -1 if the mode is not supported here
+ *
+ * -------------------------------------------------------------------------- */
+static int guard_create(void **ctx) {
+  *ctx = NULL;
+  cme_alloc_set_mode(CME_ALLOC_GUARD);
+  return CME_ALLOC_GUARD == cme_alloc_get_mode() ? 0 : -1;
+}
+
+static int redzone_create(void **ctx) {
+  *ctx = NULL;
+  cme_alloc_set_mode(CME_ALLOC_REDZONE);
+  return CME_ALLOC_REDZONE == cme_alloc_get_mode() ? 0 : -1;
+}
+
+/* --------------------------------------------------------------------------
+ * Functions: checked_malloc, checked_calloc, checked_realloc, checked_free
+ * --------------------------------------------------------------------------
+ *
+ * Description: The `cme` allocator, in the mode it was switched to
+ *
+ * -------------------------------------------------------------------------- */
+static void *checked_malloc(void *ctx, size_t size) {
+  (void)ctx;
+  return cme_malloc(size);
+}
+
+static void *checked_calloc(void *ctx, size_t size) {
+  (void)ctx;
+  return cme_calloc(1, size);
+}
+
+static void *checked_realloc(void *ctx, void *ptr, size_t size) {
+  (void)ctx;
+  return cme_realloc(ptr, size);
+}
+
+static void checked_free(void *ctx, void *ptr) {
+  (void)ctx;
+  cme_free(ptr);
+}
+
+#ifdef REPLAY_MALLINFO
+/* --------------------------------------------------------------------------
+ * Function: heap_footprint
+ * --------------------------------------------------------------------------
+ *
+ * Description: Memory the C library allocator holds: its heap and the
+ *              blocks it mapped on their own
+ *
+ * Parameters:
+ *      ctx: Unused
+ *
+ * Returns: Bytes held
+ *
+ * -------------------------------------------------------------------------- */
+static size_t heap_footprint(void *ctx) {
+  struct REPLAY_MALLINFO info = REPLAY_MALLINFO();
+
+  (void)ctx;
+  return (size_t)info.arena + (size_t)info.hblkhd;
+}
+#endif /* REPLAY_MALLINFO */
@@ -0,0 +1,1405 @@
+/* ==========================================================================
+ *  Copyright (C) 2026 Ljubomir Kurij <ljubomir_kurij@protonmail.com>
+ *
+ * This file is part of "C Common Memory Errors".
+ *
+ * "C Common Memory Errors" is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * "C Common Memory Errors" is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General
+ * Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with Focus Precision Analyze. If not, see <https://www.gnu.org/licenses/>.
+ * ========================================================================== */
+
+/* ==========================================================================
+ *
+ * 2026-10-18 Ljubomir Kurij <ljubomir_kurij@protonmail.com>
+ *
+ * * cme_runner.c: created.
+ *
+ * ========================================================================== */
+
+/* ==========================================================================
+ * Headers Include Section
+ * ========================================================================== */
+
+/* Related header */
+
+/* System headers */
+#include <dirent.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <signal.h>
+#include <sys/resource.h>
+#include <sys/stat.h>
+#include <sys/time.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+/* Standard Library headers */
+#include <errno.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+/* External libraries headers */
+#include <argparse.h>
+
+/* Project headers */
+#include "cme_alloc.h"
+#include "cme_scenario.h"
+
+/* ==========================================================================
+ * Macros Definitions Section
+ * ========================================================================== */
+
+#define APP_NAME "cme_runner"
+#define APP_DESCRIPTION                                                        \
+  "Runs the scenarios of the sample programs, the correct and the buggy\n"     \
+  "variant of each, under every checker and allocator mode. Every run is a\n"  \
+  "process of its own, in a scratch directory of its own, so a scenario\n"     \
+  "that crashes by design takes only itself down. The runs go in parallel\n"   \
+  "and are killed when they time out. For each run the exit code or\n"         \
+  "signal, the wall time, the peak resident set size and what the run\n"       \
+  "wrote to stderr (the detector output) are written out as JSON or CSV.\n"    \
+  "With --summary it writes, per scenario and checker, whether the bug was\n"  \
+  "detected and what the checker costs against the first one. The summary\n"  \
+  "runs one run at a time, repeats every run and takes the median, and\n"     \
+  "times the scenario inside the program, leaving out its start-up."
+#define APP_USAGE_A APP_NAME " [OPTION]..."
+#define APP_EPILOGUE                                                           \
+  "\nA checker is NAME=DIR, a build of the programs in DIR (e.g.\n"            \
+  "asan=build-asan/bin), or just NAME for the programs in --dir. The\n"        \
+  "checker `valgrind' runs the programs under Valgrind memcheck. Without\n"    \
+  "--checkers the programs in --dir are the `plain' checker. --dir\n"          \
+  "defaults to the directory of " APP_NAME ". The scenarios are found\n"       \
+  "with `--scenario list'.\n"                                                  \
+  "The result of a run is one of:\n"                                           \
+  "  ok        exited with status 0\n"                                         \
+  "  exit      exited with another status\n"                                   \
+  "  signal    killed by a signal (e.g. SIGSEGV, SIGABRT)\n"                   \
+  "  timeout   killed after the timeout\n"                                     \
+  "A bug counts as detected when its buggy variant does not end `ok'."
+#define DEFAULT_PROGRAMS                                                       \
+  "fishy_values,invalid_frees,invalid_frees_exercise,invalid_reads,"           \
+  "invalid_reads_exercise,invalid_writes,invalid_writes_exercise,"             \
+  "memory_leaks,uninitialized_values,uninitialized_values_exercise"
+#define DEFAULT_CHECKER "plain"
+#if CME_ALLOC_TRACKED
+#define DEFAULT_MODES "system,guard,redzone"
+#else
+#define DEFAULT_MODES "system" /* The others need the `cme` allocator */
+#endif
+#define DEFAULT_CHECKER_MODES "system" /* Modes when checkers are given */
+#define DEFAULT_TIMEOUT_MS 10000
+#define MAX_LIST 64          /* Most entries of a comma separated list */
+#define MAX_SCENARIOS 64     /* Most scenarios of a program */
+#define MAX_NAME 64          /* Longest scenario name */
+#define MAX_OUTPUT (16 << 10) /* Detector output kept per run */
+#define POLL_MS 50           /* Longest wait for output or exits */
+#define VALGRIND_ERROR 99    /* Exit status of a run Valgrind found errors in */
+#define MAX_REPEAT 99        /* Most runs of a variant */
+#define SUMMARY_ITERATIONS 1000 /* Default iterations with --summary */
+#define SUMMARY_REPEAT 5     /* Default runs of a variant with --summary */
+#define MIN_LOOP_MS 1.0      /* Shortest scenario time a slowdown is taken of */
+
+/* ==========================================================================
+ * Type Definitions Section
+ * ========================================================================== */
+
+/* A way to run the programs: the build holding them, the tool they run
+   under (if any) and the value of `CME_ALLOC` */
+typedef struct run_checker {
+  const char *name;
+  const char *dir;
+  const char *alloc_mode;
+  char *valgrind; /* Path of Valgrind for the `valgrind` checker, or NULL */
+} run_checker;
+
+/* One run of a scenario variant, and its outcome */
+typedef struct run_job {
+  const char *program;
+  char scenario[MAX_NAME];
+  int buggy;
+  const run_checker *checker;
+  pid_t pid;         /* Process of the run, 0 before it starts */
+  int fd;            /* Read end of the stderr pipe, -1 when closed */
+  char workdir[96];  /* Scratch directory of the run */
+  double start;      /* Start time (seconds) */
+  int done;          /* Nonzero once reaped */
+  int status;        /* Wait status */
+  int timed_out;     /* Nonzero if killed after the timeout */
+  double wall_ms;    /* Wall time */
+  long max_rss_kb;   /* Peak resident set size */
+  char *output;      /* Start of the stderr output */
+  size_t output_len; /* Bytes kept in `output` */
+  int truncated;     /* Nonzero if more output was dropped */
+} run_job;
+
+/* The whole sweep */
+typedef struct run_plan {
+  run_job *jobs;
+  size_t count;
+  size_t capacity;
+  char base_dir[64];
+  const char *iterations; /* Passed to the programs, NULL for the default */
+  size_t repeat;          /* Runs of each variant */
+  int timed;              /* Nonzero to have the programs time the scenario */
+} run_plan;
+
+/* ==========================================================================
+ * User Defined Function Declarations Section
+ * ========================================================================== */
+
+static size_t split_list(char *list, char **items, size_t max_items);
+static double now_seconds(void);
+static char *program_path(const run_checker *checker, const char *program);
+static size_t list_scenarios(const run_checker *checker, const char *program,
+                             char names[][MAX_NAME], size_t max_names);
+static int add_job(run_plan *plan, const char *program, const char *scenario,
+                   int buggy, const run_checker *checker);
+static int start_job(run_plan *plan, run_job *job, size_t index);
+static void read_output(run_job *job);
+static void finish_job(run_job *job, int status, const struct rusage *usage);
+static void run_all(run_plan *plan, size_t max_running, int timeout_ms);
+static void remove_dir(const char *path);
+static const char *result_name(const run_job *job);
+static const char *signal_name(int signal_number);
+static void write_json_string(FILE *f, const char *text, size_t len);
+static void write_csv_string(FILE *f, const char *text, size_t len);
+static void write_json(FILE *f, const run_plan *plan);
+static void write_csv(FILE *f, const run_plan *plan);
+static char *find_in_path(const char *name);
+static void write_summary(FILE *f, const run_plan *plan, int csv);
+static double loop_time(const run_job *job);
+static void median_run(const run_job *runs, size_t count, double *wall_ms,
+                       double *loop_ms, long *max_rss_kb);
+
+/* ==========================================================================
+ * Global Variables Section
+ * ========================================================================== */
+
+static const char *const kUsages[] = {
+    APP_USAGE_A,
+    NULL,
+};
+
+/* ==========================================================================
+ * Main Function Section
+ * ========================================================================== */
+
+int main(int argc, char **argv) {
+  const char *program_list = DEFAULT_PROGRAMS;
+  const char *mode_list = NULL;
+  const char *checker_list = DEFAULT_CHECKER;
+  const char *filter = NULL;
+  const char *dir = NULL;
+  const char *format = "json";
+  const char *output = NULL;
+  int jobs = 0;
+  int timeout_ms = DEFAULT_TIMEOUT_MS;
+  int iterations = 0;
+  int repeat = 0;
+  int summary = 0;
+  char iterations_text[16] = "";
+  char *programs[MAX_LIST];
+  char *modes[MAX_LIST];
+  char *specs[MAX_LIST];
+  run_checker *checkers = NULL;
+  char scenarios[MAX_SCENARIOS][MAX_NAME];
+  char *program_buf = NULL;
+  char *mode_buf = NULL;
+  char *checker_buf = NULL;
+  char *dir_buf = NULL;
+  size_t num_programs = 0;
+  size_t num_modes = 0;
+  size_t num_specs = 0;
+  size_t num_checkers = 0;
+  size_t num_scenarios = 0;
+  run_plan plan;
+  FILE *out = stdout;
+  double start = 0.0;
+  size_t i = 0;
+  size_t j = 0;
+  size_t k = 0;
+  size_t r = 0;
+  int variant = 0;
+
+  /* The parser reuses `argv`, so keep the path of the runner first */
+  dir_buf = strdup(argv[0]);
+
+  /* Define command line options */
+  struct argparse_option options[] = {
+      OPT_GROUP("general options"),
+      OPT_HELP(),
+      OPT_GROUP("run options"),
+      OPT_STRING('p', "programs", &program_list,
+                 "comma separated programs to run (default all)", NULL, 0, 0),
+      OPT_STRING('c', "checkers", &checker_list,
+                 "comma separated checkers, NAME or NAME=DIR (default "
+                 DEFAULT_CHECKER ")",
+                 NULL, 0, 0),
+      OPT_STRING('m', "modes", &mode_list,
+                 "comma separated allocator modes (default " DEFAULT_MODES
+                 ", " DEFAULT_CHECKER_MODES " with --checkers)",
+                 NULL, 0, 0),
+      OPT_STRING('f', "filter", &filter,
+                 "run only the scenarios whose name contains the text", NULL,
+                 0, 0),
+      OPT_STRING('d', "dir", &dir, "directory of the programs", NULL, 0, 0),
+      OPT_INTEGER('j', "jobs", &jobs,
+                  "runs at the same time (default the number of CPUs)", NULL,
+                  0, 0),
+      OPT_INTEGER('t', "timeout", &timeout_ms,
+                  "milliseconds before a run is killed (default 10000)", NULL,
+                  0, 0),
+      OPT_INTEGER('i', "iterations", &iterations,
+                  "iterations of each scenario (default 1, 1000 with "
+                  "--summary)",
+                  NULL, 0, 0),
+      OPT_INTEGER('r', "repeat", &repeat,
+                  "runs of each variant (default 1, 5 with --summary)", NULL,
+                  0, 0),
+      OPT_GROUP("output options"),
+      OPT_STRING('\0', "format", &format, "json (default) or csv", NULL, 0, 0),
+      OPT_STRING('o', "output", &output, "write the results to a file", NULL,
+                 0, 0),
+      OPT_BOOLEAN('\0', "summary", &summary,
+                  "write detection, slowdown and memory overhead per "
+                  "scenario and checker",
+                  NULL, 0, 0),
+      OPT_END(),
+  };
+
+  /* Parse command line arguments */
+  struct argparse argparse;
+  argparse_init(&argparse, options, kUsages, 0);
+  argparse_describe(&argparse, APP_DESCRIPTION, APP_EPILOGUE);
+  argc = argparse_parse(&argparse, argc, (const char **)argv);
+
+  if (0 >= timeout_ms || 0 > iterations || 0 > jobs || 0 > repeat ||
+      MAX_REPEAT < repeat ||
+      (0 != strcmp(format, "json") && 0 != strcmp(format, "csv"))) {
+    fprintf(stderr,
+            "%s: Invalid timeout, iterations, repeat, jobs or format\n",
+            APP_NAME);
+    return EXIT_FAILURE;
+  }
+  if (0 == iterations) {
+    iterations = summary ? SUMMARY_ITERATIONS : 1;
+  }
+  if (0 == repeat) {
+    repeat = summary ? SUMMARY_REPEAT : 1;
+  }
+
+  /* Runs side by side slow each other down, so time them one at a time */
+  if (summary) {
+    if (1 < jobs) {
+      fprintf(stderr, "%s: --summary runs one run at a time\n", APP_NAME);
+    }
+    jobs = 1;
+  }
+  if (0 == jobs) {
+    long cpus = sysconf(_SC_NPROCESSORS_ONLN);
+    jobs = 0 < cpus ? (int)cpus : 1;
+  }
+
+  /* The programs live next to the runner unless told otherwise */
+  if (NULL == dir) {
+    if (dir_buf && strrchr(dir_buf, '/')) {
+      *strrchr(dir_buf, '/') = '\0';
+      dir = dir_buf;
+    } else {
+      dir = ".";
+    }
+  }
+
+  if (NULL == mode_list) {
+    mode_list = 0 == strcmp(checker_list, DEFAULT_CHECKER)
+                    ? DEFAULT_MODES
+                    : DEFAULT_CHECKER_MODES;
+  }
+  program_buf = strdup(program_list);
+  mode_buf = strdup(mode_list);
+  checker_buf = strdup(checker_list);
+  num_programs = program_buf ? split_list(program_buf, programs, MAX_LIST) : 0;
+  num_modes = mode_buf ? split_list(mode_buf, modes, MAX_LIST) : 0;
+  if (!CME_ALLOC_TRACKED) {
+    /* The programs of this build bypass the `cme` allocator, so `CME_ALLOC`
+       would change nothing: every other mode would just rerun the system
+       one and report its bugs as missed */
+    for (i = 0, j = 0; i < num_modes; i++) {
+      if (0 == strcmp(modes[i], "system")) {
+        modes[j++] = modes[i];
+      } else {
+        fprintf(stderr, "%s: the %s mode needs the cme allocator, which the "
+                        "%s build bypasses; skipping it\n",
+                APP_NAME, modes[i], CME_ALLOCATOR_NAME);
+      }
+    }
+    num_modes = j;
+  }
+  num_specs = checker_buf ? split_list(checker_buf, specs, MAX_LIST) : 0;
+  checkers = calloc(num_specs * num_modes + 1, sizeof(run_checker));
+  if (0 == num_programs || 0 == num_modes || 0 == num_specs ||
+      NULL == checkers) {
+    fprintf(stderr, "%s: Invalid list of programs, checkers or modes\n",
+            APP_NAME);
+    return EXIT_FAILURE;
+  }
+
+  /* Every checker under every allocator mode */
+  for (i = 0; i < num_specs; i++) {
+    char *equals = strchr(specs[i], '=');
+    char *valgrind = NULL;
+
+    if (equals) {
+      *equals = '\0';
+    }
+    if (0 == strncmp(specs[i], "valgrind", 8)) {
+      valgrind = find_in_path("valgrind");
+      if (NULL == valgrind) {
+        fprintf(stderr, "%s: valgrind not found, skipping the %s checker\n",
+                APP_NAME, specs[i]);
+        continue;
+      }
+    }
+    for (j = 0; j < num_modes; j++) {
+      checkers[num_checkers].name = specs[i];
+      checkers[num_checkers].dir = equals ? equals + 1 : dir;
+      checkers[num_checkers].alloc_mode = modes[j];
+      checkers[num_checkers].valgrind = valgrind; /* Shared by the modes */
+      num_checkers++;
+    }
+  }
+  if (0 == num_checkers) {
+    fprintf(stderr, "%s: No checker to run\n", APP_NAME);
+    return EXIT_FAILURE;
+  }
+
+  memset(&plan, 0, sizeof(plan));
+  plan.repeat = (size_t)repeat;
+  if (1 < iterations) {
+    snprintf(iterations_text, sizeof(iterations_text), "%d", iterations);
+    plan.iterations = iterations_text;
+  }
+  snprintf(plan.base_dir, sizeof(plan.base_dir), "/tmp/%s.XXXXXX", APP_NAME);
+  if (NULL == mkdtemp(plan.base_dir)) {
+    fprintf(stderr, "%s: Can not create a scratch directory\n", APP_NAME);
+    return EXIT_FAILURE;
+  }
+
+  /* Every scenario, both variants, under every checker, `repeat` runs of
+     each */
+  plan.timed = summary;
+  for (i = 0; i < num_programs; i++) {
+    num_scenarios =
+        list_scenarios(&checkers[0], programs[i], scenarios, MAX_SCENARIOS);
+    if (0 == num_scenarios) {
+      fprintf(stderr, "%s: No scenarios found for %s\n", APP_NAME,
+              programs[i]);
+    }
+    for (j = 0; j < num_scenarios; j++) {
+      if (filter && !strstr(scenarios[j], filter)) {
+        continue;
+      }
+      for (k = 0; k < num_checkers; k++) {
+        for (variant = 0; variant < 2; variant++) {
+          for (r = 0; r < plan.repeat; r++) {
+            if (0 != add_job(&plan, programs[i], scenarios[j], variant,
+                             &checkers[k])) {
+              fprintf(stderr, "%s: Out of memory\n", APP_NAME);
+              return EXIT_FAILURE;
+            }
+          }
+        }
+      }
+    }
+  }
+
+  start = now_seconds();
+  run_all(&plan, (size_t)jobs, timeout_ms);
+  fprintf(stderr, "%s: %zu runs in %.2f s on %d jobs\n", APP_NAME, plan.count,
+          now_seconds() - start, jobs);
+  rmdir(plan.base_dir);
+
+  if (output) {
+    out = fopen(output, "w");
+    if (NULL == out) {
+      fprintf(stderr, "%s: Can not open %s\n", APP_NAME, output);
+      return EXIT_FAILURE;
+    }
+  }
+  if (summary) {
+    write_summary(out, &plan, 0 == strcmp(format, "csv"));
+  } else if (0 == strcmp(format, "csv")) {
+    write_csv(out, &plan);
+  } else {
+    write_json(out, &plan);
+  }
+  if (out != stdout) {
+    fclose(out);
+  }
+
+  for (i = 0; i < plan.count; i++) {
+    free(plan.jobs[i].output);
+  }
+  free(plan.jobs);
+  free(program_buf);
+  free(mode_buf);
+  free(checker_buf);
+  for (i = 0; i < num_checkers; i += num_modes) {
+    free(checkers[i].valgrind);
+  }
+  free(checkers);
+  free(dir_buf);
+
+  return EXIT_SUCCESS;
+}
+
+/* ==========================================================================
+ * User Defined Function Definitions Section
+ * ========================================================================== */
+
+/* --------------------------------------------------------------------------
+ * Function: split_list
+ * --------------------------------------------------------------------------
+ *
+ * Description: Split a comma separated list in place
+ *
+ * Parameters:
+ *          list: List to split (modified)
+ *         items: Receives the items
+ *     max_items: Capacity of `items`
+ *
+ * Returns: Number of items (0 if the list is empty, too long or has an
+ *          empty item)
+ *
+ * -------------------------------------------------------------------------- */
+static size_t split_list(char *list, char **items, size_t max_items) {
+  size_t count = 0;
+  char *comma = NULL;
+
+  while (*list) {
+    if (count == max_items) {
+      return 0;
+    }
+    items[count++] = list;
+    comma = strchr(list, ',');
+    if (NULL == comma) {
+      break;
+    }
+    *comma = '\0';
+    list = comma + 1;
+    if ('\0' == *list || ',' == *list) {
+      return 0;
+    }
+  }
+
+  return 0 < count && '\0' != *items[0] ? count : 0;
+}
+
+/* --------------------------------------------------------------------------
+ * Function: now_seconds
+ * --------------------------------------------------------------------------
+ *
+ * Description: Current time of a monotonic clock
+ *
+ * Returns: Time in seconds
+ *
+ * -------------------------------------------------------------------------- */
+static double now_seconds(void) {
+  struct timespec ts;
+
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+
+  return (double)ts.tv_sec + (double)ts.tv_nsec * 1e-9;
+}
+
+/* --------------------------------------------------------------------------
+ * Function: program_path
+ * --------------------------------------------------------------------------
+ *
+ * Description: Absolute path of a program (the scenarios run in scratch
+ *              directories, so a relative path would not be found)
+ *
+ * Parameters:
+ *     checker: Checker whose directory holds the program
+ *     program: Name of the program
+ *
+ * Returns: Allocated path (release it with `free`), or NULL
+ *
+ * -------------------------------------------------------------------------- */
+static char *program_path(const run_checker *checker, const char *program) {
+  char *dir = realpath(checker->dir, NULL);
+  char *path = NULL;
+  size_t size = 0;
+
+  if (dir) {
+    size = strlen(dir) + strlen(program) + 2;
+    path = malloc(size);
+    if (path) {
+      snprintf(path, size, "%s/%s", dir, program);
+    }
+    free(dir);
+  }
+
+  return path;
+}
+
+/* --------------------------------------------------------------------------
+ * Function: list_scenarios
+ * --------------------------------------------------------------------------
+ *
+ * Description: Ask a program for its scenarios (`--scenario list`)
+ *
+ * Parameters:
+ *       checker: Checker whose directory holds the program
+ *       program: Name of the program
+ *         names: Receives the names of the scenarios
+ *     max_names: Capacity of `names`
+ *
+ * Returns: Number of scenarios (0 if the program can not be run)
+ *
+ * -------------------------------------------------------------------------- */
+static size_t list_scenarios(const run_checker *checker, const char *program,
+                             char names[][MAX_NAME], size_t max_names) {
+  char *path = program_path(checker, program);
+  char line[256];
+  size_t count = 0;
+  int fds[2] = {-1, -1};
+  FILE *f = NULL;
+  pid_t pid = 0;
+
+  if (NULL == path || 0 != pipe(fds)) {
+    free(path);
+    return 0;
+  }
+
+  pid = fork();
+  if (0 == pid) {
+    dup2(fds[1], STDOUT_FILENO);
+    close(fds[0]);
+    close(fds[1]);
+    execl(path, path, "--scenario", "list", (char *)NULL);
+    _exit(127);
+  }
+  close(fds[1]);
+  free(path);
+  if (0 > pid) {
+    close(fds[0]);
+    return 0;
+  }
+
+  f = fdopen(fds[0], "r");
+  while (f && fgets(line, sizeof(line), f)) {
+    if (count < max_names && 1 == sscanf(line, "%63s", names[count])) {
+      count++;
+    }
+  }
+  if (f) {
+    fclose(f);
+  } else {
+    close(fds[0]);
+  }
+  waitpid(pid, NULL, 0);
+
+  return count;
+}
+
+/* --------------------------------------------------------------------------
+ * Function: add_job
+ * --------------------------------------------------------------------------
+ *
+ * Description: Add a run to the plan
+ *
+ * Parameters:
+ *         plan: The sweep
+ *      program: Name of the program
+ *     scenario: Name of the scenario
+ *        buggy: Nonzero for the buggy variant
+ *      checker: How to run the program
+ *
+ * Returns: 0 on success, -1 if out of memory
+ *
+ * -------------------------------------------------------------------------- */
+static int add_job(run_plan *plan, const char *program, const char *scenario,
+                   int buggy, const run_checker *checker) {
+  run_job *job = NULL;
+
+  if (plan->count == plan->capacity) {
+    size_t capacity = plan->capacity ? 2 * plan->capacity : 64;
+    run_job *jobs = realloc(plan->jobs, capacity * sizeof(run_job));
+    if (NULL == jobs) {
+      return -1;
+    }
+    plan->jobs = jobs;
+    plan->capacity = capacity;
+  }
+
+  job = &plan->jobs[plan->count++];
+  memset(job, 0, sizeof(*job));
+  job->program = program;
+  snprintf(job->scenario, sizeof(job->scenario), "%s", scenario);
+  job->buggy = buggy;
+  job->checker = checker;
+  job->fd = -1;
+
+  return 0;
+}
+
+/* --------------------------------------------------------------------------
+ * Function: start_job
+ * --------------------------------------------------------------------------
+ *
+ * Description: Start a run: fork, and in the child move to the scratch
+ *              directory of the run, send stdout to the null device and
+ *              stderr into a pipe, turn off core dumps, select the
+ *              allocator mode (and for the summary have the scenario timed)
+ *              and run the program. The child leads a process group of its
+ *              own, so a timeout kills whatever it has started as well.
+ *
+ * Parameters:
+ *      plan: The sweep
+ *       job: Run to start
+ *     index: Index of the run (names its scratch directory)
+ *
+ * Returns: 0 on success, -1 if the run could not be started (the run is
+ *          marked done with exit status 127)
+ *
+ * -------------------------------------------------------------------------- */
+static int start_job(run_plan *plan, run_job *job, size_t index) {
+  char *path = program_path(job->checker, job->program);
+  char valgrind_exit[32];
+  char *args[16];
+  size_t num_args = 0;
+  int fds[2] = {-1, -1};
+  pid_t pid = 0;
+
+  /* [valgrind OPTION...] PROGRAM --scenario NAME [--iterations N] [--buggy] */
+  if (job->checker->valgrind) {
+    snprintf(valgrind_exit, sizeof(valgrind_exit), "--error-exitcode=%d",
+             VALGRIND_ERROR);
+    args[num_args++] = job->checker->valgrind;
+    args[num_args++] = "--tool=memcheck";
+    args[num_args++] = "--quiet";
+    args[num_args++] = valgrind_exit;
+  }
+  args[num_args++] = path;
+  args[num_args++] = "--scenario";
+  args[num_args++] = job->scenario;
+  if (plan->iterations) {
+    args[num_args++] = "--iterations";
+    args[num_args++] = (char *)plan->iterations;
+  }
+  if (job->buggy) {
+    args[num_args++] = "--buggy";
+  }
+  args[num_args] = NULL;
+
+  snprintf(job->workdir, sizeof(job->workdir), "%s/%zu", plan->base_dir,
+           index);
+  job->start = now_seconds();
+  if (NULL == path || 0 != mkdir(job->workdir, 0700) || 0 != pipe(fds)) {
+    free(path);
+    job->done = 1;
+    job->status = 127 << 8;
+    return -1;
+  }
+
+  pid = fork();
+  if (0 == pid) {
+    struct rlimit no_core = {0, 0};
+    int null_fd = open("/dev/null", O_WRONLY);
+
+    setpgid(0, 0);
+    setrlimit(RLIMIT_CORE, &no_core);
+    if (0 != chdir(job->workdir)) {
+      _exit(127);
+    }
+    dup2(null_fd, STDOUT_FILENO);
+    dup2(fds[1], STDERR_FILENO);
+    close(null_fd);
+    close(fds[0]);
+    close(fds[1]);
+    setenv("CME_ALLOC", job->checker->alloc_mode, 1);
+    if (plan->timed) {
+      setenv(CME_SCENARIO_TIME_ENV, "1", 1);
+    }
+    setenv("LIBC_FATAL_STDERR_", "1", 1); /* glibc aborts go to stderr */
+
+    /* Sanitizer builds: stop at the first report (UBSan only prints by
+       default), unless the caller has chosen otherwise */
+    setenv("UBSAN_OPTIONS", "halt_on_error=1:print_stacktrace=1", 0);
+    setenv("MSAN_OPTIONS", "halt_on_error=1", 0);
+    execv(args[0], args);
+    _exit(127);
+  }
+
+  free(path);
+  close(fds[1]);
+  if (0 > pid) {
+    close(fds[0]);
+    job->done = 1;
+    job->status = 127 << 8;
+    return -1;
+  }
+  setpgid(pid, pid); /* Also here, so the group exists before any kill */
+  fcntl(fds[0], F_SETFL, fcntl(fds[0], F_GETFL) | O_NONBLOCK);
+  job->pid = pid;
+  job->fd = fds[0];
+
+  return 0;
+}
+
+/* --------------------------------------------------------------------------
+ * Function: read_output
+ * --------------------------------------------------------------------------
+ *
+ * Description: Read what a run has written to stderr so far. The first
+ *              `MAX_OUTPUT` bytes are kept, the rest is dropped. The pipe is
+ *              closed at its end.
+ *
+ * Parameters:
+ *      job: The run
+ *
+ * Returns: None
+ *
+ * -------------------------------------------------------------------------- */
+static void read_output(run_job *job) {
+  char buf[4096];
+  ssize_t got = 0;
+  size_t keep = 0;
+
+  while (0 <= job->fd) {
+    got = read(job->fd, buf, sizeof(buf));
+    if (0 > got && EINTR == errno) {
+      continue;
+    }
+    if (0 > got) {
+      return; /* Nothing more for now */
+    }
+    if (0 == got) {
+      close(job->fd);
+      job->fd = -1;
+      return;
+    }
+    if (NULL == job->output) {
+      job->output = malloc(MAX_OUTPUT);
+    }
+    keep = job->output ? MAX_OUTPUT - job->output_len : 0;
+    keep = keep < (size_t)got ? keep : (size_t)got;
+    if (keep) {
+      memcpy(job->output + job->output_len, buf, keep);
+      job->output_len += keep;
+    }
+    job->truncated |= keep < (size_t)got;
+  }
+}
+
+/* --------------------------------------------------------------------------
+ * Function: finish_job
+ * --------------------------------------------------------------------------
+ *
+ * Description: Record the outcome of a run that has been reaped, take the
+ *              rest of its output and remove its scratch directory
+ *
+ * Parameters:
+ *         job: The run
+ *      status: Wait status
+ *       usage: Resource usage of the run
+ *
+ * Returns: None
+ *
+ * -------------------------------------------------------------------------- */
+static void finish_job(run_job *job, int status, const struct rusage *usage) {
+  job->done = 1;
+  job->status = status;
+  job->wall_ms = (now_seconds() - job->start) * 1e3;
+  job->max_rss_kb = usage->ru_maxrss;
+
+  /* Whatever the process group still holds open is of no interest */
+  kill(-job->pid, SIGKILL);
+  read_output(job);
+  if (0 <= job->fd) {
+    close(job->fd);
+    job->fd = -1;
+  }
+  remove_dir(job->workdir);
+}
+
+/* --------------------------------------------------------------------------
+ * Function: run_all
+ * --------------------------------------------------------------------------
+ *
+ * Description: Run every job of the plan, at most `max_running` at a time.
+ *              The output of the running jobs is read as it comes (so no
+ *              run blocks on a full pipe), finished jobs are reaped with
+ *              their resource usage, and jobs past their deadline are
+ *              killed.
+ *
+ * Parameters:
+ *            plan: The sweep
+ *     max_running: Most runs at the same time
+ *      timeout_ms: Time a run may take
+ *
+ * Returns: None
+ *
+ * -------------------------------------------------------------------------- */
+static void run_all(run_plan *plan, size_t max_running, int timeout_ms) {
+  struct pollfd *fds = calloc(max_running, sizeof(struct pollfd));
+  size_t *running = calloc(max_running, sizeof(size_t));
+  size_t num_running = 0;
+  size_t next = 0;
+  size_t num_fds = 0;
+  size_t i = 0;
+  double now = 0.0;
+  struct rusage usage;
+  int status = 0;
+  pid_t pid = 0;
+
+  if (NULL == fds || NULL == running) {
+    free(fds);
+    free(running);
+    return;
+  }
+
+  while (next < plan->count || 0 < num_running) {
+    /* Keep every slot busy */
+    while (num_running < max_running && next < plan->count) {
+      if (0 == start_job(plan, &plan->jobs[next], next)) {
+        running[num_running++] = next;
+      }
+      next++;
+    }
+
+    /* Wait for output, at most until the next check of exits and timeouts */
+    num_fds = 0;
+    for (i = 0; i < num_running; i++) {
+      if (0 <= plan->jobs[running[i]].fd) {
+        fds[num_fds].fd = plan->jobs[running[i]].fd;
+        fds[num_fds].events = POLLIN;
+        num_fds++;
+      }
+    }
+    if (num_fds) {
+      poll(fds, num_fds, POLL_MS);
+    } else if (num_running) {
+      usleep(1000);
+    }
+    for (i = 0; i < num_running; i++) {
+      read_output(&plan->jobs[running[i]]);
+    }
+
+    /* Reap the finished runs, kill the late ones */
+    now = now_seconds();
+    for (i = 0; i < num_running;) {
+      run_job *job = &plan->jobs[running[i]];
+
+      pid = wait4(job->pid, &status, WNOHANG, &usage);
+      if (pid == job->pid) {
+        finish_job(job, status, &usage);
+        running[i] = running[--num_running];
+        continue;
+      }
+      if (!job->timed_out && (now - job->start) * 1e3 > timeout_ms) {
+        job->timed_out = 1;
+        kill(-job->pid, SIGKILL);
+      }
+      i++;
+    }
+  }
+
+  free(fds);
+  free(running);
+}
+
+/* --------------------------------------------------------------------------
+ * Function: remove_dir
+ * --------------------------------------------------------------------------
+ *
+ * Description: Remove a scratch directory and the files the run left in it
+ *              (the programs do not create subdirectories)
+ *
+ * Parameters:
+ *      path: Directory to remove
+ *
+ * Returns: None
+ *
+ * -------------------------------------------------------------------------- */
+static void remove_dir(const char *path) {
+  DIR *dir = opendir(path);
+  struct dirent *entry = NULL;
+  char file[256];
+
+  if (dir) {
+    while (NULL != (entry = readdir(dir))) {
+      if (0 != strcmp(entry->d_name, ".") && 0 != strcmp(entry->d_name, "..")) {
+        int len = snprintf(file, sizeof(file), "%s/%s", path, entry->d_name);
+
+        if (0 <= len && (size_t)len < sizeof(file)) {
+          unlink(file); /* Not a cut off name of another file */
+        }
+      }
+    }
+    closedir(dir);
+  }
+  rmdir(path);
+}
+
+/* --------------------------------------------------------------------------
+ * Function: result_name
+ * --------------------------------------------------------------------------
+ *
+ * Description: Name of the outcome of a run
+ *
+ * Parameters:
+ *      job: The run
+ *
+ * Returns: "ok", "exit", "signal" or "timeout"
+ *
+ * -------------------------------------------------------------------------- */
+static const char *result_name(const run_job *job) {
+  if (job->timed_out) {
+    return "timeout";
+  }
+  if (WIFSIGNALED(job->status)) {
+    return "signal";
+  }
+
+  return 0 == WEXITSTATUS(job->status) ? "ok" : "exit";
+}
+
+/* --------------------------------------------------------------------------
+ * Function: signal_name
+ * --------------------------------------------------------------------------
+ *
+ * Description: Name of a signal
+ *
+ * Parameters:
+ *      signal_number: The signal
+ *
+ * Returns: Name of the signal (e.g. "SIGSEGV"), or "SIG" and its number
+ *
+ * -------------------------------------------------------------------------- */
+static const char *signal_name(int signal_number) {
+  static const struct {
+    int number;
+    const char *name;
+  } kSignals[] = {
+      {SIGABRT, "SIGABRT"}, {SIGBUS, "SIGBUS"},   {SIGFPE, "SIGFPE"},
+      {SIGILL, "SIGILL"},   {SIGKILL, "SIGKILL"}, {SIGSEGV, "SIGSEGV"},
+      {SIGSYS, "SIGSYS"},   {SIGTERM, "SIGTERM"}, {SIGTRAP, "SIGTRAP"},
+  };
+  static char other[16];
+  size_t i = 0;
+
+  for (i = 0; i < sizeof(kSignals) / sizeof(kSignals[0]); i++) {
+    if (kSignals[i].number == signal_number) {
+      return kSignals[i].name;
+    }
+  }
+  snprintf(other, sizeof(other), "SIG%d", signal_number);
+
+  return other;
+}
+
+/* --------------------------------------------------------------------------
+ * Function: write_json_string
+ * --------------------------------------------------------------------------
+ *
+ * Description: Write text as a JSON string (quoted and escaped)
+ *
+ * Parameters:
+ *        f: Output file
+ *     text: Text to write
+ *      len: Length of the text
+ *
+ * Returns: None
+ *
+ * -------------------------------------------------------------------------- */
+static void write_json_string(FILE *f, const char *text, size_t len) {
+  size_t i = 0;
+  unsigned char c = 0;
+
+  fputc('"', f);
+  for (i = 0; i < len; i++) {
+    c = (unsigned char)text[i];
+    if ('"' == c || '\\' == c) {
+      fputc('\\', f);
+      fputc(c, f);
+    } else if ('\n' == c) {
+      fputs("\\n", f);
+    } else if ('\t' == c) {
+      fputs("\\t", f);
+    } else if (0x20 > c || 0x7F <= c) {
+      fprintf(f, "\\u%04x", c); /* Bytes that are not ASCII stay bytes */
+    } else {
+      fputc(c, f);
+    }
+  }
+  fputc('"', f);
+}
+
+/* --------------------------------------------------------------------------
+ * Function: write_csv_string
+ * --------------------------------------------------------------------------
+ *
+ * Description: Write text as a CSV field (quoted, quotes doubled)
+ *
+ * Parameters:
+ *        f: Output file
+ *     text: Text to write
+ *      len: Length of the text
+ *
+ * Returns: None
+ *
+ * -------------------------------------------------------------------------- */
+static void write_csv_string(FILE *f, const char *text, size_t len) {
+  size_t i = 0;
+
+  fputc('"', f);
+  for (i = 0; i < len; i++) {
+    if ('"' == text[i]) {
+      fputc('"', f);
+    }
+    fputc(text[i], f);
+  }
+  fputc('"', f);
+}
+
+/* --------------------------------------------------------------------------
+ * Function: write_json
+ * --------------------------------------------------------------------------
+ *
+ * Description: Write the results as a JSON array of runs
+ *
+ * Parameters:
+ *        f: Output file
+ *     plan: The sweep
+ *
+ * Returns: None
+ *
+ * -------------------------------------------------------------------------- */
+static void write_json(FILE *f, const run_plan *plan) {
+  const run_job *job = NULL;
+  size_t i = 0;
+
+  fputs("[\n", f);
+  for (i = 0; i < plan->count; i++) {
+    job = &plan->jobs[i];
+    fprintf(f,
+            "  {\"program\": \"%s\", \"scenario\": \"%s\", \"variant\": "
+            "\"%s\", \"checker\": \"%s\", \"mode\": \"%s\", \"result\": "
+            "\"%s\", ",
+            job->program, job->scenario, job->buggy ? "buggy" : "correct",
+            job->checker->name, job->checker->alloc_mode, result_name(job));
+    if (!job->timed_out && WIFEXITED(job->status)) {
+      fprintf(f, "\"exit_code\": %d, \"signal\": null, ",
+              WEXITSTATUS(job->status));
+    } else if (!job->timed_out && WIFSIGNALED(job->status)) {
+      fprintf(f, "\"exit_code\": null, \"signal\": \"%s\", ",
+              signal_name(WTERMSIG(job->status)));
+    } else {
+      fputs("\"exit_code\": null, \"signal\": \"SIGKILL\", ", f);
+    }
+    fprintf(f, "\"wall_ms\": %.3f, \"max_rss_kb\": %ld, \"truncated\": %s, ",
+            job->wall_ms, job->max_rss_kb, job->truncated ? "true" : "false");
+    fputs("\"output\": ", f);
+    write_json_string(f, job->output ? job->output : "", job->output_len);
+    fprintf(f, "}%s\n", i + 1 < plan->count ? "," : "");
+  }
+  fputs("]\n", f);
+}
+
+/* --------------------------------------------------------------------------
+ * Function: write_csv
+ * --------------------------------------------------------------------------
+ *
+ * Description: Write the results as CSV, one run per row
+ *
+ * Parameters:
+ *        f: Output file
+ *     plan: The sweep
+ *
+ * Returns: None
+ *
+ * -------------------------------------------------------------------------- */
+static void write_csv(FILE *f, const run_plan *plan) {
+  const run_job *job = NULL;
+  size_t i = 0;
+
+  fputs("program,scenario,variant,checker,mode,result,exit_code,signal,"
+        "wall_ms,max_rss_kb,truncated,output\n",
+        f);
+  for (i = 0; i < plan->count; i++) {
+    job = &plan->jobs[i];
+    fprintf(f, "%s,%s,%s,%s,%s,%s,", job->program, job->scenario,
+            job->buggy ? "buggy" : "correct", job->checker->name,
+            job->checker->alloc_mode, result_name(job));
+    if (!job->timed_out && WIFEXITED(job->status)) {
+      fprintf(f, "%d,,", WEXITSTATUS(job->status));
+    } else if (!job->timed_out && WIFSIGNALED(job->status)) {
+      fprintf(f, ",%s,", signal_name(WTERMSIG(job->status)));
+    } else {
+      fputs(",SIGKILL,", f);
+    }
+    fprintf(f, "%.3f,%ld,%d,", job->wall_ms, job->max_rss_kb, job->truncated);
+    write_csv_string(f, job->output ? job->output : "", job->output_len);
+    fputc('\n', f);
+  }
+}
+
+/* --------------------------------------------------------------------------
+ * Function: find_in_path
+ * --------------------------------------------------------------------------
+ *
+ * Description: Look a program up in the directories of `PATH`
+ *
+ * Parameters:
+ *      name: Name of the program
+ *
+ * Returns: Allocated path of the program (release it with `free`), or NULL
+ *          if it is not found
+ *
+ * -------------------------------------------------------------------------- */
+static char *find_in_path(const char *name) {
+  const char *path = getenv("PATH");
+  const char *end = NULL;
+  char *file = NULL;
+  size_t len = 0;
+
+  while (path && *path) {
+    end = strchr(path, ':');
+    len = end ? (size_t)(end - path) : strlen(path);
+    file = malloc(len + strlen(name) + 2);
+    if (NULL == file) {
+      return NULL;
+    }
+    sprintf(file, "%.*s/%s", (int)len, path, name);
+    if (0 < len && 0 == access(file, X_OK)) {
+      return file;
+    }
+    free(file);
+    path = end ? end + 1 : NULL;
+  }
+
+  return NULL;
+}
+
+/* --------------------------------------------------------------------------
+ * Function: write_summary
+ * --------------------------------------------------------------------------
+ *
+ * Description: Write one row per scenario, checker and allocator mode:
+ *              whether the checker detected the bug (every buggy run did
+ *              not end `ok`), whether it raised a false alarm (a correct
+ *              run did not end `ok`), and the slowdown and memory overhead
+ *              of the correct variant against the first checker. Wall time,
+ *              scenario time and peak RSS are the medians of the `repeat`
+ *              runs. The slowdown compares the scenario times the programs
+ *              report (`CME_SCENARIO_TIME`), which leave out starting the
+ *              process and the checker. It is null (JSON) or n/a (CSV) when
+ *              a run did not report one, or when the scenario took under
+ *              `MIN_LOOP_MS` against the first checker, too short to tell
+ *              from the noise (raise `--iterations`). The runs are in the
+ *              order the plan added them: for each scenario and checker the
+ *              correct runs and the buggy runs, the first checker first.
+ *
+ * Parameters:
+ *        f: Output file
+ *     plan: The sweep
+ *      csv: Nonzero for CSV, zero for JSON
+ *
+ * Returns: None
+ *
+ * -------------------------------------------------------------------------- */
+static void write_summary(FILE *f, const run_plan *plan, int csv) {
+  const size_t repeat = plan->repeat;
+  const run_job *base = NULL;
+  const run_job *correct = NULL;
+  const run_job *buggy = NULL;
+  double wall_ms = 0.0;
+  double loop_ms = 0.0;
+  double base_wall_ms = 0.0;
+  double base_loop_ms = 0.0;
+  long max_rss_kb = 0;
+  long base_rss_kb = 0;
+  double memory = 0.0;
+  char slowdown[32];
+  char loop[32];
+  int detected = 0;
+  int false_alarm = 0;
+  size_t i = 0;
+  size_t r = 0;
+  int first = 1;
+
+  fputs(csv ? "program,scenario,checker,mode,detected,false_alarm,"
+              "slowdown,memory_overhead,wall_ms,loop_ms,max_rss_kb\n"
+            : "[\n",
+        f);
+  for (i = 0; i + 2 * repeat <= plan->count; i += 2 * repeat) {
+    correct = &plan->jobs[i];
+    buggy = correct + repeat;
+    if (NULL == base || base->program != correct->program ||
+        0 != strcmp(base->scenario, correct->scenario)) {
+      base = correct;
+      median_run(base, repeat, &base_wall_ms, &base_loop_ms, &base_rss_kb);
+    }
+
+    detected = 1;
+    false_alarm = 0;
+    for (r = 0; r < repeat; r++) {
+      detected &= 0 != strcmp(result_name(&buggy[r]), "ok");
+      false_alarm |= 0 != strcmp(result_name(&correct[r]), "ok");
+    }
+    median_run(correct, repeat, &wall_ms, &loop_ms, &max_rss_kb);
+    if (MIN_LOOP_MS <= base_loop_ms && 0.0 <= loop_ms) {
+      snprintf(slowdown, sizeof(slowdown), "%.2f", loop_ms / base_loop_ms);
+    } else {
+      snprintf(slowdown, sizeof(slowdown), "%s", csv ? "n/a" : "null");
+    }
+    if (0.0 <= loop_ms) {
+      snprintf(loop, sizeof(loop), "%.3f", loop_ms);
+    } else {
+      snprintf(loop, sizeof(loop), "%s", csv ? "n/a" : "null");
+    }
+    memory = 0 < base_rss_kb ? (double)max_rss_kb / (double)base_rss_kb
+                             : 0.0;
+    if (csv) {
+      fprintf(f, "%s,%s,%s,%s,%s,%s,%s,%.2f,%.3f,%s,%ld\n",
+              correct->program, correct->scenario, correct->checker->name,
+              correct->checker->alloc_mode, detected ? "yes" : "no",
+              false_alarm ? "yes" : "no", slowdown, memory, wall_ms, loop,
+              max_rss_kb);
+    } else {
+      fprintf(f,
+              "%s  {\"program\": \"%s\", \"scenario\": \"%s\", \"checker\": "
+              "\"%s\", \"mode\": \"%s\", \"detected\": %s, \"false_alarm\": "
+              "%s, \"slowdown\": %s, \"memory_overhead\": %.2f, "
+              "\"wall_ms\": %.3f, \"loop_ms\": %s, \"max_rss_kb\": %ld}",
+              first ? "" : ",\n", correct->program, correct->scenario,
+              correct->checker->name, correct->checker->alloc_mode,
+              detected ? "true" : "false", false_alarm ? "true" : "false",
+              slowdown, memory, wall_ms, loop, max_rss_kb);
+    }
+    first = 0;
+  }
+  if (!csv) {
+    fputs(first ? "]\n" : "\n]\n", f);
+  }
+}
+
+/* --------------------------------------------------------------------------
+ * Function: loop_time
+ * --------------------------------------------------------------------------
+ *
+ * Description: Find the scenario time a run reported in its output (the
+ *              line `cme_scenario_run` writes with `CME_SCENARIO_TIME` set)
+ *
+ * Parameters:
+ *      job: A finished run
+ *
+ * Returns: Time of the scenario in milliseconds, or -1 if the run did not
+ *          report one (it crashed, or the line was past `MAX_OUTPUT`)
+ *
+ * -------------------------------------------------------------------------- */
+static double loop_time(const run_job *job) {
+  const size_t tag_len = strlen(CME_SCENARIO_TIME_TAG);
+  char number[32];
+  size_t i = 0;
+  size_t n = 0;
+
+  for (i = 0; job->output && i + tag_len < job->output_len; i++) {
+    if ((0 == i || '\n' == job->output[i - 1]) &&
+        0 == memcmp(job->output + i, CME_SCENARIO_TIME_TAG, tag_len)) {
+      for (i += tag_len, n = 0; i < job->output_len &&
+                                '\n' != job->output[i] &&
+                                n + 1 < sizeof(number);
+           i++) {
+        number[n++] = job->output[i];
+      }
+      number[n] = '\0';
+      return strtod(number, NULL);
+    }
+  }
+
+  return -1.0;
+}
+
+/* --------------------------------------------------------------------------
+ * Function: median_run
+ * --------------------------------------------------------------------------
+ *
+ * Description: Take the median wall time, scenario time and peak RSS of
+ *              runs of the same variant (each on its own, so they may come
+ *              from different runs)
+ *
+ * Parameters:
+ *           runs: The runs
+ *          count: Number of runs (at most `MAX_REPEAT`, 0 for none)
+ *        wall_ms: Receives the median wall time (0 without runs)
+ *        loop_ms: Receives the median scenario time (-1 if a run did not
+ *                 report one)
+ *     max_rss_kb: Receives the median peak RSS (0 without runs)
+ *
+ * Returns: None
+ *
+ * -------------------------------------------------------------------------- */
+static void median_run(const run_job *runs, size_t count, double *wall_ms,
+                       double *loop_ms, long *max_rss_kb) {
+  double times[MAX_REPEAT];
+  double loops[MAX_REPEAT];
+  long sizes[MAX_REPEAT];
+  double loop = 0.0;
+  double time = 0.0;
+  long size = 0;
+  int untimed = 0;
+  size_t i = 0;
+  size_t j = 0;
+
+  *wall_ms = 0.0;
+  *loop_ms = -1.0;
+  *max_rss_kb = 0;
+  if (0 == count) {
+    return;
+  }
+
+  /* Insertion sort, there are only a few runs */
+  for (i = 0; i < count; i++) {
+    time = runs[i].wall_ms;
+    size = runs[i].max_rss_kb;
+    for (j = i; 0 < j && times[j - 1] > time; j--) {
+      times[j] = times[j - 1];
+    }
+    times[j] = time;
+    loop = loop_time(&runs[i]);
+    untimed |= 0.0 > loop;
+    for (j = i; 0 < j && loops[j - 1] > loop; j--) {
+      loops[j] = loops[j - 1];
+    }
+    loops[j] = loop;
+    for (j = i; 0 < j && sizes[j - 1] > size; j--) {
+      sizes[j] = sizes[j - 1];
+    }
+    sizes[j] = size;
+  }
+
+  *wall_ms = count % 2 ? times[count / 2]
+                       : (times[count / 2 - 1] + times[count / 2]) / 2.0;
+  if (!untimed) { /* One run without a time leaves the median out */
+    *loop_ms = count % 2 ? loops[count / 2]
+                         : (loops[count / 2 - 1] + loops[count / 2]) / 2.0;
+  }
+  *max_rss_kb = count % 2 ? sizes[count / 2]
+                          : (sizes[count / 2 - 1] + sizes[count / 2]) / 2;
+}
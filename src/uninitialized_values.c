@@ -40,6 +40,12 @@
 /* External libraries headers */
 #include <argparse.h>
 
+/* Project headers */
+#include "cme_alloc.h"
+#include "cme_log.h"
+#include "cme_scenario.h"
+#include "cme_string.h"
+
 /* ==========================================================================
  * Macros Definitions Section
  * ========================================================================== */
@@ -68,15 +74,6 @@
 #endif /* End of platform specific macro definition */
 #define APP_EPILOGUE "\nReport bugs to <" APP_EMAIL ">."
 
-/* ==========================================================================
- * Global Variables Section
- * ========================================================================== */
-
-static const char *const kUsages[] = {
-    APP_USAGE_A,
-    NULL,
-};
-
 /* ==========================================================================
  * Utility Function Declarations Section
  * ========================================================================== */
@@ -88,7 +85,23 @@ int version_info(struct argparse *self, const struct argparse_option *option);
  * User Defined Function Declarations Section
  * ========================================================================== */
 
-static void print_message(const char *message);
+static void print_message(cme_str message);
+
+static void scenario_print_message(int buggy);
+
+/* ==========================================================================
+ * Global Variables Section
+ * ========================================================================== */
+
+static const char *const kUsages[] = {
+    APP_USAGE_A,
+    NULL,
+};
+
+static const cme_scenario kScenarios[] = {
+    {"print-message", "print a message that was never initialized",
+     scenario_print_message},
+};
 
 /* ==========================================================================
  * Main Function Section
@@ -98,6 +111,10 @@ int main(int argc, char **argv) {
 
   int usage = 0;
   int version = 0;
+  int stats = 0;
+  const char *scenario = NULL;
+  int buggy = 0;
+  int iterations = 1;
 
   /* Define command line options */
   struct argparse_option options[] = {
@@ -107,6 +124,16 @@ int main(int argc, char **argv) {
                   &short_usage, 0, 0),
       OPT_BOOLEAN('V', "version", &version, "print program version",
                   &version_info, 0, 0),
+      OPT_BOOLEAN('\0', "stats", &stats,
+                  "print the allocations per call site at exit", NULL, 0, 0),
+      OPT_GROUP("scenario options"),
+      OPT_STRING('s', "scenario", &scenario,
+                 "run only the scenario NAME (`list' shows the scenarios)",
+                 NULL, 0, 0),
+      OPT_BOOLEAN('\0', "buggy", &buggy,
+                  "run the buggy variant of the scenario", NULL, 0, 0),
+      OPT_INTEGER('i', "iterations", &iterations,
+                  "run the scenario N times (default 1)", NULL, 0, 0),
       OPT_END(),
   };
 
@@ -121,18 +148,35 @@ int main(int argc, char **argv) {
     exit(EXIT_SUCCESS);
   }
 
+  /* Count the allocations per call site, printed at exit */
+  if (stats != 0 && 0 != cme_alloc_stats_enable(1)) {
+    fprintf(stderr, "%s: --stats is not available with CME_ALLOCATOR=%s\n",
+            APP_NAME, CME_ALLOCATOR_NAME);
+    exit(EXIT_FAILURE);
+  }
+
   /* Main module code */
   int status = EXIT_SUCCESS;
 
-  if (argc == 0) {
+  /* Hand the output over to the background writer */
+  cme_log_start(APP_NAME, 0, CME_LOG_BLOCK);
+
+  if (argc == 0 && NULL != scenario) {
+    /* Run a single scenario instead of the whole program */
+    if (0 != cme_scenario_run(kScenarios, CME_SCENARIO_COUNT(kScenarios),
+                              scenario, buggy, iterations)) {
+      status = EXIT_FAILURE;
+    }
+  } else if (argc == 0) {
     /* No arguments were given */
-    char *message; /* Uninitialized variable */
+    cme_str message; /* Uninitialized variable */
 
     /* Call the function with uninitialized variable --------------------------
 
        This is the line that will cause the program to crash. The variable
-       `message` is uninitialized, so it points to a random location in memory.
-       When we try to read from that location, the program will crash.
+       `message` is uninitialized, so its data pointer points to a random
+       location in memory and its length is garbage. When we try to read from
+       that location, the program will crash.
 
        If we run this program with a memory profiling tool like DrMemory, we'll
        see an error message like this:
@@ -144,9 +188,11 @@ int main(int argc, char **argv) {
        with a stack trace that shows the line of code that caused the error.  */
     print_message(message);
 
-    printf("%s: Program execution complete!\n", APP_NAME);
+    cme_log("Program execution complete!\n");
   }
 
+  cme_log_stop();
+
   return status;
 }
 
@@ -211,15 +257,38 @@ int version_info(struct argparse *self, const struct argparse_option *option) {
  * Description: Print a message to the console
  *
  * Parameters:
- *     message: Pointer to a string message
+ *     message: String message
  *
  * Returns: None
  *
  * -------------------------------------------------------------------------- */
-static void print_message(const char *message) {
-  if (NULL != message) {
-    printf("%s: Hello \"%s\"\n", APP_NAME, message);
+static void print_message(cme_str message) {
+  if (NULL != message.data) {
+    cme_log("Hello \"%.*s\"\n", (int)message.len, message.data);
   } else {
-    printf("%s: This space left intentionally blank.\n", APP_NAME);
+    cme_log("This space left intentionally blank.\n");
+  }
+}
+
+/* --------------------------------------------------------------------------
+ * Function: scenario_print_message
+ * --------------------------------------------------------------------------
+ *
+ * Description: Print a message. The message of the buggy variant is never
+ *              initialized.
+ *
+ * Parameters:
+ *     buggy: Nonzero to run the buggy variant
+ *
+ * Returns: None
+ *
+ * -------------------------------------------------------------------------- */
+static void scenario_print_message(int buggy) {
+  cme_str blank = {NULL, 0, 0};
+  cme_str message; /* Uninitialized variable */
+
+  if (!buggy) {
+    message = blank;
   }
+  print_message(message);
 }
\ No newline at end of file
@@ -34,12 +34,23 @@
 /* System headers */
 
 /* Standard Library headers */
+#include <inttypes.h>
+#include <limits.h>
+#include <stdint.h>
 #include <stdio.h>
 #include <stdlib.h>
 
 /* External libraries headers */
 #include <argparse.h>
 
+/* Project headers */
+#include "cme_abs_sum.h"
+#include "cme_alloc.h"
+#include "cme_log.h"
+#include "cme_parse.h"
+#include "cme_scenario.h"
+#include "cme_values.h"
+
 /* ==========================================================================
  * Macros Definitions Section
  * ========================================================================== */
@@ -68,15 +79,6 @@
 #endif /* End of platform specific macro definition */
 #define APP_EPILOGUE "\nReport bugs to <" APP_EMAIL ">."
 
-/* ==========================================================================
- * Global Variables Section
- * ========================================================================== */
-
-static const char *const kUsages[] = {
-    APP_USAGE_A,
-    NULL,
-};
-
 /* ==========================================================================
  * Utility Function Declarations Section
  * ========================================================================== */
@@ -88,8 +90,27 @@ int version_info(struct argparse *self, const struct argparse_option *option);
  * User Defined Function Declarations Section
  * ========================================================================== */
 
-static int abs_sum(int a, int b);
-static int get_result(int base_num);
+static int add_abs_sums(void *ctx, const int32_t *values, size_t n);
+static int get_result(int base_num, int64_t *result);
+static int get_batch_result(int base_num, uint64_t *result, uint64_t *count);
+
+static void scenario_abs_sum(int buggy);
+static void scenario_unchecked_input(int buggy);
+
+/* ==========================================================================
+ * Global Variables Section
+ * ========================================================================== */
+
+static const char *const kUsages[] = {
+    APP_USAGE_A,
+    NULL,
+};
+
+static const cme_scenario kScenarios[] = {
+    {"abs-sum", "absolute sum of INT_MIN and INT_MAX", scenario_abs_sum},
+    {"unchecked-input", "sum a number that could not be read",
+     scenario_unchecked_input},
+};
 
 /* ==========================================================================
  * Main Function Section
@@ -98,7 +119,12 @@ static int get_result(int base_num);
 int main(int argc, char **argv) {
 
   int usage = 0;
+  int batch = 0;
   int version = 0;
+  int stats = 0;
+  const char *scenario = NULL;
+  int buggy = 0;
+  int iterations = 1;
 
   /* Define command line options */
   struct argparse_option options[] = {
@@ -108,6 +134,21 @@ int main(int argc, char **argv) {
                   &short_usage, 0, 0),
       OPT_BOOLEAN('V', "version", &version, "print program version",
                   &version_info, 0, 0),
+      OPT_BOOLEAN('\0', "stats", &stats,
+                  "print the allocations per call site at exit", NULL, 0, 0),
+      OPT_GROUP("input options"),
+      OPT_BOOLEAN('b', "batch", &batch,
+                  "read whitespace separated integers from the standard "
+                  "input until its end and sum their absolute values",
+                  NULL, 0, 0),
+      OPT_GROUP("scenario options"),
+      OPT_STRING('s', "scenario", &scenario,
+                 "run only the scenario NAME (`list' shows the scenarios)",
+                 NULL, 0, 0),
+      OPT_BOOLEAN('\0', "buggy", &buggy,
+                  "run the buggy variant of the scenario", NULL, 0, 0),
+      OPT_INTEGER('i', "iterations", &iterations,
+                  "run the scenario N times (default 1)", NULL, 0, 0),
       OPT_END(),
   };
 
@@ -122,18 +163,54 @@ int main(int argc, char **argv) {
     exit(EXIT_SUCCESS);
   }
 
+  /* Count the allocations per call site, printed at exit */
+  if (stats != 0 && 0 != cme_alloc_stats_enable(1)) {
+    fprintf(stderr, "%s: --stats is not available with CME_ALLOCATOR=%s\n",
+            APP_NAME, CME_ALLOCATOR_NAME);
+    exit(EXIT_FAILURE);
+  }
+
   /* Main module code */
   int status = EXIT_SUCCESS;
 
-  if (argc == 0) {
+  /* Hand the output over to the background writer */
+  cme_log_start(APP_NAME, 0, CME_LOG_BLOCK);
+
+  if (argc == 0 && NULL != scenario) {
+    /* Run a single scenario instead of the whole program */
+    if (0 != cme_scenario_run(kScenarios, CME_SCENARIO_COUNT(kScenarios),
+                              scenario, buggy, iterations)) {
+      status = EXIT_FAILURE;
+    }
+  } else if (argc == 0) {
     /* No arguments were given */
     int base_num = 0;
-    int result = get_result(base_num);
-    printf("%s: Result is %d\n", APP_NAME, result);
 
-    printf("%s: Program execution complete!\n", APP_NAME);
+    if (batch) {
+      uint64_t result = 0;
+      uint64_t count = 0;
+
+      if (0 == get_batch_result(base_num, &result, &count)) {
+        cme_log("Read %" PRIu64 " values, result is %" PRIu64 "\n", count,
+                result);
+      } else {
+        status = EXIT_FAILURE;
+      }
+    } else {
+      int64_t result = 0;
+
+      if (0 == get_result(base_num, &result)) {
+        cme_log("Result is %" PRId64 "\n", result);
+      } else {
+        status = EXIT_FAILURE;
+      }
+    }
+
+    cme_log("Program execution complete!\n");
   }
 
+  cme_log_stop();
+
   return status;
 }
 
@@ -192,47 +269,129 @@ int version_info(struct argparse *self, const struct argparse_option *option) {
  * ========================================================================== */
 
 /* --------------------------------------------------------------------------
- * Function: abs_sum
+ * Function: add_abs_sums
  * --------------------------------------------------------------------------
  *
- * Description: Calculate the absolute sum of two integers
+ * Description: Parser sink adding a batch of absolute values to a running
+ *              sum. This is `cme_abs_sum_two` applied to a whole batch at once.
  *
  * Parameters:
- *      a: First integer
- *      b: Second integer
+ *         ctx: Running sum (`uint64_t`)
+ *      values: Parsed values
+ *           n: Number of values
  *
- * Returns: Absolute sum of `a` and `b`
+ * Returns: 0 (never stops the parse)
  *
  * -------------------------------------------------------------------------- */
-static int abs_sum(int a, int b) {
-  if (a < 0) {
-    a *= -1;
-  }
+static int add_abs_sums(void *ctx, const int32_t *values, size_t n) {
+  *(uint64_t *)ctx += cme_abs_sum(values, n);
+
+  return 0;
+}
 
-  if (b < 0) {
-    b *= -1;
+/* --------------------------------------------------------------------------
+ * Function: get_result
+ * --------------------------------------------------------------------------
+ *
+ * Description: Get the result of the absolute sum of two integers. The
+ *              return value of `scanf` is checked, so a missing or malformed
+ *              number is reported instead of summing an uninitialized value.
+ *
+ * Parameters:
+ *      base_num: Base number
+ *        result: Receives the absolute sum of `base_num` and the number
+ *                entered
+ *
+ * Returns: 0 on success, -1 if no number could be read
+ *
+ * -------------------------------------------------------------------------- */
+static int get_result(int base_num, int64_t *result) {
+  int user_entered = 0;
+
+  cme_log("Enter a number: ");
+  cme_log_flush(); /* Show the prompt before waiting for the answer */
+  if (1 != scanf("%d", &user_entered)) {
+    cme_log_error("Expected a number\n");
+    return -1;
   }
 
-  return a + b;
+  *result = cme_abs_sum_two(base_num, user_entered);
+
+  return 0;
 }
 
 /* --------------------------------------------------------------------------
- * Function: get_result
+ * Function: get_batch_result
  * --------------------------------------------------------------------------
  *
- * Description: Get the result of the absolute sum of two integers
+ * Description: Get the absolute sum of the base number and of every integer
+ *              on the standard input. The input is read in large blocks and
+ *              parsed in bulk (`cme_parse_ints`), and the values are summed
+ *              a batch at a time (`cme_abs_sum`).
  *
  * Parameters:
  *      base_num: Base number
+ *        result: Receives the absolute sum
+ *         count: Receives the number of values read
+ *
+ * Returns: 0 on success, -1 on a parse or read error
+ *
+ * -------------------------------------------------------------------------- */
+static int get_batch_result(int base_num, uint64_t *result, uint64_t *count) {
+  cme_parse_error error;
+
+  *result = (uint64_t)cme_abs_sum_two(base_num, 0);
+  if (0 != cme_parse_ints(stdin, add_abs_sums, result, count, &error)) {
+    cme_log_error("<stdin>:%zu:%zu: %s (byte %" PRIu64 ")\n", error.line,
+                  error.column, error.reason, error.offset);
+    return -1;
+  }
+
+  return 0;
+}
+
+/* --------------------------------------------------------------------------
+ * Function: scenario_abs_sum
+ * --------------------------------------------------------------------------
+ *
+ * Description: Print the absolute sum of INT_MIN and INT_MAX. The buggy
+ *              variant sums them as `int`, which overflows.
+ *
+ * Parameters:
+ *     buggy: Nonzero to run the buggy variant
+ *
+ * Returns: None
+ *
+ * -------------------------------------------------------------------------- */
+static void scenario_abs_sum(int buggy) {
+  if (buggy) {
+    cme_log("Result is %d\n", cme_abs_sum_two_buggy(INT_MIN, INT_MAX));
+  } else {
+    cme_log("Result is %" PRId64 "\n", cme_abs_sum_two(INT_MIN, INT_MAX));
+  }
+}
+
+/* --------------------------------------------------------------------------
+ * Function: scenario_unchecked_input
+ * --------------------------------------------------------------------------
  *
- * Returns: Absolute sum of `base_num` and `user_entered`
+ * Description: Read a number from a text that holds none. The buggy variant
+ *              does not check the return value of `sscanf` and sums the
+ *              uninitialized number.
+ *
+ * Parameters:
+ *     buggy: Nonzero to run the buggy variant
+ *
+ * Returns: None
  *
  * -------------------------------------------------------------------------- */
-static int get_result(int base_num) {
+static void scenario_unchecked_input(int buggy) {
   int user_entered;
 
-  printf("%s: Enter a number: ", APP_NAME);
-  scanf("%d", &user_entered);
+  if (1 != sscanf("not a number", "%d", &user_entered) && !buggy) {
+    cme_log_error("Expected a number\n");
+    return;
+  }
 
-  return abs_sum(base_num, user_entered);
+  cme_log("Result is %" PRId64 "\n", cme_abs_sum_two(0, user_entered));
 }
\ No newline at end of file